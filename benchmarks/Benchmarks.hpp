@@ -0,0 +1,52 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef BENCHMARKS_HPP
+#  define BENCHMARKS_HPP
+
+//------------------------------------------------------------------------------
+//! \brief Signature of benchmarks. Arguments given to the benchmark are the
+//! command line arguments following the name of the benchmark.
+//! \return EXIT_SUCCESS or EXIT_FAILURE.
+//------------------------------------------------------------------------------
+using Benchmark = int (*)(int argc, char* argv[]);
+
+//! \brief Howard versus Karp critical cycle solvers.
+int benchmarkCriticalCycle(int argc, char* argv[]);
+
+//! \brief Minimal P-semiflows and T-semiflows of large nets.
+int benchmarkInvariants(int argc, char* argv[]);
+
+//! \brief States per second of the reachability graph explorer.
+int benchmarkReachability(int argc, char* argv[]);
+
+//! \brief Minimal siphons and traps, and the Commoner's condition.
+int benchmarkSiphons(int argc, char* argv[]);
+
+//! \brief Firings per second of the editor simulation.
+int benchmarkSimulation(int argc, char* argv[]);
+
+//! \brief Scalar versus SIMD (max,+) sparse matrix-vector products.
+int benchmarkTropical(int argc, char* argv[]);
+
+//! \brief Events per second of the dater trajectory of a timed event graph.
+int benchmarkSysLin(int argc, char* argv[]);
+
+#endif // BENCHMARKS_HPP
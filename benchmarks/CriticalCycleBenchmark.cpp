@@ -0,0 +1,149 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Algorithms.hpp"
+#include "PetriNet/Howard.h"
+#include "PetriNet/Karp.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Return the largest difference between cycle durations of Howard and
+//! Karp.
+//------------------------------------------------------------------------------
+static double maxDifference(std::vector<double> const& a, std::vector<double> const& b)
+{
+    double diff = 0.0;
+    for (size_t i = 0u; i < std::min(a.size(), b.size()); ++i)
+        diff = std::max(diff, std::abs(a[i] - b[i]));
+    return diff;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compare Howard and Karp on the event graphs of the examples.
+//------------------------------------------------------------------------------
+static bool benchmarkExamples(std::string const& path)
+{
+    char const* files[] = {
+        "Howard1.json", "Howard2.json", "EventGraph.json", "JPQ.json",
+        "SemiHoward.teg", "SemiNetherlands.teg"
+    };
+
+    bool res = true;
+    for (auto const& file: files)
+    {
+        Net net(TypeOfNet::TimedPetriNet);
+        bool stringify;
+        std::string const error = loadFromFile(net, path + file, stringify);
+        if (!error.empty())
+        {
+            std::cerr << error << std::endl;
+            res = false;
+            continue;
+        }
+
+        auto const t0 = std::chrono::steady_clock::now();
+        CriticalCycleResult const howard = findCriticalCycle(net);
+        auto const t1 = std::chrono::steady_clock::now();
+        CriticalCycleResult const karp = findCriticalCycle(net, CriticalCycleSolver::Karp);
+        auto const t2 = std::chrono::steady_clock::now();
+
+        std::cout << file << ": Howard " << (howard.success ? "ok" : "failed") << " in "
+                  << std::chrono::duration<double>(t1 - t0).count() << " s, Karp "
+                  << (karp.success ? "ok" : "failed") << " in "
+                  << std::chrono::duration<double>(t2 - t1).count() << " s";
+        if (howard.success && karp.success)
+            std::cout << ", max difference " << maxDifference(howard.durations, karp.durations);
+        else if (!karp.success)
+            std::cout << " (" << karp.message.str() << ")";
+        std::cout << std::endl;
+    }
+    return res;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compare Howard and Karp on a random strongly connected graph (a
+//! circuit plus random chords) with one or two tokens per arc.
+//------------------------------------------------------------------------------
+static void benchmarkSynthetic(size_t const nnodes, size_t const narcs)
+{
+    std::mt19937 generator(0u);
+    std::uniform_int_distribution<int> node(0, int(nnodes) - 1);
+    std::uniform_real_distribution<double> timing(0.0, 100.0);
+    std::bernoulli_distribution two_tokens(0.01);
+
+    std::vector<int> IJ;
+    std::vector<double> T, N;
+    for (size_t a = 0u; a < narcs; ++a)
+    {
+        IJ.push_back((a < nnodes) ? int(a) : node(generator));
+        IJ.push_back((a < nnodes) ? int((a + 1u) % nnodes) : node(generator));
+        T.push_back(timing(generator));
+        N.push_back(two_tokens(generator) ? 2.0 : 1.0);
+    }
+
+    std::vector<double> chi(nnodes), v(nnodes), karp;
+    std::vector<int> pi(nnodes);
+    int ncomponents, niterations;
+    size_t kcomponents;
+
+    auto const t0 = std::chrono::steady_clock::now();
+    int const howard = Semi_Howard(IJ.data(), T.data(), N.data(), int(nnodes),
+                                   int(narcs), chi.data(), v.data(), pi.data(),
+                                   &niterations, &ncomponents, 0);
+    auto const t1 = std::chrono::steady_clock::now();
+    int const res = Karp(IJ, T, N, nnodes, karp, kcomponents);
+    auto const t2 = std::chrono::steady_clock::now();
+
+    std::cout << "Synthetic graph " << nnodes << " nodes, " << narcs << " arcs: Howard "
+              << ((howard == 0) ? "ok" : "failed") << " (" << niterations
+              << " iterations) in " << std::chrono::duration<double>(t1 - t0).count()
+              << " s, Karp " << ((res == 0) ? "ok" : "failed") << " in "
+              << std::chrono::duration<double>(t2 - t1).count() << " s";
+    if ((howard == 0) && (res == 0))
+        std::cout << ", max difference " << maxDifference(chi, karp);
+    std::cout << std::endl;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compare the Howard and Karp critical cycle solvers.
+//! Arguments: [path of data/examples] [nodes] [arcs]
+//------------------------------------------------------------------------------
+int benchmarkCriticalCycle(int argc, char* argv[])
+{
+    std::string const path = (argc > 0) ? argv[0] : "../data/examples/";
+    size_t const nnodes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000u;
+    size_t const narcs = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100000u;
+
+    bool const res = benchmarkExamples(path);
+    benchmarkSynthetic(nnodes, std::max(nnodes, narcs));
+
+    return res ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,132 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "Nets.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Invariants.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Compute the P-semiflows and T-semiflows of the net and display the
+//! number of places they prove bounded.
+//------------------------------------------------------------------------------
+static bool semiflows(std::string const& name, CompiledNet const& net)
+{
+    auto const t0 = std::chrono::steady_clock::now();
+    SemiflowsResult const psemiflows = findPSemiflows(net);
+    auto const t1 = std::chrono::steady_clock::now();
+    SemiflowsResult const tsemiflows = findTSemiflows(net);
+    auto const t2 = std::chrono::steady_clock::now();
+
+    std::cout << name << " (" << net.countPlaces() << " places, "
+              << net.countTransitions() << " transitions): ";
+    if (!psemiflows.success || !tsemiflows.success)
+    {
+        std::cout << psemiflows.message << tsemiflows.message << std::endl;
+        return false;
+    }
+
+    std::vector<size_t> const bounds = structuralBounds(net, psemiflows.semiflows);
+    size_t const bounded = net.countPlaces() - size_t(std::count(
+        bounds.begin(), bounds.end(), size_t(-1)));
+    std::cout << psemiflows.semiflows.size() << " P-semiflows in "
+              << std::chrono::duration<double>(t1 - t0).count() << " s ("
+              << bounded << " bounded places), " << tsemiflows.semiflows.size()
+              << " T-semiflows in " << std::chrono::duration<double>(t2 - t1).count()
+              << " s" << std::endl;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Create a pipeline of n stages sharing k resources: each stage takes
+//! a resource, works and gives it back. Each resource is shared by all
+//! stages: semiflows overlap on the resource places.
+//------------------------------------------------------------------------------
+static void createPipeline(Net& net, size_t const n, size_t const k)
+{
+    for (size_t r = 0u; r < k; ++r)
+        net.addPlace(float(r), -1.0f, 1u);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        net.addPlace(float(i), 0.0f, (i == 0u) ? 1u : 0u); // Idle
+        net.addPlace(float(i), 1.0f, 0u); // Busy
+        net.addTransition(float(i), 0.5f);
+        net.addTransition(float(i), 1.5f);
+    }
+    for (size_t i = 0u; i < n; ++i)
+    {
+        Place& idle = net.places()[k + 2u * i];
+        Place& busy = net.places()[k + 2u * i + 1u];
+        Place& resource = net.places()[i % k];
+        Transition& take = net.transitions()[2u * i];
+        Transition& give = net.transitions()[2u * i + 1u];
+        net.addArc(idle, take);
+        net.addArc(resource, take);
+        net.addArc(take, busy);
+        net.addArc(busy, give);
+        net.addArc(give, resource);
+        net.addArc(give, net.places()[k + 2u * ((i + 1u) % n)]);
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Semiflows of the examples and of large generated nets.
+//! Arguments: [path of data/examples] [philosophers] [pipeline stages]
+//------------------------------------------------------------------------------
+int benchmarkInvariants(int argc, char* argv[])
+{
+    std::string const path = (argc > 0) ? argv[0] : "../data/examples/";
+    size_t const n = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000u;
+    size_t const m = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 4000u;
+
+    bool res = true;
+    for (auto const& file: { "Philosophers.json", "EmergencyCalls.json",
+                             "SmarthomeSafety.json", "FourRoadJunctions.json" })
+    {
+        Net net(TypeOfNet::PetriNet);
+        bool stringify;
+        std::string const error = loadFromFile(net, path + file, stringify);
+        if (!error.empty())
+        {
+            std::cerr << error << std::endl;
+            res = false;
+            continue;
+        }
+        res &= semiflows(file, CompiledNet(net));
+    }
+
+    Net philosophers(TypeOfNet::PetriNet);
+    createPhilosophers(philosophers, n);
+    res &= semiflows(std::to_string(n) + " philosophers", CompiledNet(philosophers));
+
+    Net pipeline(TypeOfNet::PetriNet);
+    createPipeline(pipeline, m, 16u);
+    res &= semiflows(std::to_string(m) + " stages pipeline", CompiledNet(pipeline));
+
+    return res ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,221 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "Nets.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Reachability.hpp"
+#include "PetriNet/SymbolicReachability.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Explore the graph and display the number of states per second.
+//------------------------------------------------------------------------------
+static void explore(std::string const& name, CompiledNet const& net,
+                    ReachabilityGraph::Options const& options)
+{
+    ReachabilityGraph graph(net);
+    auto const t0 = std::chrono::steady_clock::now();
+    graph.explore(options);
+    auto const t1 = std::chrono::steady_clock::now();
+    double const elapsed = std::chrono::duration<double>(t1 - t0).count();
+
+    std::cout << name << ": " << graph.countStates() << " states"
+              << (graph.isComplete() ? "" : " (incomplete)") << ", "
+              << graph.deadlocks().size() << " deadlocks, "
+              << (graph.isBounded() ? "bounded, " : "")
+              << graph.memory() / graph.countStates() << " bytes/state in "
+              << elapsed << " s (" << double(graph.countStates()) / elapsed
+              << " states/s)" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compute the reachable set with decision diagrams.
+//------------------------------------------------------------------------------
+static void exploreSymbolic(std::string const& name, CompiledNet const& net)
+{
+    SymbolicReachability symbolic(net);
+    auto const t0 = std::chrono::steady_clock::now();
+    bool const res = symbolic.explore();
+    auto const t1 = std::chrono::steady_clock::now();
+
+    std::cout << name << " symbolic: ";
+    if (res)
+    {
+        std::cout << symbolic.countStates() << " states, " << symbolic.countDeadlocks()
+                  << " deadlocks, " << symbolic.deadTransitions().size()
+                  << " dead transitions, " << symbolic.countNodes() << " nodes, "
+                  << symbolic.iterations() << " iterations";
+    }
+    else
+    {
+        std::cout << symbolic.error();
+    }
+    std::cout << " in " << std::chrono::duration<double>(t1 - t0).count() << " s"
+              << std::endl;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Coverability graphs of the examples and their reachability graphs
+//! reduced by stubborn sets.
+//------------------------------------------------------------------------------
+static bool benchmarkExamples(std::string const& path, size_t const threads)
+{
+    char const* files[] = {
+        "Philosophers.json", "EmergencyCalls.json", "SmarthomeSafety.json",
+        "ProducerConsumer.json", "ChainSaw.json", "Simple.json",
+        "FourRoadJunctions.json"
+    };
+
+    bool res = true;
+    for (auto const& file: files)
+    {
+        Net net(TypeOfNet::PetriNet);
+        bool stringify;
+        std::string const error = loadFromFile(net, path + file, stringify);
+        if (!error.empty())
+        {
+            std::cerr << error << std::endl;
+            res = false;
+            continue;
+        }
+
+        CompiledNet const compiled(net);
+        ReachabilityGraph::Options options;
+        options.coverability = true;
+        options.max_states = 1000000u;
+        options.threads = threads;
+        explore(std::string(file) + " coverability", compiled, options);
+        options.coverability = false;
+        options.reduction = true;
+        explore(std::string(file) + " reduced", compiled, options);
+    }
+    return res;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Reachability graph of the n dining philosophers: explicit, reduced
+//! by stubborn sets and symbolic. Only the symbolic search is made for the
+//! m philosophers.
+//------------------------------------------------------------------------------
+static void benchmarkPhilosophers(size_t const n, size_t const m, size_t const threads)
+{
+    Net net(TypeOfNet::PetriNet);
+    createPhilosophers(net, n);
+
+    CompiledNet const compiled(net);
+    std::string const name = std::to_string(n) + " philosophers";
+    ReachabilityGraph::Options options;
+    options.threads = threads;
+    explore(name, compiled, options);
+    options.reduction = true;
+    explore(name + " reduced", compiled, options);
+    exploreSymbolic(name, compiled);
+
+    Net large(TypeOfNet::PetriNet);
+    createPhilosophers(large, m);
+    exploreSymbolic(std::to_string(m) + " philosophers", CompiledNet(large));
+}
+
+//------------------------------------------------------------------------------
+//! \brief Reachability graph of independent circuits of places holding a
+//! single token: L^k states.
+//------------------------------------------------------------------------------
+static void benchmarkCircuits(size_t const k, size_t const L, size_t const threads)
+{
+    Net net(TypeOfNet::PetriNet);
+    for (size_t c = 0u; c < k; ++c)
+    {
+        size_t const first = net.places().size();
+        for (size_t i = 0u; i < L; ++i)
+        {
+            net.addPlace(float(i), float(c), (i == 0u) ? 1u : 0u);
+            net.addTransition(float(i), float(c));
+        }
+        for (size_t i = 0u; i < L; ++i)
+        {
+            net.addArc(net.places()[first + i], net.transitions()[first + i]);
+            net.addArc(net.transitions()[first + i], net.places()[first + (i + 1u) % L]);
+        }
+    }
+
+    ReachabilityGraph::Options options;
+    options.threads = threads;
+    explore(std::to_string(k) + " circuits of " + std::to_string(L) + " places",
+            CompiledNet(net), options);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Symbolic reachable sets of the GRAFCET examples.
+//------------------------------------------------------------------------------
+static bool benchmarkGrafcets(std::string const& path)
+{
+    char const* files[] = {
+        "GRAFCET.json", "GRAFCET2.json", "Gemma.json", "GermanTrafficLights.json",
+        "GrafcetActions.json"
+    };
+
+    bool res = true;
+    for (auto const& file: files)
+    {
+        Net net(TypeOfNet::GRAFCET);
+        bool stringify;
+        std::string const error = loadFromFile(net, path + file, stringify);
+        if (!error.empty())
+        {
+            std::cerr << error << std::endl;
+            res = false;
+            continue;
+        }
+        exploreSymbolic(file, CompiledNet(net));
+    }
+
+    // Restore the settings of Petri nets (GRAFCET saturates tokens).
+    Net net(TypeOfNet::PetriNet);
+    return res;
+}
+
+//------------------------------------------------------------------------------
+//! \brief States per second of the reachability graph explorer.
+//! Arguments: [path of data/examples] [circuits] [places per circuit]
+//! [philosophers] [philosophers for the symbolic search] [threads]
+//------------------------------------------------------------------------------
+int benchmarkReachability(int argc, char* argv[])
+{
+    std::string const path = (argc > 0) ? argv[0] : "../data/examples/";
+    size_t const k = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4u;
+    size_t const L = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 32u;
+    size_t const n = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 12u;
+    size_t const m = (argc > 4) ? std::strtoul(argv[4], nullptr, 10) : 200u;
+    size_t const threads = (argc > 5) ? std::strtoul(argv[5], nullptr, 10) : 0u;
+
+    bool res = benchmarkExamples(path, threads);
+    benchmarkCircuits(k, L, threads);
+    benchmarkPhilosophers(n, m, threads);
+    res &= benchmarkGrafcets(path);
+
+    return res ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,91 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Simulation.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Create a circuit P0 -> T0 -> P1 -> T1 ... -> P0 with one token per
+//! place. Each transition has two arcs.
+//------------------------------------------------------------------------------
+static void createCircuit(Net& net, size_t const transitions)
+{
+    for (size_t i = 0u; i < transitions; ++i)
+    {
+        net.addPlace(float(i), 0.0f, 1u);
+        net.addTransition(float(i), 1.0f);
+    }
+    for (size_t i = 0u; i < transitions; ++i)
+    {
+        net.addArc(net.places()[i], net.transitions()[i]);
+        net.addArc(net.transitions()[i], net.places()[(i + 1u) % transitions], 1.0f);
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Measure the number of firings per second made by the editor
+//! simulation. Tokens travel along arcs in a single step: each step fires all
+//! transitions once.
+//! Arguments: [arcs] [steps]
+//------------------------------------------------------------------------------
+int benchmarkSimulation(int argc, char* argv[])
+{
+    size_t const arcs = (argc > 0) ? std::strtoul(argv[0], nullptr, 10) : 10000u;
+    size_t const steps = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100u;
+    size_t const transitions = arcs / 2u;
+
+    Net net(TypeOfNet::TimedPetriNet);
+    createCircuit(net, transitions);
+    Simulation simulation(net);
+
+    // Silent simulation traces.
+    std::cout.setstate(std::ios::failbit);
+
+    simulation.start();
+    simulation.step(0.0f);
+    auto const start = std::chrono::steady_clock::now();
+    for (size_t i = 0u; i < steps; ++i)
+    {
+        simulation.step(1.0f);
+    }
+    auto const stop = std::chrono::steady_clock::now();
+    simulation.stop();
+    simulation.step(0.0f);
+
+    std::cout.clear();
+
+    double const seconds = std::chrono::duration<double>(stop - start).count();
+    size_t const firings = steps * transitions;
+    std::cout << "Net: " << net.places().size() << " places, "
+              << net.transitions().size() << " transitions, "
+              << net.arcs().size() << " arcs" << std::endl;
+    std::cout << "Simulation: " << steps << " steps, " << firings << " firings in "
+              << seconds << " s (" << (double(firings) / seconds) << " firings/s)"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
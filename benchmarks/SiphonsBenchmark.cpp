@@ -0,0 +1,101 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "Nets.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Siphons.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Enumerate minimal siphons and traps and check the Commoner's
+//! condition.
+//------------------------------------------------------------------------------
+static bool siphons(std::string const& name, CompiledNet const& net, size_t const threads)
+{
+    auto const t0 = std::chrono::steady_clock::now();
+    SiphonsResult const siphons = findMinimalSiphons(net, MAX_SIPHONS, threads);
+    auto const t1 = std::chrono::steady_clock::now();
+    SiphonsResult const traps = findMinimalTraps(net, MAX_SIPHONS, threads);
+    auto const t2 = std::chrono::steady_clock::now();
+    CommonerResult const commoner = checkCommoner(net, threads);
+    auto const t3 = std::chrono::steady_clock::now();
+
+    std::cout << name << " (" << net.countPlaces() << " places, " << threads
+              << " threads): ";
+    if (!siphons.success || !traps.success || !commoner.success)
+    {
+        std::cout << siphons.message << traps.message << commoner.message << std::endl;
+        return false;
+    }
+    std::cout << siphons.sets.size() << " minimal siphons in "
+              << std::chrono::duration<double>(t1 - t0).count() << " s, "
+              << traps.sets.size() << " minimal traps in "
+              << std::chrono::duration<double>(t2 - t1).count() << " s, Commoner "
+              << (commoner.holds ? "holds" : "fails") << " ("
+              << commoner.siphons.size() << " siphons without marked trap) in "
+              << std::chrono::duration<double>(t3 - t2).count() << " s" << std::endl;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Minimal siphons and traps of the examples and of the dining
+//! philosophers, with a single thread then with all threads.
+//! Arguments: [path of data/examples] [philosophers] [threads]
+//------------------------------------------------------------------------------
+int benchmarkSiphons(int argc, char* argv[])
+{
+    std::string const path = (argc > 0) ? argv[0] : "../data/examples/";
+    size_t const n = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100u;
+    size_t const threads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 0u;
+
+    bool res = true;
+    for (auto const& file: { "Philosophers.json", "EmergencyCalls.json",
+                             "SmarthomeSafety.json", "FourRoadJunctions.json",
+                             "GRAFCET.json", "Gemma.json" })
+    {
+        Net net(TypeOfNet::PetriNet);
+        bool stringify;
+        std::string const error = loadFromFile(net, path + file, stringify);
+        if (!error.empty())
+        {
+            std::cerr << error << std::endl;
+            res = false;
+            continue;
+        }
+        res &= siphons(file, CompiledNet(net), threads);
+    }
+
+    // Restore the settings of Petri nets (GRAFCET saturates tokens).
+    Net net(TypeOfNet::PetriNet);
+    createPhilosophers(net, n);
+    CompiledNet const compiled(net);
+    std::string const name = std::to_string(n) + " philosophers";
+    res &= siphons(name, compiled, 1u);
+    res &= siphons(name, compiled, threads);
+
+    return res ? EXIT_SUCCESS : EXIT_FAILURE;
+}
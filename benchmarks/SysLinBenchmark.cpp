@@ -0,0 +1,78 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/SysLinSimulation.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Create a timed event graph made of a circuit of transitions where
+//! one place every ten holds a token.
+//------------------------------------------------------------------------------
+static void createEventGraph(Net& net, size_t const transitions)
+{
+    for (size_t i = 0u; i < transitions; ++i)
+    {
+        net.addTransition(float(i), 0.0f);
+    }
+    for (size_t i = 0u; i < transitions; ++i)
+    {
+        net.addArc(net.transitions()[i], net.transitions()[(i + 1u) % transitions],
+                   (i % 10u == 0u) ? 1u : 0u, float(1u + i % 3u));
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Measure the number of events per second of the dater trajectory
+//! simulation of a timed event graph.
+//! Arguments: [transitions] [events]
+//------------------------------------------------------------------------------
+int benchmarkSysLin(int argc, char* argv[])
+{
+    size_t const transitions = (argc > 0) ? std::strtoul(argv[0], nullptr, 10) : 1000u;
+    size_t const events = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000u;
+
+    Net net(TypeOfNet::TimedEventGraph);
+    createEventGraph(net, transitions);
+
+    auto const start = std::chrono::steady_clock::now();
+    SysLinSimulation simulation(net);
+    auto const compiled = std::chrono::steady_clock::now();
+    simulation.reset(std::vector<MaxPlus>(simulation.states(), one<MaxPlus>()));
+    simulation.simulate(events, nullptr, nullptr, nullptr);
+    auto const stop = std::chrono::steady_clock::now();
+
+    double const init = std::chrono::duration<double>(compiled - start).count();
+    double const seconds = std::chrono::duration<double>(stop - compiled).count();
+    std::cout << "System: " << simulation.states() << " states, "
+              << simulation.DsA().nbNonZeros() << " non-zeros in D*A, computed in "
+              << init << " s" << std::endl;
+    std::cout << "Simulation: " << events << " events in " << seconds << " s ("
+              << (double(events) / seconds) << " events/s), X[0] = "
+              << simulation.X()[0] << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+#include "PetriNet/SparseMatrix.hpp"
+#include "PetriNet/TropicalKernels.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Time the iteration x(n) = A x(n-1) with the given kernels.
+//! \return the number of seconds.
+//------------------------------------------------------------------------------
+static double iterate(SparseMatrix<MaxPlus> const& A, size_t const iterations,
+                      bool const simd)
+{
+    tropical::enableSIMD(simd);
+    std::vector<MaxPlus> x(A.nbColumns(), one<MaxPlus>());
+
+    auto const start = std::chrono::steady_clock::now();
+    for (size_t i = 0u; i < iterations; ++i)
+    {
+        x = A * x;
+    }
+    auto const stop = std::chrono::steady_clock::now();
+
+    // Avoid the compiler removing the loop.
+    if (x[0].val == 42.0)
+        std::cout << "";
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compare scalar and SIMD (max,+) sparse matrix-vector products.
+//! Arguments: [rows] [non-zeros per row] [iterations]
+//------------------------------------------------------------------------------
+int benchmarkTropical(int argc, char* argv[])
+{
+    size_t const rows = (argc > 0) ? std::strtoul(argv[0], nullptr, 10) : 100000u;
+    size_t const nnz = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 16u;
+    size_t const iterations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100u;
+
+    std::mt19937 generator(0u);
+    std::uniform_int_distribution<size_t> columns(0u, rows - 1u);
+    std::uniform_real_distribution<double> durations(0.0, 1.0);
+    SparseMatrixBuilder<MaxPlus> builder(rows, rows);
+    builder.reserve(rows * nnz);
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        for (size_t k = 0u; k < nnz; ++k)
+        {
+            builder.add(i, columns(generator), MaxPlus(durations(generator)));
+        }
+    }
+    SparseMatrix<MaxPlus> const A = builder.build();
+
+    bool const simd = tropical::isSIMDEnabled();
+    double const scalar_time = iterate(A, iterations, false);
+    std::cout << "Scalar: " << iterations << " SpMV in " << scalar_time << " s"
+              << std::endl;
+    if (tropical::enableSIMD(true))
+    {
+        double const simd_time = iterate(A, iterations, true);
+        std::cout << "AVX2:   " << iterations << " SpMV in " << simd_time << " s (x"
+                  << (scalar_time / simd_time) << ")" << std::endl;
+    }
+    else
+    {
+        std::cout << "AVX2:   not supported" << std::endl;
+    }
+    tropical::enableSIMD(simd);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "Benchmarks.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+//------------------------------------------------------------------------------
+//! \brief Usage: ./TimedPetriNetEditor-Benchmark <benchmark> [arguments ...]
+//! Run all benchmarks with their default arguments when no benchmark is given.
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    std::map<std::string, Benchmark> const benchmarks = {
+        { "critical-cycle", benchmarkCriticalCycle },
+        { "invariants", benchmarkInvariants },
+        { "reachability", benchmarkReachability },
+        { "simulation", benchmarkSimulation },
+        { "siphons", benchmarkSiphons },
+        { "syslin", benchmarkSysLin },
+        { "tropical", benchmarkTropical },
+    };
+
+    if (argc < 2)
+    {
+        int res = EXIT_SUCCESS;
+        for (auto const& it: benchmarks)
+        {
+            std::cout << "=== " << it.first << " ===" << std::endl;
+            if (it.second(0, nullptr) != EXIT_SUCCESS)
+                res = EXIT_FAILURE;
+        }
+        return res;
+    }
+
+    auto const it = benchmarks.find(argv[1]);
+    if (it == benchmarks.end())
+    {
+        std::cerr << "Unknown benchmark '" << argv[1] << "'. Available:";
+        for (auto const& b: benchmarks)
+            std::cerr << " " << b.first;
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+    }
+    return it->second(argc - 2, argv + 2);
+}
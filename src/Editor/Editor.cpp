@@ -199,6 +199,8 @@ void Editor::closeDocument(Document const* doc)
         {
             // Unregister nets from the global registry before closing
             doc->unregisterNets();
+            // The history may refer to nets of the document.
+            m_history.clear();
             m_documents.erase(m_documents.begin() + static_cast<ptrdiff_t>(i));
             if (m_active_document_index >= m_documents.size() && !m_documents.empty())
             {
@@ -308,6 +310,7 @@ void Editor::setSavePath(std::string const& filepath)
 void Editor::run(Net const& net_to_load)
 {
     this->net() = net_to_load;
+    m_history.clear();
 
     // Start the infinite loop
     Application::run();
@@ -561,7 +564,11 @@ bool Editor::switchOfNet(TypeOfNet const type)
     std::vector<Arc*> arcs;
     std::string error_msg;
     if (convertTo(net(), type, error_msg, arcs))
+    {
+        // Not recorded by the history.
+        m_history.clear();
         return true;
+    }
 
     m_messages.setError(error_msg);
     return false;
@@ -654,6 +661,84 @@ void Editor::addArc(Node& from, Node& to, float const duration)
     m_history.add(std::move(action));
 }
 
+//------------------------------------------------------------------------------
+void Editor::moveNodes(Net& net, std::vector<Node*> const& nodes,
+                       std::vector<ImVec2> const& origins)
+{
+    // A single action for the whole dragging of nodes.
+    auto action = std::make_unique<NetModificationAction>([this]() -> Net& { return this->net(); });
+    action->before(net);
+    for (size_t i = 0u; (i < nodes.size()) && (i < origins.size()); ++i)
+    {
+        action->delta().moveNode(*nodes[i], origins[i].x, origins[i].y);
+    }
+    action->after(net);
+    if (!action->delta().empty())
+    {
+        m_history.add(std::move(action));
+        net.modified = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+void Editor::changeTokens(Net& net, Place& place, bool const increment)
+{
+    size_t const previous = place.tokens;
+    if (increment)
+        place.increment(1u);
+    else
+        place.decrement(1u);
+    if (place.tokens == previous)
+        return ;
+
+    net.touchMarking();
+    // The running simulation only checks transitions around places it has
+    // modified itself.
+    simulation().invalidate();
+
+    // The initial marking is restored when the simulation stops: tokens
+    // changed meanwhile are not recorded (undo and redo are also disabled).
+    if (simulation().isRunning())
+        return ;
+
+    auto action = std::make_unique<NetModificationAction>([this]() -> Net& { return this->net(); });
+    action->before(net);
+    action->delta().tokens(place, previous);
+    action->after(net);
+    m_history.add(std::move(action));
+    net.modified = true;
+}
+
+//------------------------------------------------------------------------------
+void Editor::changeDuration(Net& net, Arc& arc, float const previous)
+{
+    auto action = std::make_unique<NetModificationAction>([this]() -> Net& { return this->net(); });
+    action->before(net);
+    action->delta().duration(arc, previous);
+    action->after(net);
+    if (!action->delta().empty())
+    {
+        m_history.add(std::move(action));
+        net.touchStructure();
+        net.modified = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+void Editor::changeCaption(Net& net, Node& node, std::string const& previous)
+{
+    auto action = std::make_unique<NetModificationAction>([this]() -> Net& { return this->net(); });
+    action->before(net);
+    action->delta().caption(node, previous);
+    action->after(net);
+    if (!action->delta().empty())
+    {
+        m_history.add(std::move(action));
+        net.touchStructure();
+        net.modified = true;
+    }
+}
+
 //------------------------------------------------------------------------------
 void Editor::loadNetFile()
 {
@@ -696,6 +781,7 @@ void Editor::loadDocumentFromFile(std::string const& filepath)
             return;
         }
 
+        m_history.clear();
         activeDocument().unregisterNets();
         auto& doc = activeDocument();
         doc.nets().clear();
@@ -738,6 +824,7 @@ void Editor::loadDocumentFromFile(std::string const& filepath)
     }
 
     m_marked_arcs.clear();
+    m_history.clear();
     activeDocument().unregisterNets();
     auto& doc = activeDocument();
     doc.nets().clear();
@@ -781,6 +868,7 @@ void Editor::importNetFrom(Importer const& importer)
     if (FileDialogHelper::display("ImportDlgKey", [this, &importer](std::string const& filepath)
     {
         m_marked_arcs.clear();
+        m_history.clear();
         net().clear();
         std::string error = importer.importFct(net(), filepath);
         if (error.empty())
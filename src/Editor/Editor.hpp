@@ -32,6 +32,7 @@
 #  include "PetriNet/Exports/Exports.hpp"
 #  include "PetriNet/Imports/Imports.hpp"
 #  include "PetriNet/ForceDirected.hpp"
+#  include "PetriNet/AnalysisCache.hpp"
 
 #  include <vector>
 #  include <memory>
@@ -153,6 +154,19 @@ private:
     Node& addOppositeNode(Node::Type const type, float const x, float const y,
         size_t const tokens = 0u);
     void addArc(Node& from, Node& to, float const duration = 0.0f);
+    void moveNodes(Net& net, std::vector<Node*> const& nodes,
+                   std::vector<ImVec2> const& origins);
+    void changeTokens(Net& net, Place& place, bool const increment);
+    void changeDuration(Net& net, Arc& arc, float const previous);
+    void changeCaption(Net& net, Node& node, std::string const& previous);
+
+private: // Inspector panels
+
+    void drawPlacesPanel(Net& net, Simulation& simulation,
+                         bool& show_place_captions);
+    void drawTransitionsPanel(Net& net, Simulation& simulation, bool& modified,
+                              bool& show_transition_captions);
+    void drawArcsPanel(Net& net, Simulation& simulation);
 
 private: // Error logs
 
@@ -272,6 +286,9 @@ private:
     //! \brief Critical cycle found by Howard algorithm. Also used to show
     //! where are erroneous arcs making the Petri net not be a graph event.
     std::vector<Arc*> m_marked_arcs;
+    //! \brief Results of analysis shown by menus and dialogs, computed again
+    //! only when the net has been modified.
+    mutable AnalysisCache m_analyses;
     //! \brief Clipboard for copy-paste
     Clipboard m_clipboard;
     //! \brief Visualize the net and do the interaction with the user.
@@ -283,6 +300,8 @@ private:
     mutable States m_states;
     //! \brief Cache the path to save the loaded Petri file.
     std::string m_path_to_save;
+    //! \brief Caption of the node edited by the inspector, before the edition.
+    std::string m_caption_backup;
 };
 
 } // namespace tpne
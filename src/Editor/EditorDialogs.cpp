@@ -71,11 +71,17 @@ void Editor::showAdjacencyMatrices() const
         ImGui::Checkbox("Dense matrix", &display_as_dense);
         ImGui::PopStyleVar();
 
-        SparseMatrix<MaxPlus> tokens; SparseMatrix<MaxPlus> durations;
-        toAdjacencyMatrices(net(), tokens, durations);
+        AnalysisCache::AdjacencyMatrices const& matrices = m_analyses.adjacencyMatrices(net());
+        SparseMatrix<MaxPlus> const& tokens = matrices.tokens;
+        SparseMatrix<MaxPlus> const& durations = matrices.durations;
+        if (!matrices.success)
+        {
+            ImGui::Text("%s", "Not an event graph or parallel places: they cannot"
+                        " be folded into adjacency matrices");
+        }
 
         ImGuiTabBarFlags tab_bar_flags = ImGuiTabBarFlags_None;
-        if (ImGui::BeginTabBar("adjacency", tab_bar_flags))
+        if (matrices.success && ImGui::BeginTabBar("adjacency", tab_bar_flags))
         {
             if (ImGui::BeginTabItem("Durations"))
             {
@@ -128,14 +134,14 @@ void Editor::showCounterOrDaterEquation() const
         {
             if (ImGui::BeginTabItem("Counter"))
             {
-                ImGui::Text("%s", showCounterEquation(net(), "", use_caption, tropical_notation)
-                    .str().c_str());
+                ImGui::Text("%s", m_analyses.counterEquation(net(), use_caption,
+                    tropical_notation).c_str());
                 ImGui::EndTabItem();
             }
             if (ImGui::BeginTabItem("Dater"))
             {
-                ImGui::Text("%s", showDaterEquation(net(), "", use_caption, tropical_notation)
-                    .str().c_str());
+                ImGui::Text("%s", m_analyses.daterEquation(net(), use_caption,
+                    tropical_notation).c_str());
                 ImGui::EndTabItem();
             }
             ImGui::EndTabBar();
@@ -164,18 +170,11 @@ void Editor::showDynamicLinearSystem() const
         ImGui::Checkbox("Dense matrix", &display_as_dense);
         ImGui::PopStyleVar();
 
-        static SparseMatrix<MaxPlus> cached_D, cached_A, cached_B, cached_C;
-        static bool cached_valid = false;
-        if (!cached_valid)
-        {
-            toSysLin(net(), cached_D, cached_A, cached_B, cached_C);
-            cached_valid = true;
-        }
-
-        SparseMatrix<MaxPlus>& D = cached_D;
-        SparseMatrix<MaxPlus>& A = cached_A;
-        SparseMatrix<MaxPlus>& B = cached_B;
-        SparseMatrix<MaxPlus>& C = cached_C;
+        AnalysisCache::SysLin const& syslin = m_analyses.sysLin(net());
+        SparseMatrix<MaxPlus> const& D = syslin.D;
+        SparseMatrix<MaxPlus> const& A = syslin.A;
+        SparseMatrix<MaxPlus> const& B = syslin.B;
+        SparseMatrix<MaxPlus> const& C = syslin.C;
         ImGui::Text(u8"%s", "X(n) = D . X(n) (+) A . X(n-1) (+) B . U(n)\nY(n) = C . X(n)");
 
         ImGuiTabBarFlags tab_bar_flags = ImGuiTabBarFlags_None;
@@ -221,7 +220,6 @@ void Editor::showDynamicLinearSystem() const
             ImGui::CloseCurrentPopup();
             m_states.do_syslin = false;
             m_states.plot.reset();
-            cached_valid = false;
         }
         ImGui::EndPopup();
     }
@@ -235,14 +233,7 @@ void Editor::showCriticalCycles()
                             ImVec2(0.5f, 0.5f));
     if (ImGui::BeginPopupModal("Critical Cycle", NULL, ImGuiWindowFlags_AlwaysAutoResize))
     {
-        static CriticalCycleResult cached;
-        static bool cached_valid = false;
-        if (!cached_valid)
-        {
-            cached = findCriticalCycle(net());
-            cached_valid = true;
-        }
-        CriticalCycleResult const& res = cached;
+        CriticalCycleResult const& res = m_analyses.criticalCycle(net());
 
         if (!res.success)
         {
@@ -314,7 +305,6 @@ void Editor::showCriticalCycles()
         {
             ImGui::CloseCurrentPopup();
             m_states.do_find_critical_cycle = false;
-            cached_valid = false;
         }
         ImGui::EndPopup();
     }
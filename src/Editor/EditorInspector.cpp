@@ -28,8 +28,8 @@ namespace tpne {
 //------------------------------------------------------------------------------
 //! \brief Helper to display places/steps panel.
 //------------------------------------------------------------------------------
-static void drawPlacesPanel(Net& net, Simulation& simulation, bool& modified,
-                            bool& show_place_captions)
+void Editor::drawPlacesPanel(Net& net, Simulation& simulation,
+                             bool& show_place_captions)
 {
     const auto readonly = simulation.isRunning() ?
         ImGuiInputTextFlags_ReadOnly : ImGuiInputTextFlags_None;
@@ -49,23 +49,29 @@ static void drawPlacesPanel(Net& net, Simulation& simulation, bool& modified,
     {
         ImGui::PushID(place.key.c_str());
         ImGui::AlignTextToFramePadding();
-        ImGui::InputText(place.key.c_str(), &place.caption,
+        if (ImGui::InputText(place.key.c_str(), &place.caption,
             readonly | ImGuiInputTextFlags_CallbackEdit,
-            [](ImGuiInputTextCallbackData*) { return 0; });
+            [](ImGuiInputTextCallbackData*) { return 0; }))
+        {
+            net.touchStructure();
+        }
+        // A single undo for the whole edition of the caption.
+        if (ImGui::IsItemActivated())
+            m_caption_backup = place.caption;
+        if (ImGui::IsItemDeactivatedAfterEdit())
+            changeCaption(net, place, m_caption_backup);
 
         // Token increment/decrement buttons
         ImGui::SameLine();
         ImGui::PushButtonRepeat(true);
         if (ImGui::ArrowButton("##left", ImGuiDir_Left))
         {
-            place.decrement();
-            modified = true;
+            changeTokens(net, place, false);
         }
         ImGui::SameLine();
         if (ImGui::ArrowButton("##right", ImGuiDir_Right))
         {
-            place.increment();
-            modified = true;
+            changeTokens(net, place, true);
         }
         ImGui::PopButtonRepeat();
 
@@ -80,8 +86,8 @@ static void drawPlacesPanel(Net& net, Simulation& simulation, bool& modified,
 //------------------------------------------------------------------------------
 //! \brief Helper to display transitions panel.
 //------------------------------------------------------------------------------
-static void drawTransitionsPanel(Net& net, Simulation& simulation, [[maybe_unused]] bool& modified,
-                                 bool& show_transition_captions)
+void Editor::drawTransitionsPanel(Net& net, Simulation& simulation, bool& modified,
+                                  bool& show_transition_captions)
 {
     const auto readonly = simulation.isRunning() ?
         ImGuiInputTextFlags_ReadOnly : ImGuiInputTextFlags_None;
@@ -103,12 +109,20 @@ static void drawTransitionsPanel(Net& net, Simulation& simulation, [[maybe_unuse
     {
         ImGui::PushID(static_cast<int>(t.id));
 
-        ImGui::InputText(t.key.c_str(), &t.caption,
+        if (ImGui::InputText(t.key.c_str(), &t.caption,
             readonly | ImGuiInputTextFlags_CallbackEdit,
             [](ImGuiInputTextCallbackData*)
             {
                 return 0;
-            });
+            }))
+        {
+            // Captions of GRAFCET transitions are receptivities.
+            net.touchStructure();
+        }
+        if (ImGui::IsItemActivated())
+            m_caption_backup = t.caption;
+        if (ImGui::IsItemDeactivatedAfterEdit())
+            changeCaption(net, t, m_caption_backup);
 
         // GRAFCET receptivity validation
         if ((net.type() == TypeOfNet::GRAFCET) && (!simulation.isRunning()))
@@ -620,7 +634,7 @@ static void drawGrafcetActionsPanel(Net& net, Simulation& simulation, bool& modi
 //------------------------------------------------------------------------------
 //! \brief Helper to display arc durations panel.
 //------------------------------------------------------------------------------
-static void drawArcsPanel(Net& net, Simulation& simulation, bool& modified)
+void Editor::drawArcsPanel(Net& net, Simulation& simulation)
 {
     const auto readonly = simulation.isRunning() ?
         ImGuiInputTextFlags_ReadOnly : ImGuiInputTextFlags_None;
@@ -635,8 +649,8 @@ static void drawArcsPanel(Net& net, Simulation& simulation, bool& modified)
             {
                 std::string text(arc.from.key + " -> " + arc.to.arcsOut[0]->to.key);
                 float prev_value = arc.duration;
-                ImGui::InputFloat(text.c_str(), &arc.duration, 0.01f, 1.0f, "%.3f", readonly);
-                modified = (prev_value != arc.duration);
+                if (ImGui::InputFloat(text.c_str(), &arc.duration, 0.01f, 1.0f, "%.3f", readonly))
+                    changeDuration(net, arc, prev_value);
             }
         }
         ImGui::End();
@@ -649,8 +663,8 @@ static void drawArcsPanel(Net& net, Simulation& simulation, bool& modified)
         {
             std::string text(arc.from.key + " -> " + arc.to.key);
             float prev_value = arc.duration;
-            ImGui::InputFloat(text.c_str(), &arc.duration, 0.01f, 1.0f, "%.3f", readonly);
-            modified = (prev_value != arc.duration);
+            if (ImGui::InputFloat(text.c_str(), &arc.duration, 0.01f, 1.0f, "%.3f", readonly))
+                changeDuration(net, arc, prev_value);
         }
         ImGui::End();
     }
@@ -662,7 +676,7 @@ void Editor::inspector()
     static bool modified = false;
 
     // Places/Steps panel
-    drawPlacesPanel(net(), simulation(), modified, m_states.show_place_captions);
+    drawPlacesPanel(net(), simulation(), m_states.show_place_captions);
 
     // Transitions panel
     drawTransitionsPanel(net(), simulation(), modified, m_states.show_transition_captions);
@@ -676,7 +690,7 @@ void Editor::inspector()
     }
 
     // Arc durations panel (for timed nets)
-    drawArcsPanel(net(), simulation(), modified);
+    drawArcsPanel(net(), simulation());
 
     // Update net state
     net().modified |= modified;
@@ -287,6 +287,7 @@ void Editor::menuActions()
         Net pn(net().type());
         toCanonicalForm(net(), pn);
         net() = pn;
+        m_history.clear();
     }
 
     ImGui::Separator();
@@ -390,7 +391,7 @@ void Editor::menuGraphEvents()
     if (net().type() == TypeOfNet::GRAFCET)
         return;
 
-    if ((net().type() != TypeOfNet::TimedEventGraph) && !isEventGraph(net()))
+    if ((net().type() != TypeOfNet::TimedEventGraph) && !m_analyses.isEventGraph(net()))
         return;
 
     if (!ImGui::BeginMenu("Graph Events"))
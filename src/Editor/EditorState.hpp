@@ -21,7 +21,7 @@
 #ifndef EDITOR_STATE_HPP
 #  define EDITOR_STATE_HPP
 
-#  include "PetriNet/PetriNet.hpp"
+#  include "PetriNet/NetDelta.hpp"
 #  include "Editor/Messages.hpp"
 #  include <list>
 #  include <memory>
@@ -51,12 +51,13 @@ public:
     //! \brief Constructor.
     //! \param[in] max_levels Maximum number of undo levels to keep.
     //--------------------------------------------------------------------------
-    explicit History(size_t max_levels = 10u)
+    explicit History(size_t max_levels = 1000u)
         : m_max_levels(max_levels)
     {}
 
     //--------------------------------------------------------------------------
-    //! \brief Add a new action to the history.
+    //! \brief Add a new action to the history. Undone actions cannot be
+    //! redone anymore.
     //--------------------------------------------------------------------------
     void add(Action::Ptr action)
     {
@@ -64,7 +65,10 @@ public:
             m_undo_stack.pop_front();
         m_undo_stack.push_back(std::move(action));
         if (!m_redo_stack.empty())
+        {
             m_dirty_count = m_undo_stack.size() + m_redo_stack.size() + 1u;
+            m_redo_stack.clear();
+        }
         else
             m_dirty_count++;
     }
@@ -81,7 +85,8 @@ public:
 
     //--------------------------------------------------------------------------
     //! \brief Undo the last action.
-    //! \return true if successful.
+    //! \return true if successful. On failure, the history is cleared since
+    //! older actions depend on the failed one.
     //--------------------------------------------------------------------------
     bool undo()
     {
@@ -95,12 +100,15 @@ public:
             m_redo_stack.push_back(std::move(action));
             return true;
         }
+        clear();
+        m_dirty_count = 1u;
         return false;
     }
 
     //--------------------------------------------------------------------------
     //! \brief Redo the last undone action.
-    //! \return true if successful.
+    //! \return true if successful. On failure, the history is cleared (see
+    //! undo()).
     //--------------------------------------------------------------------------
     bool redo()
     {
@@ -114,6 +122,8 @@ public:
             m_undo_stack.push_back(std::move(action));
             return true;
         }
+        clear();
+        m_dirty_count = 1u;
         return false;
     }
 
@@ -141,8 +151,13 @@ private:
 };
 
 // *****************************************************************************
-//! \brief Action that stores complete net state for undo/redo.
-//! \note Memory-intensive but simple. Stores full copies of the net.
+//! \brief Action storing the modifications of the net made between before()
+//! and after() as a NetDelta: only the modified nodes and arcs are stored, not
+//! copies of the whole net. Modifications not made through the Net API (moving
+//! nodes, changing tokens, durations or captions) shall be recorded with
+//! delta().
+//! \note Undo and redo fail if the current net is not the modified one (or has
+//! been modified outside the history).
 // *****************************************************************************
 class NetModificationAction : public History::Action
 {
@@ -157,32 +172,65 @@ public:
     {}
 
     //--------------------------------------------------------------------------
-    //! \brief Snapshot the net state before modification.
+    //! \brief Stop recording if after() has not been called (the modification
+    //! has been aborted).
+    //--------------------------------------------------------------------------
+    ~NetModificationAction() override
+    {
+        if (m_recording && (m_target->journal() == &m_delta))
+            m_target->journal(nullptr);
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Start recording modifications of the net.
+    //--------------------------------------------------------------------------
+    void before(Net& net)
+    {
+        m_target = &net;
+        m_recording = true;
+        net.journal(&m_delta);
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Stop recording modifications of the net.
     //--------------------------------------------------------------------------
-    void before(Net const& net) { m_before = net; }
+    void after(Net& net)
+    {
+        net.journal(nullptr);
+        m_recording = false;
+    }
 
     //--------------------------------------------------------------------------
-    //! \brief Snapshot the net state after modification.
+    //! \brief Return the recorded modifications.
     //--------------------------------------------------------------------------
-    void after(Net const& net) { m_after = net; }
+    NetDelta& delta() { return m_delta; }
 
+    //--------------------------------------------------------------------------
+    //! \brief Cancel the recorded modifications.
+    //--------------------------------------------------------------------------
     bool undo() override
     {
-        m_net_getter() = m_before;
-        return true;
+        Net& net = m_net_getter();
+        return (&net == m_target) && m_delta.undo(net);
     }
 
+    //--------------------------------------------------------------------------
+    //! \brief Apply again the recorded modifications.
+    //--------------------------------------------------------------------------
     bool redo() override
     {
-        m_net_getter() = m_after;
-        return true;
+        Net& net = m_net_getter();
+        return (&net == m_target) && m_delta.redo(net);
     }
 
 private:
 
     std::function<Net&()> m_net_getter;
-    Net m_before;
-    Net m_after;
+    //! \brief The modified net.
+    Net* m_target = nullptr;
+    //! \brief Between before() and after().
+    bool m_recording = false;
+    NetDelta m_delta;
 };
 
 } // namespace tpne
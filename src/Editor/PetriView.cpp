@@ -408,6 +408,7 @@ void PetriView::clearAllSelections()
     m_mouse.is_rubber_band = false;
     m_mouse.is_dragging_nodes = false;
     m_mouse.drag_offsets.clear();
+    m_mouse.drag_origins.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -490,10 +491,12 @@ void PetriView::handleSelection(ImGuiMouseButton button)
             }
             m_mouse.is_dragging_nodes = true;
             m_mouse.drag_offsets.clear();
+            m_mouse.drag_origins.clear();
             for (auto const* n : m_mouse.selected_nodes)
             {
                 m_mouse.drag_offsets.push_back(
                     ImVec2(n->x - m_mouse.position.x, n->y - m_mouse.position.y));
+                m_mouse.drag_origins.push_back(ImVec2(n->x, n->y));
             }
         }
     }
@@ -593,6 +596,7 @@ void PetriView::handleAddNode(ImGuiMouseButton button)
         if (transition != nullptr)
         {
             transition->receptivity ^= true;
+            m_current_simulation->invalidate();
         }
     }
 }
@@ -751,7 +755,7 @@ void PetriView::handleMouseClicksAndDrags(Net& net, Simulation& simulation)
 }
 
 //------------------------------------------------------------------------------
-void PetriView::handleMouseRelease(Net& /*net*/)
+void PetriView::handleMouseRelease(Net& net)
 {
     ImGuiMouseButton button;
     if (!isMouseReleased(button))
@@ -777,8 +781,15 @@ void PetriView::handleMouseRelease(Net& /*net*/)
         }
     }
 
+    // Record the whole dragging as a single undoable move.
+    if (m_mouse.is_dragging_nodes)
+    {
+        m_editor.moveNodes(net, m_mouse.selected_nodes, m_mouse.drag_origins);
+    }
+
     m_mouse.is_dragging_nodes = false;
     m_mouse.drag_offsets.clear();
+    m_mouse.drag_origins.clear();
 
     if (button == MOUSE_BOUTON_HANDLE_ARC && !ImGui::GetIO().KeyCtrl)
     {
@@ -861,12 +872,7 @@ void PetriView::handleTokenShortcuts(Net& net)
     Node* node = m_editor.getNode(m_mouse.position);
     if (node != nullptr && node->type == Node::Type::Place)
     {
-        Place* place = reinterpret_cast<Place*>(node);
-        if (increment)
-            place->increment(1u);
-        else
-            place->decrement(1u);
-        net.modified = true;
+        m_editor.changeTokens(net, *reinterpret_cast<Place*>(node), increment);
     }
 }
 
@@ -1301,8 +1307,9 @@ void PetriView::drawPetriNet(Net& net, Simulation& simulation, bool interactive,
         ImGuiInputTextFlags flags = ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_AutoSelectAll;
         if (ImGui::InputText("##name", m_mouse.edit_buffer, sizeof(m_mouse.edit_buffer), flags))
         {
+            std::string const previous = m_mouse.editing_node->caption;
             m_mouse.editing_node->caption = m_mouse.edit_buffer;
-            m_current_net->modified = true;
+            m_editor.changeCaption(*m_current_net, *m_mouse.editing_node, previous);
             m_mouse.editing_node = nullptr;
         }
 
@@ -1347,16 +1354,16 @@ void PetriView::drawPetriNet(Net& net, Simulation& simulation, bool interactive,
             }
             if (m_mouse.context_menu_node != nullptr && m_mouse.context_menu_node->type == Node::Type::Place)
             {
+                // Like token shortcuts, tokens can be changed while the
+                // simulation is running.
                 ImGui::Separator();
                 if (ImGui::MenuItem("Add Token"))
                 {
-                    reinterpret_cast<Place*>(m_mouse.context_menu_node)->increment(1u);
-                    m_current_net->modified = true;
+                    m_editor.changeTokens(*m_current_net, *reinterpret_cast<Place*>(m_mouse.context_menu_node), true);
                 }
                 if (ImGui::MenuItem("Remove Token"))
                 {
-                    reinterpret_cast<Place*>(m_mouse.context_menu_node)->decrement(1u);
-                    m_current_net->modified = true;
+                    m_editor.changeTokens(*m_current_net, *reinterpret_cast<Place*>(m_mouse.context_menu_node), false);
                 }
 
                 // GRAFCET specific menu items
@@ -1382,16 +1389,22 @@ void PetriView::drawPetriNet(Net& net, Simulation& simulation, bool interactive,
                     if (ImGui::MenuItem("Force Active", nullptr, false, !is_active))
                     {
                         place->tokens = 1;
+                        m_current_simulation->invalidate();
+                        m_current_net->touchMarking();
                         m_current_net->modified = true;
                     }
                     if (ImGui::MenuItem("Force Inactive", nullptr, false, is_active))
                     {
                         place->tokens = 0;
+                        m_current_simulation->invalidate();
+                        m_current_net->touchMarking();
                         m_current_net->modified = true;
                     }
                     if (ImGui::MenuItem("Set Tokens..."))
                     {
                         place->tokens = is_active ? 0 : 1;
+                        m_current_simulation->invalidate();
+                        m_current_net->touchMarking();
                         m_current_net->modified = true;
                     }
                 }
@@ -160,6 +160,7 @@ private:
         ImVec2 rubber_band_start;            //!< Rubber band start position
         bool is_dragging_nodes = false;      //!< Is user dragging selected nodes?
         std::vector<ImVec2> drag_offsets;    //!< Offsets for dragging nodes
+        std::vector<ImVec2> drag_origins;    //!< Positions before dragging nodes (for undo)
         Node* editing_node = nullptr;        //!< Node being renamed
         char edit_buffer[256] = {0};     //!< Buffer for name editing
         bool edit_focus_requested = false;   //!< Request focus for edit widget
@@ -306,6 +306,7 @@ std::string ZeroMQRemote::cmdFire(nlohmann::json const& params)
                 transitions[id].receptivity = true;
             }
         }
+        m_editor.simulation().invalidate();
         response["status"] = "ok";
         response["message"] = "Transitions fired";
     }
@@ -319,6 +320,7 @@ std::string ZeroMQRemote::cmdFire(nlohmann::json const& params)
             {
                 transitions[i].receptivity = (bitfield[i] != '0');
             }
+            m_editor.simulation().invalidate();
             response["status"] = "ok";
             response["message"] = "Receptivities set";
         }
@@ -392,6 +394,8 @@ std::string ZeroMQRemote::cmdSetTokens(nlohmann::json const& params)
     if (place_id < places.size())
     {
         places[place_id].tokens = tokens;
+        m_editor.net().touchMarking();
+        m_editor.simulation().invalidate();
         m_editor.net().modified = true;
         response["status"] = "ok";
         response["message"] = "Tokens set";
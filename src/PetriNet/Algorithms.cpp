@@ -23,6 +23,16 @@
 #include "PetriNet/SparseMatrix.hpp"
 #include "PetriNet/TropicalAlgebra.hpp"
 #include "PetriNet/Howard.h"
+#include "PetriNet/Karp.hpp"
+#include "PetriNet/StronglyConnectedComponents.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace tpne {
 
@@ -178,62 +188,164 @@ void toCanonicalForm(Net const& net, Net& canonic)
 }
 
 //------------------------------------------------------------------------------
-void toSysLin(Net const& net,
+void toCanonicalForm(Net const& net, CanonicalForm& canonic)
+{
+    // Identifiers given by the net to its next nodes.
+    size_t next_place_id = 0u;
+    for (auto const& p: net.places())
+        next_place_id = std::max(next_place_id, p.id + 1u);
+    size_t next_transition_id = 0u;
+    for (auto const& t: net.transitions())
+        next_transition_id = std::max(next_transition_id, t.id + 1u);
+
+    canonic.net_transitions = next_transition_id;
+    canonic.roles.assign(next_transition_id, CanonicalForm::Role::None);
+    for (auto const& t: net.transitions())
+    {
+        canonic.roles[t.id] = t.isInput() ? CanonicalForm::Role::Input :
+                              t.isState() ? CanonicalForm::Role::State :
+                              t.isOutput() ? CanonicalForm::Role::Output :
+                              CanonicalForm::Role::None;
+    }
+
+    canonic.places.clear();
+    canonic.places.reserve(net.places().size());
+    for (auto const& p: net.places())
+    {
+        assert(p.arcsIn.size() == 1u);
+        assert(p.arcsOut.size() == 1u);
+        canonic.places.push_back({ p.id, p.arcsIn[0]->from.id, p.arcsOut[0]->to.id,
+                                   p.arcsIn[0]->duration, p.tokens });
+    }
+
+    // Nodes are created in the same order than toCanonicalForm(Net const&,
+    // Net&) so places, identifiers and indices are the same.
+    auto addTransition = [&]()
+    {
+        canonic.roles.push_back(CanonicalForm::Role::State);
+        return next_transition_id++;
+    };
+
+    // Explode places with more than one token into a chain of places holding
+    // a single token. The duration stays on the latest place.
+    size_t i = canonic.places.size();
+    while (i--)
+    {
+        size_t tokens = canonic.places[i].tokens;
+        if (tokens <= 1u)
+            continue;
+
+        size_t from = canonic.places[i].from;
+        while (--tokens)
+        {
+            size_t const id = next_place_id++;
+            size_t const to = addTransition();
+            canonic.places.push_back({ id, from, to, 0.0f, 1u });
+            from = to;
+        }
+        canonic.places[i].from = from;
+        canonic.places[i].tokens = 1u;
+    }
+
+    // Places with one token shall not be linked to inputs or outputs.
+    i = canonic.places.size();
+    while (i--)
+    {
+        if (canonic.places[i].tokens != 1u)
+            continue;
+
+        size_t const from = canonic.places[i].from;
+        if (canonic.roles[from] == CanonicalForm::Role::Input)
+        {
+            size_t const id = next_place_id++;
+            size_t const to = addTransition();
+            canonic.places.push_back({ id, from, to, 0.0f, 0u });
+            canonic.places[i].from = to;
+            canonic.places[i].duration = 0.0f;
+        }
+
+        size_t const to = canonic.places[i].to;
+        if (canonic.roles[to] == CanonicalForm::Role::Output)
+        {
+            size_t const transition = addTransition();
+            canonic.places.push_back({ next_place_id++, transition, to, 0.0f, 0u });
+            canonic.places[i].to = transition;
+        }
+    }
+
+    // Index of transitions inside the vectors U, X and Y. Transitions of the
+    // net are given in the order of their container.
+    canonic.indices.assign(canonic.roles.size(), 0u);
+    canonic.nb_inputs = canonic.nb_states = canonic.nb_outputs = 0u;
+    auto setIndex = [&canonic](size_t const id)
+    {
+        switch (canonic.roles[id])
+        {
+        case CanonicalForm::Role::Input:
+            canonic.indices[id] = canonic.nb_inputs++;
+            break;
+        case CanonicalForm::Role::State:
+            canonic.indices[id] = canonic.nb_states++;
+            break;
+        case CanonicalForm::Role::Output:
+            canonic.indices[id] = canonic.nb_outputs++;
+            break;
+        case CanonicalForm::Role::None:
+            break;
+        }
+    };
+    for (auto const& t: net.transitions())
+        setIndex(t.id);
+    for (size_t id = canonic.net_transitions; id < canonic.roles.size(); ++id)
+        setIndex(id);
+}
+
+//------------------------------------------------------------------------------
+void toSysLin(CanonicalForm const& canonic,
               SparseMatrix<MaxPlus>& D, SparseMatrix<MaxPlus>& A,
-              SparseMatrix<MaxPlus>& B, SparseMatrix<MaxPlus>& C,
-              std::vector<size_t> const& indices, size_t const nb_inputs,
-              size_t const nb_states, size_t const nb_outputs)
+              SparseMatrix<MaxPlus>& B, SparseMatrix<MaxPlus>& C)
 {
-    D.clear(); A.clear(); B.clear(); C.clear();
-    D.reshape(nb_states, nb_states);
-    A.reshape(nb_states, nb_states);
-    B.reshape(nb_states, nb_inputs);
-    C.reshape(nb_outputs, nb_states);
+    // Elements are collected as triplets and compressed once: parallel places
+    // between two transitions are combined by the (max,+) addition.
+    SparseMatrixBuilder<MaxPlus> Db(canonic.nb_states, canonic.nb_states);
+    SparseMatrixBuilder<MaxPlus> Ab(canonic.nb_states, canonic.nb_states);
+    SparseMatrixBuilder<MaxPlus> Bb(canonic.nb_states, canonic.nb_inputs);
+    SparseMatrixBuilder<MaxPlus> Cb(canonic.nb_outputs, canonic.nb_states);
+    std::vector<size_t> const& indices = canonic.indices;
 
     // Note origin and destination are inverted because we use the following
     // matrix product convension: M * x where x is a column vector.
-    for (auto const& arc: net.arcs())
+    for (auto const& p: canonic.places)
     {
-        if (arc.from.type == Node::Type::Place)
-            continue;
-
-        Transition& from = *reinterpret_cast<Transition*>(&(arc.from));
-        if (from.isInput())
+        CanonicalForm::Role const to = canonic.roles[p.to];
+        if (canonic.roles[p.from] == CanonicalForm::Role::Input)
         {
-            Place& p = *reinterpret_cast<Place*>(&(arc.to));
-            for (auto& a: p.arcsOut)
-            {
-                // System inputs: B U(n)
-                Transition& to = *reinterpret_cast<Transition*>(&(a->to));
-                B.set(indices[to.id], indices[from.id], float(arc.duration));
-            }
+            // System inputs: B U(n)
+            Bb.add(indices[p.to], indices[p.from], p.duration);
         }
-        else // States or outputs
+        else if (to == CanonicalForm::Role::State)
         {
-            Place& p = *reinterpret_cast<Place*>(&(arc.to));
-            for (auto& a: p.arcsOut)
+            // Systems states: X(n) = D X(n) (+) A X(n-1)
+            if (p.tokens == 1u)
             {
-                Transition& to = *reinterpret_cast<Transition*>(&(a->to));
-                if (to.isState())
-                {
-                    // Systems states: X(n) = D X(n) (+) A X(n-1)
-                    if (p.tokens == 1u)
-                    {
-                        A.set(indices[to.id], indices[from.id], arc.duration);
-                    }
-                    else
-                    {
-                        D.set(indices[to.id], indices[from.id], arc.duration);
-                    }
-                }
-                else if (to.isOutput())
-                {
-                    // System outputs: Y(n) = C X(n)
-                    C.set(indices[to.id], indices[from.id], arc.duration);
-                }
+                Ab.add(indices[p.to], indices[p.from], p.duration);
+            }
+            else
+            {
+                Db.add(indices[p.to], indices[p.from], p.duration);
             }
         }
+        else if (to == CanonicalForm::Role::Output)
+        {
+            // System outputs: Y(n) = C X(n)
+            Cb.add(indices[p.to], indices[p.from], p.duration);
+        }
     }
+
+    Db.build(D);
+    Ab.build(A);
+    Bb.build(B);
+    Cb.build(C);
 }
 
 //------------------------------------------------------------------------------
@@ -248,40 +360,58 @@ bool toSysLin(Net const& net, SparseMatrix<MaxPlus>& D, SparseMatrix<MaxPlus>& A
     if (!isEventGraph(net, error, arcs))
         return false;
 
-    // Duplicate the Petri net to preserve it because we will modify it into
-    // its canonical form (places with several tokens will splitted to places
-    // with a single token). Canonical Petri net have 0 or 1 tokens on each
-    // places.
-    Net canonical(net.type());
-    toCanonicalForm(net, canonical);
+    // Canonical Petri net have 0 or 1 tokens on each places: places with
+    // several tokens are virtually splitted to places with a single token
+    // without duplicating the net.
+    CanonicalForm canonic;
+    toCanonicalForm(net, canonic);
+    toSysLin(canonic, D, A, B, C);
+    return true;
+}
 
-    // Count the number of inputs, outputs and states for creating matrices.
-    size_t nb_states = 0u;
-    size_t nb_inputs = 0u;
-    size_t nb_outputs = 0u;
+namespace {
 
-    std::vector<size_t> indices;
-    indices.resize(canonical.transitions().size());
+//------------------------------------------------------------------------------
+// Collect places as arcs from -> to. Parallel places between the same two
+// transitions cannot be folded into a single (duration, tokens) arc: the
+// critical cycle depends on the rest of the circuit.
+class AdjacencyBuilder
+{
+public:
 
-    for (auto& t: canonical.transitions())
+    AdjacencyBuilder(size_t const nnodes, size_t const nplaces)
+        : m_nnodes(nnodes), m_durations(nnodes, nnodes), m_tokens(nnodes, nnodes)
     {
-        if (t.isInput())
-        {
-            indices[t.id] = nb_inputs++;
-        }
-        if (t.isState())
-        {
-            indices[t.id] = nb_states++;
-        }
-        if (t.isOutput())
-        {
-            indices[t.id] = nb_outputs++;
-        }
+        m_arcs.reserve(nplaces);
+        m_durations.reserve(nplaces);
+        m_tokens.reserve(nplaces);
     }
 
-    toSysLin(canonical, D, A, B, C, indices, nb_inputs, nb_states, nb_outputs);
-    return true;
-}
+    //! \return false if there is already a place from -> to.
+    bool add(size_t const from, size_t const to, float const duration, size_t const tokens)
+    {
+        if (!m_arcs.insert(from * m_nnodes + to).second)
+            return false;
+        m_durations.add(from, to, duration);
+        m_tokens.add(from, to, float(tokens));
+        return true;
+    }
+
+    void build(SparseMatrix<MaxPlus>& tokens, SparseMatrix<MaxPlus>& durations)
+    {
+        m_durations.build(durations);
+        m_tokens.build(tokens);
+    }
+
+private:
+
+    size_t m_nnodes;
+    std::unordered_set<size_t> m_arcs;
+    SparseMatrixBuilder<MaxPlus> m_durations;
+    SparseMatrixBuilder<MaxPlus> m_tokens;
+};
+
+} // namespace
 
 //------------------------------------------------------------------------------
 bool toAdjacencyMatrices(Net const& net, SparseMatrix<MaxPlus>& tokens, SparseMatrix<MaxPlus>& durations)
@@ -290,6 +420,7 @@ bool toAdjacencyMatrices(Net const& net, SparseMatrix<MaxPlus>& tokens, SparseMa
 
     durations.clear(); durations.reshape(nnodes, nnodes);
     tokens.clear(); tokens.reshape(nnodes, nnodes);
+    AdjacencyBuilder builder(nnodes, net.places().size());
 
     for (auto const& p: net.places())
     {
@@ -310,10 +441,31 @@ bool toAdjacencyMatrices(Net const& net, SparseMatrix<MaxPlus>& tokens, SparseMa
 
         // Note origin and destination are inverted because we use the following
         // matrix product convension: M * x where x is a column vector.
-        durations.set(from.id, to.id, p.arcsIn[0]->duration);
-        tokens.set(from.id, to.id, float(p.tokens));
+        if (!builder.add(from.id, to.id, p.arcsIn[0]->duration, p.tokens))
+            return false;
     }
 
+    builder.build(tokens, durations);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool toAdjacencyMatrices(CanonicalForm const& canonic,
+    SparseMatrix<MaxPlus>& tokens, SparseMatrix<MaxPlus>& durations)
+{
+    size_t const nnodes = canonic.roles.size();
+
+    durations.clear(); durations.reshape(nnodes, nnodes);
+    tokens.clear(); tokens.reshape(nnodes, nnodes);
+    AdjacencyBuilder builder(nnodes, canonic.places.size());
+
+    for (auto const& p: canonic.places)
+    {
+        if (!builder.add(p.from, p.to, p.duration, p.tokens))
+            return false;
+    }
+
+    builder.build(tokens, durations);
     return true;
 }
 
@@ -410,29 +562,38 @@ std::stringstream showDaterEquation(Net const& net, std::string const& comment,
 }
 
 //------------------------------------------------------------------------------
-CriticalCycleResult findCriticalCycle(Net const& net)
+//! \brief Return the Howard workspace of the calling thread. Its memory is
+//! reused by the successive calls made by the thread. Return nullptr if the
+//! workspace cannot be allocated.
+//------------------------------------------------------------------------------
+static HowardWorkspace* howardWorkspace()
 {
-    CriticalCycleResult result;
-    std::string error;
-
-    if (!isEventGraph(net, error, result.arcs)) {
-        result.message << error;
-        result.success = false;
-        return result;
-    }
+    thread_local std::unique_ptr<HowardWorkspace, void(*)(HowardWorkspace*)>
+        workspace(Howard_New_Workspace(), Howard_Free_Workspace);
+    return workspace.get();
+}
 
-    // Number of nodes and number of arcs
-    size_t const nnodes = net.transitions().size();
+//------------------------------------------------------------------------------
+//! \brief Convert the event graph to the graph expected by Semi_Howard: nodes
+//! are transitions and each place is an arc.
+//! \param[out] IJ arcs of the graph {(source node, destination node), ... }
+//! \param[out] T timings of arcs (durations of places).
+//! \param[out] N delays of arcs (tokens of places).
+//! \note This will work only if isEventGraph() returned true.
+//------------------------------------------------------------------------------
+static void toHowardGraph(Net const& net, std::vector<int>& IJ,
+                          std::vector<double>& T, std::vector<double>& N)
+{
     size_t const narcs = net.places().size();
 
     // Reserve memory for storing timings
-    std::vector<double> T; T.reserve(narcs);
+    T.clear(); T.reserve(narcs);
     // Reserve memory for storing Tokens (delays)
-    std::vector<double> N; N.reserve(narcs);
+    N.clear(); N.reserve(narcs);
     // Reserve memory for storing arcs of the graph:
     // {(source node, destination node), ... }
     // FIXME should be std::vector<size_t> but Howard wants int*
-    std::vector<int> IJ; IJ.reserve(2u * narcs);
+    IJ.clear(); IJ.reserve(2u * narcs);
 
     for (auto const& p: net.places())
     {
@@ -451,20 +612,214 @@ CriticalCycleResult findCriticalCycle(Net const& net)
         T.push_back(p.arcsIn[0]->duration);
         N.push_back(double(p.tokens));
     }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Key of the hash table searching the place linking two transitions.
+//------------------------------------------------------------------------------
+static inline uint64_t transitionPair(int const from, int const to)
+{
+    return (uint64_t(uint32_t(from)) << 32) | uint64_t(uint32_t(to));
+}
+
+//------------------------------------------------------------------------------
+//! \brief Call Semi_Howard on each weakly connected component of the graph.
+//! No arc links two components so their optimal policies are independent:
+//! components are solved concurrently when the graph is large and results are
+//! merged as if the whole graph was solved at once. Nodes of each component
+//! keep their relative order, so a component is solved as if it was alone.
+//! \return the error code of Semi_Howard (0 on success).
+//------------------------------------------------------------------------------
+static int semiHowardByComponents(std::vector<int>& IJ, std::vector<double>& T,
+    std::vector<double>& N, size_t const nnodes, std::vector<double>& chi,
+    std::vector<double>& v, std::vector<int>& policy, int& ncomponents)
+{
+    // Below this number of arcs, threads cost more than they save.
+    static constexpr size_t PARALLEL_ARCS = 10000u;
+
+    size_t const narcs = T.size();
+    int niterations; // Number of iteration needed by the algorithm
+    int verbosemode = 0; // No verbose
+    ncomponents = 0;
+
+    WeaklyConnectedComponents const wcc = findWeaklyConnectedComponents(nnodes, IJ);
+    if (wcc.count <= 1u)
+    {
+        // Note Semi_Howard is C code and use directly double instead of (max,+).
+        HowardWorkspace* workspace = howardWorkspace();
+        return (workspace == nullptr) ? 6 :
+            Semi_Howard_With_Workspace(workspace, IJ.data(), T.data(), N.data(),
+                                       int(nnodes), int(narcs), chi.data(),
+                                       v.data(), policy.data(), &niterations,
+                                       &ncomponents, verbosemode);
+    }
+
+    // Nodes and arcs of each component (CSR format) and index of each node
+    // inside its component.
+    std::vector<size_t> node_offsets(wcc.count + 1u, 0u);
+    std::vector<size_t> arc_offsets(wcc.count + 1u, 0u);
+    std::vector<size_t> local(nnodes);
+    for (size_t u = 0u; u < nnodes; ++u)
+        local[u] = node_offsets[wcc.component[u] + 1u]++;
+    for (size_t a = 0u; a < narcs; ++a)
+        ++arc_offsets[wcc.component[size_t(IJ[2u * a])] + 1u];
+    for (size_t c = 0u; c < wcc.count; ++c)
+    {
+        node_offsets[c + 1u] += node_offsets[c];
+        arc_offsets[c + 1u] += arc_offsets[c];
+    }
+    std::vector<size_t> nodes(nnodes);
+    for (size_t u = 0u; u < nnodes; ++u)
+        nodes[node_offsets[wcc.component[u]] + local[u]] = u;
+    std::vector<size_t> arcs(narcs);
+    std::vector<size_t> next(arc_offsets.begin(), arc_offsets.end() - 1);
+    for (size_t a = 0u; a < narcs; ++a)
+        arcs[next[wcc.component[size_t(IJ[2u * a])]]++] = a;
+
+    std::atomic<size_t> next_component{0u};
+    std::atomic<int> error{0};
+    std::atomic<int> count{0};
+    auto worker = [&]()
+    {
+        HowardWorkspace* workspace = howardWorkspace();
+        std::vector<int> ij;
+        std::vector<double> timings, delays, c_chi, c_v;
+        std::vector<int> c_policy;
+        size_t c;
+
+        while (((c = next_component++) < wcc.count) && (error == 0))
+        {
+            size_t const c_nnodes = node_offsets[c + 1u] - node_offsets[c];
+            size_t const c_narcs = arc_offsets[c + 1u] - arc_offsets[c];
+            ij.clear(); timings.clear(); delays.clear();
+            for (size_t k = arc_offsets[c]; k < arc_offsets[c + 1u]; ++k)
+            {
+                size_t const a = arcs[k];
+                ij.push_back(int(local[size_t(IJ[2u * a])]));
+                ij.push_back(int(local[size_t(IJ[2u * a + 1u])]));
+                timings.push_back(T[a]);
+                delays.push_back(N[a]);
+            }
+            c_chi.resize(c_nnodes);
+            c_v.resize(c_nnodes);
+            c_policy.resize(c_nnodes);
+
+            int c_ncomponents, c_niterations;
+            int res = (workspace == nullptr) ? 6 :
+                Semi_Howard_With_Workspace(workspace, ij.data(), timings.data(),
+                                           delays.data(), int(c_nnodes),
+                                           int(c_narcs), c_chi.data(), c_v.data(),
+                                           c_policy.data(), &c_niterations,
+                                           &c_ncomponents, 0);
+            if (res != 0)
+            {
+                int expected = 0;
+                error.compare_exchange_strong(expected, res);
+                continue;
+            }
+
+            count += c_ncomponents;
+            for (size_t i = 0u; i < c_nnodes; ++i)
+            {
+                size_t const u = nodes[node_offsets[c] + i];
+                chi[u] = c_chi[i];
+                v[u] = c_v[i];
+                policy[u] = int(nodes[node_offsets[c] + size_t(c_policy[i])]);
+            }
+        }
+    };
+
+    size_t threads = 1u;
+    if (narcs >= PARALLEL_ARCS)
+    {
+        threads = std::min(size_t(std::max(1u, std::thread::hardware_concurrency())),
+                           wcc.count);
+    }
+    std::vector<std::thread> pool;
+    for (size_t t = 1u; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread: pool)
+        thread.join();
+
+    ncomponents = count;
+    return error;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Karp version of findCriticalCycle(): only cycle durations are
+//! computed.
+//------------------------------------------------------------------------------
+static void findCriticalCycleKarp(CriticalCycleResult& result,
+    std::vector<int> const& IJ, std::vector<double> const& T,
+    std::vector<double> const& N, size_t const nnodes)
+{
+    size_t ncomponents;
+    int res = Karp(IJ, T, N, nnodes, result.durations, ncomponents);
+    if (res != 0)
+    {
+        result.durations.clear();
+        result.arcs.clear();
+        if (res == 1)
+            result.message << "The event graph has a cycle without tokens";
+        else if (res == 2)
+            result.message << "Some transitions do not reach a cycle";
+        else
+            result.message << "Tokens shall be integers";
+        result.success = false;
+        return;
+    }
+
+    result.cycles = ncomponents;
+    result.message << "Found " << ncomponents
+        << " strongly connected components holding a critical cycle:"
+        << std::endl;
+    result.message << "Cycle durations [unit of time]:" << std::endl;
+    for (size_t i = 0u; i < result.durations.size(); ++i)
+    {
+        result.message << "  T" << i << ": "
+            << result.durations[i] << std::endl;
+    }
+
+    result.success = true;
+}
+
+//------------------------------------------------------------------------------
+CriticalCycleResult findCriticalCycle(Net const& net, CriticalCycleSolver solver)
+{
+    CriticalCycleResult result;
+    std::string error;
+
+    result.solver = solver;
+    if (!isEventGraph(net, error, result.arcs)) {
+        result.message << error;
+        result.success = false;
+        return result;
+    }
+
+    // Number of nodes and number of arcs
+    size_t const nnodes = net.transitions().size();
+    size_t const narcs = net.places().size();
+
+    std::vector<int> IJ;
+    std::vector<double> T;
+    std::vector<double> N;
+    toHowardGraph(net, IJ, T, N);
+
+    if (solver == CriticalCycleSolver::Karp)
+    {
+        findCriticalCycleKarp(result, IJ, T, N, nnodes);
+        return result;
+    }
 
     result.eigenvector.resize(nnodes);
     result.durations.resize(nnodes);
     std::vector<int> optimal_policy;
     optimal_policy.resize(nnodes);
     int ncomponents; // Number of connected components of the optimal policy
-    int niterations; // Number of iteration needed by the algorithm
-    int verbosemode = 0; // No verbose
-    // Note Semi_Howard is C code and use directly double instead of (max,+).
-    int res = Semi_Howard(IJ.data(), T.data(), N.data(),
-                          int(nnodes), int(narcs),
-                          result.durations.data(), result.eigenvector.data(),
-                          optimal_policy.data(),
-                          &niterations, &ncomponents, verbosemode);
+    int res = semiHowardByComponents(IJ, T, N, nnodes, result.durations,
+                                     result.eigenvector, optimal_policy,
+                                     ncomponents);
 
     result.cycles = size_t(ncomponents);
     if ((res != 0) || (ncomponents == 0))
@@ -478,35 +833,67 @@ CriticalCycleResult findCriticalCycle(Net const& net)
         return result;
     }
 
-    result.arcs.reserve(nnodes);
+    // Place linking each pair of transitions (the first one in case of
+    // parallel places).
+    std::unordered_map<uint64_t, size_t> places;
+    places.reserve(narcs);
+    for (size_t k = 0u; k < narcs; ++k)
+    {
+        places.emplace(transitionPair(IJ[2u * k], IJ[2u * k + 1u]), k);
+    }
+
+    result.arcs.reserve(2u * nnodes);
     result.message << "Found " << ncomponents
         << " connected components of the optimal policy:"
         << std::endl;
 
     // optimal_policy returns a list of transitions. Reconstruct cycles
     // to our internal format (including places).
+    std::vector<size_t> policy_places(nnodes, narcs);
     for (size_t to = 0u; to < optimal_policy.size(); ++to)
     {
         size_t from = size_t(optimal_policy[to]);
         result.message << "  T" << from << " -> T" << to << std::endl;
-        // Search for all places that link our transitions.
-        for (auto const& p: net.places())
+        auto it = places.find(transitionPair(int(to), int(from)));
+        if (it != places.end())
         {
-            assert(p.arcsIn.size() == 1u);
-            assert(p.arcsOut.size() == 1u);
-            Node* t0 = &p.arcsIn[0]->from;
-            Node* t1 = &p.arcsOut[0]->to;
-            assert(t0->type == Node::Type::Transition);
-            assert(t1->type == Node::Type::Transition);
-            if ((t1->id == from) && (t0->id == to))
-            {
-                result.arcs.push_back(p.arcsIn[0]);
-                result.arcs.push_back(p.arcsOut[0]);
-                break;
-            }
+            Place const& p = net.places()[it->second];
+            result.arcs.push_back(p.arcsIn[0]);
+            result.arcs.push_back(p.arcsOut[0]);
+            policy_places[to] = it->second;
         }
     }
 
+    // Each connected component of the optimal policy holds a single cycle:
+    // follow the policy from each transition until reaching a transition
+    // already visited. If it has been visited by the current walk, it
+    // belongs to a new cycle.
+    std::vector<size_t> walks(nnodes, nnodes);
+    result.circuits.reserve(result.cycles);
+    for (size_t start = 0u; start < nnodes; ++start)
+    {
+        size_t u = start;
+        while (walks[u] == nnodes)
+        {
+            walks[u] = start;
+            u = size_t(optimal_policy[u]);
+        }
+        if (walks[u] != start)
+            continue;
+
+        result.circuits.emplace_back();
+        size_t w = u;
+        do
+        {
+            if (policy_places[w] == narcs)
+                break;
+            Place const& p = net.places()[policy_places[w]];
+            result.circuits.back().push_back(p.arcsIn[0]);
+            result.circuits.back().push_back(p.arcsOut[0]);
+            w = size_t(optimal_policy[w]);
+        } while (w != u);
+    }
+
     result.message << "Cycle durations [unit of time]:" << std::endl;
     for (size_t i = 0u; i < result.durations.size(); ++i)
     {
@@ -524,4 +911,96 @@ CriticalCycleResult findCriticalCycle(Net const& net)
     return result;
 }
 
+//------------------------------------------------------------------------------
+CriticalCycleSweep sweepCriticalCycle(Net const& net,
+    std::vector<CriticalCycleScenario> const& scenarios, size_t threads)
+{
+    CriticalCycleSweep result;
+    std::vector<Arc*> erroneous_arcs;
+
+    if (!isEventGraph(net, result.message, erroneous_arcs))
+        return result;
+
+    size_t const nnodes = net.transitions().size();
+    size_t const narcs = net.places().size();
+    for (size_t s = 0u; s < scenarios.size(); ++s)
+    {
+        auto const& scenario = scenarios[s];
+        if ((!scenario.durations.empty() && (scenario.durations.size() != narcs)) ||
+            (!scenario.tokens.empty() && (scenario.tokens.size() != narcs)))
+        {
+            result.message = "Scenario " + std::to_string(s) +
+                " shall have one duration and one token count per place";
+            return result;
+        }
+    }
+
+    // The graph is built once and shared by threads: only its timings and
+    // delays change between scenarios.
+    std::vector<int> IJ;
+    std::vector<double> T;
+    std::vector<double> N;
+    toHowardGraph(net, IJ, T, N);
+
+    if (threads == 0u)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(size_t(1u), std::min(threads, scenarios.size()));
+
+    // Consecutive scenarios are given to the same thread since they are
+    // likely similar: Howard is warm started from the optimal policy of the
+    // previous scenario.
+    result.eigenvalues.resize(scenarios.size());
+    size_t const chunk = (scenarios.size() + threads - 1u) / threads;
+    auto worker = [&](size_t const begin, size_t const end)
+    {
+        HowardWorkspace* workspace = howardWorkspace();
+        if (workspace != nullptr)
+            Howard_Warm_Start(workspace, 1);
+
+        std::vector<int> ij(IJ); // Howard wants int* (not modified)
+        std::vector<double> timings;
+        std::vector<double> delays;
+        std::vector<double> chi(nnodes);
+        std::vector<double> v(nnodes);
+        std::vector<int> policy(nnodes, -1);
+        int ncomponents;
+        int niterations;
+
+        for (size_t s = begin; s < end; ++s)
+        {
+            auto const& scenario = scenarios[s];
+            timings = scenario.durations.empty() ? T : scenario.durations;
+            delays = scenario.tokens.empty() ? N : scenario.tokens;
+
+            int res = (workspace == nullptr) ? 6 :
+                      Semi_Howard_With_Workspace(workspace, ij.data(),
+                          timings.data(), delays.data(), int(nnodes), int(narcs),
+                          chi.data(), v.data(), policy.data(),
+                          &niterations, &ncomponents, 0);
+            if (res == 0)
+            {
+                result.eigenvalues[s] = *std::max_element(chi.begin(), chi.end());
+            }
+            else
+            {
+                result.eigenvalues[s] = std::numeric_limits<double>::quiet_NaN();
+                std::fill(policy.begin(), policy.end(), -1);
+            }
+        }
+
+        if (workspace != nullptr)
+            Howard_Warm_Start(workspace, 0);
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t begin = chunk; begin < scenarios.size(); begin += chunk)
+        pool.emplace_back(worker, begin, std::min(begin + chunk, scenarios.size()));
+    worker(0u, std::min(chunk, scenarios.size()));
+    for (auto& thread: pool)
+        thread.join();
+
+    result.success = true;
+    return result;
+}
+
 } // namespace tpne
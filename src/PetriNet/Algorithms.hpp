@@ -67,15 +67,65 @@ bool toSysLin(Net const& net, SparseMatrix<MaxPlus>& D,
     SparseMatrix<MaxPlus>& A, SparseMatrix<MaxPlus>& B,
     SparseMatrix<MaxPlus>& C);
 
+// *****************************************************************************
+//! \brief Canonical form of an event graph (see toCanonicalForm()) described
+//! without duplicating the net. A place holding k tokens is virtually exploded
+//! into k places holding a single token, and places holding a token next to
+//! system inputs or outputs are moved away by virtual transitions.
+//!
+//! Transitions of the canonical form are the transitions of the net (indexed
+//! by Transition::id) followed by virtual transitions having the next
+//! identifiers. Places are stored in the same order than Net::places() of
+//! the net given by toCanonicalForm(Net const&, Net&).
+// *****************************************************************************
+struct CanonicalForm
+{
+    //! \brief Role of a transition in the (max,+) linear system.
+    enum class Role { None, Input, State, Output };
+
+    // *************************************************************************
+    //! \brief Place of the canonical form with its single input and output
+    //! transitions.
+    // *************************************************************************
+    struct Place
+    {
+        //! \brief Unique identifier (Place::id).
+        size_t id;
+        //! \brief Identifier of the input transition.
+        size_t from;
+        //! \brief Identifier of the output transition.
+        size_t to;
+        //! \brief Duration of the arc Transition -> Place.
+        float duration;
+        //! \brief Number of tokens: 0 or 1.
+        size_t tokens;
+    };
+
+    //! \brief Role of each transition (indexed by identifier).
+    std::vector<Role> roles;
+    //! \brief Index of each transition (indexed by identifier) inside the
+    //! vector U, X or Y of its role.
+    std::vector<size_t> indices;
+    //! \brief Places of the canonical form.
+    std::vector<Place> places;
+    //! \brief Number of transitions of the original net: identifiers of
+    //! virtual transitions start from this number.
+    size_t net_transitions = 0u;
+    //! \brief Number of system inputs (size of the vector U).
+    size_t nb_inputs = 0u;
+    //! \brief Number of system states (size of the vector X).
+    size_t nb_states = 0u;
+    //! \brief Number of system outputs (size of the vector Y).
+    size_t nb_outputs = 0u;
+};
+
 //--------------------------------------------------------------------------
-//! \brief Inner method for the entry point toSysLin() method.
-//! FIXME a mettre private
+//! \brief Inner method for the entry point toSysLin() method: compute the
+//! matrices from the canonical form of the event graph.
 //--------------------------------------------------------------------------
-void toSysLin(Net const& net,
+void toSysLin(CanonicalForm const& canonic,
               SparseMatrix<MaxPlus>& D, SparseMatrix<MaxPlus>& A,
-              SparseMatrix<MaxPlus>& B, SparseMatrix<MaxPlus>& C,
-              std::vector<size_t> const& indices, size_t const nb_inputs,
-              size_t const nb_states, size_t const nb_outputs);
+              SparseMatrix<MaxPlus>& B, SparseMatrix<MaxPlus>& C);
 
 //--------------------------------------------------------------------------
 //! \brief Transform the Event Graph to canonical form
@@ -86,21 +136,61 @@ void toSysLin(Net const& net,
 //--------------------------------------------------------------------------
 void toCanonicalForm(Net const& net, Net& canonic);
 
+//--------------------------------------------------------------------------
+//! \brief Compute the canonical form of the event graph without duplicating
+//! the net: same result than toCanonicalForm(Net const&, Net&) in
+//! O(places + tokens) without creating nodes and arcs.
+//! \param[in] net: Petri net.
+//! \param[out] canonic: the description of the canonical form.
+//! \note This will work only if isEventGraph() has returned true.
+//--------------------------------------------------------------------------
+void toCanonicalForm(Net const& net, CanonicalForm& canonic);
+
 //--------------------------------------------------------------------------
 //! \brief Return the event graph as 2 adjacency matrices.
 //! \param[out] tokens the adjacency matrix of tokens.
 //! \param[out] durations the adjacency matrix of durations.
 //! \note This will work only if isEventGraph() returned true.
-//! \return false if the Petri net is not an event graph.
+//! \note Parallel places (several places from the same transition to the
+//! same transition) cannot be folded into a single arc since the critical
+//! cycle depends on the rest of the circuit: they are reported as failure.
+//! \return false if the Petri net is not an event graph or has parallel
+//! places.
 //--------------------------------------------------------------------------
 bool toAdjacencyMatrices(Net const& net, SparseMatrix<MaxPlus>& tokens,
     SparseMatrix<MaxPlus>& durations);
 
+//--------------------------------------------------------------------------
+//! \brief Return the canonical form of an event graph as 2 adjacency
+//! matrices.
+//! \param[out] tokens the adjacency matrix of tokens.
+//! \param[out] durations the adjacency matrix of durations.
+//! \return false if the canonical form has parallel places (see
+//! toAdjacencyMatrices(Net const&, ...)).
+//--------------------------------------------------------------------------
+bool toAdjacencyMatrices(CanonicalForm const& canonic,
+    SparseMatrix<MaxPlus>& tokens, SparseMatrix<MaxPlus>& durations);
+
+//--------------------------------------------------------------------------
+//! \brief Algorithm used by findCriticalCycle().
+//--------------------------------------------------------------------------
+enum class CriticalCycleSolver
+{
+    //! \brief Policy iteration (Semi_Howard): computes cycle durations, the
+    //! eigenvector and the arcs of critical cycles.
+    Howard,
+    //! \brief Karp algorithm (see Karp()): independent cross-check of Howard
+    //! only computing cycle durations. Tokens shall be integers.
+    Karp
+};
+
 //--------------------------------------------------------------------------
 //! \brief Returned by findCriticalCycle()
 //--------------------------------------------------------------------------
 struct CriticalCycleResult
 {
+    //! \brief Algorithm which has computed this result.
+    CriticalCycleSolver solver = CriticalCycleSolver::Howard;
     //! \brief Has the algorithm found an optimal policy ? In case of failure
     //! all results are cleared.
     bool success = false;
@@ -109,9 +199,14 @@ struct CriticalCycleResult
     std::stringstream message;
     //! \brief Number of connected components of the optimal policy.
     size_t cycles = 0u;
-    //! \brief List of arcs defining the optimal policy.
-    std::vector<Arc*> arcs; // TODO std::vector<std::vector<Arc*>> where size of vector == cycles
-    //! \brief Eigenvector: Bias vectors.
+    //! \brief List of arcs defining the optimal policy: pairs of arcs
+    //! Transition -> Place -> Transition. Empty with the Karp solver.
+    std::vector<Arc*> arcs;
+    //! \brief The cycle of each connected component of the optimal policy
+    //! (size == cycles) as pairs of arcs Transition -> Place -> Transition in
+    //! the order of the cycle. Empty with the Karp solver.
+    std::vector<std::vector<Arc*>> circuits;
+    //! \brief Eigenvector: Bias vectors. Empty with the Karp solver.
     std::vector<double> eigenvector;
     //! \brief Eigenvalues: Durations of the cycle starting for each transitions.
     std::vector<double> durations;
@@ -124,8 +219,58 @@ struct CriticalCycleResult
 //! The container is cleared before reserving its memory.
 //! \return the struct CriticalCycleResult holding all information (success,
 //! message, marked arcs for the cycle, eigenvector ...).
+//! \param[in] solver the algorithm to use. Karp is slower than Howard but is
+//!   useful for validating its results.
+//! \note Can be called concurrently from several threads: each thread reuses
+//! its own Howard workspace across calls.
+//! \note With Howard, parts of the net not linked together (weakly connected
+//! components) are solved independently, concurrently for large nets.
+//--------------------------------------------------------------------------
+CriticalCycleResult findCriticalCycle(Net const& net,
+    CriticalCycleSolver solver = CriticalCycleSolver::Howard);
+
+//--------------------------------------------------------------------------
+//! \brief Durations and tokens of the places of an event graph for a
+//! scenario of sweepCriticalCycle(). Vectors are indexed as Net::places().
+//! An empty vector keeps the values of the net.
+//--------------------------------------------------------------------------
+struct CriticalCycleScenario
+{
+    //! \brief Duration of the arc Transition -> Place of each place.
+    std::vector<double> durations;
+    //! \brief Number of tokens of each place.
+    std::vector<double> tokens;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Returned by sweepCriticalCycle()
+//--------------------------------------------------------------------------
+struct CriticalCycleSweep
+{
+    //! \brief False if the net is not an event graph or if scenarios do not
+    //! match the number of places.
+    bool success = false;
+    //! \brief In case of failure, holds the reason of the failure.
+    std::string message;
+    //! \brief Eigenvalue (cycle time of the critical cycle) of each scenario.
+    //! NaN if no optimal policy has been found for the scenario (i.e. cycle
+    //! without tokens).
+    std::vector<double> eigenvalues;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Compute the eigenvalue of the event graph for a batch of scenarios
+//! modifying durations and tokens of places (parameter sweep). Equivalent to
+//! calling findCriticalCycle() on modified copies of the net, but the graph is
+//! built once, scenarios are dispatched on a pool of threads and Howard is
+//! warm started from the optimal policy of the previous scenario of the
+//! thread.
+//! \param[in] net the base timed event graph.
+//! \param[in] scenarios durations and tokens of places for each scenario.
+//! \param[in] threads number of threads. 0 for using all cores.
 //--------------------------------------------------------------------------
-CriticalCycleResult findCriticalCycle(Net const& net);
+CriticalCycleSweep sweepCriticalCycle(Net const& net,
+    std::vector<CriticalCycleScenario> const& scenarios, size_t threads = 0u);
 
 //--------------------------------------------------------------------------
 //! \brief Return the timed event graph as (min,+) system. For example
@@ -0,0 +1,124 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/AnalysisCache.hpp"
+#include "PetriNet/PetriNet.hpp"
+
+namespace tpne {
+
+//------------------------------------------------------------------------------
+template<class T>
+bool AnalysisCache::outdated(Entry<T>& entry, Net const& net, bool const marking,
+                             unsigned const options)
+{
+    uint64_t const marking_revision = marking ? net.markingRevision() : 0u;
+    if ((entry.structure == net.structureRevision()) &&
+        (entry.marking == marking_revision) && (entry.options == options))
+    {
+        return false;
+    }
+
+    entry.structure = net.structureRevision();
+    entry.marking = marking_revision;
+    entry.options = options;
+    ++m_computations;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool AnalysisCache::isEventGraph(Net const& net)
+{
+    if (outdated(m_event_graph, net, false))
+    {
+        m_event_graph.value = tpne::isEventGraph(net);
+    }
+    return m_event_graph.value;
+}
+
+//------------------------------------------------------------------------------
+CriticalCycleResult const& AnalysisCache::criticalCycle(Net const& net)
+{
+    if (outdated(m_critical_cycle, net, true))
+    {
+        m_critical_cycle.value = findCriticalCycle(net);
+    }
+    return m_critical_cycle.value;
+}
+
+//------------------------------------------------------------------------------
+AnalysisCache::SysLin const& AnalysisCache::sysLin(Net const& net)
+{
+    if (outdated(m_syslin, net, true))
+    {
+        SysLin& s = m_syslin.value;
+        s.success = toSysLin(net, s.D, s.A, s.B, s.C);
+    }
+    return m_syslin.value;
+}
+
+//------------------------------------------------------------------------------
+AnalysisCache::AdjacencyMatrices const& AnalysisCache::adjacencyMatrices(Net const& net)
+{
+    if (outdated(m_adjacency, net, true))
+    {
+        AdjacencyMatrices& m = m_adjacency.value;
+        m.success = toAdjacencyMatrices(net, m.tokens, m.durations);
+    }
+    return m_adjacency.value;
+}
+
+//------------------------------------------------------------------------------
+std::string const& AnalysisCache::counterEquation(Net const& net,
+    bool const use_caption, bool const minplus_notation)
+{
+    unsigned const options = (use_caption ? 1u : 0u) | (minplus_notation ? 2u : 0u);
+    if (outdated(m_counter_equation, net, true, options))
+    {
+        m_counter_equation.value = showCounterEquation(
+            net, "", use_caption, minplus_notation).str();
+    }
+    return m_counter_equation.value;
+}
+
+//------------------------------------------------------------------------------
+std::string const& AnalysisCache::daterEquation(Net const& net,
+    bool const use_caption, bool const maxplus_notation)
+{
+    unsigned const options = (use_caption ? 1u : 0u) | (maxplus_notation ? 2u : 0u);
+    if (outdated(m_dater_equation, net, true, options))
+    {
+        m_dater_equation.value = showDaterEquation(
+            net, "", use_caption, maxplus_notation).str();
+    }
+    return m_dater_equation.value;
+}
+
+//------------------------------------------------------------------------------
+void AnalysisCache::clear()
+{
+    m_event_graph = Entry<bool>();
+    m_critical_cycle = Entry<CriticalCycleResult>();
+    m_syslin = Entry<SysLin>();
+    m_adjacency = Entry<AdjacencyMatrices>();
+    m_counter_equation = Entry<std::string>();
+    m_dater_equation = Entry<std::string>();
+}
+
+} // namespace tpne
@@ -0,0 +1,163 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef ANALYSIS_CACHE_HPP
+#  define ANALYSIS_CACHE_HPP
+
+#  include "PetriNet/Algorithms.hpp"
+#  include "PetriNet/SparseMatrix.hpp"
+#  include "PetriNet/TropicalAlgebra.hpp"
+
+#  include <cstdint>
+#  include <string>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Memoize results of analysis of a net, for example for the editor
+//! showing them at each frame.
+//!
+//! Each result is stored with the revisions of the net (Net::structureRevision()
+//! and, when the result depends on tokens, Net::markingRevision()) it has been
+//! computed from. A result is computed again only when the net has a different
+//! revision than the stored one. Since revisions are unique among all nets, a
+//! single cache can be used with several nets (for example when switching tabs
+//! of the editor) but it only keeps the result for the latest one.
+//!
+//! \note Results holding addresses of arcs (criticalCycle()) are only valid
+//! while the net has the same structure revision.
+//! \note Not thread-safe.
+// *****************************************************************************
+class AnalysisCache
+{
+public:
+
+    // *************************************************************************
+    //! \brief Matrices of the (max,+) implicit dynamic linear system (see
+    //! toSysLin()).
+    // *************************************************************************
+    struct SysLin
+    {
+        //! \brief Returned value of toSysLin().
+        bool success = false;
+        SparseMatrix<MaxPlus> D, A, B, C;
+    };
+
+    // *************************************************************************
+    //! \brief Adjacency matrices of the event graph (see
+    //! toAdjacencyMatrices()).
+    // *************************************************************************
+    struct AdjacencyMatrices
+    {
+        //! \brief Returned value of toAdjacencyMatrices().
+        bool success = false;
+        SparseMatrix<MaxPlus> tokens;
+        SparseMatrix<MaxPlus> durations;
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Memoized isEventGraph(Net const&). Depends on the structure only.
+    //--------------------------------------------------------------------------
+    bool isEventGraph(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Memoized findCriticalCycle() with the Howard solver.
+    //--------------------------------------------------------------------------
+    CriticalCycleResult const& criticalCycle(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Memoized toSysLin().
+    //--------------------------------------------------------------------------
+    SysLin const& sysLin(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Memoized toAdjacencyMatrices().
+    //--------------------------------------------------------------------------
+    AdjacencyMatrices const& adjacencyMatrices(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Memoized showCounterEquation() without comment. Changing options
+    //! computes again the equation.
+    //--------------------------------------------------------------------------
+    std::string const& counterEquation(Net const& net, bool const use_caption,
+                                       bool const minplus_notation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Memoized showDaterEquation() without comment. Changing options
+    //! computes again the equation.
+    //--------------------------------------------------------------------------
+    std::string const& daterEquation(Net const& net, bool const use_caption,
+                                     bool const maxplus_notation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Forget all results.
+    //--------------------------------------------------------------------------
+    void clear();
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of analysis computed since the creation of the
+    //! cache (the number of cache misses).
+    //--------------------------------------------------------------------------
+    inline size_t computations() const { return m_computations; }
+
+private:
+
+    // *************************************************************************
+    //! \brief A memoized result with the revisions of the net it has been
+    //! computed from. Revision 0 is never given by Net: the entry is empty.
+    // *************************************************************************
+    template<class T>
+    struct Entry
+    {
+        //! \brief Net::structureRevision() of the result.
+        uint64_t structure = 0u;
+        //! \brief Net::markingRevision() of the result, or 0 if the result
+        //! does not depend on tokens.
+        uint64_t marking = 0u;
+        //! \brief Options used for computing the result.
+        unsigned options = 0u;
+        //! \brief The memoized result.
+        T value = T();
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Check if the entry has to be computed again. If so, update its
+    //! revisions and options, and count a computation.
+    //! \param[in] marking: true if the result depends on tokens.
+    //--------------------------------------------------------------------------
+    template<class T>
+    bool outdated(Entry<T>& entry, Net const& net, bool const marking,
+                  unsigned const options = 0u);
+
+private:
+
+    Entry<bool> m_event_graph;
+    Entry<CriticalCycleResult> m_critical_cycle;
+    Entry<SysLin> m_syslin;
+    Entry<AdjacencyMatrices> m_adjacency;
+    Entry<std::string> m_counter_equation;
+    Entry<std::string> m_dater_equation;
+    //! \brief Number of cache misses.
+    size_t m_computations = 0u;
+};
+
+} // namespace tpne
+
+#endif
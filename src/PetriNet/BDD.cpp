@@ -0,0 +1,466 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/BDD.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace tpne {
+
+//! \brief Initial number of slots of the unique table and the computed cache.
+static constexpr size_t INITIAL_SLOTS = 4096u;
+//! \brief Maximal number of entries of the computed cache.
+static constexpr size_t MAX_COMPUTED = 1u << 21;
+//! \brief Variable of freed nodes.
+static constexpr uint32_t FREED = std::numeric_limits<uint32_t>::max();
+
+//! \brief Operations memorized in the computed cache (0 for empty entries).
+enum Operation : uint32_t
+{
+    OP_NOT = 1u, OP_AND, OP_OR, OP_ITE, OP_EXISTS, OP_AND_EXISTS
+};
+
+//------------------------------------------------------------------------------
+static inline size_t hashOf(uint32_t const a, uint32_t const b, uint32_t const c,
+                            uint32_t const d = 0u)
+{
+    uint64_t h = (uint64_t(a) << 32 | b) * 0x9e3779b97f4a7c15ull;
+    h ^= (uint64_t(c) << 32 | d) * 0xc2b2ae3d27d4eb4full;
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::BDDManager(size_t const variables)
+{
+    reset(variables);
+}
+
+//------------------------------------------------------------------------------
+void BDDManager::reset(size_t const variables)
+{
+    assert(variables < FREED);
+    m_variables = variables;
+    uint32_t const terminal = uint32_t(variables);
+    m_nodes.assign({ { terminal, ZERO, ZERO }, { terminal, ONE, ONE } });
+    m_free.clear();
+    m_unique.assign(INITIAL_SLOTS, ZERO);
+    m_computed.assign(INITIAL_SLOTS, Computed{ 0u, 0u, 0u, 0u, 0u });
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::make(uint32_t const v, Node const low, Node const high)
+{
+    if (low == high)
+        return low;
+
+    size_t const mask = m_unique.size() - 1u;
+    size_t i = hashOf(v, low, high) & mask;
+    while (m_unique[i] != ZERO)
+    {
+        Decision const& d = m_nodes[m_unique[i]];
+        if ((d.var == v) && (d.low == low) && (d.high == high))
+            return m_unique[i];
+        i = (i + 1u) & mask;
+    }
+
+    Node node;
+    if (m_free.empty())
+    {
+        assert(m_nodes.size() < std::numeric_limits<Node>::max());
+        node = Node(m_nodes.size());
+        m_nodes.push_back({ v, low, high });
+    }
+    else
+    {
+        node = m_free.back();
+        m_free.pop_back();
+        m_nodes[node] = { v, low, high };
+    }
+    m_unique[i] = node;
+
+    // Keep the load factor of the unique table below 1/2.
+    if (2u * countNodes() > m_unique.size())
+        rehash(2u * m_unique.size());
+    return node;
+}
+
+//------------------------------------------------------------------------------
+void BDDManager::rehash(size_t const slots)
+{
+    m_unique.assign(slots, ZERO);
+    size_t const mask = slots - 1u;
+    for (size_t n = 2u; n < m_nodes.size(); ++n)
+    {
+        Decision const& d = m_nodes[n];
+        if (d.var == FREED)
+            continue;
+        size_t i = hashOf(d.var, d.low, d.high) & mask;
+        while (m_unique[i] != ZERO)
+            i = (i + 1u) & mask;
+        m_unique[i] = Node(n);
+    }
+
+    // The computed cache grows with the number of nodes.
+    size_t const entries = std::min(MAX_COMPUTED, slots / 2u);
+    if (entries > m_computed.size())
+        m_computed.assign(entries, Computed{ 0u, 0u, 0u, 0u, 0u });
+}
+
+//------------------------------------------------------------------------------
+bool BDDManager::cached(uint32_t const op, Node const f, Node const g, Node const h,
+                        Node& result) const
+{
+    Computed const& c = m_computed[hashOf(op, f, g, h) & (m_computed.size() - 1u)];
+    if ((c.op == op) && (c.f == f) && (c.g == g) && (c.h == h))
+    {
+        result = c.result;
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void BDDManager::cache(uint32_t const op, Node const f, Node const g, Node const h,
+                       Node const result)
+{
+    m_computed[hashOf(op, f, g, h) & (m_computed.size() - 1u)] = { op, f, g, h, result };
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::variable(size_t const v)
+{
+    assert(v < m_variables);
+    return make(uint32_t(v), ZERO, ONE);
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::negativeVariable(size_t const v)
+{
+    assert(v < m_variables);
+    return make(uint32_t(v), ONE, ZERO);
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::cube(std::vector<size_t> const& variables)
+{
+    std::vector<size_t> sorted(variables);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    Node f = ONE;
+    for (auto it = sorted.rbegin(); it != sorted.rend(); ++it)
+    {
+        assert(*it < m_variables);
+        f = make(uint32_t(*it), ZERO, f);
+    }
+    return f;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::minterm(std::vector<bool> const& values)
+{
+    assert(values.size() == m_variables);
+    Node f = ONE;
+    for (size_t v = m_variables; v-- > 0u;)
+        f = values[v] ? make(uint32_t(v), ZERO, f) : make(uint32_t(v), f, ZERO);
+    return f;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::negation(Node const f)
+{
+    if (f <= ONE)
+        return ONE - f;
+
+    Node result;
+    if (cached(OP_NOT, f, 0u, 0u, result))
+        return result;
+
+    Decision const d = m_nodes[f];
+    Node const low = negation(d.low);
+    Node const high = negation(d.high);
+    result = make(d.var, low, high);
+    cache(OP_NOT, f, 0u, 0u, result);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::conjunction(Node f, Node g)
+{
+    if ((f == ZERO) || (g == ZERO))
+        return ZERO;
+    if ((f == ONE) || (f == g))
+        return g;
+    if (g == ONE)
+        return f;
+    if (f > g)
+        std::swap(f, g);
+
+    Node result;
+    if (cached(OP_AND, f, g, 0u, result))
+        return result;
+
+    Decision const df = m_nodes[f];
+    Decision const dg = m_nodes[g];
+    uint32_t const v = std::min(df.var, dg.var);
+    Node const low = conjunction((df.var == v) ? df.low : f, (dg.var == v) ? dg.low : g);
+    Node const high = conjunction((df.var == v) ? df.high : f, (dg.var == v) ? dg.high : g);
+    result = make(v, low, high);
+    cache(OP_AND, f, g, 0u, result);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::disjunction(Node f, Node g)
+{
+    if ((f == ONE) || (g == ONE))
+        return ONE;
+    if ((f == ZERO) || (f == g))
+        return g;
+    if (g == ZERO)
+        return f;
+    if (f > g)
+        std::swap(f, g);
+
+    Node result;
+    if (cached(OP_OR, f, g, 0u, result))
+        return result;
+
+    Decision const df = m_nodes[f];
+    Decision const dg = m_nodes[g];
+    uint32_t const v = std::min(df.var, dg.var);
+    Node const low = disjunction((df.var == v) ? df.low : f, (dg.var == v) ? dg.low : g);
+    Node const high = disjunction((df.var == v) ? df.high : f, (dg.var == v) ? dg.high : g);
+    result = make(v, low, high);
+    cache(OP_OR, f, g, 0u, result);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::ite(Node const f, Node const g, Node const h)
+{
+    if (f == ONE)
+        return g;
+    if (f == ZERO)
+        return h;
+    if (g == h)
+        return g;
+    if ((g == ONE) && (h == ZERO))
+        return f;
+    if (g == ZERO)
+        return conjunction(negation(f), h);
+    if (h == ONE)
+        return disjunction(negation(f), g);
+
+    Node result;
+    if (cached(OP_ITE, f, g, h, result))
+        return result;
+
+    Decision const df = m_nodes[f];
+    Decision const dg = m_nodes[g];
+    Decision const dh = m_nodes[h];
+    uint32_t const v = std::min({ df.var, dg.var, dh.var });
+    Node const low = ite((df.var == v) ? df.low : f, (dg.var == v) ? dg.low : g,
+                         (dh.var == v) ? dh.low : h);
+    Node const high = ite((df.var == v) ? df.high : f, (dg.var == v) ? dg.high : g,
+                          (dh.var == v) ? dh.high : h);
+    result = make(v, low, high);
+    cache(OP_ITE, f, g, h, result);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::exists(Node const f, Node cube)
+{
+    if (f <= ONE)
+        return f;
+
+    // Skip quantified variables above the top variable of f.
+    Decision const d = m_nodes[f];
+    while ((cube != ONE) && (var(cube) < d.var))
+        cube = m_nodes[cube].high;
+    if (cube == ONE)
+        return f;
+
+    Node result;
+    if (cached(OP_EXISTS, f, cube, 0u, result))
+        return result;
+
+    Node const low = exists(d.low, cube);
+    if ((var(cube) == d.var) && (low == ONE))
+    {
+        result = ONE;
+    }
+    else
+    {
+        Node const high = exists(d.high, cube);
+        result = (var(cube) == d.var) ? disjunction(low, high) : make(d.var, low, high);
+    }
+    cache(OP_EXISTS, f, cube, 0u, result);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+BDDManager::Node BDDManager::andExists(Node f, Node g, Node cube)
+{
+    if ((f == ZERO) || (g == ZERO))
+        return ZERO;
+    if ((f == ONE) || (f == g))
+        return exists(g, cube);
+    if (g == ONE)
+        return exists(f, cube);
+    if (f > g)
+        std::swap(f, g);
+
+    Decision const df = m_nodes[f];
+    Decision const dg = m_nodes[g];
+    uint32_t const v = std::min(df.var, dg.var);
+    while ((cube != ONE) && (var(cube) < v))
+        cube = m_nodes[cube].high;
+    if (cube == ONE)
+        return conjunction(f, g);
+
+    Node result;
+    if (cached(OP_AND_EXISTS, f, g, cube, result))
+        return result;
+
+    Node const low = andExists((df.var == v) ? df.low : f, (dg.var == v) ? dg.low : g, cube);
+    if ((var(cube) == v) && (low == ONE))
+    {
+        result = ONE;
+    }
+    else
+    {
+        Node const high = andExists((df.var == v) ? df.high : f,
+                                    (dg.var == v) ? dg.high : g, cube);
+        result = (var(cube) == v) ? disjunction(low, high) : make(v, low, high);
+    }
+    cache(OP_AND_EXISTS, f, g, cube, result);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+double BDDManager::satCount(Node const f) const
+{
+    // Density of the function: the fraction of assignments making it true.
+    std::unordered_map<Node, double> densities;
+    auto density = [&](Node const n, auto const& self) -> double
+    {
+        if (n <= ONE)
+            return double(n);
+        auto const it = densities.find(n);
+        if (it != densities.end())
+            return it->second;
+        double const d = 0.5 * (self(m_nodes[n].low, self) + self(m_nodes[n].high, self));
+        densities[n] = d;
+        return d;
+    };
+    return std::ldexp(density(f, density), int(m_variables));
+}
+
+//------------------------------------------------------------------------------
+bool BDDManager::pick(Node f, std::vector<bool>& values) const
+{
+    values.assign(m_variables, false);
+    if (f == ZERO)
+        return false;
+
+    while (f != ONE)
+    {
+        Decision const& d = m_nodes[f];
+        values[d.var] = (d.low == ZERO);
+        f = values[d.var] ? d.high : d.low;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool BDDManager::evaluate(Node f, std::vector<bool> const& values) const
+{
+    while (f > ONE)
+    {
+        Decision const& d = m_nodes[f];
+        f = values[d.var] ? d.high : d.low;
+    }
+    return f == ONE;
+}
+
+//------------------------------------------------------------------------------
+size_t BDDManager::size(Node const f) const
+{
+    std::vector<bool> visited(m_nodes.size(), false);
+    std::vector<Node> stack(1u, f);
+    size_t count = 0u;
+    while (!stack.empty())
+    {
+        Node const n = stack.back();
+        stack.pop_back();
+        if (visited[n])
+            continue;
+        visited[n] = true;
+        ++count;
+        if (n > ONE)
+        {
+            stack.push_back(m_nodes[n].low);
+            stack.push_back(m_nodes[n].high);
+        }
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+void BDDManager::collect(std::vector<Node> const& roots)
+{
+    std::vector<bool> alive(m_nodes.size(), false);
+    alive[ZERO] = alive[ONE] = true;
+    std::vector<Node> stack(roots);
+    while (!stack.empty())
+    {
+        Node const n = stack.back();
+        stack.pop_back();
+        if (alive[n])
+            continue;
+        alive[n] = true;
+        stack.push_back(m_nodes[n].low);
+        stack.push_back(m_nodes[n].high);
+    }
+
+    m_free.clear();
+    for (size_t n = m_nodes.size(); n-- > 2u;)
+    {
+        if (!alive[n])
+        {
+            m_nodes[n].var = FREED;
+            m_free.push_back(Node(n));
+        }
+    }
+
+    rehash(m_unique.size());
+    std::fill(m_computed.begin(), m_computed.end(), Computed{ 0u, 0u, 0u, 0u, 0u });
+}
+
+} // namespace tpne
@@ -0,0 +1,214 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef BDD_HPP
+#  define BDD_HPP
+
+#  include <cstddef>
+#  include <cstdint>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Small package of Reduced Ordered Binary Decision Diagrams (ROBDD)
+//! representing boolean functions over the variables x_0 < x_1 < ... < x_n-1.
+//!
+//! Diagrams are referred by indices of nodes (BDDManager::Node) owned by the
+//! manager. Nodes are hash-consed inside a unique table: two equivalent
+//! functions have the same index, therefore equality of functions is the
+//! equality of indices. Results of operations are memorized in a computed
+//! cache (direct-mapped, entries are overwritten on collisions).
+//!
+//! Nodes are never freed implicitly: call collect() with the diagrams still
+//! in use to reclaim the memory of the others.
+// *****************************************************************************
+class BDDManager
+{
+public:
+
+    //! \brief Index of a node inside the manager.
+    using Node = uint32_t;
+
+    //! \brief The constant function false.
+    static constexpr Node ZERO = 0u;
+    //! \brief The constant function true.
+    static constexpr Node ONE = 1u;
+
+    //--------------------------------------------------------------------------
+    //! \brief Create a manager of functions of the given number of variables.
+    //--------------------------------------------------------------------------
+    explicit BDDManager(size_t const variables);
+
+    //--------------------------------------------------------------------------
+    //! \brief Remove all diagrams and change the number of variables.
+    //--------------------------------------------------------------------------
+    void reset(size_t const variables);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of variables.
+    //--------------------------------------------------------------------------
+    inline size_t countVariables() const { return m_variables; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of nodes in use (terminals included).
+    //--------------------------------------------------------------------------
+    inline size_t countNodes() const { return m_nodes.size() - m_free.size(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the function x_v.
+    //--------------------------------------------------------------------------
+    Node variable(size_t const v);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the function !x_v.
+    //--------------------------------------------------------------------------
+    Node negativeVariable(size_t const v);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the conjunction of the given variables. Used as set of
+    //! variables for exists() and andExists().
+    //--------------------------------------------------------------------------
+    Node cube(std::vector<size_t> const& variables);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the function true only for the given values of all
+    //! variables.
+    //--------------------------------------------------------------------------
+    Node minterm(std::vector<bool> const& values);
+
+    //--------------------------------------------------------------------------
+    //! \brief Boolean operators.
+    //--------------------------------------------------------------------------
+    Node negation(Node const f);
+    Node conjunction(Node const f, Node const g);
+    Node disjunction(Node const f, Node const g);
+    //! \brief If-then-else: (f & g) | (!f & h).
+    Node ite(Node const f, Node const g, Node const h);
+
+    //--------------------------------------------------------------------------
+    //! \brief Existential quantification of the variables of the cube.
+    //--------------------------------------------------------------------------
+    Node exists(Node const f, Node const cube);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return exists(conjunction(f, g), cube) without building the
+    //! conjunction (relational product).
+    //--------------------------------------------------------------------------
+    Node andExists(Node const f, Node const g, Node const cube);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of assignments of all the variables for which
+    //! the function is true.
+    //--------------------------------------------------------------------------
+    double satCount(Node const f) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Find an assignment of the variables for which the function is
+    //! true. Variables not constrained by the function are set to false.
+    //! \return false if the function is always false.
+    //--------------------------------------------------------------------------
+    bool pick(Node const f, std::vector<bool>& values) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the value of the function for the given values of
+    //! variables.
+    //--------------------------------------------------------------------------
+    bool evaluate(Node const f, std::vector<bool> const& values) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of nodes of the diagram (terminals included).
+    //--------------------------------------------------------------------------
+    size_t size(Node const f) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Garbage collector: free the nodes not reachable from the given
+    //! diagrams. Indices of other diagrams become invalid.
+    //--------------------------------------------------------------------------
+    void collect(std::vector<Node> const& roots);
+
+private:
+
+    // *************************************************************************
+    //! \brief Decision node: if x_var then high else low. Terminals have
+    //! var == number of variables.
+    // *************************************************************************
+    struct Decision
+    {
+        uint32_t var;
+        Node low;
+        Node high;
+    };
+
+    // *************************************************************************
+    //! \brief Entry of the computed cache.
+    // *************************************************************************
+    struct Computed
+    {
+        uint32_t op;
+        Node f;
+        Node g;
+        Node h;
+        Node result;
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the unique node (var, low, high).
+    //--------------------------------------------------------------------------
+    Node make(uint32_t const var, Node const low, Node const high);
+
+    //--------------------------------------------------------------------------
+    //! \brief Rebuild the unique table with the given number of slots (power
+    //! of 2).
+    //--------------------------------------------------------------------------
+    void rehash(size_t const slots);
+
+    //--------------------------------------------------------------------------
+    //! \brief Look for the result of the operation in the computed cache.
+    //--------------------------------------------------------------------------
+    bool cached(uint32_t const op, Node const f, Node const g, Node const h,
+                Node& result) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Store the result of the operation in the computed cache.
+    //--------------------------------------------------------------------------
+    void cache(uint32_t const op, Node const f, Node const g, Node const h,
+               Node const result);
+
+    inline uint32_t var(Node const f) const { return m_nodes[f].var; }
+
+private:
+
+    //! \brief Number of variables.
+    size_t m_variables;
+    //! \brief Nodes: ZERO and ONE then decision nodes.
+    std::vector<Decision> m_nodes;
+    //! \brief Freed nodes reused by make().
+    std::vector<Node> m_free;
+    //! \brief Unique table: open addressing holding node indices (ZERO means
+    //! empty slot).
+    std::vector<Node> m_unique;
+    //! \brief Computed cache.
+    std::vector<Computed> m_computed;
+};
+
+} // namespace tpne
+
+#endif
@@ -0,0 +1,211 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/BatchSimulation.hpp"
+#include "PetriNet/PetriNet.hpp"
+
+#include <algorithm>
+
+namespace tpne {
+
+//------------------------------------------------------------------------------
+BatchSimulation::BatchSimulation(CompiledNet const& net, uint32_t const seed)
+    : m_net(net), m_generator(seed)
+{
+    reset();
+}
+
+//------------------------------------------------------------------------------
+void BatchSimulation::reset()
+{
+    reset(m_net.initialMarking());
+}
+
+//------------------------------------------------------------------------------
+void BatchSimulation::reset(Marking const& marking)
+{
+    size_t const T = m_net.countTransitions();
+
+    m_marking = marking;
+    m_time = 0.0;
+    m_arrivals = std::priority_queue<Arrival>();
+    m_order = 0u;
+    m_transiting = 0u;
+    m_firings = 0u;
+    m_firing_counts.assign(T, 0u);
+    m_busy.assign(T, false);
+    m_fired.clear();
+    m_fired.reserve(T);
+
+    // All transitions have to be checked at the first firing round.
+    m_candidates.resize(T);
+    for (size_t t = 0u; t < T; ++t)
+        m_candidates[t] = t;
+    m_is_candidate.assign(T, true);
+}
+
+//------------------------------------------------------------------------------
+void BatchSimulation::addCandidate(size_t const t)
+{
+    if (!m_is_candidate[t])
+    {
+        m_is_candidate[t] = true;
+        m_candidates.push_back(t);
+    }
+}
+
+//------------------------------------------------------------------------------
+void BatchSimulation::addCandidatesOf(size_t const place)
+{
+    for (size_t k = m_net.consumersBegin(place); k < m_net.consumersEnd(place); ++k)
+        addCandidate(m_net.consumer(k));
+}
+
+//------------------------------------------------------------------------------
+size_t BatchSimulation::fireCandidates(size_t const max_firings)
+{
+    size_t count = 0u;
+
+    // Consuming tokens can only disable transitions: a transition which did
+    // not fire during a round cannot fire at the next one. Only transitions
+    // which have fired are checked again.
+    while ((!m_candidates.empty()) && (count < max_firings))
+    {
+        std::shuffle(m_candidates.begin(), m_candidates.end(), m_generator);
+        m_fired.clear();
+
+        for (size_t const t: m_candidates)
+        {
+            // Budget reached: keep the remaining transitions for later.
+            if (count == max_firings)
+            {
+                m_fired.push_back(t);
+                continue;
+            }
+
+            size_t tokens = m_busy[t] ? 0u : m_net.maxTokensToConsume(t, m_marking);
+            tokens = std::min(tokens, max_firings - count);
+            if (tokens == 0u)
+            {
+                m_is_candidate[t] = false;
+                continue;
+            }
+
+            m_net.consume(t, tokens, m_marking);
+            bool const source = m_net.isSource(t);
+            for (size_t k = m_net.postBegin(t); k < m_net.postEnd(t); ++k)
+            {
+                size_t const n = tokens * m_net.postWeight(k);
+                double const duration = std::max(0.0, double(m_net.postDuration(k)));
+                m_arrivals.push(Arrival{ m_time + duration, m_order++,
+                                         m_net.postPlace(k), n, source ? t : NONE });
+                m_transiting += n;
+            }
+
+            m_firing_counts[t] += tokens;
+            count += tokens;
+
+            // Source transitions wait for the arrival of their tokens.
+            if (source)
+            {
+                m_busy[t] = true;
+                m_is_candidate[t] = false;
+            }
+            else
+            {
+                m_fired.push_back(t);
+            }
+        }
+
+        m_candidates.swap(m_fired);
+    }
+
+    m_firings += count;
+    return count;
+}
+
+//------------------------------------------------------------------------------
+void BatchSimulation::processNextArrivals()
+{
+    m_time = m_arrivals.top().time;
+    while ((!m_arrivals.empty()) && (m_arrivals.top().time == m_time))
+    {
+        Arrival const& arrival = m_arrivals.top();
+        size_t& tokens = m_marking[arrival.place];
+        tokens = (Net::Settings::maxTokens - tokens >= arrival.tokens)
+                 ? tokens + arrival.tokens : Net::Settings::maxTokens;
+        m_transiting -= arrival.tokens;
+        addCandidatesOf(arrival.place);
+        if (arrival.source != NONE)
+        {
+            m_busy[arrival.source] = false;
+            addCandidate(arrival.source);
+        }
+        m_arrivals.pop();
+    }
+}
+
+//------------------------------------------------------------------------------
+size_t BatchSimulation::runUntil(double const time)
+{
+    if (time < m_time)
+        return 0u;
+
+    size_t const before = m_firings;
+    while (true)
+    {
+        fireCandidates(size_t(-1));
+        if (m_arrivals.empty() || (m_arrivals.top().time > time))
+            break;
+        processNextArrivals();
+    }
+    m_time = time;
+    return m_firings - before;
+}
+
+//------------------------------------------------------------------------------
+size_t BatchSimulation::runFirings(size_t const n)
+{
+    size_t count = 0u;
+    while (true)
+    {
+        count += fireCandidates(n - count);
+        if ((count >= n) || m_arrivals.empty())
+            break;
+        processNextArrivals();
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+bool BatchSimulation::isDead() const
+{
+    if (!m_arrivals.empty())
+        return false;
+
+    for (size_t const t: m_candidates)
+    {
+        if ((!m_busy[t]) && (m_net.maxTokensToConsume(t, m_marking) > 0u))
+            return false;
+    }
+    return true;
+}
+
+} // namespace tpne
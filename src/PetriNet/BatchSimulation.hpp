@@ -0,0 +1,227 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef BATCH_SIMULATION_HPP
+#  define BATCH_SIMULATION_HPP
+
+#  include "PetriNet/CompiledNet.hpp"
+
+#  include <cstdint>
+#  include <queue>
+#  include <random>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Headless discrete-event simulation of a timed Petri net.
+//!
+//! Contrary to the Simulation class, used by the editor, this class does not
+//! depend on the frame rate and does not animate tokens: the simulation jumps
+//! from an event to the next one. Events are the arrivals of tokens in places
+//! and are sorted by date inside a priority queue. When a transition fires,
+//! tokens are immediately consumed from its input places and arrive in its
+//! output places after the duration of the arc Transition -> Place.
+//!
+//! The firing policy is the same as the editor: at each date, enabled
+//! transitions fire in a random order (defined by the seedable pseudo random
+//! generator) until no more transition can fire; the number of tokens consumed
+//! at each firing depends on Net::Settings::firing. A source transition (having
+//! no input place) cannot fire again until one of its produced tokens arrived.
+//!
+//! \note Receptivities and GRAFCET temporizations are not evaluated: all
+//! transitions are considered as receptive (like timed Petri nets and timed
+//! event graphs).
+//! \note Nets with cycles of null durations can fire infinitely at the same
+//! date: prefer runFirings() for them.
+// *****************************************************************************
+class BatchSimulation
+{
+public:
+
+    using Marking = CompiledNet::Marking;
+
+    //--------------------------------------------------------------------------
+    //! \brief Constructor. The simulation starts with the initial marking of
+    //! the compiled net at date 0.
+    //! \param[in] net: the compiled net to simulate. Shall outlive this
+    //! instance. Several simulations can share the same compiled net.
+    //! \param[in] seed: seed of the random generator defining the order of
+    //! firing of transitions.
+    //--------------------------------------------------------------------------
+    explicit BatchSimulation(CompiledNet const& net, uint32_t const seed = 0u);
+
+    //--------------------------------------------------------------------------
+    //! \brief Restart the simulation at date 0 with the initial marking of
+    //! the compiled net.
+    //--------------------------------------------------------------------------
+    void reset();
+
+    //--------------------------------------------------------------------------
+    //! \brief Restart the simulation at date 0 with the given marking.
+    //! \param[in] marking: number of tokens for each place index.
+    //--------------------------------------------------------------------------
+    void reset(Marking const& marking);
+
+    //--------------------------------------------------------------------------
+    //! \brief Change the seed of the random generator.
+    //--------------------------------------------------------------------------
+    inline void seed(uint32_t const seed) { m_generator.seed(seed); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Simulate until the given date is reached (events at this date
+    //! are processed). Does nothing if the date is in the past.
+    //! \return the number of firings made during this call.
+    //--------------------------------------------------------------------------
+    size_t runUntil(double const time);
+
+    //--------------------------------------------------------------------------
+    //! \brief Simulate until \c n firings have been made or until the net
+    //! cannot evolve anymore.
+    //! \return the number of firings made during this call (<= n).
+    //--------------------------------------------------------------------------
+    size_t runFirings(size_t const n);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the current date of the simulation.
+    //--------------------------------------------------------------------------
+    inline double time() const { return m_time; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the current marking. Tokens transiting along arcs are not
+    //! counted.
+    //--------------------------------------------------------------------------
+    inline Marking const& marking() const { return m_marking; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the total number of firings since the last reset. Firing
+    //! a transition consuming n tokens at once counts as n firings.
+    //--------------------------------------------------------------------------
+    inline size_t firings() const { return m_firings; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of firings of each transition (indexed by
+    //! transition index) since the last reset.
+    //--------------------------------------------------------------------------
+    inline std::vector<size_t> const& firingCounts() const { return m_firing_counts; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of tokens transiting along arcs.
+    //--------------------------------------------------------------------------
+    inline size_t transitingTokens() const { return m_transiting; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return true if no transition can fire and no token is
+    //! transiting: the simulation cannot evolve anymore.
+    //--------------------------------------------------------------------------
+    bool isDead() const;
+
+private:
+
+    // *************************************************************************
+    //! \brief Arrival of tokens in a place.
+    // *************************************************************************
+    struct Arrival
+    {
+        //! \brief Date of the arrival.
+        double time;
+        //! \brief Insertion order: arrivals at the same date are processed
+        //! in the order of their creation.
+        uint64_t order;
+        //! \brief Place index receiving tokens.
+        size_t place;
+        //! \brief Number of tokens.
+        size_t tokens;
+        //! \brief Index of the source transition which produced these tokens
+        //! or NONE if the transition has input places.
+        size_t source;
+
+        //! \brief Ordering for the priority queue: the earliest arrival on the
+        //! top.
+        bool operator<(Arrival const& other) const
+        {
+            if (time != other.time)
+                return time > other.time;
+            return order > other.order;
+        }
+    };
+
+    //! \brief Value for Arrival::source.
+    static constexpr size_t NONE = size_t(-1);
+
+    //--------------------------------------------------------------------------
+    //! \brief Add the transition to the list of transitions to check at the
+    //! next firing round.
+    //--------------------------------------------------------------------------
+    void addCandidate(size_t const t);
+
+    //--------------------------------------------------------------------------
+    //! \brief Mark consumers of the place as transitions to be checked.
+    //--------------------------------------------------------------------------
+    void addCandidatesOf(size_t const place);
+
+    //--------------------------------------------------------------------------
+    //! \brief Fire candidate transitions at the current date until no more
+    //! transition can fire or the maximum number of firings is reached.
+    //! \return the number of firings made.
+    //--------------------------------------------------------------------------
+    size_t fireCandidates(size_t const max_firings);
+
+    //--------------------------------------------------------------------------
+    //! \brief Jump to the date of the next arrival and process all arrivals at
+    //! this date.
+    //--------------------------------------------------------------------------
+    void processNextArrivals();
+
+private:
+
+    //! \brief The net to simulate.
+    CompiledNet const& m_net;
+    //! \brief Current marking.
+    Marking m_marking;
+    //! \brief Current date.
+    double m_time = 0.0;
+    //! \brief Future arrivals of tokens sorted by date.
+    std::priority_queue<Arrival> m_arrivals;
+    //! \brief Counter for Arrival::order.
+    uint64_t m_order = 0u;
+    //! \brief Number of tokens inside m_arrivals.
+    size_t m_transiting = 0u;
+    //! \brief Transitions which could be enabled: their input places have
+    //! received tokens since their last check.
+    std::vector<size_t> m_candidates;
+    //! \brief Transitions which fired during the current firing round.
+    std::vector<size_t> m_fired;
+    //! \brief For each transition: is inside m_candidates ?
+    std::vector<bool> m_is_candidate;
+    //! \brief For each source transition: waiting for the arrival of its
+    //! tokens before firing again.
+    std::vector<bool> m_busy;
+    //! \brief Number of firings since the last reset.
+    size_t m_firings = 0u;
+    //! \brief Number of firings of each transition since the last reset.
+    std::vector<size_t> m_firing_counts;
+    //! \brief Random generator for the order of firing.
+    std::mt19937 m_generator;
+};
+
+} // namespace tpne
+
+#endif
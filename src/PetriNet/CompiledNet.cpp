@@ -0,0 +1,203 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/CompiledNet.hpp"
+#include "PetriNet/PetriNet.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace tpne {
+
+//------------------------------------------------------------------------------
+//! \brief Return the table converting node identifiers to their slot in the
+//! given container. Identifiers are usually consecutive numbers starting
+//! from 0.
+//------------------------------------------------------------------------------
+template<class Container>
+static std::vector<size_t> slotsOf(Container const& nodes, std::vector<size_t>& ids)
+{
+    size_t max_id = 0u;
+    for (auto const& n: nodes)
+        max_id = std::max(max_id, n.id + 1u);
+
+    std::vector<size_t> slots(max_id, std::numeric_limits<size_t>::max());
+    ids.clear();
+    ids.reserve(nodes.size());
+    for (auto const& n: nodes)
+    {
+        slots[n.id] = ids.size();
+        ids.push_back(n.id);
+    }
+    return slots;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Transform counters into CSR row offsets (exclusive prefix sum).
+//------------------------------------------------------------------------------
+static void toOffsets(std::vector<size_t>& offsets)
+{
+    size_t sum = 0u;
+    for (auto& it: offsets)
+    {
+        size_t const count = it;
+        it = sum;
+        sum += count;
+    }
+}
+
+//------------------------------------------------------------------------------
+CompiledNet::CompiledNet(Net const& net)
+{
+    compile(net);
+}
+
+//------------------------------------------------------------------------------
+void CompiledNet::compile(Net const& net)
+{
+    std::vector<size_t> const place_slots = slotsOf(net.places(), m_place_ids);
+    std::vector<size_t> const transition_slots = slotsOf(net.transitions(), m_transition_ids);
+    size_t const P = m_place_ids.size();
+    size_t const T = m_transition_ids.size();
+
+    m_initial_marking.clear();
+    m_initial_marking.reserve(P);
+    for (auto const& p: net.places())
+        m_initial_marking.push_back(p.tokens);
+
+    // Count the number of elements for each row of the CSR matrices. An extra
+    // element is added to store the final offset.
+    m_pre_offsets.assign(T + 1u, 0u);
+    m_post_offsets.assign(T + 1u, 0u);
+    m_consumer_offsets.assign(P + 1u, 0u);
+    m_producer_offsets.assign(P + 1u, 0u);
+    for (auto const& a: net.arcs())
+    {
+        if (a.from.type == Node::Type::Place)
+        {
+            m_pre_offsets[transition_slots[a.to.id]]++;
+            m_consumer_offsets[place_slots[a.from.id]]++;
+        }
+        else
+        {
+            m_post_offsets[transition_slots[a.from.id]]++;
+            m_producer_offsets[place_slots[a.to.id]]++;
+        }
+    }
+    toOffsets(m_pre_offsets);
+    toOffsets(m_post_offsets);
+    toOffsets(m_consumer_offsets);
+    toOffsets(m_producer_offsets);
+
+    // Fill the CSR matrices. Arcs keep the order of Net::arcs() inside each
+    // row.
+    size_t const pre_size = m_pre_offsets[T];
+    size_t const post_size = m_post_offsets[T];
+    m_pre_places.resize(pre_size);
+    m_pre_weights.assign(pre_size, 1u);
+    m_post_places.resize(post_size);
+    m_post_weights.assign(post_size, 1u);
+    m_post_durations.resize(post_size);
+    m_post_arcs.resize(post_size);
+    m_consumers.resize(pre_size);
+    m_producers.resize(post_size);
+
+    std::vector<size_t> pre_next(m_pre_offsets.begin(), m_pre_offsets.end() - 1);
+    std::vector<size_t> post_next(m_post_offsets.begin(), m_post_offsets.end() - 1);
+    std::vector<size_t> consumer_next(m_consumer_offsets.begin(), m_consumer_offsets.end() - 1);
+    std::vector<size_t> producer_next(m_producer_offsets.begin(), m_producer_offsets.end() - 1);
+    for (auto const& a: net.arcs())
+    {
+        if (a.from.type == Node::Type::Place)
+        {
+            size_t const p = place_slots[a.from.id];
+            size_t const t = transition_slots[a.to.id];
+            m_pre_places[pre_next[t]++] = p;
+            m_consumers[consumer_next[p]++] = t;
+        }
+        else
+        {
+            size_t const t = transition_slots[a.from.id];
+            size_t const p = place_slots[a.to.id];
+            size_t const k = post_next[t]++;
+            m_post_places[k] = p;
+            m_post_durations[k] = a.duration;
+            m_post_arcs[k] = a.index;
+            m_producers[producer_next[p]++] = t;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool CompiledNet::isEnabled(size_t const t, Marking const& marking) const
+{
+    for (size_t k = m_pre_offsets[t]; k < m_pre_offsets[t + 1u]; ++k)
+    {
+        if (marking[m_pre_places[k]] < m_pre_weights[k])
+            return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+size_t CompiledNet::maxTokensToConsume(size_t const t, Marking const& marking) const
+{
+    // Same behavior than Transition::maxTokensToConsume(): source transitions
+    // fire one token.
+    if (isSource(t))
+        return 1u;
+
+    auto min_tokens = std::numeric_limits<size_t>::max();
+    for (size_t k = m_pre_offsets[t]; k < m_pre_offsets[t + 1u]; ++k)
+    {
+        size_t const tokens = marking[m_pre_places[k]] / m_pre_weights[k];
+        if (tokens == 0u)
+            return 0u;
+
+        if (tokens < min_tokens)
+            min_tokens = tokens;
+    }
+    return (Net::Settings::firing == Net::Settings::Fire::OneByOne) ? 1u : min_tokens;
+}
+
+//------------------------------------------------------------------------------
+void CompiledNet::consume(size_t const t, size_t const count, Marking& marking) const
+{
+    for (size_t k = m_pre_offsets[t]; k < m_pre_offsets[t + 1u]; ++k)
+    {
+        size_t& tokens = marking[m_pre_places[k]];
+        size_t const n = count * m_pre_weights[k];
+        tokens = (tokens >= n) ? tokens - n : 0u;
+    }
+}
+
+//------------------------------------------------------------------------------
+void CompiledNet::produce(size_t const t, size_t const count, Marking& marking) const
+{
+    for (size_t k = m_post_offsets[t]; k < m_post_offsets[t + 1u]; ++k)
+    {
+        size_t& tokens = marking[m_post_places[k]];
+        size_t const n = count * m_post_weights[k];
+        tokens = (Net::Settings::maxTokens - tokens >= n)
+                 ? tokens + n : Net::Settings::maxTokens;
+    }
+}
+
+} // namespace tpne
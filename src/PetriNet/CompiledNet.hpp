@@ -0,0 +1,230 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef COMPILED_NET_HPP
+#  define COMPILED_NET_HPP
+
+#  include <cstddef>
+#  include <vector>
+
+namespace tpne {
+
+class Net;
+
+// *****************************************************************************
+//! \brief Read-only and compact runtime representation of a Net made for
+//! simulations and analysis algorithms needing millions of firings.
+//!
+//! Nodes are referred by integer indices: the slot of the node inside
+//! Net::places() or Net::transitions(). Strings, captions and positions are not
+//! stored. The structure of the net is stored as structure of arrays in the
+//! CSR (Compressed Sparse Row) format:
+//!   - the pre incidence: for each transition, its input places with the arc
+//!     weights;
+//!   - the post incidence: for each transition, its output places with the arc
+//!     weights and durations;
+//!   - the consumers: for each place, the transitions consuming its tokens.
+//!     This allows to update the set of enabled transitions after a firing;
+//!   - the producers: for each place, the transitions producing its tokens.
+//!
+//! The marking is not stored inside this class but given as a contiguous
+//! vector of tokens (indexed by place index) to the methods. Therefore a single
+//! compiled net can be shared by several simulations (for example one per
+//! thread).
+//!
+//! \note The compiled net is not updated when the Net is modified: call
+//! compile() again.
+// *****************************************************************************
+class CompiledNet
+{
+public:
+
+    //! \brief Number of tokens for each place (indexed by place index).
+    using Marking = std::vector<size_t>;
+
+    //--------------------------------------------------------------------------
+    //! \brief Default constructor: empty net.
+    //--------------------------------------------------------------------------
+    CompiledNet() = default;
+
+    //--------------------------------------------------------------------------
+    //! \brief Compile the given net.
+    //--------------------------------------------------------------------------
+    explicit CompiledNet(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Compile the given net. Previous content is replaced. Complexity
+    //! is O(P + T + A).
+    //--------------------------------------------------------------------------
+    void compile(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of places.
+    //--------------------------------------------------------------------------
+    inline size_t countPlaces() const { return m_place_ids.size(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of transitions.
+    //--------------------------------------------------------------------------
+    inline size_t countTransitions() const { return m_transition_ids.size(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the unique identifier of the place (Place::id) for the
+    //! given place index.
+    //--------------------------------------------------------------------------
+    inline size_t placeId(size_t const p) const { return m_place_ids[p]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the unique identifier of the transition (Transition::id)
+    //! for the given transition index.
+    //--------------------------------------------------------------------------
+    inline size_t transitionId(size_t const t) const { return m_transition_ids[t]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the marking of the net at the moment it was compiled.
+    //--------------------------------------------------------------------------
+    inline Marking const& initialMarking() const { return m_initial_marking; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return true if the transition \c t has no input place (system
+    //! input).
+    //--------------------------------------------------------------------------
+    inline bool isSource(size_t const t) const
+    {
+        return m_pre_offsets[t] == m_pre_offsets[t + 1u];
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Pre incidence of the transition \c t: input places are
+    //! prePlace(k) for k in [preBegin(t), preEnd(t)[.
+    //--------------------------------------------------------------------------
+    inline size_t preBegin(size_t const t) const { return m_pre_offsets[t]; }
+    inline size_t preEnd(size_t const t) const { return m_pre_offsets[t + 1u]; }
+    inline size_t prePlace(size_t const k) const { return m_pre_places[k]; }
+    inline size_t preWeight(size_t const k) const { return m_pre_weights[k]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Post incidence of the transition \c t: output places are
+    //! postPlace(k) for k in [postBegin(t), postEnd(t)[.
+    //--------------------------------------------------------------------------
+    inline size_t postBegin(size_t const t) const { return m_post_offsets[t]; }
+    inline size_t postEnd(size_t const t) const { return m_post_offsets[t + 1u]; }
+    inline size_t postPlace(size_t const k) const { return m_post_places[k]; }
+    inline size_t postWeight(size_t const k) const { return m_post_weights[k]; }
+    inline float postDuration(size_t const k) const { return m_post_durations[k]; }
+    //! \brief Return the index (Arc::index) of the arc Transition -> Place.
+    inline size_t postArc(size_t const k) const { return m_post_arcs[k]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Transitions consuming tokens of the place \c p are consumer(k)
+    //! for k in [consumersBegin(p), consumersEnd(p)[.
+    //--------------------------------------------------------------------------
+    inline size_t consumersBegin(size_t const p) const { return m_consumer_offsets[p]; }
+    inline size_t consumersEnd(size_t const p) const { return m_consumer_offsets[p + 1u]; }
+    inline size_t consumer(size_t const k) const { return m_consumers[k]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Transitions producing tokens in the place \c p are producer(k)
+    //! for k in [producersBegin(p), producersEnd(p)[.
+    //--------------------------------------------------------------------------
+    inline size_t producersBegin(size_t const p) const { return m_producer_offsets[p]; }
+    inline size_t producersEnd(size_t const p) const { return m_producer_offsets[p + 1u]; }
+    inline size_t producer(size_t const k) const { return m_producers[k]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Check if all input places of the transition \c t have enough
+    //! tokens. Source transitions are always enabled.
+    //--------------------------------------------------------------------------
+    bool isEnabled(size_t const t, Marking const& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the maximum number of times the transition \c t can fire
+    //! with the given marking. This is the equivalent of
+    //! Transition::maxTokensToConsume() with a receptivity set to true: the
+    //! result is constrained to 1 when Net::Settings::firing is OneByOne and
+    //! source transitions return 1.
+    //--------------------------------------------------------------------------
+    size_t maxTokensToConsume(size_t const t, Marking const& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Remove tokens from the input places of the transition \c t as if
+    //! it was fired \c count times. The caller shall have checked that enough
+    //! tokens are available.
+    //--------------------------------------------------------------------------
+    void consume(size_t const t, size_t const count, Marking& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Add tokens to the output places of the transition \c t as if it
+    //! was fired \c count times. Tokens are constrained by
+    //! Net::Settings::maxTokens.
+    //--------------------------------------------------------------------------
+    void produce(size_t const t, size_t const count, Marking& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Fire immediately (durations are ignored) the transition \c t
+    //! \c count times: consume() then produce().
+    //--------------------------------------------------------------------------
+    inline void fire(size_t const t, size_t const count, Marking& marking) const
+    {
+        consume(t, count, marking);
+        produce(t, count, marking);
+    }
+
+private:
+
+    //! \brief Place::id for each place index.
+    std::vector<size_t> m_place_ids;
+    //! \brief Transition::id for each transition index.
+    std::vector<size_t> m_transition_ids;
+    //! \brief Tokens for each place index when compiled.
+    Marking m_initial_marking;
+
+    //! \brief CSR pre incidence: row offsets indexed by transition.
+    std::vector<size_t> m_pre_offsets;
+    //! \brief CSR pre incidence: input place indices.
+    std::vector<size_t> m_pre_places;
+    //! \brief CSR pre incidence: arc weights.
+    std::vector<size_t> m_pre_weights;
+
+    //! \brief CSR post incidence: row offsets indexed by transition.
+    std::vector<size_t> m_post_offsets;
+    //! \brief CSR post incidence: output place indices.
+    std::vector<size_t> m_post_places;
+    //! \brief CSR post incidence: arc weights.
+    std::vector<size_t> m_post_weights;
+    //! \brief CSR post incidence: arc durations.
+    std::vector<float> m_post_durations;
+    //! \brief CSR post incidence: Arc::index.
+    std::vector<size_t> m_post_arcs;
+
+    //! \brief CSR place -> consumer transitions: row offsets indexed by place.
+    std::vector<size_t> m_consumer_offsets;
+    //! \brief CSR place -> consumer transitions: transition indices.
+    std::vector<size_t> m_consumers;
+
+    //! \brief CSR place -> producer transitions: row offsets indexed by place.
+    std::vector<size_t> m_producer_offsets;
+    //! \brief CSR place -> producer transitions: transition indices.
+    std::vector<size_t> m_producers;
+};
+
+} // namespace tpne
+
+#endif
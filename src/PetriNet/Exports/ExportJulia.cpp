@@ -39,18 +39,11 @@ std::string exportToJulia(Net const& net, std::string const& filename)
     if (!isEventGraph(net))
         return "Expected a net with places having a single input and output arcs";
 
-    // TODO quick test check if we have to do the canonical form, this can avoid
-    // duplicating the Petri net
-    // if (!cannonical) {
-
-    // Duplicate the Petri net since we potentially modify it to transform it to
-    // its canonical form.
-    Net canonic;
+    // Canonical form of the Petri net: places with several tokens are
+    // virtually splitted without duplicating the net.
+    CanonicalForm canonic;
     toCanonicalForm(net, canonic);
 
-    // TODO
-    // } else { return ::exportToJulia(*this, filename); }
-
     // Open the file
     std::ofstream file(filename);
     if (!file)
@@ -65,47 +58,25 @@ std::string exportToJulia(Net const& net, std::string const& filename)
     file << "# This file has been generated" << std::endl << std::endl;
     file << "using MaxPlus, SparseArrays" << std::endl << std::endl;
 
-    // Count the number of inputs, outputs and states for creating matrices.
-    size_t nb_states = 0u;
-    size_t nb_inputs = 0u;
-    size_t nb_outputs = 0u;
-
-    std::vector<size_t> indices;
-    indices.resize(canonic.transitions().size());
-
     file << "## Petri Transitions:" << std::endl;
 
-    // Show and count system inputs
-    for (auto& t: canonic.transitions())
+    // Show system inputs, then states, then outputs. Transitions of the net
+    // are given before the transitions added by the canonical form.
+    static char const* names[] = { "", ": input (U", ": state (X", ": output (Y" };
+    for (auto role: { CanonicalForm::Role::Input, CanonicalForm::Role::State,
+                      CanonicalForm::Role::Output })
     {
-        if (t.isInput())
+        auto show = [&](size_t const id)
         {
-            indices[t.id] = nb_inputs++;
-            file << "# " << t.key << ": input (U"
-                 << nb_inputs << ")" << std::endl;
-        }
-    }
-
-    // Show and count system states
-    for (auto& t: canonic.transitions())
-    {
-        if (t.isState())
-        {
-            indices[t.id] = nb_states++;
-            file << "# " << t.key << ": state (X"
-                 << nb_states << ")" << std::endl;
-        }
-    }
-
-    // Show and count system outputs
-    for (auto& t: canonic.transitions())
-    {
-        if (t.isOutput())
-        {
-            indices[t.id] = nb_outputs++;
-            file << "# " << t.key << ": output (Y" << nb_outputs
-                 << ")" << std::endl;
-        }
+            if (canonic.roles[id] != role)
+                return ;
+            file << "# T" << id << names[size_t(role)]
+                 << canonic.indices[id] + 1u << ")" << std::endl;
+        };
+        for (auto const& t: net.transitions())
+            show(t.id);
+        for (size_t id = canonic.net_transitions; id < canonic.roles.size(); ++id)
+            show(id);
     }
 
     // Graph representation. Since an event graph have all its places with a
@@ -119,20 +90,22 @@ std::string exportToJulia(Net const& net, std::string const& filename)
     file << "# Nodes are Transitions." << std::endl;
     file << "# Arcs are Places and therefore have tokens and durations" << std::endl;
     SparseMatrix<MaxPlus> N; SparseMatrix<MaxPlus> T;
-    bool res = toAdjacencyMatrices(canonic, N, T);
-    assert(res == true); (void) res;
-    for (auto& p: canonic.places())
+    for (auto const& p: canonic.places)
     {
-        Transition& from = *reinterpret_cast<Transition*>(&(p.arcsIn[0]->from));
-        Transition& to = *reinterpret_cast<Transition*>(&(p.arcsOut[0]->to));
-
-        file << "# Arc " << p.key << ": " << from.key << " -> " << to.key
-             << " (Duration: " << p.arcsIn[0]->duration
+        file << "# Arc P" << p.id << ": T" << p.from << " -> T" << p.to
+             << " (Duration: " << p.duration
              << ", Tokens: " << p.tokens << ")" << std::endl;
     }
-    size_t const nnodes = canonic.transitions().size();
-    file << "N = sparse(" << N << ", " << nnodes << ", " << nnodes << ") # Tokens" << std::endl;
-    file << "T = sparse(" << T << ", " << nnodes << ", " << nnodes << ") # Durations" << std::endl;
+    if (toAdjacencyMatrices(canonic, N, T))
+    {
+        size_t const nnodes = canonic.roles.size();
+        file << "N = sparse(" << N << ", " << nnodes << ", " << nnodes << ") # Tokens" << std::endl;
+        file << "T = sparse(" << T << ", " << nnodes << ", " << nnodes << ") # Durations" << std::endl;
+    }
+    else
+    {
+        file << "# Parallel places cannot be folded into adjacency matrices" << std::endl;
+    }
 
     // Show the event graph to its Max-Plus counter and dater equation
     file << std::endl;
@@ -146,7 +119,7 @@ std::string exportToJulia(Net const& net, std::string const& filename)
     // X(n) = D X(n) ⨁ A X(n-1) ⨁ B U(n)
     // Y(n) = C X(n)
     SparseMatrix<MaxPlus> D; SparseMatrix<MaxPlus> A; SparseMatrix<MaxPlus> B; SparseMatrix<MaxPlus> C;
-    toSysLin(canonic, D, A, B, C, indices, nb_inputs, nb_states, nb_outputs);
+    toSysLin(canonic, D, A, B, C);
 
     file << std::endl;
     file << "## Max-Plus implicit linear dynamic system of the dater equation:" << std::endl;
@@ -41,41 +41,53 @@
 /*#define EPSILON  -1.79769313486231570e308*/
 
 
-/* GLOBAL VARIABLES */
-
-static int *ij;
-static double *a;
-static double *t;
-static int nnodes;
-static int narcs;
-static double *chi;
-static double *v;
-static int *pi;
-static int *NIterations;
-static int *NComponents;
-static int verbosemode;
-static int ERRORTYPE;
-
-/****************************************************************/
-
-static int *newpi=NULL; /*  new policy */
-/* the inverse policy is coded by a linearly chained list */
-static  int *piinv_idx=NULL; /* piinv_idx[i]= pointer to the chain of inverses
-                                of node i */
-static  int *piinv_succ=NULL;/* piinv_idx[j]= pointer to the next inverse */
-static  int *piinv_elem=NULL;/* corresponding  node  */
-static  int *piinv_last=NULL;/* piinv_last[i]= last inverse of i */
-static  double *c=NULL;
-static  double *tau=NULL;
-static  double *newtau=NULL;
-static  double *vaux=NULL;
-static  double *newc=NULL;
-static  double *newchi=NULL;
-static  int *visited=NULL;
-static  int *component=NULL;
-static  double lambda=0;
-static  double epsilon=0;
-static  int color=1;
+/* WORKSPACE
+
+   All the working state of the algorithm is stored inside a workspace: the
+   arguments of the current call and the arrays of size nnodes. Arrays are
+   only reallocated when a call needs more nodes than the capacity of the
+   workspace, therefore repeated calls do not pay allocations. Functions
+   using distinct workspaces can be called concurrently.
+*/
+
+struct HowardWorkspace
+{
+    /* Arguments of the current call */
+    int *ij;
+    double *a;
+    double *t;
+    int nnodes;
+    int narcs;
+    double *chi;
+    double *v;
+    int *pi;
+    int *NIterations;
+    int *NComponents;
+    int verbosemode;
+
+    /* Number of nodes the arrays can hold */
+    int capacity;
+    int *newpi; /*  new policy */
+    /* the inverse policy is coded by a linearly chained list */
+    int *piinv_idx; /* piinv_idx[i]= pointer to the chain of inverses
+                       of node i */
+    int *piinv_succ;/* piinv_idx[j]= pointer to the next inverse */
+    int *piinv_elem;/* corresponding  node  */
+    int *piinv_last;/* piinv_last[i]= last inverse of i */
+    double *c;
+    double *tau;
+    double *newtau;
+    double *vaux;
+    double *newc;
+    double *newchi;
+    int *visited;
+    int *component;
+    double lambda;
+    double epsilon;
+    int color;
+    /* Start from the policy given as argument (see Howard_Warm_Start) */
+    int warmstart;
+};
 
 static void Display_Policy(int *pi,double *c,int nnodes)
 {
@@ -161,28 +173,28 @@ static void Display_Semi_Sparse_Matrix(int narcs, int *ij,double *A, double *t)
 /* The termination tests are performed up to an epsilon
    constant, which is fixed heuristically by the following routine
 */
-static void Epsilon(double *a,int narcs,double *epsilon)
+static void Epsilon(HowardWorkspace *w)
 {
     int i;
     double MAX,MIN;
-    MAX=a[0];
-    MIN=a[0];
-    for (i=1;i<narcs; i++)
+    MAX=w->a[0];
+    MIN=w->a[0];
+    for (i=1;i<w->narcs; i++)
     {
-        if (a[i]> MAX)
+        if (w->a[i]> MAX)
         {
-            MAX=a[i];
+            MAX=w->a[i];
         }
-        if (a[i]<MIN)
+        if (w->a[i]<MIN)
         {
-            MIN=a[i];
+            MIN=w->a[i];
         }
     }
     /* this value is somehow arbitrary. */
-    *epsilon=(MAX-MIN+1)*0.000000001;
-    if (verbosemode>1)
+    w->epsilon=(MAX-MIN+1)*0.000000001;
+    if (w->verbosemode>1)
     {
-        printf("MAX of coefs =%f MIN of coefs=%f MAX-MIN= %f epsilon=%f\n",MAX,MIN,MAX-MIN, *epsilon);
+        printf("MAX of coefs =%f MIN of coefs=%f MAX-MIN= %f epsilon=%f\n",MAX,MIN,MAX-MIN, w->epsilon);
     }
 }
 
@@ -195,126 +207,182 @@ static void Epsilon(double *a,int narcs,double *epsilon)
    to cut the number of iterations by a factor 1.5, by comparison
    with a random initial policy */
 
-static void Initial_Policy(void)
+static void Initial_Policy(HowardWorkspace *w)
 {
     int i;
+    int *ij=w->ij;
 
     /* we loose a O(nnodes) time here ... */
     /* we use the auxiliary variable vaux to compute the row max of A */
-    for (i=0; i< nnodes; i++)
+    for (i=0; i< w->nnodes; i++)
     {
-        vaux[i] = EPSILON;
+        w->vaux[i] = EPSILON;
     }
-    for (i=0; i<narcs; i++)
+    for (i=0; i<w->narcs; i++)
     {
-        if (vaux[ij[i*2]] <= a[i])
+        if (w->vaux[ij[i*2]] <= w->a[i])
         {
-            pi[ij[i*2]] =  ij[i*2+1];
-            c[ij[i*2]] = a[i];
-            vaux[ij[i*2]] = a[i];
+            w->pi[ij[i*2]] =  ij[i*2+1];
+            w->c[ij[i*2]] = w->a[i];
+            w->vaux[ij[i*2]] = w->a[i];
         }
     }
 }
 
 /* idem : semi Markov case */
 
-static void Semi_Initial_Policy(void)
+static void Semi_Initial_Policy(HowardWorkspace *w)
 {
     int i;
+    int *ij=w->ij;
+    double *a=w->a;
+    double *t=w->t;
 
     /* we loose a O(nnodes) time here ... */
     /* heuristic rule to determine the initial policy... A */
-    for (i=0; i< nnodes; i++)
+    for (i=0; i< w->nnodes; i++)
     {
-        vaux[i] = EPSILON;
+        w->vaux[i] = EPSILON;
     }
-    for (i=0; i<narcs; i++)
+    for (i=0; i<w->narcs; i++)
     {
         if (t[i]>0)
         {
-            if (vaux[ij[i*2]]<= a[i]/t[i] )
+            if (w->vaux[ij[i*2]]<= a[i]/t[i] )
             {
-                pi[ij[i*2]] =  ij[i*2+1];
-                c[ij[i*2]] = a[i];
-                tau[ij[i*2]] =t[i];
-                vaux[ij[i*2]] = a[i]/t[i];
+                w->pi[ij[i*2]] =  ij[i*2+1];
+                w->c[ij[i*2]] = a[i];
+                w->tau[ij[i*2]] =t[i];
+                w->vaux[ij[i*2]] = a[i]/t[i];
             }
         }
         else
             /* degenerate case */
         {
-            if (vaux[ij[i*2]]<= a[i]){
-                pi[ij[i*2]] =  ij[i*2+1];
-                c[ij[i*2]] = a[i];
-                tau[ij[i*2]] =t[i];
-                vaux[ij[i*2]] = a[i];
+            if (w->vaux[ij[i*2]]<= a[i]){
+                w->pi[ij[i*2]] =  ij[i*2+1];
+                w->c[ij[i*2]] = a[i];
+                w->tau[ij[i*2]] =t[i];
+                w->vaux[ij[i*2]] = a[i];
+            }
+        }
+    }
+}
+
+/* Warm start: use the policy pi given by the caller (for example the
+   optimal policy of a previous call on a similar graph) as initial policy.
+   Among the arcs i->pi[i], the same greedy rule than the initial policy
+   is used. The array visited is used as temporary storage.
+   Return 0 if the given policy is admissible, else 1. */
+
+static int Given_Policy(HowardWorkspace *w)
+{
+    int i,I;
+    double ratio;
+    int *ij=w->ij;
+    double *a=w->a;
+    double *t=w->t; /* NULL for the non semi Markov case */
+
+    for (i=0; i< w->nnodes; i++)
+    {
+        w->visited[i] = 0;
+        w->vaux[i] = EPSILON;
+    }
+    for (i=0; i<w->narcs; i++)
+    {
+        I=ij[i*2];
+        if (w->pi[I] != ij[i*2+1])
+        {
+            continue;
+        }
+        ratio=((t!=NULL) && (t[i]>0)) ? a[i]/t[i] : a[i];
+        if ((w->visited[I]==0) || (w->vaux[I]<= ratio))
+        {
+            w->visited[I]=1;
+            w->c[I] = a[i];
+            if (t!=NULL)
+            {
+                w->tau[I] = t[i];
+            }
+            w->vaux[I] = ratio;
+        }
+    }
+    for (i=0; i< w->nnodes; i++)
+    {
+        if (w->visited[i]==0)
+        {
+            if (w->verbosemode>0)
+            {
+                printf("warm start: node %d has no arc to pi(%d)=%d\n",i,i,w->pi[i]);
             }
+            return(1);
         }
     }
+    return(0);
 }
 
-static void New_Display_Inverse(void)
+static void New_Display_Inverse(HowardWorkspace *w)
 {
     int i,a;
-    printf("DISPLAYING INVERSE nnodes=%d\n",nnodes);
-    for (i=0; i<nnodes; i++)
-    { a=piinv_idx[i];
+    printf("DISPLAYING INVERSE nnodes=%d\n",w->nnodes);
+    for (i=0; i<w->nnodes; i++)
+    { a=w->piinv_idx[i];
         while (a != -1)
         {
-            printf("inverse of %d= %d\n",i,piinv_elem[a]);
-            a=piinv_succ[a];
+            printf("inverse of %d= %d\n",i,w->piinv_elem[a]);
+            a=w->piinv_succ[a];
         }
     }
 }
 
-static void New_Build_Inverse(void)
+static void New_Build_Inverse(HowardWorkspace *w)
 {
     int i,j,locus;
     int ptr=0;
-    if (verbosemode >1 )
+    if (w->verbosemode >1 )
     {
         printf("BUILDING INVERSE\n");
     }
-    for (i=0;i<nnodes;i++)
+    for (i=0;i<w->nnodes;i++)
     {
-        piinv_idx[i] =-1;
-        piinv_last[i]=-1;
+        w->piinv_idx[i] =-1;
+        w->piinv_last[i]=-1;
     }
-    for (i=0;i<nnodes;i++)
+    for (i=0;i<w->nnodes;i++)
     {
-        j=pi[i];
-        if (piinv_idx[j]==-1)
+        j=w->pi[i];
+        if (w->piinv_idx[j]==-1)
         {
-            piinv_succ[ptr]=-1;
-            piinv_elem[ptr]=i;
-            piinv_last[j]=ptr;
-            piinv_idx[j]=ptr;
+            w->piinv_succ[ptr]=-1;
+            w->piinv_elem[ptr]=i;
+            w->piinv_last[j]=ptr;
+            w->piinv_idx[j]=ptr;
             ptr++;
         }
         else
         {
-            piinv_succ[ptr]=-1;
-            piinv_elem[ptr]=i;
-            locus=piinv_last[j];
-            piinv_succ[locus]=ptr;
-            piinv_last[j]=ptr;
+            w->piinv_succ[ptr]=-1;
+            w->piinv_elem[ptr]=i;
+            locus=w->piinv_last[j];
+            w->piinv_succ[locus]=ptr;
+            w->piinv_last[j]=ptr;
             ptr++;
         };
     }
-    if (verbosemode >1)
+    if (w->verbosemode >1)
     {
-        New_Display_Inverse();
+        New_Display_Inverse(w);
         printf("INVERSE OK\n");
     }
 }
 
-static void Init_Depth_First(void)
+static void Init_Depth_First(HowardWorkspace *w)
 {
     int j;
-    for (j=0;j<nnodes;j++)
+    for (j=0;j<w->nnodes;j++)
     {
-        visited[j]=0;
-        component[j]=0;
+        w->visited[j]=0;
+        w->component[j]=0;
     }
 }
 
@@ -325,55 +393,55 @@ static void Init_Depth_First(void)
 /* the array visited is changed by side effect */
 
 
-static void New_Depth_First_Label(int i)
+static void New_Depth_First_Label(HowardWorkspace *w,int i)
 {
     int nexti,a;
-    a=piinv_idx[i];
-    while (a != -1 && visited[piinv_elem[a]]==0)
+    a=w->piinv_idx[i];
+    while (a != -1 && w->visited[w->piinv_elem[a]]==0)
     {
-        nexti=piinv_elem[a];
-        visited[nexti]=1;
-        v[nexti]= -lambda + c[nexti]+ v[i];
-        component[nexti]=color;
-        chi[nexti]= lambda;
-        New_Depth_First_Label(nexti);
-        a=piinv_succ[a];
+        nexti=w->piinv_elem[a];
+        w->visited[nexti]=1;
+        w->v[nexti]= -w->lambda + w->c[nexti]+ w->v[i];
+        w->component[nexti]=w->color;
+        w->chi[nexti]= w->lambda;
+        New_Depth_First_Label(w,nexti);
+        a=w->piinv_succ[a];
     }
 }
-static void Semi_New_Depth_First_Label(int i)
+static void Semi_New_Depth_First_Label(HowardWorkspace *w,int i)
 {
     int nexti,a;
-    a=piinv_idx[i];
-    while (a != -1 && visited[piinv_elem[a]]==0)
+    a=w->piinv_idx[i];
+    while (a != -1 && w->visited[w->piinv_elem[a]]==0)
     {
-        nexti=piinv_elem[a];
-        visited[nexti]=1;
-        v[nexti]= -lambda*tau[nexti] + c[nexti]+ v[i];
-        component[nexti]=color;
-        chi[nexti]= lambda;
-        Semi_New_Depth_First_Label(nexti);
-        a=piinv_succ[a];
+        nexti=w->piinv_elem[a];
+        w->visited[nexti]=1;
+        w->v[nexti]= -w->lambda*w->tau[nexti] + w->c[nexti]+ w->v[i];
+        w->component[nexti]=w->color;
+        w->chi[nexti]= w->lambda;
+        Semi_New_Depth_First_Label(w,nexti);
+        a=w->piinv_succ[a];
     }
 }
 
 
-static void Visit_From(int initialpoint,int color)
+static void Visit_From(HowardWorkspace *w,int initialpoint,int color)
 {
     int index,newindex,i;
     double weight;
     int length;
-    if (verbosemode>1)
+    if (w->verbosemode>1)
     {
         printf("visiting from node %d color=%d\n",initialpoint, color);
     }
     index=initialpoint;
-    component[index]=color;
-    newindex=pi[index];
-    while (component[newindex]==0)
+    w->component[index]=color;
+    newindex=w->pi[index];
+    while (w->component[newindex]==0)
     {
-        component[newindex]=color;
+        w->component[newindex]=color;
         index=newindex;
-        newindex=pi[index];
+        newindex=w->pi[index];
     }
     /* a cycle has been detected, since newindex is already visited */
     weight=0;
@@ -381,35 +449,35 @@ static void Visit_From(int initialpoint,int color)
     i=index;
     do
     {
-        weight+=c[i];
+        weight+=w->c[i];
         length++;
-        i=pi[i];
+        i=w->pi[i];
     }
     while (i !=index);
-    lambda=weight/length;
-    v[i]=vaux[i]; /* keeping the previous value */
-    chi[i]=lambda;
-    New_Depth_First_Label(index);
+    w->lambda=weight/length;
+    w->v[i]=w->vaux[i]; /* keeping the previous value */
+    w->chi[i]=w->lambda;
+    New_Depth_First_Label(w,index);
 }
 
 
-static int Semi_Visit_From(int initialpoint,int color)
+static int Semi_Visit_From(HowardWorkspace *w,int initialpoint,int color)
 {
     int index,newindex,i;
     double weight;
     double glength;
-    if (verbosemode>1)
+    if (w->verbosemode>1)
     {
         printf("visiting from node %d color=%d\n",initialpoint, color);
     }
     index=initialpoint;
-    component[index]=color;
-    newindex=pi[index];
-    while (component[newindex]==0)
+    w->component[index]=color;
+    newindex=w->pi[index];
+    while (w->component[newindex]==0)
     {
-        component[newindex]=color;
+        w->component[newindex]=color;
         index=newindex;
-        newindex=pi[index];
+        newindex=w->pi[index];
     }
     /* a cycle has been detected, since newindex is already visited */
     weight=0;
@@ -417,25 +485,25 @@ static int Semi_Visit_From(int initialpoint,int color)
     i=index;
     do
     {
-        weight+=c[i];
-        glength+=tau[i];
-        i=pi[i];
+        weight+=w->c[i];
+        glength+=w->tau[i];
+        i=w->pi[i];
     }
     while (i !=index);
     if (glength<= 0)
     {
-        if (verbosemode >0)
+        if (w->verbosemode >0)
         {
             printf("ERROR: cycle with non-positive weight %g found at node %d\n",glength, i);
             printf("CURRENT POLICY: \n");
-            Display_Semi_Policy(pi,c,tau,nnodes);
+            Display_Semi_Policy(w->pi,w->c,w->tau,w->nnodes);
         }
         return(2);
     }
-    lambda=weight/glength;
-    v[i]=vaux[i]; /* keeping the previous value */
-    chi[i]=lambda;
-    Semi_New_Depth_First_Label(index);
+    w->lambda=weight/glength;
+    w->v[i]=w->vaux[i]; /* keeping the previous value */
+    w->chi[i]=w->lambda;
+    Semi_New_Depth_First_Label(w,index);
     return(0);
 }
 
@@ -443,28 +511,28 @@ static int Semi_Visit_From(int initialpoint,int color)
 /*       Value() */
 /* Computes the value (v,chi) associated with a policy pi */
 
-static void Value(void)
+static void Value(HowardWorkspace *w)
 {
     int initialpoint;
-    color=1;
-    if (verbosemode>0)
+    w->color=1;
+    if (w->verbosemode>0)
     {
         printf("Computing the value\n");
     }
-    Init_Depth_First();
+    Init_Depth_First(w);
     initialpoint=0;
     do
     {
-        Visit_From(initialpoint,color);
-        while ((initialpoint<nnodes) && (component[initialpoint] !=0))
+        Visit_From(w,initialpoint,w->color);
+        while ((initialpoint<w->nnodes) && (w->component[initialpoint] !=0))
         {
             initialpoint++;
         }
-        color++;
+        w->color++;
     }
-    while (initialpoint<nnodes);
-    *NComponents=--color;
-    if (verbosemode>0)
+    while (initialpoint<w->nnodes);
+    *w->NComponents=--w->color;
+    if (w->verbosemode>0)
     {
         printf("Value OK\n");
     }
@@ -474,31 +542,31 @@ static void Value(void)
 /*       Value()  (Semi-Markov case) */
 /* Computes the value (v,chi) associated with a policy pi */
 
-static int Semi_Value(void)
+static int Semi_Value(HowardWorkspace *w)
 {
     int initialpoint;
-    color=1;
-    if (verbosemode>0)
+    w->color=1;
+    if (w->verbosemode>0)
     {
         printf("Computing the value\n");
     }
-    Init_Depth_First();
+    Init_Depth_First(w);
     initialpoint=0;
     do
     {
-        if (Semi_Visit_From(initialpoint,color)!=0)
+        if (Semi_Visit_From(w,initialpoint,w->color)!=0)
         {
             return(2);
         }
-        while ((initialpoint<nnodes) && (component[initialpoint] !=0))
+        while ((initialpoint<w->nnodes) && (w->component[initialpoint] !=0))
         {
             initialpoint++;
         }
-        color++;
+        w->color++;
     }
-    while (initialpoint<nnodes);
-    *NComponents=--color;
-    if (verbosemode>0)
+    while (initialpoint<w->nnodes);
+    *w->NComponents=--w->color;
+    if (w->verbosemode>0)
     {
         printf("Value OK\n");
     }
@@ -506,121 +574,125 @@ static int Semi_Value(void)
 }
 
 
-static void Show_Info_Improve_Chi(int i)
+static void Show_Info_Improve_Chi(HowardWorkspace *w,int i)
 {
     int I,J;
     /*printf("type 1 improvement\n");*/
-    if (verbosemode>0)
+    if (w->verbosemode>0)
     {
-        I=ij[i*2];
-        J=ij[i*2+1];
+        I=w->ij[i*2];
+        J=w->ij[i*2+1];
         printf("Improvement of the cycle time at node %d\n",I);
-        printf("arc %d: %d--->%d chi[%d]-chi[%d]=%f-%f=%g>0\n",i,I,J,I,J,chi[J],chi[I],chi[J]-chi[I]);
+        printf("arc %d: %d--->%d chi[%d]-chi[%d]=%f-%f=%g>0\n",i,I,J,I,J,w->chi[J],w->chi[I],w->chi[J]-w->chi[I]);
     }
 }
 
-static void Show_Info_Improve_Bias(int i)
+static void Show_Info_Improve_Bias(HowardWorkspace *w,int i)
 {
     int I,J;
     /*printf("type 2 improvement\n");*/
-    if (verbosemode>0)
+    if (w->verbosemode>0)
     {
-        I=ij[i*2];
-        J=ij[i*2+1];
+        I=w->ij[i*2];
+        J=w->ij[i*2+1];
         printf("Improvement of the BIAS at node %d\n",I);
-        printf("A[%d]+v[%d] - chi[%d]-v[%d]= %f + %f -%f -%f =%f >0\n",i,J,I,I,a[i],v[J],chi[I],v[I],a[i]+v[J]-chi[I]-v[I]);
+        printf("A[%d]+v[%d] - chi[%d]-v[%d]= %f + %f -%f -%f =%f >0\n",i,J,I,I,w->a[i],w->v[J],w->chi[I],w->v[I],w->a[i]+w->v[J]-w->chi[I]-w->v[I]);
     }
 }
 
-static void Semi_Show_Info_Improve_Bias(int i)
+static void Semi_Show_Info_Improve_Bias(HowardWorkspace *w,int i)
 {
     int I,J;
     /*printf("type 2 improvement\n");*/
-    if (verbosemode>0)
+    if (w->verbosemode>0)
     {
-        I=ij[i*2];
-        J=ij[i*2+1];
+        I=w->ij[i*2];
+        J=w->ij[i*2+1];
         printf("Improvement of the BIAS at node %d\n",I);
-        printf("A[%d]+v[%d] - chi[%d]*t[%d]-v[%d]= %f + %f -%f*%f -%f =%f >0\n",i,J,J,J,I,a[i],v[J],chi[I],t[i],v[I],a[i]+v[J]-chi[I]*t[i]-v[I]);
+        printf("A[%d]+v[%d] - chi[%d]*t[%d]-v[%d]= %f + %f -%f*%f -%f =%f >0\n",i,J,J,J,I,w->a[i],w->v[J],w->chi[I],w->t[i],w->v[I],w->a[i]+w->v[J]-w->chi[I]*w->t[i]-w->v[I]);
     }
 }
 
-static void Init_Improve(void)
+static void Init_Improve(HowardWorkspace *w)
 {
     int i;
-    for (i=0;i<nnodes; i++)
+    for (i=0;i<w->nnodes; i++)
     {
-        newchi[i]=chi[i];
-        vaux[i]=v[i];
-        newpi[i]=pi[i];
-        newc[i]=c[i];
+        w->newchi[i]=w->chi[i];
+        w->vaux[i]=w->v[i];
+        w->newpi[i]=w->pi[i];
+        w->newc[i]=w->c[i];
     }
 }
 
-static void Semi_Init_Improve(void)
+static void Semi_Init_Improve(HowardWorkspace *w)
 {
     int i;
-    for (i=0;i<nnodes; i++)
+    for (i=0;i<w->nnodes; i++)
     {
-        newchi[i]=chi[i];
-        vaux[i]=v[i];
-        newpi[i]=pi[i];
-        newc[i]=c[i];
-        newtau[i]=tau[i];
+        w->newchi[i]=w->chi[i];
+        w->vaux[i]=w->v[i];
+        w->newpi[i]=w->pi[i];
+        w->newc[i]=w->c[i];
+        w->newtau[i]=w->tau[i];
     }
 }
 
-static void First_Order_Improvement(int *improved)
+static void First_Order_Improvement(HowardWorkspace *w,int *improved)
 {
     int i;
-    for (i=0;i<narcs; i++)
+    int *ij=w->ij;
+    for (i=0;i<w->narcs; i++)
     {
-        if (chi[ij[i*2+1]]>newchi[ij[i*2]])
+        if (w->chi[ij[i*2+1]]>w->newchi[ij[i*2]])
         {
-            Show_Info_Improve_Chi(i);
+            Show_Info_Improve_Chi(w,i);
             *improved=1;
-            newpi[ij[i*2]]=ij[i*2+1];
-            newchi[ij[i*2]]=chi[ij[i*2+1]];
-            newc[ij[i*2]]=a[i];
+            w->newpi[ij[i*2]]=ij[i*2+1];
+            w->newchi[ij[i*2]]=w->chi[ij[i*2+1]];
+            w->newc[ij[i*2]]=w->a[i];
         }
     }
 }
-static void Semi_First_Order_Improvement(int *improved)
+static void Semi_First_Order_Improvement(HowardWorkspace *w,int *improved)
 {
     int i;
-    for (i=0;i<narcs; i++)
+    int *ij=w->ij;
+    for (i=0;i<w->narcs; i++)
     {
-        if (chi[ij[i*2+1]]>newchi[ij[i*2]])
+        if (w->chi[ij[i*2+1]]>w->newchi[ij[i*2]])
         {
-            Show_Info_Improve_Chi(i);
+            Show_Info_Improve_Chi(w,i);
             *improved=1;
-            newpi[ij[i*2]]=ij[i*2+1];
-            newchi[ij[i*2]]=chi[ij[i*2+1]];
-            newc[ij[i*2]]=a[i];
-            newtau[ij[i*2]]=t[i];
+            w->newpi[ij[i*2]]=ij[i*2+1];
+            w->newchi[ij[i*2]]=w->chi[ij[i*2+1]];
+            w->newc[ij[i*2]]=w->a[i];
+            w->newtau[ij[i*2]]=w->t[i];
         }
     }
 }
 
-static void Second_Order_Improvement(int *improved)
+static void Second_Order_Improvement(HowardWorkspace *w,int *improved)
 {
     int i;
-    double w;
-    if (*NComponents >1) /* a bit more complicated */
+    double x;
+    int *ij=w->ij;
+    double *a=w->a;
+    if (*w->NComponents >1) /* a bit more complicated */
     {
-        for (i=0;i<narcs; i++)
+        for (i=0;i<w->narcs; i++)
         {
-            if (chi[ij[i*2+1]]==newchi[ij[i*2]])
+            if (w->chi[ij[i*2+1]]==w->newchi[ij[i*2]])
                 /* arc i is critical */
             {
-                w=a[i]+ v[ij[i*2+1]] - chi[ij[i*2]];
-                if (w>vaux[ij[i*2]] + epsilon)
+                x=a[i]+ w->v[ij[i*2+1]] - w->chi[ij[i*2]];
+                if (x>w->vaux[ij[i*2]] + w->epsilon)
                 {
-                    Show_Info_Improve_Bias(i);
+                    Show_Info_Improve_Bias(w,i);
                     *improved=1;
-                    vaux[ij[i*2]]=w;
-                    newpi[ij[i*2]]=ij[i*2+1];
-                    newc[ij[i*2]]=a[i];
+                    w->vaux[ij[i*2]]=x;
+                    w->newpi[ij[i*2]]=ij[i*2+1];
+                    w->newc[ij[i*2]]=a[i];
                 }
             }
         }
@@ -628,41 +700,44 @@ static void Second_Order_Improvement(int *improved)
     else /* we know that all the arcs realize the max in the
             first order improvement */
     {
-        for (i=0;i<narcs; i++)
+        for (i=0;i<w->narcs; i++)
         {
-            w=a[i]+ v[ij[i*2+1]] - chi[ij[i*2]];
-            if (w>vaux[ij[i*2]] + epsilon)
+            x=a[i]+ w->v[ij[i*2+1]] - w->chi[ij[i*2]];
+            if (x>w->vaux[ij[i*2]] + w->epsilon)
             {
-                Show_Info_Improve_Bias(i);
+                Show_Info_Improve_Bias(w,i);
                 *improved=1;
-                vaux[ij[i*2]]=w;
-                newpi[ij[i*2]]=ij[i*2+1];
-                newc[ij[i*2]]=a[i];
+                w->vaux[ij[i*2]]=x;
+                w->newpi[ij[i*2]]=ij[i*2+1];
+                w->newc[ij[i*2]]=a[i];
             }
         }
     }
 }
 
-static void Semi_Second_Order_Improvement(int *improved)
+static void Semi_Second_Order_Improvement(HowardWorkspace *w,int *improved)
 {
     int i;
-    double w;
-    if (*NComponents >1) /* a bit more complicated */
+    double x;
+    int *ij=w->ij;
+    double *a=w->a;
+    double *t=w->t;
+    if (*w->NComponents >1) /* a bit more complicated */
     {
-        for (i=0;i<narcs; i++)
+        for (i=0;i<w->narcs; i++)
         {
-            if (chi[ij[i*2+1]]==newchi[ij[i*2]])
+            if (w->chi[ij[i*2+1]]==w->newchi[ij[i*2]])
                 /* arc i is critical */
             {
-                w=a[i]+ v[ij[i*2+1]] - chi[ij[i*2+1]]*t[i];
-                if (w>vaux[ij[i*2]] + epsilon)
+                x=a[i]+ w->v[ij[i*2+1]] - w->chi[ij[i*2+1]]*t[i];
+                if (x>w->vaux[ij[i*2]] + w->epsilon)
                 {
-                    Semi_Show_Info_Improve_Bias(i);
+                    Semi_Show_Info_Improve_Bias(w,i);
                     *improved=1;
-                    vaux[ij[i*2]]=w;
-                    newpi[ij[i*2]]=ij[i*2+1];
-                    newc[ij[i*2]]=a[i];
-                    newtau[ij[i*2]]=t[i];
+                    w->vaux[ij[i*2]]=x;
+                    w->newpi[ij[i*2]]=ij[i*2+1];
+                    w->newc[ij[i*2]]=a[i];
+                    w->newtau[ij[i*2]]=t[i];
                 }
             }
         }
@@ -670,182 +745,227 @@ static void Semi_Second_Order_Improvement(int *improved)
     else /* we know that all the arcs realize the max in the
             first order improvement */
     {
-        for (i=0;i<narcs; i++)
+        for (i=0;i<w->narcs; i++)
         {
-            w=a[i]+ v[ij[i*2+1]] - chi[ij[i*2+1]]*t[i];
-            if (w>vaux[ij[i*2]] + epsilon)
+            x=a[i]+ w->v[ij[i*2+1]] - w->chi[ij[i*2+1]]*t[i];
+            if (x>w->vaux[ij[i*2]] + w->epsilon)
             {
-                Semi_Show_Info_Improve_Bias(i);
+                Semi_Show_Info_Improve_Bias(w,i);
                 *improved=1;
-                vaux[ij[i*2]]=w;
-                newpi[ij[i*2]]=ij[i*2+1];
-                newc[ij[i*2]]=a[i];
-                newtau[ij[i*2]]=t[i];
+                w->vaux[ij[i*2]]=x;
+                w->newpi[ij[i*2]]=ij[i*2+1];
+                w->newc[ij[i*2]]=a[i];
+                w->newtau[ij[i*2]]=t[i];
             }
         }
     }
 }
 
-static void Improve(int *improved)
+static void Improve(HowardWorkspace *w,int *improved)
 {
     *improved=0;
-    Init_Improve();
-    if (*NComponents>1) /* a first order policy improvement may occur */
-        First_Order_Improvement(improved);
+    Init_Improve(w);
+    if (*w->NComponents>1) /* a first order policy improvement may occur */
+        First_Order_Improvement(w,improved);
     if (*improved ==0)
     {
-        Second_Order_Improvement(improved);
+        Second_Order_Improvement(w,improved);
     }
 }
 
 /* semi Markov variant */
-static void Semi_Improve(int *improved)
+static void Semi_Improve(HowardWorkspace *w,int *improved)
 {
     *improved=0;
-    Semi_Init_Improve();
-    if (*NComponents>1) /* a first order policy improvement may occur */
-        Semi_First_Order_Improvement(improved);
+    Semi_Init_Improve(w);
+    if (*w->NComponents>1) /* a first order policy improvement may occur */
+        Semi_First_Order_Improvement(w,improved);
     if (*improved ==0)
     {
-        Semi_Second_Order_Improvement(improved);
+        Semi_Second_Order_Improvement(w,improved);
     }
 }
 
-static void Allocate_Memory(void)
+/* Resize an array. The array is kept unchanged on failure.
+   Return 0 on success. */
+static int Grow_Int(int **array,size_t n)
 {
-    newpi=(int *)calloc(nnodes, sizeof(int));
-    piinv_idx=(int *)calloc(nnodes, sizeof(int));
-    piinv_succ=(int *)calloc(nnodes, sizeof(int));
-    piinv_elem=(int *)calloc(nnodes, sizeof(int));
-    piinv_last=(int *)calloc(nnodes, sizeof(int));
-    visited=(int *)calloc(nnodes, sizeof(int));
-    component=(int *)calloc(nnodes, sizeof(int));
-    c=(double *)calloc(nnodes, sizeof(double));
-    newc=(double *)calloc(nnodes, sizeof(double));
-    vaux=(double *)calloc(nnodes, sizeof(double));
-    newchi=(double *)calloc(nnodes, sizeof(double));
-    if ((newchi==NULL)|| (vaux==NULL) || (newc==NULL)|| (c==NULL)|| (component==NULL) || (visited==NULL)|| (piinv_idx==NULL) ||(piinv_succ== NULL) ||( piinv_elem==NULL)|| (  piinv_last==NULL) || (newpi==NULL))
+    int *p=(int *)realloc(*array, n*sizeof(int));
+    if (p==NULL)
     {
-        printf("error in Howard... memory allocation failed...\n");
-        exit(1);
+        return(1);
     }
+    *array=p;
+    return(0);
 }
 
-static void Semi_Allocate_Memory(void)
+static int Grow_Double(double **array,size_t n)
 {
-    Allocate_Memory();
-    tau=(double *)calloc(nnodes, sizeof(double));
-    newtau=(double *)calloc(nnodes, sizeof(double));
-    if ((tau==NULL)|| (newtau==NULL))
+    double *p=(double *)realloc(*array, n*sizeof(double));
+    if (p==NULL)
     {
-        printf("error in Howard... memory allocation failed...\n");
-        exit(1);
+        return(1);
     }
+    *array=p;
+    return(0);
 }
 
-static void Free_Memory(void)
+/* Grow the arrays of the workspace to hold at least nnodes elements.
+   Arrays are never shrunk. Return 0 on success. */
+static int Reserve_Memory(HowardWorkspace *w,int nnodes)
 {
-    free(newpi);
-    free(piinv_idx);
-    free(piinv_succ);
-    free(piinv_elem);
-    free(piinv_last);
-    free(visited);
-    free(component);
-    free(c);
-    free(newc);
-    free(vaux);
-    free(newchi);
+    int failed=0;
+    size_t n=(size_t)nnodes;
+    if (nnodes<=w->capacity)
+    {
+        return(0);
+    }
+    failed|=Grow_Int(&w->newpi,n);
+    failed|=Grow_Int(&w->piinv_idx,n);
+    failed|=Grow_Int(&w->piinv_succ,n);
+    failed|=Grow_Int(&w->piinv_elem,n);
+    failed|=Grow_Int(&w->piinv_last,n);
+    failed|=Grow_Int(&w->visited,n);
+    failed|=Grow_Int(&w->component,n);
+    failed|=Grow_Double(&w->c,n);
+    failed|=Grow_Double(&w->tau,n);
+    failed|=Grow_Double(&w->newtau,n);
+    failed|=Grow_Double(&w->newc,n);
+    failed|=Grow_Double(&w->vaux,n);
+    failed|=Grow_Double(&w->newchi,n);
+    if (failed)
+    {
+        if (w->verbosemode>0)
+        {
+            printf("error in Howard... memory allocation failed...\n");
+        }
+        return(6);
+    }
+    w->capacity=nnodes;
+    return(0);
+}
+
+HowardWorkspace* Howard_New_Workspace(void)
+{
+    return (HowardWorkspace *)calloc(1, sizeof(HowardWorkspace));
 }
 
-static void Semi_Free_Memory(void)
+void Howard_Free_Workspace(HowardWorkspace *w)
 {
-    free(tau);
-    free(newtau);
-    Free_Memory();
+    if (w==NULL)
+    {
+        return;
+    }
+    free(w->newpi);
+    free(w->piinv_idx);
+    free(w->piinv_succ);
+    free(w->piinv_elem);
+    free(w->piinv_last);
+    free(w->visited);
+    free(w->component);
+    free(w->c);
+    free(w->tau);
+    free(w->newtau);
+    free(w->newc);
+    free(w->vaux);
+    free(w->newchi);
+    free(w);
 }
 
-static void Show_Info(void)
+void Howard_Warm_Start(HowardWorkspace *w,int enable)
 {
-    if (verbosemode >0)
+    w->warmstart=enable;
+}
+
+static void Show_Info(HowardWorkspace *w)
+{
+    if (w->verbosemode >0)
     {
-        printf("verbosemode=%d",verbosemode);
-        printf("*** ITERATION %d of Max Plus Howard Algorithm *** \n",*NIterations);
-        Display_Policy(pi,c,nnodes);
+        printf("verbosemode=%d",w->verbosemode);
+        printf("*** ITERATION %d of Max Plus Howard Algorithm *** \n",*w->NIterations);
+        Display_Policy(w->pi,w->c,w->nnodes);
         printf("vector chi=\n");
-        Display_Vector(nnodes,chi);
+        Display_Vector(w->nnodes,w->chi);
         printf("vector v=\n");
-        Display_Vector(nnodes,v);
+        Display_Vector(w->nnodes,w->v);
     }
 }
 
-static void Semi_Show_Info(void)
+static void Semi_Show_Info(HowardWorkspace *w)
 {
-    if (verbosemode >0)
+    if (w->verbosemode >0)
     {
-        printf("verbosemode=%d",verbosemode);
-        printf("*** ITERATION %d of Max Plus Howard Algorithm *** \n",*NIterations);
-        Display_Semi_Policy(pi,c,tau,nnodes);
+        printf("verbosemode=%d",w->verbosemode);
+        printf("*** ITERATION %d of Max Plus Howard Algorithm *** \n",*w->NIterations);
+        Display_Semi_Policy(w->pi,w->c,w->tau,w->nnodes);
         printf("vector chi=\n");
-        Display_Vector(nnodes,chi);
+        Display_Vector(w->nnodes,w->chi);
         printf("vector v=\n");
-        Display_Vector(nnodes,v);
+        Display_Vector(w->nnodes,w->v);
     }
 }
 
-static int Check_Rows(void)
+/* The array visited of the workspace is used as temporary storage */
+static int Check_Rows(HowardWorkspace *w)
 {
     int i;
-    int *u=NULL;
-    u=(int *)calloc(nnodes,sizeof(int));
-    for (i=0; i<narcs;i++ )
+    int *u=w->visited;
+    for (i=0; i<w->nnodes;i++ )
+    {
+        u[i]=0;
+    }
+    for (i=0; i<w->narcs;i++ )
     {
-        u[ij[2*i]]=1;
+        u[w->ij[2*i]]=1;
     }
-    if (verbosemode>0)
+    if (w->verbosemode>0)
     {
-        for (i=0; i<nnodes;i++ )
+        for (i=0; i<w->nnodes;i++ )
         {
             printf("u[%d] = %d\n", i, u[i]);
         }
     }
-    for (i=0; i<nnodes;i++ )
+    for (i=0; i<w->nnodes;i++ )
     {
         if (u[i]==0)
         {
-            if (verbosemode>0)
+            if (w->verbosemode>0)
             {
                 printf("ERROR : node numbered %d has no predecessor (recall that nodes are internally numbered from 0)\n",i);
             }
-            free(u);
             return(1);
         }
     }
-    free(u);
     return(0);
 }
 
-static int Universal_Security_Check(void)
+static int Universal_Security_Check(HowardWorkspace *w)
 {
-    if (nnodes<1)
+    int errorflag;
+    if (w->nnodes<1)
     {
-        if (verbosemode>0)
+        if (w->verbosemode>0)
         {
             printf("ERROR: nnodes must be a positive integer\n");
         }
         return(3);
     }
-    if (narcs<1)
+    if (w->narcs<1)
     {
-        if (verbosemode>0)
+        if (w->verbosemode>0)
         {
             printf("ERROR: narcs must be a positive integer\n");
         }
         return(4);
     }
-    if (verbosemode >-1)
+    errorflag=Reserve_Memory(w,w->nnodes);
+    if (errorflag !=0)
     {
-        return(Check_Rows());
+        return(errorflag);
+    }
+    if (w->verbosemode >-1)
+    {
+        return(Check_Rows(w));
     }
     else
     {
@@ -853,84 +973,70 @@ static int Universal_Security_Check(void)
     }
 }
 
-static int Security_Check(void)
+static int Security_Check(HowardWorkspace *w)
 {
     int errorflag;
-    errorflag=Universal_Security_Check();
-    if (verbosemode >0)
+    errorflag=Universal_Security_Check(w);
+    if (w->verbosemode >0)
     {
-        Display_Sparse_Matrix(narcs,ij,a);
+        Display_Sparse_Matrix(w->narcs,w->ij,w->a);
 
     }
     return(errorflag);
 }
 
-static int Semi_Security_Check(void)
+static int Semi_Security_Check(HowardWorkspace *w)
 {
     int errorflag;
-    errorflag=Universal_Security_Check();
-    if (verbosemode >0)
+    errorflag=Universal_Security_Check(w);
+    if (w->verbosemode >0)
     {
-        Display_Semi_Sparse_Matrix(narcs,ij,a,t);
+        Display_Semi_Sparse_Matrix(w->narcs,w->ij,w->a,w->t);
     }
     return(errorflag);
 }
 
-static void Import_Arguments(int *IJ, double *A,int NNODES, int NARCS, double *CHI, double *V, int *POLICY, int *NITERATIONS, int *NCOMPONENTS, int VERBOSEMODE)
-{
-    ij=IJ;
-    a=A;
-    nnodes=NNODES;
-    narcs=NARCS;
-    chi=CHI;
-    v=V;
-    pi=POLICY;
-    NIterations=NITERATIONS;
-    NComponents=NCOMPONENTS;
-    verbosemode=VERBOSEMODE;
-}
-
-static void Semi_Import_Arguments(int *IJ, double *A,double *T,int NNODES, int NARCS, double *CHI, double *V, int *POLICY, int *NITERATIONS, int *NCOMPONENTS, int VERBOSEMODE)
+static void Import_Arguments(HowardWorkspace *w, int *IJ, double *A, double *T, int NNODES, int NARCS, double *CHI, double *V, int *POLICY, int *NITERATIONS, int *NCOMPONENTS, int VERBOSEMODE)
 {
-    ij=IJ;
-    a=A;
-    t=T;
-    nnodes=NNODES;
-    narcs=NARCS;
-    chi=CHI;
-    v=V;
-    pi=POLICY;
-    NIterations=NITERATIONS;
-    NComponents=NCOMPONENTS;
-    verbosemode=VERBOSEMODE;
+    w->ij=IJ;
+    w->a=A;
+    w->t=T;
+    w->nnodes=NNODES;
+    w->narcs=NARCS;
+    w->chi=CHI;
+    w->v=V;
+    w->pi=POLICY;
+    w->NIterations=NITERATIONS;
+    w->NComponents=NCOMPONENTS;
+    w->verbosemode=VERBOSEMODE;
 }
 
-static void Update_Policy(void)
+static void Update_Policy(HowardWorkspace *w)
 {
     int i;
-    for (i=0;i<nnodes;i++)
+    for (i=0;i<w->nnodes;i++)
     {
-        pi[i]=newpi[i];
-        c[i]=newc[i];
-        vaux[i]=v[i]; /* We need a to keep a copy of the current value function */
+        w->pi[i]=w->newpi[i];
+        w->c[i]=w->newc[i];
+        w->vaux[i]=w->v[i]; /* We need a to keep a copy of the current value function */
     }
 }
 
-static void Semi_Update_Policy(void)
+static void Semi_Update_Policy(HowardWorkspace *w)
 {
     int i;
-    for (i=0;i<nnodes;i++)
+    for (i=0;i<w->nnodes;i++)
     {
-        pi[i]=newpi[i];
-        c[i]=newc[i];
-        tau[i]=newtau[i];
-        vaux[i]=v[i]; /* We need a to keep a copy of the current value function */
+        w->pi[i]=w->newpi[i];
+        w->c[i]=w->newc[i];
+        w->tau[i]=w->newtau[i];
+        w->vaux[i]=w->v[i]; /* We need a to keep a copy of the current value function */
     }
 }
 
-static int End_Message(void)
+static int End_Message(HowardWorkspace *w)
 {
-    if (*NIterations ==MAX_NIterations)
+    if (*w->NIterations ==MAX_NIterations)
     {
         printf("ERROR : maximal number of iterations (=%d) reached\n",MAX_NIterations);
         printf("This should not happen (usual number of iterations is <80,\n");
@@ -941,74 +1047,112 @@ static int End_Message(void)
         printf("Bug reports should be sent to Stephane.Gaubert@inria.fr\n");
         return(5);
     }
-    if (verbosemode >1)
+    if (w->verbosemode >1)
     {
         printf("END OF HOWARD: OK\n");
     }
     return(0);
 }
 
-int Howard(int *IJ, double *A,int NNODES,int NARCS,double *CHI,
-           double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,
-           int VERBOSEMODE)
+int Howard_With_Workspace(HowardWorkspace *WORKSPACE, int *IJ, double *A,
+                          int NNODES,int NARCS,double *CHI,double *V,
+                          int *POLICY,int *NITERATIONS,int *NCOMPONENTS,
+                          int VERBOSEMODE)
 {
     int improved=0;
+    int errortype;
+    HowardWorkspace *w=WORKSPACE;
     *NITERATIONS=0;
-    Import_Arguments(IJ,A,NNODES,NARCS,CHI,V,POLICY,NITERATIONS,NCOMPONENTS,VERBOSEMODE);
-    ERRORTYPE=Security_Check();
-    if (ERRORTYPE !=0)
+    Import_Arguments(w,IJ,A,NULL,NNODES,NARCS,CHI,V,POLICY,NITERATIONS,NCOMPONENTS,VERBOSEMODE);
+    errortype=Security_Check(w);
+    if (errortype !=0)
     {
-        return(ERRORTYPE);
+        return(errortype);
     }
-    Allocate_Memory();
-    Epsilon(a,narcs,&epsilon);
-    Initial_Policy();
-    New_Build_Inverse();
+    Epsilon(w);
+    if ((w->warmstart==0) || (Given_Policy(w)!=0))
+    {
+        Initial_Policy(w);
+    }
+    New_Build_Inverse(w);
     do
     {
-        Value();
-        Show_Info();
-        Improve(&improved);
-        Update_Policy();
-        New_Build_Inverse();
-        (*NIterations)++;
+        Value(w);
+        Show_Info(w);
+        Improve(w,&improved);
+        Update_Policy(w);
+        New_Build_Inverse(w);
+        (*NITERATIONS)++;
     }
-    while ((improved != 0) && *NIterations <MAX_NIterations);
-    Free_Memory();
-    ERRORTYPE=End_Message();
-    return(ERRORTYPE);
+    while ((improved != 0) && *NITERATIONS <MAX_NIterations);
+    return(End_Message(w));
 }
 
-int Semi_Howard(int *IJ, double *A,double *T,int NNODES,int NARCS,double *CHI,double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,int VERBOSEMODE)
+int Semi_Howard_With_Workspace(HowardWorkspace *WORKSPACE, int *IJ, double *A,
+                               double *T,int NNODES,int NARCS,double *CHI,
+                               double *V,int *POLICY,int *NITERATIONS,
+                               int *NCOMPONENTS,int VERBOSEMODE)
 {
     int improved=0;
+    int errortype;
+    HowardWorkspace *w=WORKSPACE;
     *NITERATIONS=0;
-    Semi_Import_Arguments(IJ,A,T,NNODES,NARCS,CHI,V,POLICY,NITERATIONS,NCOMPONENTS,VERBOSEMODE);
-    ERRORTYPE=Semi_Security_Check();
-    if(ERRORTYPE !=0)
+    Import_Arguments(w,IJ,A,T,NNODES,NARCS,CHI,V,POLICY,NITERATIONS,NCOMPONENTS,VERBOSEMODE);
+    errortype=Semi_Security_Check(w);
+    if(errortype !=0)
+    {
+        return(errortype);
+    }
+    Epsilon(w);
+    if ((w->warmstart==0) || (Given_Policy(w)!=0))
     {
-        return(ERRORTYPE);
+        Semi_Initial_Policy(w);
     }
-    Semi_Allocate_Memory();
-    Epsilon(a,narcs,&epsilon);
-    Semi_Initial_Policy();
-    New_Build_Inverse();
+    New_Build_Inverse(w);
     do
     {
-        if(Semi_Value()!=0)
+        if(Semi_Value(w)!=0)
         {
             return(2);
         }
-        Semi_Show_Info();
-        Semi_Improve(&improved);
-        Semi_Update_Policy();
-        New_Build_Inverse();
-        (*NIterations)++;
-    }
-    while ((improved != 0) && *NIterations <MAX_NIterations);
-    Semi_Free_Memory();
-    ERRORTYPE=End_Message();
-    return(ERRORTYPE);
+        Semi_Show_Info(w);
+        Semi_Improve(w,&improved);
+        Semi_Update_Policy(w);
+        New_Build_Inverse(w);
+        (*NITERATIONS)++;
+    }
+    while ((improved != 0) && *NITERATIONS <MAX_NIterations);
+    return(End_Message(w));
+}
+
+int Howard(int *IJ, double *A,int NNODES,int NARCS,double *CHI,
+           double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,
+           int VERBOSEMODE)
+{
+    int errortype;
+    HowardWorkspace *w=Howard_New_Workspace();
+    if (w==NULL)
+    {
+        return(6);
+    }
+    errortype=Howard_With_Workspace(w,IJ,A,NNODES,NARCS,CHI,V,POLICY,
+                                    NITERATIONS,NCOMPONENTS,VERBOSEMODE);
+    Howard_Free_Workspace(w);
+    return(errortype);
+}
+
+int Semi_Howard(int *IJ, double *A,double *T,int NNODES,int NARCS,double *CHI,double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,int VERBOSEMODE)
+{
+    int errortype;
+    HowardWorkspace *w=Howard_New_Workspace();
+    if (w==NULL)
+    {
+        return(6);
+    }
+    errortype=Semi_Howard_With_Workspace(w,IJ,A,T,NNODES,NARCS,CHI,V,POLICY,
+                                         NITERATIONS,NCOMPONENTS,VERBOSEMODE);
+    Howard_Free_Workspace(w);
+    return(errortype);
 }
 
 #if !defined(_WIN32)
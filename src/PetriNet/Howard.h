@@ -72,6 +72,42 @@ int Howard(int *IJ, double *A,int NNODES,int NARCS,double *CHI,double *V,int *PO
 */
 int Semi_Howard(int *IJ, double *A,double *T,int NNODES,int NARCS,double *CHI,double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,int VERBOSEMODE);
 
+/*  Reentrant versions of Howard and Semi_Howard.
+
+    All the working memory of the algorithm is stored inside a workspace
+    given as first argument. A workspace can be reused across calls: its
+    memory is only reallocated when a graph with more nodes is given, so
+    repeated calls (parameter sweeps) do not pay allocations. A workspace
+    shall not be used by two threads at the same time, but distinct
+    workspaces can be used concurrently.
+
+    Howard and Semi_Howard are wrappers creating a temporary workspace.
+
+    Return values are identical to Howard and Semi_Howard, plus the value 6
+    when the memory of the workspace cannot be allocated.
+*/
+typedef struct HowardWorkspace HowardWorkspace;
+
+/*  Return a new empty workspace (or NULL if out of memory). Shall be
+    released by Howard_Free_Workspace. */
+HowardWorkspace* Howard_New_Workspace(void);
+
+/*  Release the memory of a workspace. NULL is accepted. */
+void Howard_Free_Workspace(HowardWorkspace *WORKSPACE);
+
+/*  Enable (ENABLE != 0) or disable the warm start of the workspace (disabled
+    by default). When enabled, the content of the POLICY array given to
+    Howard_With_Workspace or Semi_Howard_With_Workspace is used as initial
+    policy instead of the greedy rule: POLICY[i] shall be a successor of the
+    node i. Giving the optimal policy of a similar graph (for example the
+    previous graph of a parameter sweep) reduces the number of iterations.
+    If the given policy is not admissible, the greedy rule is used. */
+void Howard_Warm_Start(HowardWorkspace *WORKSPACE, int ENABLE);
+
+int Howard_With_Workspace(HowardWorkspace *WORKSPACE, int *IJ, double *A,int NNODES,int NARCS,double *CHI,double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,int VERBOSEMODE);
+
+int Semi_Howard_With_Workspace(HowardWorkspace *WORKSPACE, int *IJ, double *A,double *T,int NNODES,int NARCS,double *CHI,double *V,int *POLICY,int *NITERATIONS,int *NCOMPONENTS,int VERBOSEMODE);
+
 #  ifdef __cplusplus
 } // extern C
 #  endif
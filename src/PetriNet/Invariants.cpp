@@ -0,0 +1,362 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/Invariants.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace tpne {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//! \brief Non-null element of a sparse row.
+//------------------------------------------------------------------------------
+struct Term
+{
+    size_t index;
+    int64_t value;
+};
+
+//------------------------------------------------------------------------------
+//! \brief Row of the Farkas algorithm: the part of y.C not yet eliminated and
+//! the combination y of the rows of C (its support is the support of the
+//! future semiflow).
+//------------------------------------------------------------------------------
+struct Row
+{
+    //! \brief Non-null elements of y.C on the columns not yet eliminated.
+    std::vector<Term> columns;
+    //! \brief Non-null elements of y.
+    std::vector<Term> support;
+    //! \brief Bit (index % 64) set for each element of the support: quick
+    //! rejection of the inclusion tests.
+    uint64_t signature;
+};
+
+//------------------------------------------------------------------------------
+//! \brief Return the value of the column j of the row (0 if not stored).
+//------------------------------------------------------------------------------
+static int64_t valueAt(Row const& row, size_t const j)
+{
+    auto it = std::lower_bound(row.columns.begin(), row.columns.end(), j,
+        [](Term const& t, size_t const index) { return t.index < index; });
+    return ((it != row.columns.end()) && (it->index == j)) ? it->value : 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief r = fa * a + fb * b for sorted sparse vectors. Null elements are
+//! not stored. \return false on integer overflow.
+//------------------------------------------------------------------------------
+static bool combine(std::vector<Term> const& a, int64_t const fa,
+                    std::vector<Term> const& b, int64_t const fb,
+                    std::vector<Term>& r)
+{
+    r.clear();
+    r.reserve(a.size() + b.size());
+    size_t i = 0u, k = 0u;
+    while ((i < a.size()) || (k < b.size()))
+    {
+        size_t index;
+        int64_t x = 0, y = 0;
+        if ((k == b.size()) || ((i < a.size()) && (a[i].index < b[k].index)))
+        {
+            index = a[i].index;
+            x = a[i++].value;
+        }
+        else if ((i == a.size()) || (b[k].index < a[i].index))
+        {
+            index = b[k].index;
+            y = b[k++].value;
+        }
+        else
+        {
+            index = a[i].index;
+            x = a[i++].value;
+            y = b[k++].value;
+        }
+
+        int64_t value;
+        if (__builtin_mul_overflow(x, fa, &x) || __builtin_mul_overflow(y, fb, &y) ||
+            __builtin_add_overflow(x, y, &value))
+            return false;
+        if (value != 0)
+            r.push_back(Term{index, value});
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Divide the row by the greatest common divisor of its support.
+//------------------------------------------------------------------------------
+static void normalize(Row& row)
+{
+    int64_t g = 0;
+    for (auto const& t: row.support)
+        g = std::gcd(g, t.value);
+    if (g <= 1)
+        return;
+    for (auto& t: row.support)
+        t.value /= g;
+    for (auto& t: row.columns)
+        t.value /= g;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+SparseMatrix<int64_t> incidenceMatrix(CompiledNet const& net)
+{
+    SparseMatrixBuilder<int64_t> builder(net.countPlaces(), net.countTransitions());
+    for (size_t t = 0u; t < net.countTransitions(); ++t)
+    {
+        for (size_t k = net.preBegin(t); k < net.preEnd(t); ++k)
+            builder.add(net.prePlace(k), t, -int64_t(net.preWeight(k)));
+        for (size_t k = net.postBegin(t); k < net.postEnd(t); ++k)
+            builder.add(net.postPlace(k), t, int64_t(net.postWeight(k)));
+    }
+    return builder.build();
+}
+
+//------------------------------------------------------------------------------
+SemiflowsResult findSemiflows(SparseMatrix<int64_t> const& C, size_t const max_rows)
+{
+    SemiflowsResult result;
+    size_t const n = C.nbRows();
+    size_t const m = C.nbColumns();
+
+    // Initial rows [C | I].
+    std::vector<Row> rows(n);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        for (size_t k = C.rowBegin(i); k < C.rowEnd(i); ++k)
+            rows[i].columns.push_back(Term{C.column(k), C.value(k)});
+        rows[i].support.push_back(Term{i, 1});
+        rows[i].signature = uint64_t(1) << (i % 64u);
+    }
+
+    std::vector<size_t> positives(m), negatives(m);
+    std::vector<size_t> marks(n, 0u); // Stamp of the unions of supports
+    size_t stamp = 0u;
+    std::vector<size_t> bucket_offsets; // Rows sorted by smallest support index
+    std::vector<size_t> buckets;
+    std::vector<size_t> zeros, pos, neg;
+    std::vector<Row> next;
+    Row row;
+
+    while (true)
+    {
+        // Choose the column creating the fewest rows. Columns with a single
+        // sign only remove rows.
+        std::fill(positives.begin(), positives.end(), 0u);
+        std::fill(negatives.begin(), negatives.end(), 0u);
+        for (auto const& r: rows)
+        {
+            for (auto const& t: r.columns)
+                ++(t.value > 0 ? positives[t.index] : negatives[t.index]);
+        }
+        size_t column = m;
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t j = 0u; j < m; ++j)
+        {
+            double const p = double(positives[j]), q = double(negatives[j]);
+            if ((p + q > 0.0) && (p * q - p - q < best))
+            {
+                best = p * q - p - q;
+                column = j;
+            }
+        }
+        if (column == m)
+            break; // All columns have been eliminated
+
+        zeros.clear(); pos.clear(); neg.clear();
+        for (size_t i = 0u; i < rows.size(); ++i)
+        {
+            int64_t const v = valueAt(rows[i], column);
+            (v == 0 ? zeros : (v > 0 ? pos : neg)).push_back(i);
+        }
+
+        // Index the rows by the smallest element of their support: a row
+        // included in a union of supports has its smallest element in it.
+        bucket_offsets.assign(n + 1u, 0u);
+        for (auto const& r: rows)
+            ++bucket_offsets[r.support[0].index + 1u];
+        std::partial_sum(bucket_offsets.begin(), bucket_offsets.end(), bucket_offsets.begin());
+        buckets.resize(rows.size());
+        {
+            std::vector<size_t> fill(bucket_offsets.begin(), bucket_offsets.end() - 1);
+            for (size_t i = 0u; i < rows.size(); ++i)
+                buckets[fill[rows[i].support[0].index]++] = i;
+        }
+
+        next.clear();
+        for (size_t const a: pos)
+        {
+            for (size_t const b: neg)
+            {
+                Row const& ra = rows[a];
+                Row const& rb = rows[b];
+                uint64_t const signature = ra.signature | rb.signature;
+
+                // Mark the union of both supports.
+                ++stamp;
+                size_t count = 0u;
+                for (auto const& t: ra.support)
+                {
+                    marks[t.index] = stamp;
+                    ++count;
+                }
+                for (auto const& t: rb.support)
+                {
+                    count += (marks[t.index] != stamp);
+                    marks[t.index] = stamp;
+                }
+
+                // Adjacency test: skip the pair if another row is included in
+                // the union (the combination would not be minimal).
+                bool adjacent = true;
+                auto check = [&](std::vector<Term> const& support)
+                {
+                    for (size_t e = 0u; (e < support.size()) && adjacent; ++e)
+                    {
+                        size_t const u = support[e].index;
+                        for (size_t k = bucket_offsets[u]; k < bucket_offsets[u + 1u]; ++k)
+                        {
+                            size_t const c = buckets[k];
+                            Row const& rc = rows[c];
+                            if ((c == a) || (c == b) || (rc.support.size() > count) ||
+                                ((rc.signature & ~signature) != 0u))
+                                continue;
+                            if (std::all_of(rc.support.begin(), rc.support.end(),
+                                    [&](Term const& t) { return marks[t.index] == stamp; }))
+                            {
+                                adjacent = false;
+                                break;
+                            }
+                        }
+                    }
+                };
+                check(ra.support);
+                check(rb.support);
+                if (!adjacent)
+                    continue;
+
+                // Combine both rows to eliminate the column.
+                int64_t const va = valueAt(ra, column);
+                int64_t const vb = -valueAt(rb, column);
+                int64_t const g = std::gcd(va, vb);
+                if (!combine(ra.columns, vb / g, rb.columns, va / g, row.columns) ||
+                    !combine(ra.support, vb / g, rb.support, va / g, row.support))
+                {
+                    result.message = "Integer overflow while combining the rows "
+                                     "of the Farkas algorithm";
+                    return result;
+                }
+                row.signature = signature;
+                normalize(row);
+                next.push_back(std::move(row));
+
+                if (zeros.size() + next.size() > max_rows)
+                {
+                    result.message = "The number of rows of the Farkas algorithm "
+                                     "exceeds the limit of " + std::to_string(max_rows);
+                    return result;
+                }
+            }
+        }
+
+        // Keep the rows already null on the column and the combinations.
+        for (size_t const i: zeros)
+            next.push_back(std::move(rows[i]));
+        rows.swap(next);
+    }
+
+    // Remaining rows are the minimal semiflows.
+    result.semiflows.resize(rows.size());
+    for (size_t i = 0u; i < rows.size(); ++i)
+    {
+        Semiflow& s = result.semiflows[i];
+        s.indices.reserve(rows[i].support.size());
+        s.weights.reserve(rows[i].support.size());
+        for (auto const& t: rows[i].support)
+        {
+            s.indices.push_back(t.index);
+            s.weights.push_back(t.value);
+        }
+    }
+    std::sort(result.semiflows.begin(), result.semiflows.end(),
+              [](Semiflow const& x, Semiflow const& y) { return x.indices < y.indices; });
+    result.success = true;
+    return result;
+}
+
+//------------------------------------------------------------------------------
+SemiflowsResult findPSemiflows(CompiledNet const& net, size_t const max_rows)
+{
+    return findSemiflows(incidenceMatrix(net), max_rows);
+}
+
+//------------------------------------------------------------------------------
+SemiflowsResult findTSemiflows(CompiledNet const& net, size_t const max_rows)
+{
+    SparseMatrixBuilder<int64_t> builder(net.countTransitions(), net.countPlaces());
+    for (size_t t = 0u; t < net.countTransitions(); ++t)
+    {
+        for (size_t k = net.preBegin(t); k < net.preEnd(t); ++k)
+            builder.add(t, net.prePlace(k), -int64_t(net.preWeight(k)));
+        for (size_t k = net.postBegin(t); k < net.postEnd(t); ++k)
+            builder.add(t, net.postPlace(k), int64_t(net.postWeight(k)));
+    }
+    return findSemiflows(builder.build(), max_rows);
+}
+
+//------------------------------------------------------------------------------
+std::vector<size_t> structuralBounds(CompiledNet const& net,
+    std::vector<Semiflow> const& psemiflows)
+{
+    std::vector<size_t> bounds(net.countPlaces(), std::numeric_limits<size_t>::max());
+    CompiledNet::Marking const& marking = net.initialMarking();
+    for (auto const& s: psemiflows)
+    {
+        // Weighted sum of tokens: constant for all reachable markings. An
+        // overflowing sum gives no bound.
+        size_t sum = 0u;
+        bool overflow = false;
+        for (size_t i = 0u; (i < s.indices.size()) && !overflow; ++i)
+        {
+            size_t tokens;
+            overflow = __builtin_mul_overflow(size_t(s.weights[i]), marking[s.indices[i]], &tokens) ||
+                       __builtin_add_overflow(sum, tokens, &sum);
+        }
+        if (overflow)
+            continue;
+
+        for (size_t i = 0u; i < s.indices.size(); ++i)
+        {
+            size_t& bound = bounds[s.indices[i]];
+            bound = std::min(bound, sum / size_t(s.weights[i]));
+        }
+    }
+    return bounds;
+}
+
+} // namespace tpne
@@ -0,0 +1,128 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef INVARIANTS_HPP
+#  define INVARIANTS_HPP
+
+#  include "PetriNet/CompiledNet.hpp"
+#  include "PetriNet/SparseMatrix.hpp"
+
+#  include <cstdint>
+#  include <string>
+#  include <vector>
+
+namespace tpne {
+
+//--------------------------------------------------------------------------
+//! \brief Semiflow: non-negative integer vector y such as y.C = 0 (P-semiflow
+//! where C is the incidence matrix) or C.x = 0 (T-semiflow). Stored sparse:
+//! only the non-null weights are given, sorted by increasing index. Weights
+//! have no common divisor.
+//--------------------------------------------------------------------------
+struct Semiflow
+{
+    //! \brief Place indices (P-semiflows) or transition indices (T-semiflows)
+    //! of the support, as given by CompiledNet.
+    std::vector<size_t> indices;
+    //! \brief Positive weight of each element of the support.
+    std::vector<int64_t> weights;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Returned by findSemiflows(), findPSemiflows() and findTSemiflows().
+//--------------------------------------------------------------------------
+struct SemiflowsResult
+{
+    //! \brief False if the computation has been aborted (too many
+    //! intermediate rows or integer overflow). In case of failure semiflows
+    //! are cleared.
+    bool success = false;
+    //! \brief In case of failure, holds the reason of the failure.
+    std::string message;
+    //! \brief Minimal semiflows sorted by their support. Each minimal support
+    //! is given once.
+    std::vector<Semiflow> semiflows;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Default maximum number of rows of the Farkas algorithm.
+//--------------------------------------------------------------------------
+constexpr size_t MAX_SEMIFLOW_ROWS = 100000u;
+
+//--------------------------------------------------------------------------
+//! \brief Return the incidence matrix C = Post - Pre of the net: one row per
+//! place index, one column per transition index. C(p, t) is the number of
+//! tokens added to the place p when firing the transition t.
+//--------------------------------------------------------------------------
+SparseMatrix<int64_t> incidenceMatrix(CompiledNet const& net);
+
+//--------------------------------------------------------------------------
+//! \brief Compute the minimal semiflows of the matrix: non-negative integer
+//! vectors y with minimal support such as y.C = 0. Every non-negative solution
+//! is a non-negative combination of them.
+//!
+//! The Farkas algorithm (Fourier-Motzkin elimination) works on rows [C | I]:
+//! columns of C are eliminated one by one by combining the pairs of rows of
+//! opposite signs. Pruning heuristics keep the number of rows low:
+//!   - the next column to eliminate is the one creating the fewest rows
+//!     (pos * neg - pos - neg);
+//!   - a pair of rows is combined only when no other row has its support
+//!     included in the union of their supports (adjacency test of the double
+//!     description method): the non-minimal rows are never created. Rows are
+//!     indexed by the smallest element of their support so the test only
+//!     visits the rows which could be included.
+//!
+//! \param[in] C the matrix. Use the transpose of the incidence matrix for
+//!   T-semiflows.
+//! \param[in] max_rows abort when the number of rows exceeds this limit
+//!   (the number of minimal semiflows can be exponential).
+//--------------------------------------------------------------------------
+SemiflowsResult findSemiflows(SparseMatrix<int64_t> const& C,
+    size_t const max_rows = MAX_SEMIFLOW_ROWS);
+
+//--------------------------------------------------------------------------
+//! \brief Compute the minimal P-semiflows (place invariants) of the net:
+//! for each of them the weighted sum of tokens y.M is the same for all
+//! reachable markings M.
+//--------------------------------------------------------------------------
+SemiflowsResult findPSemiflows(CompiledNet const& net,
+    size_t const max_rows = MAX_SEMIFLOW_ROWS);
+
+//--------------------------------------------------------------------------
+//! \brief Compute the minimal T-semiflows (transition invariants) of the net:
+//! firing each transition as many times as its weight gives back the same
+//! marking.
+//--------------------------------------------------------------------------
+SemiflowsResult findTSemiflows(CompiledNet const& net,
+    size_t const max_rows = MAX_SEMIFLOW_ROWS);
+
+//--------------------------------------------------------------------------
+//! \brief Return the bound of each place index given by the P-semiflows and
+//! the initial marking of the net: min over the semiflows y covering p of
+//! floor(y.M0 / y(p)). Places not covered by any semiflow get SIZE_MAX. When
+//! no place gets SIZE_MAX, the net is structurally bounded.
+//! \note Net::Settings::maxTokens is not taken into account.
+//--------------------------------------------------------------------------
+std::vector<size_t> structuralBounds(CompiledNet const& net,
+    std::vector<Semiflow> const& psemiflows);
+
+} // namespace tpne
+
+#endif
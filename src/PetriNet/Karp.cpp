@@ -0,0 +1,266 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/Karp.hpp"
+#include "PetriNet/StronglyConnectedComponents.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace tpne {
+
+static double const EPSILON = -std::numeric_limits<double>::infinity();
+
+// *****************************************************************************
+//! \brief Strongly connected component with arcs holding 0 or 1 token, arcs
+//! being stored as incoming arcs of their destination (CSR format).
+// *****************************************************************************
+struct KarpGraph
+{
+    //! \brief Number of nodes (including nodes added by splitting arcs).
+    size_t nnodes = 0u;
+    //! \brief Incoming arcs of node v are [offsets[v], offsets[v + 1][.
+    std::vector<size_t> offsets;
+    std::vector<size_t> sources;
+    std::vector<double> weights;
+    std::vector<bool> tokens;
+    //! \brief Topological order of the subgraph of arcs without tokens.
+    std::vector<size_t> order;
+};
+
+//------------------------------------------------------------------------------
+//! \brief Compute the maximal weights D_k(v) of walks from the node 0 to v
+//! holding exactly k tokens, knowing D_(k-1).
+//------------------------------------------------------------------------------
+static void nextLevel(KarpGraph const& g, std::vector<double> const& previous,
+                      std::vector<double>& current)
+{
+    for (size_t v: g.order)
+    {
+        double best = EPSILON;
+        for (size_t a = g.offsets[v]; a < g.offsets[v + 1u]; ++a)
+        {
+            // Arcs without tokens: sources have been computed before since
+            // nodes are processed in topological order.
+            double const d = g.tokens[a] ? previous[g.sources[a]] : current[g.sources[a]];
+            if (d != EPSILON)
+                best = std::max(best, d + g.weights[a]);
+        }
+        current[v] = best;
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Maximum cycle mean (by token) of a strongly connected component:
+//! max_v min_k (D_n(v) - D_k(v)) / (n - k).
+//------------------------------------------------------------------------------
+static double maximumCycleMean(KarpGraph const& g)
+{
+    size_t const n = g.nnodes;
+    std::vector<double> previous(n), current(n);
+
+    // First pass: D_n.
+    auto start = [&]()
+    {
+        std::fill(previous.begin(), previous.end(), EPSILON);
+        std::fill(current.begin(), current.end(), EPSILON);
+        current[0] = 0.0;
+        // D_0: walks without tokens.
+        for (size_t v: g.order)
+        {
+            for (size_t a = g.offsets[v]; a < g.offsets[v + 1u]; ++a)
+            {
+                if (!g.tokens[a] && (current[g.sources[a]] != EPSILON))
+                    current[v] = std::max(current[v], current[g.sources[a]] + g.weights[a]);
+            }
+        }
+    };
+
+    start();
+    for (size_t k = 1u; k <= n; ++k)
+    {
+        previous.swap(current);
+        nextLevel(g, previous, current);
+    }
+    std::vector<double> const Dn(current);
+
+    // Second pass: D_k for k < n.
+    std::vector<double> ratio(n, std::numeric_limits<double>::infinity());
+    start();
+    for (size_t k = 0u; k < n; ++k)
+    {
+        if (k > 0u)
+        {
+            previous.swap(current);
+            nextLevel(g, previous, current);
+        }
+        for (size_t v = 0u; v < n; ++v)
+        {
+            if ((Dn[v] != EPSILON) && (current[v] != EPSILON))
+                ratio[v] = std::min(ratio[v], (Dn[v] - current[v]) / double(n - k));
+        }
+    }
+
+    double lambda = EPSILON;
+    for (size_t v = 0u; v < n; ++v)
+    {
+        if (Dn[v] != EPSILON)
+            lambda = std::max(lambda, ratio[v]);
+    }
+    return lambda;
+}
+
+//------------------------------------------------------------------------------
+int Karp(std::vector<int> const& IJ, std::vector<double> const& T,
+         std::vector<double> const& N, size_t const nnodes,
+         std::vector<double>& chi, size_t& ncomponents)
+{
+    size_t const narcs = T.size();
+    ncomponents = 0u;
+    chi.assign(nnodes, EPSILON);
+
+    for (double const n: N)
+    {
+        if ((n < 0.0) || (n != std::floor(n)))
+            return 3;
+    }
+
+    StronglyConnectedComponents const scc = findStronglyConnectedComponents(nnodes, IJ);
+
+    // Nodes and internal arcs of each component.
+    std::vector<std::vector<size_t>> nodes(scc.count);
+    std::vector<std::vector<size_t>> arcs(scc.count);
+    std::vector<size_t> local(nnodes);
+    for (size_t u = 0u; u < nnodes; ++u)
+    {
+        local[u] = nodes[scc.component[u]].size();
+        nodes[scc.component[u]].push_back(u);
+    }
+    for (size_t a = 0u; a < narcs; ++a)
+    {
+        size_t const c = scc.component[size_t(IJ[2u * a])];
+        if (c == scc.component[size_t(IJ[2u * a + 1u])])
+            arcs[c].push_back(a);
+    }
+
+    std::vector<double> lambda(scc.count, EPSILON);
+    KarpGraph g;
+    for (size_t c = 0u; c < scc.count; ++c)
+    {
+        if (arcs[c].empty())
+            continue;
+
+        // Split arcs with several tokens: (from, to, weight, token).
+        struct Edge { size_t from; size_t to; double weight; bool token; };
+        std::vector<Edge> edges;
+        g.nnodes = nodes[c].size();
+        for (size_t a: arcs[c])
+        {
+            size_t from = local[size_t(IJ[2u * a])];
+            size_t const to = local[size_t(IJ[2u * a + 1u])];
+            double weight = T[a];
+            for (size_t k = size_t(N[a]); k > 1u; --k)
+            {
+                edges.push_back({ from, g.nnodes, weight, true });
+                from = g.nnodes++;
+                weight = 0.0;
+            }
+            edges.push_back({ from, to, weight, N[a] != 0.0 });
+        }
+
+        // Incoming arcs in CSR format.
+        g.offsets.assign(g.nnodes + 1u, 0u);
+        for (auto const& e: edges)
+            ++g.offsets[e.to + 1u];
+        for (size_t v = 0u; v < g.nnodes; ++v)
+            g.offsets[v + 1u] += g.offsets[v];
+        g.sources.resize(edges.size());
+        g.weights.resize(edges.size());
+        g.tokens.resize(edges.size());
+        std::vector<size_t> next(g.offsets.begin(), g.offsets.end() - 1);
+        for (auto const& e: edges)
+        {
+            size_t const i = next[e.to]++;
+            g.sources[i] = e.from;
+            g.weights[i] = e.weight;
+            g.tokens[i] = e.token;
+        }
+
+        // Kahn's algorithm on arcs without tokens.
+        std::vector<size_t> degree(g.nnodes, 0u);
+        std::vector<std::vector<size_t>> successors(g.nnodes);
+        for (auto const& e: edges)
+        {
+            if (!e.token)
+            {
+                ++degree[e.to];
+                successors[e.from].push_back(e.to);
+            }
+        }
+        g.order.clear();
+        for (size_t v = 0u; v < g.nnodes; ++v)
+        {
+            if (degree[v] == 0u)
+                g.order.push_back(v);
+        }
+        for (size_t i = 0u; i < g.order.size(); ++i)
+        {
+            for (size_t v: successors[g.order[i]])
+            {
+                if (--degree[v] == 0u)
+                    g.order.push_back(v);
+            }
+        }
+        if (g.order.size() != g.nnodes)
+            return 1;
+
+        lambda[c] = maximumCycleMean(g);
+    }
+
+    // Components are numbered in reverse topological order: the cycle time of
+    // successor components is known before the one of their predecessors.
+    std::vector<double> cycle_time(lambda);
+    for (size_t a = 0u; a < narcs; ++a)
+    {
+        size_t const from = scc.component[size_t(IJ[2u * a])];
+        size_t const to = scc.component[size_t(IJ[2u * a + 1u])];
+        if (from != to)
+            arcs[from].push_back(a);
+    }
+    for (size_t c = 0u; c < scc.count; ++c)
+    {
+        for (size_t a: arcs[c])
+        {
+            size_t const to = scc.component[size_t(IJ[2u * a + 1u])];
+            cycle_time[c] = std::max(cycle_time[c], cycle_time[to]);
+        }
+        if (cycle_time[c] == EPSILON)
+            return 2;
+        if (lambda[c] == cycle_time[c])
+            ++ncomponents;
+        for (size_t u: nodes[c])
+            chi[u] = cycle_time[c];
+    }
+
+    return 0;
+}
+
+} // namespace tpne
@@ -0,0 +1,59 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef KARP_HPP
+#  define KARP_HPP
+
+#  include <cstddef>
+#  include <vector>
+
+namespace tpne {
+
+//--------------------------------------------------------------------------
+//! \brief Compute the cycle time of each node of a graph with the Karp
+//! algorithm. This is an alternative to Semi_Howard() taking the same graph:
+//! the cycle time of a node is the maximum ratio sum(T) / sum(N) of circuits
+//! reachable from this node.
+//!
+//! Karp is generalized to integer delays: arcs with several tokens are split
+//! into chains of arcs with one token and arcs without tokens are processed
+//! in topological order. Each strongly connected component is solved
+//! independently: for a component of n nodes (after splitting) and m arcs the
+//! complexity is O(n.m) in time and O(n + m) in memory (walk weights are
+//! computed twice instead of being stored).
+//!
+//! \param[in] IJ arcs {(source node, destination node), ... }.
+//! \param[in] T timings of arcs (durations of places).
+//! \param[in] N delays of arcs (tokens of places): non-negative integers.
+//! \param[in] nnodes number of nodes.
+//! \param[out] chi cycle time of each node.
+//! \param[out] ncomponents number of strongly connected components holding
+//!   a circuit which is critical for their nodes.
+//! \return 0 in case of success, 1 if a circuit has no tokens (infinite cycle
+//!   time), 2 if a node does not reach any circuit, 3 if a delay is not a
+//!   non-negative integer.
+//--------------------------------------------------------------------------
+int Karp(std::vector<int> const& IJ, std::vector<double> const& T,
+         std::vector<double> const& N, size_t const nnodes,
+         std::vector<double>& chi, size_t& ncomponents);
+
+} // namespace tpne
+
+#endif
@@ -0,0 +1,216 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/MonteCarlo.hpp"
+#include "PetriNet/BatchSimulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace tpne {
+namespace {
+
+// *****************************************************************************
+//! \brief Accumulate values of a random variable. Values are integers (number
+//! of firings or tokens): stored as double, their sums are exact and therefore
+//! do not depend on the order replications are accumulated.
+// *****************************************************************************
+struct Accumulator
+{
+    void add(double const value)
+    {
+        sum += value;
+        sum_squares += value * value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(Accumulator const& other)
+    {
+        sum += other.sum;
+        sum_squares += other.sum_squares;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    //! \brief Return statistics of the accumulated values divided by scale.
+    MonteCarlo::Statistic statistic(size_t const count, double const scale) const
+    {
+        MonteCarlo::Statistic stat;
+        if (count == 0u)
+            return stat;
+
+        double const n = double(count);
+        stat.mean = sum / n / scale;
+        if (count > 1u)
+        {
+            double const variance = (sum_squares - sum * sum / n) / (n - 1.0);
+            stat.stddev = std::sqrt(std::max(0.0, variance)) / scale;
+        }
+        stat.min = min / scale;
+        stat.max = max / scale;
+        return stat;
+    }
+
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+// *****************************************************************************
+//! \brief Accumulators of a worker thread.
+// *****************************************************************************
+struct Accumulators
+{
+    Accumulators(size_t const places, size_t const transitions)
+        : firing_counts(transitions), markings(places)
+    {}
+
+    void merge(Accumulators const& other)
+    {
+        for (size_t t = 0u; t < firing_counts.size(); ++t)
+            firing_counts[t].merge(other.firing_counts[t]);
+        for (size_t p = 0u; p < markings.size(); ++p)
+            markings[p].merge(other.markings[p]);
+        firings.merge(other.firings);
+        replications += other.replications;
+        deadlocks += other.deadlocks;
+    }
+
+    std::vector<Accumulator> firing_counts;
+    std::vector<Accumulator> markings;
+    Accumulator firings;
+    size_t replications = 0u;
+    size_t deadlocks = 0u;
+};
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+MonteCarlo::MonteCarlo(CompiledNet const& net)
+    : m_net(net)
+{}
+
+//------------------------------------------------------------------------------
+uint32_t MonteCarlo::seedOf(uint32_t const seed, size_t const replication)
+{
+    // Mix the seed and the replication number to avoid correlated generators.
+    std::seed_seq sequence{ seed, uint32_t(replication), uint32_t(uint64_t(replication) >> 32) };
+    uint32_t result;
+    sequence.generate(&result, &result + 1);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+MonteCarlo::Result MonteCarlo::run(Options const& options, Initializer const& initializer) const
+{
+    size_t const P = m_net.countPlaces();
+    size_t const T = m_net.countTransitions();
+
+    size_t threads = options.threads;
+    if (threads == 0u)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(size_t(1u), std::min(threads, options.replications));
+
+    Accumulators total(P, T);
+    std::atomic<size_t> next{0u};
+    std::atomic<bool> cancelled{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+
+    // Each worker picks the next replication to run and accumulates its
+    // results locally. Accumulators are merged at the end of the worker.
+    auto worker = [&]()
+    {
+        Accumulators local(P, T);
+        BatchSimulation simulation(m_net);
+        Marking marking;
+
+        try
+        {
+            size_t r;
+            while (!cancelled && ((r = next++) < options.replications))
+            {
+                marking = m_net.initialMarking();
+                if (initializer)
+                    initializer(r, marking);
+
+                simulation.seed(seedOf(options.seed, r));
+                simulation.reset(marking);
+                simulation.runUntil(options.duration);
+
+                for (size_t t = 0u; t < T; ++t)
+                    local.firing_counts[t].add(double(simulation.firingCounts()[t]));
+                for (size_t p = 0u; p < P; ++p)
+                    local.markings[p].add(double(simulation.marking()[p]));
+                local.firings.add(double(simulation.firings()));
+                local.replications += 1u;
+                if (simulation.isDead())
+                    local.deadlocks += 1u;
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            cancelled = true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        total.merge(local);
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1u);
+    for (size_t i = 1u; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread: pool)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    // Throughputs are firings per unit of time.
+    double const duration = (options.duration > 0.0) ? options.duration : 1.0;
+
+    Result result;
+    result.replications = total.replications;
+    result.duration = options.duration;
+    result.deadlocks = total.deadlocks;
+    result.throughputs.resize(T);
+    for (size_t t = 0u; t < T; ++t)
+        result.throughputs[t] = total.firing_counts[t].statistic(total.replications, duration);
+    result.markings.resize(P);
+    for (size_t p = 0u; p < P; ++p)
+        result.markings[p] = total.markings[p].statistic(total.replications, 1.0);
+    result.firings = total.firings.statistic(total.replications, 1.0);
+    return result;
+}
+
+} // namespace tpne
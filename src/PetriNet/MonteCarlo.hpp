@@ -0,0 +1,139 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef MONTE_CARLO_HPP
+#  define MONTE_CARLO_HPP
+
+#  include "PetriNet/CompiledNet.hpp"
+
+#  include <cstdint>
+#  include <functional>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Run many independent replications of a BatchSimulation in parallel
+//! and aggregate their results into statistics.
+//!
+//! Each replication owns its random generator, seeded from the replication
+//! number, and its own copy of the marking. Replications are dispatched to a
+//! pool of worker threads sharing the same read-only CompiledNet. Results do
+//! not depend on the number of threads: a given seed always gives the same
+//! statistics.
+//!
+//! \note Net::Settings shall not be modified while running.
+// *****************************************************************************
+class MonteCarlo
+{
+public:
+
+    using Marking = CompiledNet::Marking;
+
+    // *************************************************************************
+    //! \brief Parameters of the replications.
+    // *************************************************************************
+    struct Options
+    {
+        //! \brief Number of independent replications.
+        size_t replications = 1000u;
+        //! \brief Simulated duration of each replication.
+        double duration = 100.0;
+        //! \brief Seed from which the seed of each replication is derived
+        //! (see seedOf()).
+        uint32_t seed = 0u;
+        //! \brief Number of worker threads. 0 for using all cores.
+        size_t threads = 0u;
+    };
+
+    // *************************************************************************
+    //! \brief Statistics of a value over all replications.
+    // *************************************************************************
+    struct Statistic
+    {
+        double mean = 0.0;
+        //! \brief Sample standard deviation (0 for a single replication).
+        double stddev = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    // *************************************************************************
+    //! \brief Aggregated results of all replications.
+    // *************************************************************************
+    struct Result
+    {
+        //! \brief Number of replications made.
+        size_t replications = 0u;
+        //! \brief Simulated duration of each replication.
+        double duration = 0.0;
+        //! \brief Firings per unit of time of each transition (indexed by
+        //! transition index of the CompiledNet).
+        std::vector<Statistic> throughputs;
+        //! \brief Tokens at the end of the replications for each place
+        //! (indexed by place index of the CompiledNet). Transiting tokens are
+        //! not counted.
+        std::vector<Statistic> markings;
+        //! \brief Total number of firings of replications.
+        Statistic firings;
+        //! \brief Number of replications which cannot evolve anymore at the
+        //! end of the duration.
+        size_t deadlocks = 0u;
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Optional callback modifying the initial marking of a
+    //! replication. The marking is initialized with the initial marking of the
+    //! compiled net before the call. Called concurrently from worker threads.
+    //--------------------------------------------------------------------------
+    using Initializer = std::function<void(size_t const replication, Marking& marking)>;
+
+    //--------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] net: the compiled net to simulate. Shall outlive this
+    //! instance.
+    //--------------------------------------------------------------------------
+    explicit MonteCarlo(CompiledNet const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Run all replications and wait for their end.
+    //! \param[in] options: number of replications, duration, seed, threads.
+    //! \param[in] initializer: optional callback for changing the initial
+    //! marking of each replication.
+    //! \return the aggregated statistics.
+    //! \note If the initializer throws, remaining replications are cancelled
+    //! and the exception is rethrown.
+    //--------------------------------------------------------------------------
+    Result run(Options const& options, Initializer const& initializer = nullptr) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the seed of the random generator of the given replication.
+    //--------------------------------------------------------------------------
+    static uint32_t seedOf(uint32_t const seed, size_t const replication);
+
+private:
+
+    //! \brief The net to simulate.
+    CompiledNet const& m_net;
+};
+
+} // namespace tpne
+
+#endif
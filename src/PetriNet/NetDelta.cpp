@@ -0,0 +1,422 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/NetDelta.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace tpne {
+
+//------------------------------------------------------------------------------
+bool NetDelta::undo(Net& net)
+{
+    // Do not record the modifications made for undoing.
+    NetDelta* journal = net.m_journal;
+    net.m_journal = nullptr;
+
+    bool res = true;
+    for (auto it = m_operations.rbegin(); res && (it != m_operations.rend()); ++it)
+    {
+        res = apply(net, *it, false);
+    }
+
+    net.m_journal = journal;
+    return res;
+}
+
+//------------------------------------------------------------------------------
+bool NetDelta::redo(Net& net)
+{
+    NetDelta* journal = net.m_journal;
+    net.m_journal = nullptr;
+
+    bool res = true;
+    for (auto it = m_operations.begin(); res && (it != m_operations.end()); ++it)
+    {
+        res = apply(net, *it, true);
+    }
+
+    net.m_journal = journal;
+    return res;
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::moveNode(Node const& node, float const previous_x,
+                        float const previous_y)
+{
+    // Keep the position before the first move.
+    if (findMergeable(Operation::Kind::MoveNode, node) != nullptr)
+        return ;
+    if ((node.x == previous_x) && (node.y == previous_y))
+        return ;
+
+    Operation operation;
+    operation.kind = Operation::Kind::MoveNode;
+    operation.type = node.type;
+    operation.id = node.id;
+    operation.x = previous_x;
+    operation.y = previous_y;
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::tokens(Place const& place, size_t const previous)
+{
+    // Keep the number of tokens before the first change.
+    if (findMergeable(Operation::Kind::Tokens, place) != nullptr)
+        return ;
+    if (place.tokens == previous)
+        return ;
+
+    Operation operation;
+    operation.kind = Operation::Kind::Tokens;
+    operation.type = Node::Type::Place;
+    operation.id = place.id;
+    operation.other = previous;
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::duration(Arc const& arc, float const previous)
+{
+    // Keep the duration before the first change.
+    if (findMergeable(Operation::Kind::Duration, arc.from, arc.to.id) != nullptr)
+        return ;
+    if (arc.duration == previous)
+        return ;
+
+    Operation operation;
+    operation.kind = Operation::Kind::Duration;
+    operation.type = arc.from.type;
+    operation.id = arc.from.id;
+    operation.other = arc.to.id;
+    operation.duration = previous;
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::caption(Node const& node, std::string const& previous)
+{
+    // Keep the caption before the first change.
+    if (findMergeable(Operation::Kind::Caption, node) != nullptr)
+        return ;
+    if (node.caption == previous)
+        return ;
+
+    Operation operation;
+    operation.kind = Operation::Kind::Caption;
+    operation.type = node.type;
+    operation.id = node.id;
+    operation.caption = previous;
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+NetDelta::Operation* NetDelta::findMergeable(Operation::Kind const kind,
+                                             Node const& node, size_t const other)
+{
+    // Identifiers of nodes are stable until the next structural modification.
+    for (auto it = m_operations.rbegin(); it != m_operations.rend(); ++it)
+    {
+        if ((it->kind != Operation::Kind::MoveNode) &&
+            (it->kind != Operation::Kind::Tokens) &&
+            (it->kind != Operation::Kind::Duration) &&
+            (it->kind != Operation::Kind::Caption))
+        {
+            return nullptr;
+        }
+        if ((it->kind == kind) && (it->type == node.type) && (it->id == node.id) &&
+            ((kind != Operation::Kind::Duration) || (it->other == other)))
+        {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::onAddNode(Node const& node)
+{
+    Operation operation;
+    operation.kind = Operation::Kind::AddNode;
+    operation.type = node.type;
+    operation.id = node.id;
+    operation.other = node.id;
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::onRemoveNode(Node const& removed, Node const& last)
+{
+    Operation operation;
+    operation.kind = Operation::Kind::RemoveNode;
+    operation.type = removed.type;
+    operation.id = removed.id;
+    operation.other = last.id;
+    operation.default_caption = (last.caption == last.key);
+    if (removed.type == Node::Type::Place)
+    {
+        operation.place = std::make_unique<Place>(
+            static_cast<Place const&>(removed));
+    }
+    else
+    {
+        operation.transition = std::make_unique<Transition>(
+            static_cast<Transition const&>(removed));
+    }
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::onAddArc(Arc const& arc)
+{
+    Operation operation;
+    operation.kind = Operation::Kind::AddArc;
+    describe(operation, arc);
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::onRemoveArc(Arc const& arc)
+{
+    Operation operation;
+    operation.kind = Operation::Kind::RemoveArc;
+    describe(operation, arc);
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::onReset(Net const& net)
+{
+    Operation operation;
+    operation.kind = Operation::Kind::Reset;
+    operation.net = std::make_unique<Net>(net);
+    m_operations.push_back(std::move(operation));
+}
+
+//------------------------------------------------------------------------------
+void NetDelta::describe(Operation& operation, Arc const& arc)
+{
+    operation.type = arc.from.type;
+    operation.id = arc.from.id;
+    operation.other = arc.to.id;
+    operation.duration = arc.duration;
+    operation.slot = arc.index;
+    operation.out_position = size_t(
+        std::find(arc.from.arcsOut.begin(), arc.from.arcsOut.end(), &arc) -
+        arc.from.arcsOut.begin());
+    operation.in_position = size_t(
+        std::find(arc.to.arcsIn.begin(), arc.to.arcsIn.end(), &arc) -
+        arc.to.arcsIn.begin());
+}
+
+//------------------------------------------------------------------------------
+Node* NetDelta::findNode(Net& net, Node::Type const type, size_t const id)
+{
+    if (type == Node::Type::Place)
+        return net.findPlace(id);
+    return net.findTransition(id);
+}
+
+//------------------------------------------------------------------------------
+Arc* NetDelta::findArc(Net& net, Operation const& operation)
+{
+    Node::Type const to_type = (operation.type == Node::Type::Place)
+                               ? Node::Type::Transition : Node::Type::Place;
+    Node* from = findNode(net, operation.type, operation.id);
+    Node* to = findNode(net, to_type, operation.other);
+    if ((from == nullptr) || (to == nullptr))
+        return nullptr;
+    return net.findArc(*from, *to);
+}
+
+//------------------------------------------------------------------------------
+bool NetDelta::apply(Net& net, Operation& operation, bool const forward)
+{
+    switch (operation.kind)
+    {
+    case Operation::Kind::AddNode:
+        return forward ? restoreNode(net, operation) : removeNode(net, operation);
+    case Operation::Kind::RemoveNode:
+        return forward ? removeNode(net, operation) : restoreNode(net, operation);
+    case Operation::Kind::AddArc:
+        return forward ? restoreArc(net, operation) : removeArc(net, operation);
+    case Operation::Kind::RemoveArc:
+        return forward ? removeArc(net, operation) : restoreArc(net, operation);
+    case Operation::Kind::MoveNode:
+        {
+            // Swap positions: the operation holds the position for the next
+            // call.
+            Node* node = findNode(net, operation.type, operation.id);
+            if (node == nullptr)
+                return false;
+            std::swap(node->x, operation.x);
+            std::swap(node->y, operation.y);
+            net.modified = true;
+            return true;
+        }
+    case Operation::Kind::Tokens:
+        {
+            Place* place = net.findPlace(operation.id);
+            if (place == nullptr)
+                return false;
+            std::swap(place->tokens, operation.other);
+            net.modified = true;
+            net.touchMarking();
+            return true;
+        }
+    case Operation::Kind::Duration:
+        {
+            Arc* arc = findArc(net, operation);
+            if (arc == nullptr)
+                return false;
+            std::swap(arc->duration, operation.duration);
+            net.modified = true;
+            net.touchStructure();
+            return true;
+        }
+    case Operation::Kind::Caption:
+        {
+            Node* node = findNode(net, operation.type, operation.id);
+            if (node == nullptr)
+                return false;
+            std::swap(node->caption, operation.caption);
+            net.modified = true;
+            net.touchStructure();
+            return true;
+        }
+    case Operation::Kind::Reset:
+        {
+            if (operation.net == nullptr)
+                return false;
+            // The net moved last defines the global settings (Net::Settings).
+            Net other(std::move(*operation.net));
+            *operation.net = std::move(net);
+            net = std::move(other);
+            net.modified = true;
+            net.touchStructure();
+            net.touchMarking();
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool NetDelta::removeNode(Net& net, Operation& operation)
+{
+    Node* node = findNode(net, operation.type, operation.id);
+    if ((node == nullptr) || (!node->arcsIn.empty()) || (!node->arcsOut.empty()))
+        return false;
+
+    // The latest node will take the location of the removed one.
+    Node const& last = (operation.type == Node::Type::Place)
+                       ? static_cast<Node const&>(net.m_places.back())
+                       : static_cast<Node const&>(net.m_transitions.back());
+    operation.other = last.id;
+    operation.default_caption = (last.caption == last.key);
+
+    if (operation.type == Node::Type::Place)
+    {
+        operation.place = std::make_unique<Place>(*static_cast<Place*>(node));
+        net.helperRemovePlace(*node);
+    }
+    else
+    {
+        operation.transition = std::make_unique<Transition>(
+            *static_cast<Transition*>(node));
+        net.helperRemoveTransition(*node);
+    }
+
+    net.modified = true;
+    net.touchStructure();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool NetDelta::restoreNode(Net& net, Operation& operation)
+{
+    // The latest node has taken the location of the removed one, except if the
+    // removed node was the latest one.
+    if (operation.other != operation.id)
+    {
+        if ((findNode(net, operation.type, operation.id) == nullptr) ||
+            (findNode(net, operation.type, operation.other) != nullptr))
+            return false;
+    }
+    else if (findNode(net, operation.type, operation.id) != nullptr)
+    {
+        return false;
+    }
+
+    if (operation.type == Node::Type::Place)
+    {
+        if (operation.place == nullptr)
+            return false;
+        net.helperRestorePlace(std::move(*operation.place), operation.other,
+                               operation.default_caption);
+        operation.place.reset();
+    }
+    else
+    {
+        if (operation.transition == nullptr)
+            return false;
+        net.helperRestoreTransition(std::move(*operation.transition),
+                                    operation.other, operation.default_caption);
+        operation.transition.reset();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool NetDelta::removeArc(Net& net, Operation& operation)
+{
+    Arc* arc = findArc(net, operation);
+    if (arc == nullptr)
+        return false;
+
+    describe(operation, *arc);
+    net.helperRemoveArcAt(arc->index);
+    net.modified = true;
+    net.touchStructure();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool NetDelta::restoreArc(Net& net, Operation& operation)
+{
+    Node::Type const to_type = (operation.type == Node::Type::Place)
+                               ? Node::Type::Transition : Node::Type::Place;
+    Node* from = findNode(net, operation.type, operation.id);
+    Node* to = findNode(net, to_type, operation.other);
+    if ((from == nullptr) || (to == nullptr) ||
+        (operation.slot > net.m_arcs.size()) ||
+        (net.findArc(*from, *to) != nullptr))
+        return false;
+
+    net.helperInsertArc(*from, *to, operation.duration, operation.slot,
+                        operation.out_position, operation.in_position);
+    net.modified = true;
+    net.touchStructure();
+    return true;
+}
+
+} // namespace tpne
@@ -0,0 +1,242 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef NET_DELTA_HPP
+#  define NET_DELTA_HPP
+
+#  include "PetriNet/PetriNet.hpp"
+
+#  include <memory>
+#  include <string>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Record of the modifications made on a net, allowing to undo and redo
+//! them without storing copies of the whole net.
+//!
+//! Structural modifications (adding and removing nodes and arcs) are recorded
+//! by the Net itself while the delta is attached to it (see Net::journal()).
+//! Each record holds what is needed to apply the modification in both
+//! directions: removing a node or an arc is undone by putting it back at its
+//! former location in the containers of the net (the exact inverse of the swap
+//! with the latest element made by Net), so identifiers, slots and orders of
+//! arcs are the same after undo() or redo(). Removed nodes are stored without
+//! their arcs: arcs have their own records.
+//!
+//! Modifications not made through the Net API (moving nodes, changing tokens,
+//! durations of arcs and captions) are recorded by the caller with moveNode(),
+//! tokens(), duration() and caption(). Successive changes of the same element
+//! are merged: dragging a node records a single move.
+//!
+//! \note Clearing the net (Net::clear() and Net::reset()) still stores a copy
+//! of the whole net.
+//! \note Modifications shall be undone in the reverse order they have been
+//! made: undo() and redo() fail if the net does not match the records.
+// *****************************************************************************
+class NetDelta
+{
+    //! \brief To record modifications.
+    friend class Net;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //! \brief Cancel the modifications by applying their inverses in the
+    //! reverse order.
+    //! \return false if the net does not match the records (it may have been
+    //! partially modified).
+    //--------------------------------------------------------------------------
+    bool undo(Net& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Apply again the modifications canceled by undo().
+    //! \return false if the net does not match the records (it may have been
+    //! partially modified).
+    //--------------------------------------------------------------------------
+    bool redo(Net& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Record the position of the node before the user moved it. The
+    //! node holds the new position. Merged with a previous move of the same
+    //! node.
+    //--------------------------------------------------------------------------
+    void moveNode(Node const& node, float const previous_x, float const previous_y);
+
+    //--------------------------------------------------------------------------
+    //! \brief Record the number of tokens of the place before the user changed
+    //! it. The place holds the new number of tokens. Merged with a previous
+    //! change of the same place.
+    //--------------------------------------------------------------------------
+    void tokens(Place const& place, size_t const previous);
+
+    //--------------------------------------------------------------------------
+    //! \brief Record the duration of the arc before the user changed it. The
+    //! arc holds the new duration. Merged with a previous change of the same
+    //! arc.
+    //--------------------------------------------------------------------------
+    void duration(Arc const& arc, float const previous);
+
+    //--------------------------------------------------------------------------
+    //! \brief Record the caption of the node before the user changed it. The
+    //! node holds the new caption. Merged with a previous change of the same
+    //! node.
+    //--------------------------------------------------------------------------
+    void caption(Node const& node, std::string const& previous);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return true if no modification has been recorded.
+    //--------------------------------------------------------------------------
+    inline bool empty() const { return m_operations.empty(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of recorded modifications.
+    //--------------------------------------------------------------------------
+    inline size_t size() const { return m_operations.size(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Forget all modifications.
+    //--------------------------------------------------------------------------
+    inline void clear() { m_operations.clear(); }
+
+private:
+
+    // *************************************************************************
+    //! \brief A recorded modification.
+    // *************************************************************************
+    struct Operation
+    {
+        enum class Kind { AddNode, RemoveNode, AddArc, RemoveArc, MoveNode,
+                          Tokens, Duration, Caption, Reset };
+
+        Kind kind = Kind::AddNode;
+        //! \brief Type of the node or of the origin node of the arc.
+        Node::Type type = Node::Type::Place;
+        //! \brief Identifier of the node or of the origin node of the arc.
+        size_t id = 0u;
+        //! \brief Arcs: identifier of the destination node. Nodes: identifier
+        //! of the latest node taking the location of the removed one. Tokens:
+        //! the number of tokens to swap with the place.
+        size_t other = 0u;
+        //! \brief Nodes: the latest node had its default caption.
+        bool default_caption = false;
+        //! \brief Position to swap with the node.
+        float x = 0.0f;
+        float y = 0.0f;
+        //! \brief Arcs: duration (to swap with the arc for Duration), slot in
+        //! Net::arcs() and positions in Node::arcsOut of the origin node and
+        //! Node::arcsIn of the destination node.
+        float duration = 0.0f;
+        size_t slot = 0u;
+        size_t out_position = 0u;
+        size_t in_position = 0u;
+        //! \brief Caption to swap with the node.
+        std::string caption;
+        //! \brief Removed node (without arcs). Only one is set.
+        std::unique_ptr<Place> place;
+        std::unique_ptr<Transition> transition;
+        //! \brief Net to swap with (clear and reset).
+        std::unique_ptr<Net> net;
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Called by Net after a node has been added.
+    //--------------------------------------------------------------------------
+    void onAddNode(Node const& node);
+
+    //--------------------------------------------------------------------------
+    //! \brief Called by Net before removing the node \c removed (arcs have
+    //! been removed) and moving the node \c last to its location.
+    //--------------------------------------------------------------------------
+    void onRemoveNode(Node const& removed, Node const& last);
+
+    //--------------------------------------------------------------------------
+    //! \brief Called by Net after an arc has been added.
+    //--------------------------------------------------------------------------
+    void onAddArc(Arc const& arc);
+
+    //--------------------------------------------------------------------------
+    //! \brief Called by Net before removing an arc.
+    //--------------------------------------------------------------------------
+    void onRemoveArc(Arc const& arc);
+
+    //--------------------------------------------------------------------------
+    //! \brief Called by Net before clearing or resetting the net.
+    //--------------------------------------------------------------------------
+    void onReset(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Apply the operation in the given direction.
+    //--------------------------------------------------------------------------
+    bool apply(Net& net, Operation& operation, bool const forward);
+
+    //--------------------------------------------------------------------------
+    //! \brief Remove the node (having no arcs) and store it in the operation.
+    //--------------------------------------------------------------------------
+    bool removeNode(Net& net, Operation& operation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Put back the node stored in the operation.
+    //--------------------------------------------------------------------------
+    bool restoreNode(Net& net, Operation& operation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Remove the arc described by the operation.
+    //--------------------------------------------------------------------------
+    bool removeArc(Net& net, Operation& operation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Put back the arc described by the operation.
+    //--------------------------------------------------------------------------
+    bool restoreArc(Net& net, Operation& operation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the node of the net or nullptr.
+    //--------------------------------------------------------------------------
+    static Node* findNode(Net& net, Node::Type const type, size_t const id);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the arc described by the operation or nullptr.
+    //--------------------------------------------------------------------------
+    static Arc* findArc(Net& net, Operation const& operation);
+
+    //--------------------------------------------------------------------------
+    //! \brief Describe the arc inside the operation.
+    //--------------------------------------------------------------------------
+    static void describe(Operation& operation, Arc const& arc);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the latest operation of the given kind on the given node
+    //! (or on the arc from this node to the node \c other) made after the
+    //! latest structural modification, or nullptr.
+    //--------------------------------------------------------------------------
+    Operation* findMergeable(Operation::Kind const kind, Node const& node,
+                             size_t const other = 0u);
+
+private:
+
+    //! \brief Recorded modifications in the order they have been made.
+    std::vector<Operation> m_operations;
+};
+
+} // namespace tpne
+
+#endif
@@ -21,11 +21,13 @@
 #include "PetriNet/PetriNet.hpp"
 
 #include "PetriNet/Algorithms.hpp"
+#include "PetriNet/NetDelta.hpp"
 #include "PetriNet/Imports/Imports.hpp"
 #include "PetriNet/Exports/Exports.hpp"
 #include "Editor/Path.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <cstring>
 #include <limits>
@@ -38,6 +40,16 @@ namespace tpne {
 size_t Net::Settings::maxTokens = std::numeric_limits<size_t>::max();
 Net::Settings::Fire Net::Settings::firing = Net::Settings::Fire::OneByOne;
 
+//------------------------------------------------------------------------------
+//! \brief Return a new revision, unique among all nets. Revision 0 is never
+//! given.
+//------------------------------------------------------------------------------
+static uint64_t nextRevision()
+{
+    static std::atomic<uint64_t> revisions{0u};
+    return ++revisions;
+}
+
 //------------------------------------------------------------------------------
 static void applyNewNetSettings(TypeOfNet const type)
 {
@@ -147,7 +159,8 @@ size_t Transition::maxTokensToConsume() const
 
 //------------------------------------------------------------------------------
 Net::Net(TypeOfNet const type)
-    : m_type(type), name(to_str(type))
+    : name(to_str(type)), m_type(type), m_structure_revision(nextRevision()),
+      m_marking_revision(nextRevision())
 {
     applyNewNetSettings(type);
 }
@@ -168,19 +181,26 @@ Net::Net(Net const& other)
     for (auto const& it: other.m_arcs)
     {
         Node& from = (it.from.type == Node::Type::Place)
-                     ? reinterpret_cast<Node&>(m_places[it.from.id])
-                     : reinterpret_cast<Node&>(m_transitions[it.from.id]);
+                     ? reinterpret_cast<Node&>(m_places[other.m_place_slots.at(it.from.id)])
+                     : reinterpret_cast<Node&>(m_transitions[other.m_transition_slots.at(it.from.id)]);
         Node& to = (it.to.type == Node::Type::Place)
-                   ? reinterpret_cast<Node&>(m_places[it.to.id])
-                   : reinterpret_cast<Node&>(m_transitions[it.to.id]);
-        m_arcs.emplace_back(from, to, it.duration);
+                   ? reinterpret_cast<Node&>(m_places[other.m_place_slots.at(it.to.id)])
+                   : reinterpret_cast<Node&>(m_transitions[other.m_transition_slots.at(it.to.id)]);
+        m_arcs.emplace_back(from, to, it.duration, m_arcs.size());
     }
     generateArcsInArcsOut();
 
+    // Indices store slots, not addresses, so they are still valid.
+    m_place_slots = other.m_place_slots;
+    m_transition_slots = other.m_transition_slots;
+    m_arc_slots = other.m_arc_slots;
+
     m_next_place_id = other.m_next_place_id;
     m_next_transition_id = other.m_next_transition_id;
     name = other.name;
     modified = false;
+    m_structure_revision = nextRevision();
+    m_marking_revision = nextRevision();
 }
 
 //------------------------------------------------------------------------------
@@ -189,29 +209,100 @@ Net& Net::operator=(Net const& other)
     if (this == &other)
         return *this;
 
-    this->~Net(); // destroy
-    new (this) Net(other); // copy construct in place
+    return *this = Net(other);
+}
+
+//------------------------------------------------------------------------------
+Net::Net(Net&& other)
+    : name(std::move(other.name)), modified(other.modified),
+      m_type(other.m_type), m_places(std::move(other.m_places)),
+      m_transitions(std::move(other.m_transitions)),
+      m_arcs(std::move(other.m_arcs)),
+      m_next_place_id(other.m_next_place_id),
+      m_next_transition_id(other.m_next_transition_id),
+      m_place_slots(std::move(other.m_place_slots)),
+      m_transition_slots(std::move(other.m_transition_slots)),
+      m_arc_slots(std::move(other.m_arc_slots)),
+      m_structure_revision(other.m_structure_revision),
+      m_marking_revision(other.m_marking_revision)
+{
+    applyNewNetSettings(m_type);
+    other.helperClear();
+    other.modified = false;
+    other.touchMarking();
+}
+
+//------------------------------------------------------------------------------
+Net& Net::operator=(Net&& other)
+{
+    if (this == &other)
+        return *this;
+
+    name = std::move(other.name);
+    modified = other.modified;
+    m_type = other.m_type;
+    m_places = std::move(other.m_places);
+    m_transitions = std::move(other.m_transitions);
+    m_arcs = std::move(other.m_arcs);
+    m_next_place_id = other.m_next_place_id;
+    m_next_transition_id = other.m_next_transition_id;
+    m_place_slots = std::move(other.m_place_slots);
+    m_transition_slots = std::move(other.m_transition_slots);
+    m_arc_slots = std::move(other.m_arc_slots);
+    m_structure_revision = other.m_structure_revision;
+    m_marking_revision = other.m_marking_revision;
+    applyNewNetSettings(m_type);
+
+    other.helperClear();
+    other.modified = false;
+    other.touchMarking();
     return *this;
 }
 
 //------------------------------------------------------------------------------
 void Net::reset(TypeOfNet const type)
 {
+    if (m_journal != nullptr)
+        m_journal->onReset(*this);
     m_type = type;
     applyNewNetSettings(type);
-    clear();
+    helperClear();
     name = to_str(type);
 }
 
 //------------------------------------------------------------------------------
 void Net::clear()
+{
+    if (m_journal != nullptr)
+        m_journal->onReset(*this);
+    helperClear();
+}
+
+//------------------------------------------------------------------------------
+void Net::helperClear()
 {
     m_places.clear();
     m_transitions.clear();
     m_arcs.clear();
+    m_place_slots.clear();
+    m_transition_slots.clear();
+    m_arc_slots.clear();
     m_next_place_id = 0u;
     m_next_transition_id = 0u;
     modified = true;
+    touchStructure();
+}
+
+//------------------------------------------------------------------------------
+void Net::touchStructure()
+{
+    m_structure_revision = nextRevision();
+}
+
+//------------------------------------------------------------------------------
+void Net::touchMarking()
+{
+    m_marking_revision = nextRevision();
 }
 
 //------------------------------------------------------------------------------
@@ -239,6 +330,7 @@ bool Net::tokens(std::vector<size_t> const& tokens_)
     {
         m_places[i].tokens = std::min(Net::Settings::maxTokens, tokens_[i]);
     }
+    touchMarking();
 
     return true;
 }
@@ -247,7 +339,11 @@ bool Net::tokens(std::vector<size_t> const& tokens_)
 Place& Net::addPlace(float const x, float const y, size_t const tokens)
 {
     modified = true;
+    touchStructure();
+    m_place_slots.emplace(m_next_place_id, m_places.size());
     m_places.emplace_back(m_next_place_id++, "", x, y, tokens);
+    if (m_journal != nullptr)
+        m_journal->onAddNode(m_places.back());
     return m_places.back();
 }
 
@@ -256,9 +352,13 @@ Place& Net::addPlace(size_t const id, std::string const& caption, float const x,
                      float const y, size_t const tokens)
 {
     modified = true;
+    touchStructure();
+    m_place_slots.emplace(id, m_places.size());
     m_places.emplace_back(id, caption, x, y, tokens);
     if (id + 1u > m_next_place_id)
         m_next_place_id = id + 1u;
+    if (m_journal != nullptr)
+        m_journal->onAddNode(m_places.back());
     return m_places.back();
 }
 
@@ -266,8 +366,12 @@ Place& Net::addPlace(size_t const id, std::string const& caption, float const x,
 Transition& Net::addTransition(float const x, float const y)
 {
     modified = true;
+    touchStructure();
+    m_transition_slots.emplace(m_next_transition_id, m_transitions.size());
     m_transitions.push_back(Transition(m_next_transition_id++, "", x, y,
                    (m_type == TypeOfNet::TimedPetriNet) ? true : false));
+    if (m_journal != nullptr)
+        m_journal->onAddNode(m_transitions.back());
     return m_transitions.back();
 }
 
@@ -276,10 +380,14 @@ Transition& Net::addTransition(size_t const id, std::string const& caption,
                                float const x, float const y)
 {
     modified = true;
+    touchStructure();
+    m_transition_slots.emplace(id, m_transitions.size());
     m_transitions.emplace_back(id, caption, x, y,
                    (m_type == TypeOfNet::TimedPetriNet) ? true : false);
     if (id + 1u > m_next_transition_id)
         m_next_transition_id = id + 1u;
+    if (m_journal != nullptr)
+        m_journal->onAddNode(m_transitions.back());
     return m_transitions.back();
 }
 
@@ -336,7 +444,22 @@ bool Net::sanityArc(Node const& from, Node const& to, bool const strict, std::st
 }
 
 //------------------------------------------------------------------------------
-// FIXME: faire l'equivalent de generateArcsInArcsOut
+//! \brief Replace the arc address \c old_arc by \c new_arc in the given list
+//! of arcs. Replace by nullptr to remove it.
+//------------------------------------------------------------------------------
+static void replaceArc(std::vector<Arc*>& arcs, Arc const* old_arc, Arc* new_arc)
+{
+    auto it = std::find(arcs.begin(), arcs.end(), old_arc);
+    if (it == arcs.end())
+        return ;
+
+    if (new_arc == nullptr)
+        arcs.erase(it);
+    else
+        *it = new_arc;
+}
+
+//------------------------------------------------------------------------------
 bool Net::addArc(Transition& from, Transition& to, size_t const tokens, float const duration)
 {
     // Create the intermediate node
@@ -345,22 +468,17 @@ bool Net::addArc(Transition& from, Transition& to, size_t const tokens, float co
     Place& n = addPlace(x, y, tokens);
 
     // Frist arc
-    m_arcs.emplace_back(from, n, duration);
-    from.arcsOut.push_back(&m_arcs.back());
-    n.arcsIn.push_back(&m_arcs.back());
+    helperAddArc(from, n, duration);
 
     // Second arc
-    m_arcs.emplace_back(n, to, duration);
-    n.arcsOut.push_back(&m_arcs.back());
-    to.arcsIn.push_back(&m_arcs.back());
+    helperAddArc(n, to, duration);
 
-    generateArcsInArcsOut(); // FIXME a optimiser !!!
     modified = true;
+    touchStructure();
     return true;
 }
 
 //------------------------------------------------------------------------------
-// FIXME: faire l'equivalent de generateArcsInArcsOut
 std::string Net::addArc(Node& from, Node& to, float const duration)
 {
     std::stringstream message;
@@ -368,13 +486,12 @@ std::string Net::addArc(Node& from, Node& to, float const duration)
         return message.str();
 
     modified = true;
+    touchStructure();
 
     // Create an arc "Place -> Transition" or "Transition -> Place"
     if (from.type != to.type)
     {
-        m_arcs.emplace_back(from, to, duration);
-        from.arcsOut.push_back(&m_arcs.back());
-        to.arcsIn.push_back(&m_arcs.back());
+        helperAddArc(from, to, duration);
     }
     else // Manage the case "Place -> Place" or "Transition -> Transition"
     {
@@ -384,40 +501,68 @@ std::string Net::addArc(Node& from, Node& to, float const duration)
         Node& n = addOppositeNode(to.type, x, y);
 
         // Frist arc
-        m_arcs.emplace_back(from, n, duration);
-        from.arcsOut.push_back(&m_arcs.back());
-        n.arcsIn.push_back(&m_arcs.back());
+        helperAddArc(from, n, duration);
 
         // Second arc
-        m_arcs.emplace_back(n, to, duration);
-        n.arcsOut.push_back(&m_arcs.back());
-        to.arcsIn.push_back(&m_arcs.back());
+        helperAddArc(n, to, duration);
     }
 
-    generateArcsInArcsOut(); // FIXME a optimiser !!!
     return message.str();
 }
 
 //------------------------------------------------------------------------------
-Arc* Net::findArc(Node const& from, Node const& to)
+Arc& Net::helperAddArc(Node& from, Node& to, float const duration)
+{
+    Arc& arc = helperInsertArc(from, to, duration, m_arcs.size(),
+                               from.arcsOut.size(), to.arcsIn.size());
+    if (m_journal != nullptr)
+        m_journal->onAddArc(arc);
+    return arc;
+}
+
+//------------------------------------------------------------------------------
+Arc& Net::helperInsertArc(Node& from, Node& to, float const duration,
+                          size_t const slot, size_t const out_position,
+                          size_t const in_position)
 {
-    for (auto& it: m_arcs)
+    // Make the arc holding the desired slot go to the end of the container.
+    // Incoming and outgoing arcs of the impacted nodes are updated accordingly.
+    if (slot < m_arcs.size())
     {
-        if ((it.from.key == from.key) && (it.to.key == to.key))
-            return &it;
+        Arc& a = m_arcs[slot];
+        m_arcs.emplace_back(a.from, a.to, a.duration, m_arcs.size());
+        Arc& e = m_arcs.back();
+        m_arc_slots[arcKey(e.from, e.to)] = e.index;
+        replaceArc(e.from.arcsOut, &a, &e);
+        replaceArc(e.to.arcsIn, &a, &e);
+        a = Arc(from, to, duration, slot);
     }
-    return nullptr;
+    else
+    {
+        m_arcs.emplace_back(from, to, duration, slot);
+    }
+
+    Arc& arc = m_arcs[slot];
+    m_arc_slots.emplace(arcKey(from, to), slot);
+    from.arcsOut.insert(from.arcsOut.begin() + std::ptrdiff_t(
+        std::min(out_position, from.arcsOut.size())), &arc);
+    to.arcsIn.insert(to.arcsIn.begin() + std::ptrdiff_t(
+        std::min(in_position, to.arcsIn.size())), &arc);
+    return arc;
+}
+
+//------------------------------------------------------------------------------
+Arc* Net::findArc(Node const& from, Node const& to)
+{
+    auto const it = m_arc_slots.find(arcKey(from, to));
+    return (it != m_arc_slots.end()) ? &m_arcs[it->second] : nullptr;
 }
 
 //------------------------------------------------------------------------------
 Arc const* Net::findArc(Node const& from, Node const& to) const
 {
-    for (auto& it: m_arcs)
-    {
-        if ((it.from.key == from.key) && (it.to.key == to.key))
-            return &it;
-    }
-    return nullptr;
+    auto const it = m_arc_slots.find(arcKey(from, to));
+    return (it != m_arc_slots.end()) ? &m_arcs[it->second] : nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -427,103 +572,80 @@ void Net::generateArcsInArcsOut()
     {
         trans.arcsIn.clear();
         trans.arcsOut.clear();
-
-        for (auto& a: m_arcs)
-        {
-            if ((a.from.type == Node::Type::Place) && (a.to.id == trans.id))
-                trans.arcsIn.push_back(&a);
-            else if ((a.to.type == Node::Type::Place) && (a.from.id == trans.id))
-                trans.arcsOut.push_back(&a);
-        }
     }
 
-    // if (true)
     for (auto& p: m_places)
     {
         p.arcsIn.clear();
         p.arcsOut.clear();
+    }
 
-        for (auto& a: m_arcs)
-        {
-            if ((a.from.type == Node::Type::Transition) && (a.to.id == p.id))
-                p.arcsIn.push_back(&a);
-            else if ((a.to.type == Node::Type::Transition) && (a.from.id == p.id))
-                p.arcsOut.push_back(&a);
-        }
+    // Single pass on arcs: nodes get their arcs in the same order than the
+    // container of arcs.
+    for (auto& a: m_arcs)
+    {
+        a.from.arcsOut.push_back(&a);
+        a.to.arcsIn.push_back(&a);
     }
 }
 
 //------------------------------------------------------------------------------
 Node* Net::findNode(std::string const& key)
 {
-    if (key[0] == 'P')
-    {
-        for (auto& p: m_places)
-        {
-            if (p.key == key)
-                return &p;
-        }
-        return nullptr;
-    }
-
-    if (key[0] == 'T')
-    {
-        for (auto& t: m_transitions)
-        {
-            if (t.key == key)
-                return &t;
-        }
-        return nullptr;
-    }
-
-    return nullptr;
+    return const_cast<Node*>(static_cast<Net const&>(*this).findNode(key));
 }
 
 //------------------------------------------------------------------------------
 Node const* Net::findNode(std::string const& key) const
 {
-    if (key[0] == 'P')
-    {
-        for (auto& p: m_places)
-        {
-            if (p.key == key)
-                return &p;
-        }
+    // Parse the key "P42" or "T42" without allocating memory.
+    if ((key.size() < 2u) || ((key[0] != 'P') && (key[0] != 'T')))
         return nullptr;
-    }
-    else if (key[0] == 'T')
+
+    size_t id = 0u;
+    for (size_t i = 1u; i < key.size(); ++i)
     {
-        for (auto& t: m_transitions)
-        {
-            if (t.key == key)
-                return &t;
-        }
-        return nullptr;
+        if ((key[i] < '0') || (key[i] > '9'))
+            return nullptr;
+        id = id * 10u + size_t(key[i] - '0');
     }
 
-    return nullptr;
+    Node const* node = (key[0] == 'P')
+                       ? static_cast<Node const*>(findPlace(id))
+                       : static_cast<Node const*>(findTransition(id));
+
+    // Reject non canonical keys such as "P007".
+    if ((node != nullptr) && (node->key != key))
+        return nullptr;
+    return node;
 }
 
 //------------------------------------------------------------------------------
 Transition* Net::findTransition(size_t const id)
 {
-    for (auto& t: m_transitions)
-    {
-        if (t.id == id)
-            return &t;
-    }
-    return nullptr;
+    auto const it = m_transition_slots.find(id);
+    return (it != m_transition_slots.end()) ? &m_transitions[it->second] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+Transition const* Net::findTransition(size_t const id) const
+{
+    auto const it = m_transition_slots.find(id);
+    return (it != m_transition_slots.end()) ? &m_transitions[it->second] : nullptr;
 }
 
 //------------------------------------------------------------------------------
 Place* Net::findPlace(size_t const id)
 {
-    for (auto& p: m_places)
-    {
-        if (p.id == id)
-            return &p;
-    }
-    return nullptr;
+    auto const it = m_place_slots.find(id);
+    return (it != m_place_slots.end()) ? &m_places[it->second] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+Place const* Net::findPlace(size_t const id) const
+{
+    auto const it = m_place_slots.find(id);
+    return (it != m_place_slots.end()) ? &m_places[it->second] : nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -579,118 +701,208 @@ bool Net::removeArc(Arc const& a)
 //------------------------------------------------------------------------------
 bool Net::removeArc(Node const& from, Node const& to)
 {
-// Supprimer les arcs qui touchent la place supprimee
+    auto const it = m_arc_slots.find(arcKey(from, to));
+    if (it == m_arc_slots.end())
+        return false;
 
-    size_t i = m_arcs.size();
-    while (i--)
+    helperRemoveArcAt(it->second);
+    touchStructure();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void Net::helperRemoveArcAt(size_t const slot)
+{
+    // Make the latest element take the location of the undesired arc in the
+    // container. Incoming and outgoing arcs of the impacted nodes are
+    // updated accordingly.
+    size_t const last = m_arcs.size() - 1u;
+    Arc& a = m_arcs[slot];
+    if (m_journal != nullptr)
+        m_journal->onRemoveArc(a);
+    m_arc_slots.erase(arcKey(a.from, a.to));
+    replaceArc(a.from.arcsOut, &a, nullptr);
+    replaceArc(a.to.arcsIn, &a, nullptr);
+    if (slot != last)
     {
-        if ((m_arcs[i].from.key == from.key) && (m_arcs[i].to.key == to.key))
-        {
-            // Found the undesired arc: make the latest element take its
-            // location in the container.
-            m_arcs[i] = m_arcs[m_arcs.size() - 1u];
-            m_arcs.pop_back();
+        Arc& e = m_arcs[last];
+        m_arc_slots[arcKey(e.from, e.to)] = slot;
+        replaceArc(e.from.arcsOut, &e, &a);
+        replaceArc(e.to.arcsIn, &e, &a);
+        m_arcs[slot] = e;
+        a.index = slot;
+    }
+    m_arcs.pop_back();
+}
 
-            generateArcsInArcsOut();
-            return true;
-        }
+//------------------------------------------------------------------------------
+template<class N>
+void Net::helperMoveNode(N& node, N& last)
+{
+    // Strings, GRAFCET actions and lists of arcs are moved. Only the key is
+    // rebuilt (and the caption when it was the default one) since the moved
+    // node takes the identifier of the removed one.
+    size_t const id = node.id;
+    std::string key = std::move(node.key);
+    bool const default_caption = (last.caption == last.key);
+    node = std::move(last);
+    node.id = id;
+    node.key = std::move(key);
+    if (default_caption)
+    {
+        node.caption = node.key;
+    }
+
+    // Update the references to nodes of the arcs of the moved node. Arcs keep
+    // their address in the container.
+    helperMoveArcs(last, node);
+}
+
+//------------------------------------------------------------------------------
+void Net::helperMoveArcs(Node const& moved, Node& node)
+{
+    // Note: the moved node still holds its former identifier which is needed
+    // for finding arcs in the index.
+    for (auto a: node.arcsIn)
+    {
+        m_arc_slots.erase(arcKey(a->from, moved));
+        *a = Arc(a->from, node, a->duration, a->index);
+        m_arc_slots[arcKey(a->from, node)] = a->index;
+    }
+    for (auto a: node.arcsOut)
+    {
+        m_arc_slots.erase(arcKey(moved, a->to));
+        *a = Arc(node, a->to, a->duration, a->index);
+        m_arc_slots[arcKey(node, a->to)] = a->index;
     }
-    return false;
 }
 
 //------------------------------------------------------------------------------
 void Net::helperRemovePlace(Node const& node)
 {
-    size_t i = m_places.size();
-    while (i--)
+    auto const it = m_place_slots.find(node.id);
+    if (it == m_place_slots.end())
+        return ;
+
+    // Found the undesired node: make the latest element take its
+    // location in the container. But before doing this we have to
+    // restore references on impacted arcs.
+    size_t const i = it->second;
+
+    // Move element but keep the ID of the removed element
+    Place& pi = m_places[i];
+    Place& pe = m_places.back();
+    // The removed slot keeps its identifier: this is the identifier of the
+    // latest element which disappears.
+    if (m_journal != nullptr)
+        m_journal->onRemoveNode(pi, pe);
+    m_place_slots.erase(pe.id);
+    if (&pi != &pe)
     {
-        // Found the undesired node: make the latest element take its
-        // location in the container. But before doing this we have to
-        // restore references on impacted arcs.
-        if (m_places[i].id == node.id)
-        {
-            // Swap element but keep the ID of the removed element
-            Place& pi = m_places[i];
-            Place& pe = m_places[m_places.size() - 1u];
-            if (pe.caption == pe.key)
-            {
-                m_places[i] = Place(pi.id, pi.key, pe.x, pe.y, pe.tokens);
-            }
-            else
-            {
-                m_places[i] = Place(pi.id, pe.caption, pe.x, pe.y, pe.tokens);
-            }
-            assert(m_next_place_id >= 1u);
-            m_next_place_id -= 1u;
-
-            // Update the references to nodes of the arc
-            for (auto& a: m_arcs) // TODO optim: use in/out arcs but they may not be generated
-            {
-                if (a.to.key == pe.key)
-                    a = Arc(a.from, m_places[i], a.duration);
-                if (a.from.key == pe.key)
-                    a = Arc(m_places[i], a.to, a.duration);
-            }
-
-            m_places.pop_back();
-        }
+        helperMoveNode(pi, pe);
     }
+    assert(m_next_place_id >= 1u);
+    m_next_place_id -= 1u;
+
+    m_places.pop_back();
 }
 
 //------------------------------------------------------------------------------
 void Net::helperRemoveTransition(Node const& node)
 {
-    size_t i = m_transitions.size();
-    while (i--)
+    auto const it = m_transition_slots.find(node.id);
+    if (it == m_transition_slots.end())
+        return ;
+
+    // Found the undesired node: make the latest element take its
+    // location in the container. But before doing this we have to
+    // restore references on impacted arcs.
+    size_t const i = it->second;
+
+    Transition& ti = m_transitions[i];
+    Transition& te = m_transitions.back();
+    // The removed slot keeps its identifier: this is the identifier of the
+    // latest element which disappears.
+    if (m_journal != nullptr)
+        m_journal->onRemoveNode(ti, te);
+    m_transition_slots.erase(te.id);
+    if (&ti != &te)
     {
-        // Found the undesired node: make the latest element take its
-        // location in the container. But before doing this we have to
-        // restore references on impacted arcs.
-        if (m_transitions[i].id == node.id)
-        {
-            Transition& ti = m_transitions[i];
-            Transition& te = m_transitions[m_transitions.size() - 1u];
-            if (te.caption == te.key)
-            {
-                m_transitions[i] = Transition(ti.id, ti.key, te.x, te.y,
-                                                (m_type == TypeOfNet::TimedPetriNet)
-                                                ? true : false);
-            }
-            else
-            {
-                m_transitions[i] = Transition(ti.id, te.caption, te.x, te.y,
-                                                (m_type == TypeOfNet::TimedPetriNet)
-                                                ? true : false);
-            }
-            assert(m_next_transition_id >= 1u);
-            m_next_transition_id -= 1u;
-
-            // Update the references to nodes of the arc
-            for (auto& a: m_arcs) // TODO optim: use in/out arcs but they may not be generated
-            {
-                if (a.to.key == te.key)
-                    a = Arc(a.from, m_transitions[i], a.duration);
-                if (a.from.key == te.key)
-                    a = Arc(m_transitions[i], a.to, a.duration);
-            }
-
-            m_transitions.pop_back();
-        }
+        helperMoveNode(ti, te);
+    }
+    assert(m_next_transition_id >= 1u);
+    m_next_transition_id -= 1u;
+
+    m_transitions.pop_back();
+}
+
+//------------------------------------------------------------------------------
+template<class N, class C>
+N& Net::helperRestoreNode(C& nodes, std::unordered_map<size_t, size_t>& slots,
+                          size_t& next_id, N&& node, size_t const moved_id,
+                          bool const default_caption)
+{
+    next_id += 1u;
+    modified = true;
+    touchStructure();
+
+    // The removed node was the latest element of the container.
+    auto const it = slots.find(node.id);
+    if (it == slots.end())
+    {
+        slots.emplace(node.id, nodes.size());
+        nodes.push_back(std::move(node));
+        return nodes.back();
+    }
+
+    // The node which took the location of the removed node goes back to the
+    // end of the container with its former identifier.
+    N& current = nodes[it->second];
+    nodes.push_back(std::move(current));
+    N& last = nodes.back();
+    last.id = moved_id;
+    last.key = N::to_str(moved_id);
+    if (default_caption)
+    {
+        last.caption = last.key;
     }
+    slots[moved_id] = nodes.size() - 1u;
+    helperMoveArcs(current, last);
+
+    current = std::move(node);
+    return current;
+}
+
+//------------------------------------------------------------------------------
+Place& Net::helperRestorePlace(Place&& place, size_t const moved_id,
+                               bool const default_caption)
+{
+    return helperRestoreNode(m_places, m_place_slots, m_next_place_id,
+                             std::move(place), moved_id, default_caption);
+}
+
+//------------------------------------------------------------------------------
+Transition& Net::helperRestoreTransition(Transition&& transition,
+                                         size_t const moved_id,
+                                         bool const default_caption)
+{
+    return helperRestoreNode(m_transitions, m_transition_slots,
+                             m_next_transition_id, std::move(transition),
+                             moved_id, default_caption);
 }
 
 //------------------------------------------------------------------------------
 void Net::helperRemoveArcFromNode(Node const& node)
 {
-    size_t s = m_arcs.size();
-    size_t i = s;
-    while (i--)
+    // Removing an arc also removes it from the incoming and outgoing arcs of
+    // the node.
+    while (!node.arcsIn.empty())
     {
-        if ((m_arcs[i].to.key == node.key) || (m_arcs[i].from.key == node.key))
-        {
-            m_arcs[i] = m_arcs[m_arcs.size() - 1u];
-            m_arcs.pop_back();
-        }
+        helperRemoveArcAt(node.arcsIn.back()->index);
+    }
+    while (!node.arcsOut.empty())
+    {
+        helperRemoveArcAt(node.arcsOut.back()->index);
     }
 }
 
@@ -741,9 +953,8 @@ void Net::removeNode(Node& node)
         }
     }
 
-    // Restore in arcs and out arcs for each node
-    generateArcsInArcsOut();
     modified = true;
+    touchStructure();
 }
 
 //------------------------------------------------------------------------------
@@ -815,6 +1026,8 @@ std::string loadFromFile(Net& net, std::string const& filepath, bool& springify)
     }
 
     net.modified = false;
+    net.touchStructure();
+    net.touchMarking();
 
     return error;
 }
@@ -852,7 +1065,9 @@ bool convertTo(Net& net, TypeOfNet const type, std::string& error, std::vector<A
         {
             place.tokens = std::min(Net::Settings::maxTokens, place.tokens);
         }
+        net.touchMarking();
     }
+    net.touchStructure();
 
     return true;
 }
@@ -24,9 +24,11 @@
 #  include "PetriNet/Grafcet.hpp"
 
 #  include <cmath>
+#  include <cstdint>
 #  include <string>
 #  include <deque>
 #  include <vector>
+#  include <unordered_map>
 #  include <cassert>
 #  include <sstream>
 #  include <iosfwd>
@@ -96,53 +98,55 @@ public:
     {}
 
     //--------------------------------------------------------------------------
-    //! \brief Copy operator needed because this class has constant member
-    //! variables.
+    //! \brief Copy constructor. Arcs are not copied since they refer to the
+    //! net of the copied node: the Net class regenerates them.
+    //--------------------------------------------------------------------------
+    Node(Node const& other)
+        : type(other.type), id(other.id), key(other.key), x(other.x),
+          y(other.y), caption(other.caption)
+    {}
+
+    //--------------------------------------------------------------------------
+    //! \brief Copy operator. Arcs are not copied (see the copy constructor).
     //--------------------------------------------------------------------------
     Node& operator=(Node const& other)
     {
-        this->~Node(); // destroy
-        new (this) Node(other); // copy construct in place
+        type = other.type;
+        id = other.id;
+        key = other.key;
+        x = other.x;
+        y = other.y;
+        caption = other.caption;
+        arcsIn.clear();
+        arcsOut.clear();
         return *this;
     }
 
     //--------------------------------------------------------------------------
-    //! \brief Needed because this class has constant member variables.
-    //--------------------------------------------------------------------------
-    Node(Node const& other)
-        : Node(other.type, other.id, other.caption, other.x, other.y)
-    {}
-
-    //--------------------------------------------------------------------------
-    //! \brief Needed because this class has constant member variables.
+    //! \brief Move constructor: strings and arcs are moved, not copied. Arcs
+    //! still refer to the moved node: the Net class shall update them.
     //--------------------------------------------------------------------------
-    Node(Node&& other)
-        : Node(other.type, other.id, other.caption, other.x, other.y)
-    {}
+    Node(Node&& other) noexcept = default;
 
     //--------------------------------------------------------------------------
-    //! \brief Needed because this class has constant member variables.
+    //! \brief Move operator: see the move constructor.
     //--------------------------------------------------------------------------
-    Node& operator=(Node&& other)
-    {
-        this->~Node(); // destroy
-        new (this) Node(other); // copy construct in place
-        return *this;
-    }
+    Node& operator=(Node&& other) noexcept = default;
 
 public:
 
     //! \brief Type of nodes: Petri Place or Petri Transition. Once created, it
     //! is not supposed to be changed.
-    Type const type;
+    Type type;
     //! \brief Unique identifier (auto-incremented from 0 by the derived class).
-    //! Once created, it is not supposed to be changed.
-    size_t const id;
+    //! Once created, it is not supposed to be changed (except by the Net when
+    //! removing nodes). Not constant to allow moving nodes.
+    size_t id;
     //! \brief Unique node identifier as string. It is formed by the 'P' char
     //! for place or by the 'T' char for transition followed by the unique
     //! identifier (i.e. "P0", "P1", "T0", "T1", ...). Once created, it is not
-    //! supposed to be changed.
-    std::string const key;
+    //! supposed to be changed (except by the Net when removing nodes).
+    std::string key;
     //! \brief Position inside the window needed for the display.
     float x;
     //! \brief Position in the window needed for the display.
@@ -151,12 +155,12 @@ public:
     //! the tring unique \c key.
     std::string caption;
     //! \brief Hold the incoming arcs to access to previous nodes.
-    //! \note this vector is not updated by this class but shall be made by
-    //! the caller.
+    //! \note this vector is not updated by this class but by the Net class
+    //! when adding or removing arcs.
     std::vector<Arc*> arcsIn;
     //! \brief Hold the outcoming arcs to access to successor nodes.
-    //! \note this vector is not updated by this class but shall be made by
-    //! the caller.
+    //! \note this vector is not updated by this class but by the Net class
+    //! when adding or removing arcs.
     std::vector<Arc*> arcsOut;
 };
 
@@ -373,47 +377,48 @@ public:
     //! \param[in] to_: Destination node (Place or Transition).
     //! \param[in] duration_: Duration of the process (in unit of time) if \c to_
     //! is a Place (else the duration is forced to NaN).
+    //! \param[in] index_: Position of the arc inside Net::arcs().
     //! \note Nodes shall have different types. Assertion is made here.
     //--------------------------------------------------------------------------
-    Arc(Node& from_, Node& to_, float duration_ = 0.0f)
+    Arc(Node& from_, Node& to_, float duration_ = 0.0f, size_t const index_ = 0u)
         : from(from_), to(to_),
-          duration(from_.type == Node::Type::Transition ? duration_ : std::numeric_limits<float>::quiet_NaN())
+          duration(from_.type == Node::Type::Transition ? duration_ : std::numeric_limits<float>::quiet_NaN()),
+          index(index_)
     {
         assert(from.type != to.type);
     }
 
     //--------------------------------------------------------------------------
-    //! \brief Needed because of usage of references.
+    //! \brief Copy constructor. An arc only holds references and scalars:
+    //! copies and moves are allocation-free.
     //--------------------------------------------------------------------------
-    Arc& operator=(Arc const& other)
-    {
-        this->~Arc(); // destroy
-        new (this) Arc(other); // copy construct in place
-        return *this;
-    }
+    Arc(Arc const& other) noexcept = default;
 
     //--------------------------------------------------------------------------
-    //! \brief Needed because of usage of references.
+    //! \brief Move constructor: same than the copy constructor.
     //--------------------------------------------------------------------------
-    Arc(Arc const& other)
-        : Arc(other.from, other.to, other.duration)
-    {}
+    Arc(Arc&& other) noexcept = default;
 
     //--------------------------------------------------------------------------
-    //! \brief Needed because of usage of references.
+    //! \brief Copy operator. Needed because references cannot be reassigned:
+    //! the arc is rebuilt in place.
     //--------------------------------------------------------------------------
-    Arc(Arc&& other) noexcept
-        : Arc(other.from, other.to, other.duration)
-    {}
+    Arc& operator=(Arc const& other) noexcept
+    {
+        if (this != &other)
+        {
+            this->~Arc(); // destroy (trivial)
+            new (this) Arc(other); // copy construct in place
+        }
+        return *this;
+    }
 
     //--------------------------------------------------------------------------
-    //! \brief Needed because of usage of references.
+    //! \brief Move operator: same than the copy operator.
     //--------------------------------------------------------------------------
     Arc& operator=(Arc&& other) noexcept
     {
-        this->~Arc(); // destroy
-        new (this) Arc(other); // copy construct in place
-        return *this;
+        return *this = static_cast<Arc const&>(other);
     }
 
     //--------------------------------------------------------------------------
@@ -456,8 +461,14 @@ public:
     //! \note for the animation of tokens during the simulation, seconds are
     //! used.
     float duration;
+    //! \brief Position of the arc inside Net::arcs(). Maintained by the Net:
+    //! indices are dense (0 .. arcs().size() - 1) and allow algorithms (like
+    //! the simulation) to store per-arc data inside vectors.
+    size_t index;
 };
 
+class NetDelta;
+
 // *****************************************************************************
 //! \brief Class storing and managing Places, Transitions and Arcs.
 //! This class does not offer method for the simulation but has to be seen as a
@@ -467,6 +478,8 @@ class Net
 {
     friend bool convertTo(Net& net, TypeOfNet const type, std::string& error,
                           std::vector<Arc*>& erroneous_arcs);
+    //! \brief To undo and redo modifications.
+    friend class NetDelta;
 
 public:
 
@@ -503,15 +516,30 @@ public:
     explicit Net(TypeOfNet const type = TypeOfNet::TimedPetriNet);
 
     //--------------------------------------------------------------------------
-    //! \brief Copy constructor. Needed to remove compilation warnings.
+    //! \brief Copy constructor. Arcs of the copy refer to nodes of the copy.
+    //! The copy gets new revisions.
     //--------------------------------------------------------------------------
     Net(Net const& other);
 
     //--------------------------------------------------------------------------
-    //! \brief Copy operator. Needed to remove compilation warnings.
+    //! \brief Copy operator. See the copy constructor.
     //--------------------------------------------------------------------------
     Net& operator=(Net const& other);
 
+    //--------------------------------------------------------------------------
+    //! \brief Move constructor in O(1). Containers are moved: nodes and arcs
+    //! keep their address, so arcs and the addresses of arcs held by other
+    //! classes (for example CriticalCycleResult) stay valid, and so does the
+    //! revisions of the net. The moved net is left empty with new revisions.
+    //! \note Not noexcept: moving a std::deque may allocate.
+    //--------------------------------------------------------------------------
+    Net(Net&& other);
+
+    //--------------------------------------------------------------------------
+    //! \brief Move operator in O(1). See the move constructor.
+    //--------------------------------------------------------------------------
+    Net& operator=(Net&& other);
+
     //--------------------------------------------------------------------------
     //! \brief Remove all nodes and arcs. Reset counters for unique identifiers.
     //! Change the type of net for the new one. Reset the name of the net (give
@@ -623,7 +651,7 @@ public:
 
     //--------------------------------------------------------------------------
     //! \brief Search and return a place or a transition by its unique
-    //! identifier. Search is O(n) where n is the number of nodes. Return
+    //! identifier. Search is O(1) thanks to the internal index. Return
     //! nullptr if not found.
     //! \param[in] key for example "P42" for the Place 42 or "T0" for the
     //! transition 0.
@@ -633,17 +661,19 @@ public:
 
     //--------------------------------------------------------------------------
     //! \brief Search and return a Transition by its unique identifier. Search
-    //! is O(n) where n is the number of nodes. Return nullptr if not found.
+    //! is O(1) thanks to the internal index. Return nullptr if not found.
     //! \param[in] id for example 42 for the Transition 42.
     //--------------------------------------------------------------------------
     Transition* findTransition(size_t const id);
+    Transition const* findTransition(size_t const id) const;
 
     //--------------------------------------------------------------------------
     //! \brief Search and return a Place by its unique identifier. Search
-    //! is O(n) where n is the number of nodes. Return nullptr if not found.
+    //! is O(1) thanks to the internal index. Return nullptr if not found.
     //! \param[in] id for example 42 for the Place 42.
     //--------------------------------------------------------------------------
     Place* findPlace(size_t const id);
+    Place const* findPlace(size_t const id) const;
 
     //--------------------------------------------------------------------------
     //! \brief Find a Place at the given screen position (spatial query).
@@ -699,6 +729,7 @@ public:
 
     //--------------------------------------------------------------------------
     //! \brief Return the address of the arc linking the two given nodes.
+    //! Search is O(1) thanks to the internal index.
     //! \param[in] from: source node (Place or Transition).
     //! \param[in] to: destination node (Place or Transition but not of the same
     //! type than the destination node).
@@ -731,7 +762,11 @@ public:
 
     //--------------------------------------------------------------------------
     //! \brief Populate or update Node::arcsIn and Node::arcsOut for all
-    //! transitions and places in the Petri net.
+    //! transitions and places in the Petri net. Complexity is O(A) where A is
+    //! the number of arcs.
+    //! \note Adding or removing nodes and arcs already updates them
+    //! incrementally: calling this method is only needed when arcs have been
+    //! copied (i.e. copy constructor).
     //--------------------------------------------------------------------------
     void generateArcsInArcsOut(); // FIXME a placer dana protected
 
@@ -740,6 +775,47 @@ public:
     //--------------------------------------------------------------------------
     void resetReceptivies(); // FIXME a placer dans protected
 
+    //--------------------------------------------------------------------------
+    //! \brief Return the revision of the structure of the net: type of net,
+    //! nodes, arcs, captions and durations (positions of nodes are not part of
+    //! it). The revision changes each time the structure is modified by the
+    //! methods of this class or by touchStructure(). Revisions are unique
+    //! among all nets (a copied net gets new revisions) so they can be used
+    //! as key for caching results of analysis (see AnalysisCache).
+    //--------------------------------------------------------------------------
+    inline uint64_t structureRevision() const { return m_structure_revision; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the revision of the marking (tokens of places). Results
+    //! depending on tokens shall be keyed on both revisions.
+    //--------------------------------------------------------------------------
+    inline uint64_t markingRevision() const { return m_marking_revision; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Give a new structure revision. To be called after modifying
+    //! directly public fields (Node::caption, Arc::duration ...).
+    //--------------------------------------------------------------------------
+    void touchStructure();
+
+    //--------------------------------------------------------------------------
+    //! \brief Give a new marking revision. To be called after modifying
+    //! directly Place::tokens (Place::increment() ...).
+    //--------------------------------------------------------------------------
+    void touchMarking();
+
+    //--------------------------------------------------------------------------
+    //! \brief Record the modifications of the structure made by the methods of
+    //! this class (adding and removing nodes and arcs, clear() and reset())
+    //! into the given delta, allowing to undo them. Pass nullptr to stop
+    //! recording. The delta is not copied or moved along with the net.
+    //--------------------------------------------------------------------------
+    inline void journal(NetDelta* delta) { m_journal = delta; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the delta recording modifications or nullptr.
+    //--------------------------------------------------------------------------
+    inline NetDelta* journal() const { return m_journal; }
+
 protected:
 
     //--------------------------------------------------------------------------
@@ -778,6 +854,111 @@ protected:
     //--------------------------------------------------------------------------
     void helperRemoveArcFromNode(Node const& node);
 
+    //--------------------------------------------------------------------------
+    //! \brief Helper method for the swap-and-pop of nodes: make the incoming
+    //! and outgoing arcs of \c node refer to it instead of the node \c moved
+    //! it has been moved from inside the container (and whose identifier has
+    //! been given to \c node).
+    //--------------------------------------------------------------------------
+    void helperMoveArcs(Node const& moved, Node& node);
+
+    //--------------------------------------------------------------------------
+    //! \brief Helper method for the swap-and-pop of nodes: move the node
+    //! \c last into the slot of the removed node \c node. The moved node takes
+    //! the identifier of the removed node. Strings and GRAFCET data are moved,
+    //! not copied.
+    //--------------------------------------------------------------------------
+    template<class N>
+    void helperMoveNode(N& node, N& last);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //! \brief Key of the arc index: unique codes of the origin and destination
+    //! nodes (see nodeCode()).
+    //--------------------------------------------------------------------------
+    using ArcKey = std::pair<size_t, size_t>;
+
+    //--------------------------------------------------------------------------
+    //! \brief Hash function for ArcKey.
+    //--------------------------------------------------------------------------
+    struct ArcKeyHash
+    {
+        size_t operator()(ArcKey const& key) const
+        {
+            size_t const golden = static_cast<size_t>(0x9E3779B97F4A7C15ull);
+            return std::hash<size_t>()(key.first ^ (key.second * golden));
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Return a code unique for all places and transitions: the
+    //! identifier shifted by one bit and the type of node in the lowest bit.
+    //--------------------------------------------------------------------------
+    static size_t nodeCode(Node const& node)
+    {
+        return (node.id << 1u) | size_t(node.type == Node::Type::Transition);
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the key of the arc index for the given pair of nodes.
+    //--------------------------------------------------------------------------
+    static ArcKey arcKey(Node const& from, Node const& to)
+    {
+        return { nodeCode(from), nodeCode(to) };
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Helper method removing the arc stored at the given slot of the
+    //! container. The latest arc takes its location and the index is updated.
+    //--------------------------------------------------------------------------
+    void helperRemoveArcAt(size_t const slot);
+
+    //--------------------------------------------------------------------------
+    //! \brief Helper method appending the arc from -> to without sanity checks.
+    //! Nodes shall have different types.
+    //--------------------------------------------------------------------------
+    Arc& helperAddArc(Node& from, Node& to, float const duration);
+
+    //--------------------------------------------------------------------------
+    //! \brief Inverse of helperRemoveArcAt(): insert the arc from -> to at the
+    //! given slot of the container (the arc holding this slot goes back at the
+    //! end) and at the given positions inside from.arcsOut and to.arcsIn.
+    //--------------------------------------------------------------------------
+    Arc& helperInsertArc(Node& from, Node& to, float const duration,
+                         size_t const slot, size_t const out_position,
+                         size_t const in_position);
+
+    //--------------------------------------------------------------------------
+    //! \brief Helper method for clear(): without recording into the journal.
+    //--------------------------------------------------------------------------
+    void helperClear();
+
+    //--------------------------------------------------------------------------
+    //! \brief Inverse of helperRemovePlace(): put back the removed place (without
+    //! arcs) in its slot. The place which has been moved in this slot goes back
+    //! at the end of the container with its former identifier \c moved_id. Its
+    //! caption is restored to its key if \c default_caption is set.
+    //--------------------------------------------------------------------------
+    Place& helperRestorePlace(Place&& place, size_t const moved_id,
+                              bool const default_caption);
+
+    //--------------------------------------------------------------------------
+    //! \brief Inverse of helperRemoveTransition(). See helperRestorePlace().
+    //--------------------------------------------------------------------------
+    Transition& helperRestoreTransition(Transition&& transition,
+                                        size_t const moved_id,
+                                        bool const default_caption);
+
+    //--------------------------------------------------------------------------
+    //! \brief Implementation of helperRestorePlace() and
+    //! helperRestoreTransition().
+    //--------------------------------------------------------------------------
+    template<class N, class C>
+    N& helperRestoreNode(C& nodes, std::unordered_map<size_t, size_t>& slots,
+                         size_t& next_id, N&& node, size_t const moved_id,
+                         bool const default_caption);
+
 public:
 
     //! \brief Name of Petri net given by its filename once load() has been called.
@@ -803,6 +984,20 @@ private:
     //! \brief Auto increment unique identifier. Start from 0 (code placed in
     //! the cpp file). Note: their reset is possible through class friendship.
     size_t m_next_transition_id = 0u;
+    //! \brief Index of Places: unique identifier -> slot in m_places.
+    std::unordered_map<size_t, size_t> m_place_slots;
+    //! \brief Index of Transitions: unique identifier -> slot in m_transitions.
+    std::unordered_map<size_t, size_t> m_transition_slots;
+    //! \brief Index of Arcs: (origin, destination) -> slot in m_arcs. Slots are
+    //! stored instead of addresses so the index can be copied along with the
+    //! containers.
+    std::unordered_map<ArcKey, size_t, ArcKeyHash> m_arc_slots;
+    //! \brief See structureRevision().
+    uint64_t m_structure_revision;
+    //! \brief See markingRevision().
+    uint64_t m_marking_revision;
+    //! \brief See journal().
+    NetDelta* m_journal = nullptr;
 };
 
 //-----------------------------------------------------------------------------
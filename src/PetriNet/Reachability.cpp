@@ -0,0 +1,686 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/Reachability.hpp"
+#include "PetriNet/PetriNet.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+namespace tpne {
+
+//! \brief Size of the memory blocks of arenas.
+static constexpr size_t BLOCK_SIZE = 1u << 20;
+//! \brief Number of states given at once to a worker.
+static constexpr size_t CHUNK = 64u;
+//! \brief Maximum number of states expanded between two synchronizations of
+//! workers. Bounds the memory needed by the set of visited markings.
+static constexpr size_t MAX_SLICE = 65536u;
+
+// *****************************************************************************
+//! \brief Memory holding the records of a worker. Blocks are never moved nor
+//! freed before the next exploration, so records can be read by other workers
+//! once published in the set of visited markings.
+//!
+//! A record is: the state identifier (size_t, set at the end of the level),
+//! the size of the encoded marking (varint) then the encoded marking.
+// *****************************************************************************
+struct ReachabilityGraph::Arena
+{
+    //! \brief Return the memory for a record of the given size.
+    uint8_t* allocate(size_t const size)
+    {
+        if (blocks.empty() || (used + size > capacity))
+        {
+            capacity = std::max(BLOCK_SIZE, size);
+            blocks.emplace_back(new uint8_t[capacity]);
+            used = 0u;
+        }
+        uint8_t* record = blocks.back().get() + used;
+        used += size;
+        total += size;
+        return record;
+    }
+
+    //! \brief Store the record of the encoded marking.
+    //! \param[out] size the size of the record.
+    uint8_t* store(std::vector<uint8_t> const& payload, size_t& size)
+    {
+        uint8_t length[16];
+        size_t count = 0u;
+        size_t value = payload.size();
+        while (value >= 0x80u)
+        {
+            length[count++] = uint8_t(value | 0x80u);
+            value >>= 7;
+        }
+        length[count++] = uint8_t(value);
+
+        size = sizeof(size_t) + count + payload.size();
+        uint8_t* record = allocate(size);
+        size_t const id = ReachabilityGraph::NONE;
+        std::memcpy(record, &id, sizeof(size_t));
+        std::memcpy(record + sizeof(size_t), length, count);
+        if (!payload.empty())
+            std::memcpy(record + sizeof(size_t) + count, payload.data(), payload.size());
+        return record;
+    }
+
+    //! \brief Free the latest record (the marking was already visited).
+    void release(size_t const size)
+    {
+        used -= size;
+        total -= size;
+    }
+
+    std::vector<std::unique_ptr<uint8_t[]>> blocks;
+    //! \brief Size of the latest block.
+    size_t capacity = 0u;
+    //! \brief Bytes used in the latest block.
+    size_t used = 0u;
+    //! \brief Bytes used by records.
+    size_t total = 0u;
+};
+
+// *****************************************************************************
+//! \brief Memory and results of a worker thread for the current slice of
+//! states. Results are merged by the main thread at the end of the slice.
+// *****************************************************************************
+struct ReachabilityGraph::Worker
+{
+    //! \brief Marking visited for the first time.
+    struct NewState
+    {
+        uint8_t const* record;
+        size_t parent;
+        size_t transition;
+    };
+
+    //! \brief Arc of the graph before knowing the identifier of its target.
+    struct NewEdge
+    {
+        size_t source;
+        size_t transition;
+        uint8_t const* target;
+    };
+
+    Arena arena;
+    std::vector<NewState> states;
+    std::vector<NewEdge> edges;
+    std::vector<size_t> deadlocks;
+    std::vector<size_t> bounds;
+    //! \brief Stopped by Options::max_states.
+    bool truncated = false;
+    // Buffers reused between states.
+    Marking marking;
+    Marking successor;
+    Marking ancestor;
+    std::vector<uint8_t> payload;
+    std::vector<size_t> enabled;
+    // Stubborn sets: transitions to fire, candidate set, closure stack.
+    std::vector<size_t> stubborn;
+    std::vector<size_t> candidate;
+    std::vector<size_t> stack;
+    //! \brief Transitions enabled by the current marking.
+    std::vector<uint8_t> is_enabled;
+    //! \brief Transitions visited by the current closure have stamps[t] ==
+    //! stamp (avoids clearing between closures).
+    std::vector<size_t> stamps;
+    size_t stamp = 0u;
+};
+
+//------------------------------------------------------------------------------
+static inline void putVarint(std::vector<uint8_t>& out, size_t value)
+{
+    while (value >= 0x80u)
+    {
+        out.push_back(uint8_t(value | 0x80u));
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+//------------------------------------------------------------------------------
+static inline size_t getVarint(uint8_t const*& in)
+{
+    size_t value = 0u;
+    unsigned shift = 0u;
+    while (*in & 0x80u)
+    {
+        value |= size_t(*in++ & 0x7Fu) << shift;
+        shift += 7u;
+    }
+    return value | (size_t(*in++) << shift);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Encode the marking as pairs of varints (empty places skipped, tokens)
+//! for each place holding tokens. OMEGA is encoded as 0 tokens.
+//------------------------------------------------------------------------------
+static void encode(ReachabilityGraph::Marking const& marking, std::vector<uint8_t>& payload)
+{
+    payload.clear();
+    size_t skipped = 0u;
+    for (auto const tokens: marking)
+    {
+        if (tokens == 0u)
+        {
+            ++skipped;
+            continue;
+        }
+        putVarint(payload, skipped);
+        putVarint(payload, (tokens == ReachabilityGraph::OMEGA) ? 0u : tokens);
+        skipped = 0u;
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Return the encoded marking of the record and its size.
+//------------------------------------------------------------------------------
+static inline uint8_t const* payloadOf(uint8_t const* record, size_t& size)
+{
+    record += sizeof(size_t);
+    size = getVarint(record);
+    return record;
+}
+
+//------------------------------------------------------------------------------
+static inline size_t idOf(uint8_t const* record)
+{
+    size_t id;
+    std::memcpy(&id, record, sizeof(size_t));
+    return id;
+}
+
+//------------------------------------------------------------------------------
+//! \brief FNV-1a hash of the encoded marking with a final mix: low bits are
+//! used for indexing the set of visited markings.
+//------------------------------------------------------------------------------
+static inline uint64_t hashOf(uint8_t const* data, size_t const size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0u; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Fire the transition once. OMEGA places stay unbounded.
+//------------------------------------------------------------------------------
+static void fire(CompiledNet const& net, size_t const t, ReachabilityGraph::Marking& marking)
+{
+    for (size_t k = net.preBegin(t); k < net.preEnd(t); ++k)
+    {
+        size_t& tokens = marking[net.prePlace(k)];
+        if (tokens != ReachabilityGraph::OMEGA)
+            tokens -= net.preWeight(k);
+    }
+    for (size_t k = net.postBegin(t); k < net.postEnd(t); ++k)
+    {
+        size_t& tokens = marking[net.postPlace(k)];
+        size_t const n = net.postWeight(k);
+        if (tokens != ReachabilityGraph::OMEGA)
+        {
+            tokens = (Net::Settings::maxTokens - tokens >= n)
+                     ? tokens + n : Net::Settings::maxTokens;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+ReachabilityGraph::ReachabilityGraph(CompiledNet const& net)
+    : m_net(net)
+{}
+
+//------------------------------------------------------------------------------
+ReachabilityGraph::~ReachabilityGraph() = default;
+
+//------------------------------------------------------------------------------
+bool ReachabilityGraph::explore(Options const& options)
+{
+    return explore(options, m_net.initialMarking());
+}
+
+//------------------------------------------------------------------------------
+bool ReachabilityGraph::explore(Options const& options, Marking const& initial)
+{
+    m_options = options;
+    m_accelerate = options.coverability &&
+        (Net::Settings::maxTokens == std::numeric_limits<size_t>::max());
+    m_reduce = options.reduction && !options.coverability &&
+        (Net::Settings::maxTokens == std::numeric_limits<size_t>::max());
+    m_complete = false;
+    m_truncated = false;
+    m_records.clear();
+    m_parents.clear();
+    m_fired.clear();
+    m_slots.reset();
+    m_mask = 0u;
+    m_edge_offsets.clear();
+    m_edges.clear();
+    m_deadlocks.clear();
+    m_bounds.assign(m_net.countPlaces(), 0u);
+
+    size_t threads = options.threads;
+    if (threads == 0u)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    m_workers.clear();
+    for (size_t i = 0u; i < threads; ++i)
+    {
+        m_workers.emplace_back(new Worker);
+        m_workers.back()->bounds.assign(m_net.countPlaces(), 0u);
+        if (m_reduce)
+        {
+            m_workers.back()->is_enabled.assign(m_net.countTransitions(), 0u);
+            m_workers.back()->stamps.assign(m_net.countTransitions(), 0u);
+        }
+    }
+
+    // Initial state.
+    Worker& main = *m_workers[0];
+    size_t size;
+    encode(initial, main.payload);
+    uint8_t* record = main.arena.store(main.payload, size);
+    reserve(1u);
+    insert(record);
+    size_t const id = 0u;
+    std::memcpy(record, &id, sizeof(size_t));
+    m_records.push_back(record);
+    m_parents.push_back(NONE);
+    m_fired.push_back(NONE);
+    if (options.edges)
+        m_edge_offsets.push_back(0u);
+
+    // Breadth-first search: states of a level are expanded by slices. Between
+    // two slices, identifiers are given to new states and the set of visited
+    // markings can grow.
+    size_t const transitions = std::max(size_t(1u), m_net.countTransitions());
+    size_t level_begin = 0u;
+    size_t level_end = 1u;
+    while ((level_begin < level_end) && (!m_truncated))
+    {
+        size_t begin = level_begin;
+        while ((begin < level_end) && (!m_truncated))
+        {
+            size_t const slice = std::min({ level_end - begin, MAX_SLICE,
+                std::max(size_t(1u), (m_records.size() + MAX_SLICE) / transitions) });
+            size_t const end = begin + slice;
+            reserve(m_records.size() + slice * transitions);
+            m_inserted = 0u;
+
+            std::atomic<size_t> next{begin};
+            auto work = [&](Worker& worker)
+            {
+                size_t first;
+                while ((first = next.fetch_add(CHUNK)) < end)
+                    expand(worker, first, std::min(first + CHUNK, end));
+            };
+
+            size_t const count = std::min(threads, (slice + CHUNK - 1u) / CHUNK);
+            std::vector<std::thread> pool;
+            for (size_t i = 1u; i < count; ++i)
+                pool.emplace_back(work, std::ref(*m_workers[i]));
+            work(main);
+            for (auto& thread: pool)
+                thread.join();
+
+            // Give identifiers to new states.
+            for (auto& worker: m_workers)
+            {
+                for (auto const& state: worker->states)
+                {
+                    size_t const s = m_records.size();
+                    std::memcpy(const_cast<uint8_t*>(state.record), &s, sizeof(size_t));
+                    m_records.push_back(state.record);
+                    m_parents.push_back(state.parent);
+                    m_fired.push_back(state.transition);
+                }
+                worker->states.clear();
+                m_deadlocks.insert(m_deadlocks.end(), worker->deadlocks.begin(),
+                                   worker->deadlocks.end());
+                worker->deadlocks.clear();
+                m_truncated |= worker->truncated;
+            }
+
+            // Counting sort of arcs by source state: arcs of a state are
+            // created by a single worker in the order of transitions. Arcs
+            // to states dropped by Options::max_states have no identifier
+            // and are dropped too.
+            if (options.edges)
+            {
+                size_t const base = m_edges.size();
+                m_edge_offsets.resize(end + 1u, 0u);
+                for (auto const& worker: m_workers)
+                {
+                    for (auto const& e: worker->edges)
+                    {
+                        if (idOf(e.target) != NONE)
+                            ++m_edge_offsets[e.source + 1u];
+                    }
+                }
+                std::vector<size_t> position(slice);
+                for (size_t s = begin; s < end; ++s)
+                {
+                    position[s - begin] = m_edge_offsets[s];
+                    m_edge_offsets[s + 1u] += m_edge_offsets[s];
+                }
+                m_edges.resize(m_edge_offsets[end]);
+                for (auto& worker: m_workers)
+                {
+                    for (auto const& e: worker->edges)
+                    {
+                        size_t const target = idOf(e.target);
+                        if (target != NONE)
+                            m_edges[position[e.source - begin]++] = { e.transition, target };
+                    }
+                    worker->edges.clear();
+                }
+                assert(m_edge_offsets[begin] == base); (void) base;
+            }
+
+            begin = end;
+        }
+
+        level_begin = level_end;
+        level_end = m_records.size();
+    }
+
+    std::sort(m_deadlocks.begin(), m_deadlocks.end());
+    for (auto const& worker: m_workers)
+    {
+        for (size_t p = 0u; p < m_bounds.size(); ++p)
+            m_bounds[p] = std::max(m_bounds[p], worker->bounds[p]);
+    }
+    m_complete = !m_truncated;
+    return m_complete;
+}
+
+//------------------------------------------------------------------------------
+void ReachabilityGraph::reserve(size_t const states)
+{
+    size_t capacity = 1024u;
+    while (capacity < 2u * states)
+        capacity <<= 1;
+    if (m_slots && (capacity <= m_mask + 1u))
+        return ;
+
+    m_slots.reset(new std::atomic<uint8_t const*>[capacity]);
+    for (size_t i = 0u; i < capacity; ++i)
+        m_slots[i].store(nullptr, std::memory_order_relaxed);
+    m_mask = capacity - 1u;
+    for (auto const record: m_records)
+        insert(record);
+}
+
+//------------------------------------------------------------------------------
+uint8_t const* ReachabilityGraph::insert(uint8_t const* record)
+{
+    size_t size;
+    uint8_t const* payload = payloadOf(record, size);
+    size_t i = hashOf(payload, size) & m_mask;
+    while (true)
+    {
+        uint8_t const* current = m_slots[i].load(std::memory_order_acquire);
+        if ((current == nullptr) &&
+            m_slots[i].compare_exchange_strong(current, record,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire))
+        {
+            return record;
+        }
+
+        // The slot is taken (maybe by another worker meanwhile).
+        size_t other_size;
+        uint8_t const* other = payloadOf(current, other_size);
+        if ((other_size == size) && (std::memcmp(other, payload, size) == 0))
+            return current;
+        i = (i + 1u) & m_mask;
+    }
+}
+
+//------------------------------------------------------------------------------
+void ReachabilityGraph::expand(Worker& worker, size_t const begin, size_t const end)
+{
+    size_t const transitions = m_net.countTransitions();
+    for (size_t s = begin; s < end; ++s)
+    {
+        marking(s, worker.marking);
+        for (size_t p = 0u; p < worker.marking.size(); ++p)
+            worker.bounds[p] = std::max(worker.bounds[p], worker.marking[p]);
+
+        worker.enabled.clear();
+        for (size_t t = 0u; t < transitions; ++t)
+        {
+            if (m_net.isEnabled(t, worker.marking))
+                worker.enabled.push_back(t);
+        }
+        if (worker.enabled.empty())
+        {
+            worker.deadlocks.push_back(s);
+            continue;
+        }
+
+        std::vector<size_t> const* fired = &worker.enabled;
+        if (m_reduce && (worker.enabled.size() > 1u))
+        {
+            stubbornSet(worker);
+            fired = &worker.stubborn;
+        }
+
+        for (auto const t: *fired)
+        {
+            worker.successor = worker.marking;
+            fire(m_net, t, worker.successor);
+            if (m_accelerate)
+                accelerate(s, worker.successor, worker.ancestor);
+
+            size_t size;
+            encode(worker.successor, worker.payload);
+            uint8_t const* record = worker.arena.store(worker.payload, size);
+            uint8_t const* found = insert(record);
+            if (found == record)
+            {
+                if ((m_options.max_states != 0u) && (m_records.size() +
+                    m_inserted.fetch_add(1u) >= m_options.max_states))
+                {
+                    // Too many states: the record stays in the set but has no
+                    // identifier. The exploration ends with this slice.
+                    worker.truncated = true;
+                    continue;
+                }
+                worker.states.push_back({ record, s, t });
+            }
+            else
+            {
+                worker.arena.release(size);
+            }
+
+            if (m_options.edges)
+                worker.edges.push_back({ s, t, found });
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void ReachabilityGraph::accelerate(size_t const parent, Marking& marking,
+                                   Marking& ancestor) const
+{
+    for (size_t a = parent; a != NONE; a = m_parents[a])
+    {
+        this->marking(a, ancestor);
+
+        bool covers = true;
+        bool strictly = false;
+        for (size_t p = 0u; p < marking.size(); ++p)
+        {
+            if (marking[p] < ancestor[p])
+            {
+                covers = false;
+                break;
+            }
+            strictly |= (marking[p] > ancestor[p]);
+        }
+
+        if (covers && strictly)
+        {
+            for (size_t p = 0u; p < marking.size(); ++p)
+            {
+                if (marking[p] > ancestor[p])
+                    marking[p] = OMEGA;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void ReachabilityGraph::stubbornSet(Worker& worker) const
+{
+    for (auto const t: worker.enabled)
+        worker.is_enabled[t] = 1u;
+
+    worker.stubborn = worker.enabled;
+    for (auto const seed: worker.enabled)
+    {
+        if (!closure(worker, seed, worker.stubborn.size()))
+            continue;
+        worker.stubborn.swap(worker.candidate);
+        if (worker.stubborn.size() == 1u)
+            break;
+    }
+
+    for (auto const t: worker.enabled)
+        worker.is_enabled[t] = 0u;
+
+    // Fire in the order of transitions like the non reduced search.
+    std::sort(worker.stubborn.begin(), worker.stubborn.end());
+}
+
+//------------------------------------------------------------------------------
+bool ReachabilityGraph::closure(Worker& worker, size_t const seed, size_t const bound) const
+{
+    size_t const stamp = ++worker.stamp;
+    worker.candidate.clear();
+    worker.stack.assign(1u, seed);
+    worker.stamps[seed] = stamp;
+
+    auto visit = [&worker, stamp](size_t const t)
+    {
+        if (worker.stamps[t] != stamp)
+        {
+            worker.stamps[t] = stamp;
+            worker.stack.push_back(t);
+        }
+    };
+
+    while (!worker.stack.empty())
+    {
+        size_t const t = worker.stack.back();
+        worker.stack.pop_back();
+
+        if (worker.is_enabled[t])
+        {
+            worker.candidate.push_back(t);
+            if (worker.candidate.size() >= bound)
+                return false;
+
+            // Transitions in conflict: they consume tokens of t.
+            for (size_t k = m_net.preBegin(t); k < m_net.preEnd(t); ++k)
+            {
+                size_t const p = m_net.prePlace(k);
+                for (size_t c = m_net.consumersBegin(p); c < m_net.consumersEnd(p); ++c)
+                    visit(m_net.consumer(c));
+            }
+        }
+        else
+        {
+            // Producers of the input place lacking tokens having the least
+            // producers: t stays disabled until one of them fires.
+            size_t place = NONE;
+            size_t count = NONE;
+            for (size_t k = m_net.preBegin(t); k < m_net.preEnd(t); ++k)
+            {
+                size_t const p = m_net.prePlace(k);
+                size_t const n = m_net.producersEnd(p) - m_net.producersBegin(p);
+                if ((worker.marking[p] < m_net.preWeight(k)) && (n < count))
+                {
+                    place = p;
+                    count = n;
+                }
+            }
+            for (size_t c = m_net.producersBegin(place); c < m_net.producersEnd(place); ++c)
+                visit(m_net.producer(c));
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void ReachabilityGraph::marking(size_t const state, Marking& marking) const
+{
+    marking.assign(m_net.countPlaces(), 0u);
+
+    size_t size;
+    uint8_t const* payload = payloadOf(m_records[state], size);
+    uint8_t const* const end = payload + size;
+    size_t p = 0u;
+    while (payload < end)
+    {
+        p += getVarint(payload);
+        size_t const tokens = getVarint(payload);
+        marking[p++] = (tokens == 0u) ? OMEGA : tokens;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool ReachabilityGraph::isBounded() const
+{
+    return m_complete && !m_reduce && std::none_of(m_bounds.begin(), m_bounds.end(),
+        [](size_t const bound) { return bound == OMEGA; });
+}
+
+//------------------------------------------------------------------------------
+std::vector<size_t> ReachabilityGraph::trace(size_t const state) const
+{
+    std::vector<size_t> transitions;
+    for (size_t s = state; m_parents[s] != NONE; s = m_parents[s])
+        transitions.push_back(m_fired[s]);
+    std::reverse(transitions.begin(), transitions.end());
+    return transitions;
+}
+
+//------------------------------------------------------------------------------
+size_t ReachabilityGraph::memory() const
+{
+    size_t bytes = 0u;
+    for (auto const& worker: m_workers)
+        bytes += worker->arena.total;
+    return bytes;
+}
+
+} // namespace tpne
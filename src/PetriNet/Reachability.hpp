@@ -0,0 +1,297 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef REACHABILITY_HPP
+#  define REACHABILITY_HPP
+
+#  include "PetriNet/CompiledNet.hpp"
+
+#  include <atomic>
+#  include <cstdint>
+#  include <limits>
+#  include <memory>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Explicit state space of a Petri net: its reachability graph or, for
+//! unbounded nets, its coverability graph (Karp-Miller).
+//!
+//! States are the markings reached from the initial marking by firing one
+//! transition at a time. A transition is enabled with the same rule than
+//! Transition::isEnabled() (see CompiledNet::isEnabled()). Receptivities are
+//! not evaluated: all transitions are considered as receptive, therefore
+//! all possible behaviors of a GRAFCET are explored. Tokens are constrained by
+//! Net::Settings::maxTokens (1 for GRAFCET) like CompiledNet::produce().
+//!
+//! Each marking is stored once (hash-consing) inside memory arenas, encoded as
+//! varints (LEB128): for each place holding tokens, the number of empty places
+//! skipped since the previous one then its tokens. Markings of large safe nets
+//! fit in a few bytes.
+//!
+//! The exploration is a breadth-first search synchronized on levels: states of
+//! a level are expanded by a pool of threads sharing a lock-free set of
+//! visited markings (open addressing, slots are claimed by compare-and-swap).
+//! Identifiers of states are given after each slice of a level: they depend on
+//! the number of threads, but the numbers of states and deadlocks and the
+//! bounds of places do not.
+//!
+//! Optionally, the search is reduced by stubborn sets (Valmari): from each
+//! state, only the enabled transitions of a stubborn set are fired. A set is
+//! stubborn when it is closed by: adding the transitions sharing an input
+//! place with its enabled transitions (conflicts) and, for each disabled
+//! transition, the producers of one of its input places lacking tokens. The
+//! transitions outside the set can neither disable nor enable the ones inside
+//! the set, so all deadlocks stay reachable while interleavings of
+//! independent transitions are explored once.
+//!
+//! \note Net::Settings shall not be modified while exploring.
+// *****************************************************************************
+class ReachabilityGraph
+{
+public:
+
+    using Marking = CompiledNet::Marking;
+
+    //! \brief Tokens of unbounded places in the coverability graph.
+    static constexpr size_t OMEGA = std::numeric_limits<size_t>::max();
+    //! \brief Parent of the initial state.
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    // *************************************************************************
+    //! \brief Parameters of the exploration.
+    // *************************************************************************
+    struct Options
+    {
+        //! \brief Build the coverability graph (Karp-Miller): a marking
+        //! strictly covering one of its ancestors has its growing places set to
+        //! OMEGA, therefore the graph is always finite. Ignored when
+        //! Net::Settings::maxTokens is finite since the net is then bounded.
+        bool coverability = false;
+        //! \brief Stop the exploration when this number of states is reached
+        //! (may be slightly exceeded with several threads). 0 for no limit.
+        size_t max_states = 10000000u;
+        //! \brief Store the arcs of the graph (see edgesBegin()).
+        bool edges = false;
+        //! \brief Number of worker threads. 0 for using all cores.
+        size_t threads = 0u;
+        //! \brief Only fire the enabled transitions of a stubborn set: all
+        //! deadlocks are found but states are a subset of reachable states.
+        //! Ignored for the coverability graph and when tokens are saturated
+        //! by Net::Settings::maxTokens (firings do not commute).
+        bool reduction = false;
+    };
+
+    // *************************************************************************
+    //! \brief Arc of the graph: firing a transition from a state.
+    // *************************************************************************
+    struct Edge
+    {
+        //! \brief Fired transition (transition index of the CompiledNet).
+        size_t transition;
+        //! \brief Reached state.
+        size_t state;
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Constructor. The graph is empty until explore() is called.
+    //! \param[in] net: the compiled net to explore. Shall outlive this
+    //! instance.
+    //--------------------------------------------------------------------------
+    explicit ReachabilityGraph(CompiledNet const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Destructor.
+    //--------------------------------------------------------------------------
+    ~ReachabilityGraph();
+
+    //--------------------------------------------------------------------------
+    //! \brief Explore the states reachable from the initial marking of the
+    //! compiled net. The previous graph is replaced.
+    //! \return true if all states have been explored (see isComplete()).
+    //--------------------------------------------------------------------------
+    bool explore(Options const& options);
+
+    //--------------------------------------------------------------------------
+    //! \brief Explore the states reachable from the given marking (indexed by
+    //! place index). The previous graph is replaced.
+    //! \return true if all states have been explored (see isComplete()).
+    //--------------------------------------------------------------------------
+    bool explore(Options const& options, Marking const& initial);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of states. The initial state is 0.
+    //--------------------------------------------------------------------------
+    inline size_t countStates() const { return m_records.size(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of arcs (0 if Options::edges was false).
+    //--------------------------------------------------------------------------
+    inline size_t countEdges() const { return m_edges.size(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return false if the exploration has been stopped by
+    //! Options::max_states: results only concern the explored states.
+    //--------------------------------------------------------------------------
+    inline bool isComplete() const { return m_complete; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return true if the exploration is complete, not reduced by
+    //! stubborn sets and no place is unbounded (OMEGA).
+    //--------------------------------------------------------------------------
+    bool isBounded() const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the maximum number of tokens of each place (indexed by
+    //! place index) over explored states. OMEGA for unbounded places.
+    //! \note With Options::reduction, bounds only concern visited states.
+    //--------------------------------------------------------------------------
+    inline std::vector<size_t> const& bounds() const { return m_bounds; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the sorted list of states where no transition is enabled.
+    //! \note With the coverability graph, OMEGA places enable transitions: a
+    //! deadlock hidden behind an unbounded place is not detected.
+    //--------------------------------------------------------------------------
+    inline std::vector<size_t> const& deadlocks() const { return m_deadlocks; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Decode the marking of the given state (indexed by place index).
+    //--------------------------------------------------------------------------
+    void marking(size_t const state, Marking& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the state from which the given state has been discovered
+    //! (NONE for the initial state).
+    //--------------------------------------------------------------------------
+    inline size_t parent(size_t const state) const { return m_parents[state]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the sequence of transitions (transition indices) leading
+    //! from the initial state to the given state: for example the trace of a
+    //! deadlock.
+    //--------------------------------------------------------------------------
+    std::vector<size_t> trace(size_t const state) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Arcs leaving the state \c s are edge(k) for k in
+    //! [edgesBegin(s), edgesEnd(s)[. Only available if Options::edges was set
+    //! and if the state has been expanded. Arcs to states dropped by
+    //! Options::max_states are not stored.
+    //--------------------------------------------------------------------------
+    inline size_t edgesBegin(size_t const s) const
+    {
+        return (s + 1u < m_edge_offsets.size()) ? m_edge_offsets[s] : 0u;
+    }
+    inline size_t edgesEnd(size_t const s) const
+    {
+        return (s + 1u < m_edge_offsets.size()) ? m_edge_offsets[s + 1u] : 0u;
+    }
+    inline Edge const& edge(size_t const k) const { return m_edges[k]; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of bytes used by the encoded markings.
+    //--------------------------------------------------------------------------
+    size_t memory() const;
+
+private:
+
+    struct Arena;
+    struct Worker;
+
+    //--------------------------------------------------------------------------
+    //! \brief Grow the set of visited markings to hold the given number of
+    //! states with a load factor below 1/2.
+    //--------------------------------------------------------------------------
+    void reserve(size_t const states);
+
+    //--------------------------------------------------------------------------
+    //! \brief Insert the encoded marking in the set of visited markings.
+    //! \return the record of the marking: the given one if it was not yet
+    //! visited, else the one already stored.
+    //--------------------------------------------------------------------------
+    uint8_t const* insert(uint8_t const* record);
+
+    //--------------------------------------------------------------------------
+    //! \brief Expand the states [begin, end[ of the current level.
+    //--------------------------------------------------------------------------
+    void expand(Worker& worker, size_t const begin, size_t const end);
+
+    //--------------------------------------------------------------------------
+    //! \brief Set to OMEGA the places of the marking growing from one of the
+    //! ancestors of the state \c parent (Karp-Miller acceleration).
+    //--------------------------------------------------------------------------
+    void accelerate(size_t const parent, Marking& marking, Marking& ancestor) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Select, among the transitions enabled by the marking of the
+    //! worker, the enabled transitions of the smallest stubborn set found by
+    //! trying each enabled transition as seed.
+    //--------------------------------------------------------------------------
+    void stubbornSet(Worker& worker) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute the stubborn set containing the transition \c seed.
+    //! \return false if it holds at least \c bound enabled transitions.
+    //--------------------------------------------------------------------------
+    bool closure(Worker& worker, size_t const seed, size_t const bound) const;
+
+private:
+
+    //! \brief The net to explore.
+    CompiledNet const& m_net;
+    //! \brief Options of the current exploration.
+    Options m_options;
+    //! \brief Apply Karp-Miller acceleration.
+    bool m_accelerate = false;
+    //! \brief Apply stubborn set reduction.
+    bool m_reduce = false;
+    //! \brief Has the exploration visited all states ?
+    bool m_complete = false;
+    //! \brief Stop the exploration: too many states.
+    bool m_truncated = false;
+    //! \brief Encoded marking of each state.
+    std::vector<uint8_t const*> m_records;
+    //! \brief Parent of each state.
+    std::vector<size_t> m_parents;
+    //! \brief Transition fired from the parent of each state.
+    std::vector<size_t> m_fired;
+    //! \brief Set of visited markings: slots hold records or nullptr.
+    std::unique_ptr<std::atomic<uint8_t const*>[]> m_slots;
+    //! \brief Number of slots - 1 (the number of slots is a power of 2).
+    size_t m_mask = 0u;
+    //! \brief Number of states inserted in the set during the current slice.
+    std::atomic<size_t> m_inserted{0u};
+    //! \brief Workers of the exploration owning the memory of records.
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    //! \brief CSR arcs of the graph: offsets indexed by state.
+    std::vector<size_t> m_edge_offsets;
+    //! \brief CSR arcs of the graph.
+    std::vector<Edge> m_edges;
+    //! \brief Sorted states without enabled transitions.
+    std::vector<size_t> m_deadlocks;
+    //! \brief Maximum number of tokens of each place.
+    std::vector<size_t> m_bounds;
+};
+
+} // namespace tpne
+
+#endif
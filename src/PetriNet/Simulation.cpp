@@ -27,7 +27,6 @@
 #include <ctime>
 #include <cmath>
 #include <iostream>
-#include <random>
 
 namespace tpne {
 
@@ -73,7 +72,7 @@ static const char* current_time()
 
 //------------------------------------------------------------------------------
 Simulation::Simulation(Net& net)
-    : m_net(net)
+    : m_net(net), m_generator(std::random_device{}())
 {
     m_animated_tokens.reserve(128u);
 }
@@ -109,8 +108,24 @@ void Simulation::initializeRuntimeState()
     // Memorize initial marking for restoring after the simulation
     storeInitialMarking();
 
-    // Shuffle transitions for random firing order
-    shuffleTransitions(true);
+    // All transitions are checked at the first step, then only transitions
+    // around places receiving tokens.
+    m_candidates.clear();
+    m_candidates.reserve(m_net.transitions().size());
+    m_fired.clear();
+    m_is_candidate.clear();
+    m_is_candidate.resize(m_net.transitions().size(), false);
+    m_rescan = true;
+
+    // Only temporized transitions need their timers to be updated
+    m_delayed_transitions.clear();
+    for (auto& trans : m_net.transitions())
+    {
+        if (trans.delay > 0.0f)
+        {
+            m_delayed_transitions.push_back(&trans);
+        }
+    }
 
     // Clear animated tokens
     m_animated_tokens.clear();
@@ -141,22 +156,22 @@ void Simulation::initializeRuntimeState()
 }
 
 //------------------------------------------------------------------------------
-std::vector<Transition*> const& Simulation::shuffleTransitions(bool const reset)
+void Simulation::addCandidate(Transition& transition)
 {
-    static std::random_device rd;
-    static std::mt19937 g(rd());
+    if (!m_is_candidate[transition.id])
+    {
+        m_is_candidate[transition.id] = true;
+        m_candidates.push_back(&transition);
+    }
+}
 
-    if (reset)
+//------------------------------------------------------------------------------
+void Simulation::addCandidatesOf(Place const& place)
+{
+    for (auto* a : place.arcsOut)
     {
-        m_shuffled_transitions.clear();
-        m_shuffled_transitions.reserve(m_net.transitions().size());
-        for (auto& trans : m_net.transitions())
-        {
-            m_shuffled_transitions.push_back(&trans);
-        }
+        addCandidate(reinterpret_cast<Transition&>(a->to));
     }
-    std::shuffle(m_shuffled_transitions.begin(), m_shuffled_transitions.end(), g);
-    return m_shuffled_transitions;
 }
 
 //------------------------------------------------------------------------------
@@ -234,6 +249,9 @@ void Simulation::handleHaltingState()
     m_receptivities.clear();
     m_animated_tokens.clear();
     m_action_states.clear();
+    m_candidates.clear();
+    m_fired.clear();
+    m_delayed_transitions.clear();
     Sensors::instance().clear();
 
     m_state = State::Idle;
@@ -313,6 +331,12 @@ bool Simulation::compileReceptivities()
 //------------------------------------------------------------------------------
 bool Simulation::validateReceptivities()
 {
+    // Called at each frame by the editor: parse again receptivities only when
+    // captions (or the type of net) have changed.
+    if (m_validated_revision == m_net.structureRevision())
+        return !m_has_receptivity_errors;
+    m_validated_revision = m_net.structureRevision();
+
     if (m_net.type() != TypeOfNet::GRAFCET)
     {
         m_has_receptivity_errors = false;
@@ -352,50 +376,67 @@ void Simulation::evaluateReceptivities()
     if (m_net.type() != TypeOfNet::GRAFCET)
         return;
 
+    // Receptivities depend on sensors and on steps of other nets: they are
+    // evaluated at each step and receptive transitions have to be checked.
     for (auto& t : m_net.transitions())
     {
         t.receptivity = m_receptivities[t.id].evaluate();
+        if (t.receptivity)
+        {
+            addCandidate(t);
+        }
     }
 }
 
 //------------------------------------------------------------------------------
 void Simulation::updateTransitionDelayTimers(float const dt)
 {
-    for (auto& t : m_net.transitions())
+    for (auto* t : m_delayed_transitions)
     {
-        if (t.delay > 0.0f)
+        if (t->isEnabled() && t->receptivity)
         {
-            if (t.isEnabled() && t.receptivity)
-            {
-                m_transition_delay_timers[t.id] += dt;
-            }
-            else
+            m_transition_delay_timers[t->id] += dt;
+            if (m_transition_delay_timers[t->id] >= t->delay)
             {
-                m_transition_delay_timers[t.id] = 0.0f;
+                addCandidate(*t);
             }
         }
+        else
+        {
+            m_transition_delay_timers[t->id] = 0.0f;
+        }
     }
 }
 
 //------------------------------------------------------------------------------
 void Simulation::fireTransitions()
 {
-    size_t consuming = 0u;
-
-    // Reset arc token counts
-    std::fill(m_arc_token_counts.begin(), m_arc_token_counts.end(), 0u);
+    if (m_rescan)
+    {
+        m_rescan = false;
+        for (auto& trans : m_net.transitions())
+        {
+            addCandidate(trans);
+        }
+    }
 
-    // Collect arcs that will carry animated tokens
+    // Collect arcs that will carry animated tokens. Their token counts are
+    // reset to zero when creating animated tokens.
     std::vector<std::pair<Arc*, size_t>> arcs_to_animate; // arc, arc_index
     arcs_to_animate.reserve(32u);
 
-    do
+    // Firing only removes tokens: a candidate which cannot fire during a pass
+    // cannot fire during the next passes. Only transitions which fired are
+    // checked again (they may fire again with Net::Settings::Fire::OneByOne).
+    while (!m_candidates.empty())
     {
-        auto& transitions = shuffleTransitions();
-        consuming = 0u;
+        std::shuffle(m_candidates.begin(), m_candidates.end(), m_generator);
+        m_fired.clear();
 
-        for (auto* trans : transitions)
+        for (auto* trans : m_candidates)
         {
+            m_is_candidate[trans->id] = false;
+
             // Check delay timer for GRAFCET temporization
             if (trans->delay > 0.0f && m_transition_delay_timers[trans->id] < trans->delay)
                 continue;
@@ -405,15 +446,15 @@ void Simulation::fireTransitions()
             if (tokens > 0u)
             {
                 assert(tokens <= Net::Settings::maxTokens);
-                consuming = tokens;
 
                 if (trans->isInput())
                 {
-                    consuming = 0u;
                     trans->receptivity = false;
                 }
                 else
                 {
+                    m_fired.push_back(trans);
+                    m_net.touchMarking();
                     for (auto* a : trans->arcsIn)
                     {
                         size_t& tks = a->tokensIn();
@@ -431,15 +472,7 @@ void Simulation::fireTransitions()
                 // Count tokens for animation using arc indices
                 for (auto* a : trans->arcsOut)
                 {
-                    // Find arc index
-                    size_t arc_idx = 0;
-                    for (auto& arc : m_net.arcs())
-                    {
-                        if (&arc == a)
-                            break;
-                        ++arc_idx;
-                    }
-
+                    size_t const arc_idx = a->index;
                     if (m_arc_token_counts[arc_idx] == 0u)
                     {
                         arcs_to_animate.push_back({a, arc_idx});
@@ -450,7 +483,13 @@ void Simulation::fireTransitions()
                 }
             }
         }
-    } while (consuming != 0u);
+
+        m_candidates.swap(m_fired);
+        for (auto* trans : m_candidates)
+        {
+            m_is_candidate[trans->id] = true;
+        }
+    }
 
     // Create animated tokens
     for (auto& [arc, arc_idx] : arcs_to_animate)
@@ -521,6 +560,8 @@ void Simulation::animateTokens(float const dt)
                       << std::endl;
 
             token.targetPlace->tokens += token.tokens;
+            m_net.touchMarking();
+            addCandidatesOf(*token.targetPlace);
 
             if (m_net.type() != TypeOfNet::PetriNet)
             {
@@ -528,6 +569,7 @@ void Simulation::animateTokens(float const dt)
                 if (t.isInput())
                 {
                     t.receptivity = true;
+                    addCandidate(t);
                 }
             }
 
@@ -723,6 +765,7 @@ void Simulation::applyGrafcetForcings()
                     {
                     case Forcing::Type::Init:
                         restoreInitialMarking();
+                        invalidate();
                         break;
 
                     case Forcing::Type::Freeze:
@@ -732,6 +775,8 @@ void Simulation::applyGrafcetForcings()
                     case Forcing::Type::Empty:
                         for (auto& p : m_net.places())
                             p.tokens = 0;
+                        m_net.touchMarking();
+                        invalidate();
                         onInfo.emit("Forcing " + forcing.targetNet + " to empty state");
                         break;
 
@@ -747,12 +792,17 @@ void Simulation::applyGrafcetForcings()
                                 onWarning.emit("Forcing step " + std::to_string(step_id) +
                                              " not found in " + forcing.targetNet);
                         }
+                        m_net.touchMarking();
+                        invalidate();
                         break;
                     }
                 }
                 else
                 {
-                    // Cross-net forcing via registry
+                    // Cross-net forcing via registry. The simulation of the
+                    // target net does not know its tokens changed: this is fine
+                    // for GRAFCET since receptive transitions are checked at
+                    // each step.
                     Net* target = NetRegistry::instance().findNet(forcing.targetNet);
                     if (target == nullptr)
                     {
@@ -775,6 +825,7 @@ void Simulation::applyGrafcetForcings()
                     case Forcing::Type::Empty:
                         for (auto& p : target->places())
                             p.tokens = 0;
+                        target->touchMarking();
                         onInfo.emit("Forcing " + forcing.targetNet + " to empty state");
                         break;
 
@@ -790,6 +841,7 @@ void Simulation::applyGrafcetForcings()
                                 onWarning.emit("Forcing step " + std::to_string(step_id) +
                                              " not found in " + forcing.targetNet);
                         }
+                        target->touchMarking();
                         break;
                     }
                 }
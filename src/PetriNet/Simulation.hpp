@@ -24,6 +24,8 @@
 #  include "PetriNet/Signal.hpp"
 
 #  include <atomic>
+#  include <cstdint>
+#  include <random>
 #  include <string>
 #  include <vector>
 #  include <map>
@@ -90,8 +92,19 @@ public:
         float timer = 0.0f;
     };
 
+    //--------------------------------------------------------------------------
+    //! \brief Constructor. The random generator defining the order of firing
+    //! of transitions is seeded with a random value: call seed() for having
+    //! reproducible simulations.
+    //--------------------------------------------------------------------------
     explicit Simulation(Net& net);
 
+    //--------------------------------------------------------------------------
+    //! \brief Change the seed of the random generator defining the order of
+    //! firing of transitions.
+    //--------------------------------------------------------------------------
+    inline void seed(uint32_t const seed) { m_generator.seed(seed); }
+
     //--------------------------------------------------------------------------
     //! \brief Start the simulation. Emits onStarted signal on success.
     //--------------------------------------------------------------------------
@@ -123,7 +136,7 @@ public:
     inline Receptivities const& receptivities() const { return m_receptivities; }
 
     //--------------------------------------------------------------------------
-    //! \brief Get the arc token count for animation (indexed by arc position).
+    //! \brief Get the arc token count for animation (indexed by Arc::index).
     //--------------------------------------------------------------------------
     inline size_t arcTokenCount(size_t arc_index) const
     {
@@ -193,6 +206,14 @@ public:
     //--------------------------------------------------------------------------
     bool validateReceptivities();
 
+    //--------------------------------------------------------------------------
+    //! \brief Notify the simulation that tokens or receptivities have been
+    //! modified outside of it (editor, remote control ...). The simulation only
+    //! checks transitions around places having received tokens: this forces to
+    //! check all transitions at the next step.
+    //--------------------------------------------------------------------------
+    inline void invalidate() { m_rescan = true; }
+
     //! \brief Signal emitted when simulation starts successfully.
     Signal<> onStarted;
     //! \brief Signal emitted when simulation stops.
@@ -237,7 +258,8 @@ private:
     void updateTransitionDelayTimers(float const dt);
     void fireTransitions();
     void animateTokens(float const dt);
-    std::vector<Transition*> const& shuffleTransitions(bool const reset = false);
+    void addCandidate(Transition& transition);
+    void addCandidatesOf(Place const& place);
 
     //--------------------------------------------------------------------------
     // GRAFCET specific
@@ -274,7 +296,7 @@ private:
     //! Indexed by Transition::id.
     std::vector<float> m_transition_delay_timers;
     //! \brief Token counts for arcs during animation.
-    //! Indexed by arc position in Net::arcs().
+    //! Indexed by Arc::index.
     std::vector<size_t> m_arc_token_counts;
     //! \brief Runtime state for GRAFCET actions.
     //! Key: (place_id, action_index), Value: ActionState.
@@ -284,8 +306,20 @@ private:
     // Other simulation data
     //--------------------------------------------------------------------------
 
-    //! \brief List of shuffled Transitions for random firing order.
-    std::vector<Transition*> m_shuffled_transitions;
+    //! \brief Transitions which may fire: their input places received tokens,
+    //! their receptivity or their temporization changed. Shuffled for random
+    //! firing order.
+    std::vector<Transition*> m_candidates;
+    //! \brief Transitions which fired during the current firing pass.
+    std::vector<Transition*> m_fired;
+    //! \brief Is the transition inside m_candidates ? Indexed by Transition::id.
+    std::vector<bool> m_is_candidate;
+    //! \brief Transitions having a temporization (Transition::delay > 0).
+    std::vector<Transition*> m_delayed_transitions;
+    //! \brief Check all transitions at the next step (see invalidate()).
+    bool m_rescan = true;
+    //! \brief Random generator for the order of firing.
+    std::mt19937 m_generator;
     //! \brief Animated tokens transitioning from Transitions to Places.
     AnimatedTokens m_animated_tokens;
     //! \brief Initial marking stored at simulation start.
@@ -294,6 +328,9 @@ private:
     Receptivities m_receptivities;
     //! \brief True if there are receptivity parsing errors.
     bool m_has_receptivity_errors = false;
+    //! \brief Net::structureRevision() when validateReceptivities() has been
+    //! called for the last time.
+    uint64_t m_validated_revision = 0u;
     //! \brief Dummy action state returned for invalid queries.
     static ActionState s_dummy_action_state;
 };
@@ -0,0 +1,551 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/Siphons.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace tpne {
+
+namespace {
+
+//------------------------------------------------------------------------------
+//! \brief Adjacency list in the CSR format: targets of the node i are
+//! targets[k] for k in [offsets[i], offsets[i + 1][.
+//------------------------------------------------------------------------------
+struct Csr
+{
+    std::vector<size_t> offsets;
+    std::vector<size_t> targets;
+
+    template<class Begin, class End, class At>
+    void assign(size_t const n, Begin begin, End end, At at)
+    {
+        offsets.resize(n + 1u);
+        targets.clear();
+        for (size_t i = 0u; i < n; ++i)
+        {
+            offsets[i] = targets.size();
+            for (size_t k = begin(i); k < end(i); ++k)
+                targets.push_back(at(k));
+        }
+        offsets[n] = targets.size();
+    }
+};
+
+//------------------------------------------------------------------------------
+//! \brief The net as seen by the search of siphons. Arcs are reversed for the
+//! search of traps.
+//------------------------------------------------------------------------------
+struct Structure
+{
+    Structure(CompiledNet const& net, bool const reversed)
+        : places(net.countPlaces()), transitions(net.countTransitions())
+    {
+        auto const& n = net;
+        auto preBegin = [&n](size_t t) { return n.preBegin(t); };
+        auto preEnd = [&n](size_t t) { return n.preEnd(t); };
+        auto prePlace = [&n](size_t k) { return n.prePlace(k); };
+        auto postBegin = [&n](size_t t) { return n.postBegin(t); };
+        auto postEnd = [&n](size_t t) { return n.postEnd(t); };
+        auto postPlace = [&n](size_t k) { return n.postPlace(k); };
+        auto consumersBegin = [&n](size_t p) { return n.consumersBegin(p); };
+        auto consumersEnd = [&n](size_t p) { return n.consumersEnd(p); };
+        auto consumer = [&n](size_t k) { return n.consumer(k); };
+        auto producersBegin = [&n](size_t p) { return n.producersBegin(p); };
+        auto producersEnd = [&n](size_t p) { return n.producersEnd(p); };
+        auto producer = [&n](size_t k) { return n.producer(k); };
+
+        if (reversed)
+        {
+            producers.assign(places, consumersBegin, consumersEnd, consumer);
+            consumers.assign(places, producersBegin, producersEnd, producer);
+            inputs.assign(transitions, postBegin, postEnd, postPlace);
+            outputs.assign(transitions, preBegin, preEnd, prePlace);
+        }
+        else
+        {
+            producers.assign(places, producersBegin, producersEnd, producer);
+            consumers.assign(places, consumersBegin, consumersEnd, consumer);
+            inputs.assign(transitions, preBegin, preEnd, prePlace);
+            outputs.assign(transitions, postBegin, postEnd, postPlace);
+        }
+    }
+
+    size_t places;
+    size_t transitions;
+    //! \brief Place -> transitions producing tokens in it.
+    Csr producers;
+    //! \brief Place -> transitions consuming its tokens.
+    Csr consumers;
+    //! \brief Transition -> input places.
+    Csr inputs;
+    //! \brief Transition -> output places.
+    Csr outputs;
+};
+
+//------------------------------------------------------------------------------
+//! \brief Reduce the set of places (inside[p] != 0) to the maximal siphon it
+//! holds: remove places having a producer transition without input place
+//! inside the set, until a fixed point is reached.
+//! \param[inout] inside membership of each place.
+//! \param[inout] counters workspace of Structure::transitions elements.
+//! \param[inout] stack workspace.
+//------------------------------------------------------------------------------
+static void reduceToSiphon(Structure const& s, std::vector<uint8_t>& inside,
+                           std::vector<size_t>& counters, std::vector<size_t>& stack)
+{
+    // Number of input places inside the set for each transition.
+    std::fill(counters.begin(), counters.end(), 0u);
+    for (size_t p = 0u; p < s.places; ++p)
+    {
+        if (!inside[p])
+            continue;
+        for (size_t k = s.consumers.offsets[p]; k < s.consumers.offsets[p + 1u]; ++k)
+            ++counters[s.consumers.targets[k]];
+    }
+
+    stack.clear();
+    for (size_t p = 0u; p < s.places; ++p)
+    {
+        if (!inside[p])
+            continue;
+        for (size_t k = s.producers.offsets[p]; k < s.producers.offsets[p + 1u]; ++k)
+        {
+            if (counters[s.producers.targets[k]] == 0u)
+            {
+                stack.push_back(p);
+                break;
+            }
+        }
+    }
+
+    while (!stack.empty())
+    {
+        size_t const p = stack.back();
+        stack.pop_back();
+        if (!inside[p])
+            continue;
+        inside[p] = 0u;
+        for (size_t k = s.consumers.offsets[p]; k < s.consumers.offsets[p + 1u]; ++k)
+        {
+            size_t const t = s.consumers.targets[k];
+            if (--counters[t] != 0u)
+                continue;
+            for (size_t i = s.outputs.offsets[t]; i < s.outputs.offsets[t + 1u]; ++i)
+            {
+                if (inside[s.outputs.targets[i]])
+                    stack.push_back(s.outputs.targets[i]);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Return the maximal siphon of the structure held by the places.
+//------------------------------------------------------------------------------
+static std::vector<size_t> maximalOf(Structure const& s, std::vector<size_t> const& places)
+{
+    std::vector<uint8_t> inside(s.places, 0u);
+    std::vector<size_t> counters(s.transitions);
+    std::vector<size_t> stack;
+    for (auto const p: places)
+        inside[p] = 1u;
+    reduceToSiphon(s, inside, counters, stack);
+
+    std::vector<size_t> result;
+    for (size_t p = 0u; p < s.places; ++p)
+    {
+        if (inside[p])
+            result.push_back(p);
+    }
+    return result;
+}
+
+// *****************************************************************************
+//! \brief Branch-and-bound enumeration of the minimal siphons whose smallest
+//! place is a given seed. One instance per thread: its memory is reused from
+//! a seed to the next one.
+// *****************************************************************************
+class Search
+{
+public:
+
+    Search(Structure const& s, size_t const max, std::atomic<size_t>& total,
+           std::atomic<bool>& aborted)
+        : m_structure(s), m_max(max), m_total(total), m_aborted(aborted),
+          m_state(s.places), m_inside(s.places), m_counters(s.transitions)
+    {}
+
+    //--------------------------------------------------------------------------
+    //! \brief Store in \c found the minimal siphons whose smallest place is
+    //! \c seed.
+    //--------------------------------------------------------------------------
+    void run(size_t const seed, std::vector<std::vector<size_t>>& found)
+    {
+        m_found = &found;
+        m_trail.clear();
+        std::fill(m_state.begin(), m_state.begin() + seed, OUT);
+        std::fill(m_state.begin() + seed, m_state.end(), FREE);
+        assign(seed, IN);
+        explore();
+        std::sort(found.begin(), found.end());
+    }
+
+private:
+
+    //! \brief State of places in the current node of the search.
+    enum : uint8_t { FREE, IN, OUT };
+    //! \brief No transition to branch on.
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    void assign(size_t const p, uint8_t const state)
+    {
+        m_state[p] = state;
+        m_trail.push_back(p);
+    }
+
+    void undo(size_t const mark)
+    {
+        while (m_trail.size() > mark)
+        {
+            m_state[m_trail.back()] = FREE;
+            m_trail.pop_back();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Include the places forced by transitions producing in the
+    //! included places. \return false if a transition cannot be covered.
+    //! Otherwise \c branch is the unsatisfied transition having the fewest
+    //! candidate input places, or NONE if the included places are a siphon.
+    //--------------------------------------------------------------------------
+    bool propagate(size_t& branch)
+    {
+        Structure const& s = m_structure;
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            branch = NONE;
+            size_t best = NONE;
+            for (size_t i = 0u; i < m_trail.size(); ++i)
+            {
+                size_t const p = m_trail[i];
+                if (m_state[p] != IN)
+                    continue;
+                for (size_t k = s.producers.offsets[p]; k < s.producers.offsets[p + 1u]; ++k)
+                {
+                    size_t const t = s.producers.targets[k];
+                    size_t candidates = 0u, last = NONE;
+                    bool covered = false;
+                    for (size_t j = s.inputs.offsets[t]; j < s.inputs.offsets[t + 1u]; ++j)
+                    {
+                        size_t const q = s.inputs.targets[j];
+                        if (m_state[q] == IN)
+                        {
+                            covered = true;
+                            break;
+                        }
+                        if (m_state[q] == FREE)
+                        {
+                            ++candidates;
+                            last = q;
+                        }
+                    }
+                    if (covered)
+                        continue;
+                    if (candidates == 0u)
+                        return false;
+                    if (candidates == 1u)
+                    {
+                        assign(last, IN);
+                        changed = true;
+                    }
+                    else if (candidates < best)
+                    {
+                        best = candidates;
+                        branch = t;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return false if an included place is outside the maximal siphon
+    //! of the non excluded places: no siphon in this branch.
+    //--------------------------------------------------------------------------
+    bool bound()
+    {
+        for (size_t p = 0u; p < m_structure.places; ++p)
+            m_inside[p] = (m_state[p] != OUT);
+        reduceToSiphon(m_structure, m_inside, m_counters, m_stack);
+        for (auto const p: m_trail)
+        {
+            if ((m_state[p] == IN) && !m_inside[p])
+                return false;
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return true if the included places hold a siphon already found.
+    //--------------------------------------------------------------------------
+    bool includesFound() const
+    {
+        for (auto const& siphon: *m_found)
+        {
+            if (std::all_of(siphon.begin(), siphon.end(),
+                            [this](size_t p) { return m_state[p] == IN; }))
+                return true;
+        }
+        return false;
+    }
+
+    //--------------------------------------------------------------------------
+    //! \brief A siphon is minimal if removing any of its places leaves no
+    //! siphon.
+    //--------------------------------------------------------------------------
+    bool isMinimal(std::vector<size_t> const& siphon)
+    {
+        std::fill(m_inside.begin(), m_inside.end(), 0u);
+        for (auto const removed: siphon)
+        {
+            for (auto const p: siphon)
+                m_inside[p] = (p != removed);
+            reduceToSiphon(m_structure, m_inside, m_counters, m_stack);
+            if (std::any_of(siphon.begin(), siphon.end(),
+                            [this](size_t p) { return m_inside[p] != 0u; }))
+                return false;
+        }
+        return true;
+    }
+
+    void explore()
+    {
+        if (m_aborted)
+            return;
+
+        size_t const mark = m_trail.size();
+        size_t branch;
+        if (!propagate(branch) || !bound() || includesFound())
+        {
+            undo(mark);
+            return;
+        }
+
+        if (branch == NONE)
+        {
+            std::vector<size_t> siphon;
+            for (auto const p: m_trail)
+            {
+                if (m_state[p] == IN)
+                    siphon.push_back(p);
+            }
+            std::sort(siphon.begin(), siphon.end());
+            if (isMinimal(siphon))
+            {
+                m_found->push_back(std::move(siphon));
+                if (++m_total > m_max)
+                    m_aborted = true;
+            }
+            undo(mark);
+            return;
+        }
+
+        // The k-th branch includes the k-th candidate and excludes the
+        // previous ones.
+        std::vector<size_t> candidates;
+        Structure const& s = m_structure;
+        for (size_t j = s.inputs.offsets[branch]; j < s.inputs.offsets[branch + 1u]; ++j)
+        {
+            if (m_state[s.inputs.targets[j]] == FREE)
+                candidates.push_back(s.inputs.targets[j]);
+        }
+        for (auto const q: candidates)
+        {
+            size_t const before = m_trail.size();
+            assign(q, IN);
+            explore();
+            undo(before);
+            assign(q, OUT);
+        }
+        undo(mark);
+    }
+
+private:
+
+    Structure const& m_structure;
+    size_t const m_max;
+    std::atomic<size_t>& m_total;
+    std::atomic<bool>& m_aborted;
+    //! \brief FREE, IN or OUT for each place.
+    std::vector<uint8_t> m_state;
+    //! \brief Places assigned since the seed, in the order of assignment.
+    std::vector<size_t> m_trail;
+    //! \brief Minimal siphons found for the current seed.
+    std::vector<std::vector<size_t>>* m_found = nullptr;
+    //! \brief Workspaces of reduceToSiphon().
+    std::vector<uint8_t> m_inside;
+    std::vector<size_t> m_counters;
+    std::vector<size_t> m_stack;
+};
+
+//------------------------------------------------------------------------------
+//! \brief Enumerate the minimal siphons of the structure, seeds being
+//! dispatched on a pool of threads.
+//------------------------------------------------------------------------------
+static SiphonsResult enumerate(Structure const& s, size_t const max, size_t threads)
+{
+    SiphonsResult result;
+    std::vector<std::vector<std::vector<size_t>>> found(s.places);
+    std::atomic<size_t> next_seed{0u};
+    std::atomic<size_t> total{0u};
+    std::atomic<bool> aborted{false};
+
+    auto worker = [&]()
+    {
+        Search search(s, max, total, aborted);
+        size_t seed;
+        while (((seed = next_seed++) < s.places) && !aborted)
+            search.run(seed, found[seed]);
+    };
+
+    if (threads == 0u)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(size_t(1u), std::min(threads, s.places));
+    std::vector<std::thread> pool;
+    for (size_t t = 1u; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread: pool)
+        thread.join();
+
+    if (aborted)
+    {
+        result.message = "The number of minimal sets exceeds the limit of " +
+                         std::to_string(max);
+        return result;
+    }
+
+    // Seeds are the smallest places of their sets: concatenating them keeps
+    // the lexicographic order.
+    result.sets.reserve(total);
+    for (auto& sets: found)
+    {
+        for (auto& set: sets)
+            result.sets.push_back(std::move(set));
+    }
+    result.success = true;
+    return result;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+SiphonsResult findMinimalSiphons(CompiledNet const& net, size_t const max, size_t const threads)
+{
+    return enumerate(Structure(net, false), max, threads);
+}
+
+//------------------------------------------------------------------------------
+SiphonsResult findMinimalTraps(CompiledNet const& net, size_t const max, size_t const threads)
+{
+    return enumerate(Structure(net, true), max, threads);
+}
+
+//------------------------------------------------------------------------------
+std::vector<size_t> maximalSiphon(CompiledNet const& net, std::vector<size_t> const& places)
+{
+    return maximalOf(Structure(net, false), places);
+}
+
+//------------------------------------------------------------------------------
+std::vector<size_t> maximalTrap(CompiledNet const& net, std::vector<size_t> const& places)
+{
+    return maximalOf(Structure(net, true), places);
+}
+
+//------------------------------------------------------------------------------
+bool isFreeChoice(CompiledNet const& net)
+{
+    for (size_t t = 0u; t < net.countTransitions(); ++t)
+    {
+        for (size_t k = net.postBegin(t); k < net.postEnd(t); ++k)
+        {
+            if (net.postWeight(k) != 1u)
+                return false;
+        }
+    }
+
+    std::vector<size_t> reference, consumers;
+    for (size_t t = 0u; t < net.countTransitions(); ++t)
+    {
+        for (size_t k = net.preBegin(t); k < net.preEnd(t); ++k)
+        {
+            size_t const p = net.prePlace(k);
+            if (net.preWeight(k) != 1u)
+                return false;
+
+            consumers.clear();
+            for (size_t i = net.consumersBegin(p); i < net.consumersEnd(p); ++i)
+                consumers.push_back(net.consumer(i));
+            std::sort(consumers.begin(), consumers.end());
+            if (k == net.preBegin(t))
+                reference.swap(consumers);
+            else if (consumers != reference)
+                return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+CommonerResult checkCommoner(CompiledNet const& net, size_t const threads)
+{
+    CommonerResult result;
+    SiphonsResult siphons = findMinimalSiphons(net, MAX_SIPHONS, threads);
+    if (!siphons.success)
+    {
+        result.message = siphons.message;
+        return result;
+    }
+
+    Structure const reversed(net, true);
+    CompiledNet::Marking const& marking = net.initialMarking();
+    for (auto& siphon: siphons.sets)
+    {
+        std::vector<size_t> const trap = maximalOf(reversed, siphon);
+        if (std::none_of(trap.begin(), trap.end(),
+                         [&marking](size_t p) { return marking[p] > 0u; }))
+            result.siphons.push_back(std::move(siphon));
+    }
+    result.holds = result.siphons.empty();
+    result.free_choice = isFreeChoice(net);
+    result.success = true;
+    return result;
+}
+
+} // namespace tpne
@@ -0,0 +1,143 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef SIPHONS_HPP
+#  define SIPHONS_HPP
+
+#  include "PetriNet/CompiledNet.hpp"
+
+#  include <string>
+#  include <vector>
+
+namespace tpne {
+
+//--------------------------------------------------------------------------
+//! \brief Default maximum number of minimal siphons or traps to enumerate.
+//--------------------------------------------------------------------------
+constexpr size_t MAX_SIPHONS = 100000u;
+
+//--------------------------------------------------------------------------
+//! \brief Returned by findMinimalSiphons() and findMinimalTraps().
+//--------------------------------------------------------------------------
+struct SiphonsResult
+{
+    //! \brief False if the enumeration has been aborted (too many sets). In
+    //! case of failure sets are cleared.
+    bool success = false;
+    //! \brief In case of failure, holds the reason of the failure.
+    std::string message;
+    //! \brief The minimal sets: place indices (as given by CompiledNet)
+    //! sorted by increasing index. Sets are sorted lexicographically.
+    std::vector<std::vector<size_t>> sets;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Enumerate the minimal siphons of the net. A siphon is a non-empty
+//! set of places S such as each transition producing tokens in S consumes
+//! tokens from S: once empty, a siphon stays empty.
+//!
+//! The enumeration is a branch-and-bound made for each seed place p: it
+//! searches the minimal siphons whose smallest place is p, therefore each
+//! siphon is found once and seeds are dispatched on a pool of threads. A
+//! node of the search includes or excludes places:
+//!   - unit propagation: a transition producing in the included places with
+//!     a single non-excluded input place forces this place;
+//!   - bound: the included places shall belong to the maximal siphon of the
+//!     non-excluded places, else the branch holds no siphon;
+//!   - branching: on the transition having the fewest candidate input
+//!     places, the k-th branch includes its k-th candidate and excludes the
+//!     previous ones (branches are disjoint);
+//!   - a branch including a siphon already found is cut (the siphon would not
+//!     be minimal).
+//!
+//! \param[in] net the compiled net. Arc weights are ignored.
+//! \param[in] max abort when the number of minimal siphons exceeds this
+//!   limit (it can be exponential).
+//! \param[in] threads number of threads. 0 for using all cores.
+//--------------------------------------------------------------------------
+SiphonsResult findMinimalSiphons(CompiledNet const& net,
+    size_t const max = MAX_SIPHONS, size_t const threads = 0u);
+
+//--------------------------------------------------------------------------
+//! \brief Enumerate the minimal traps of the net. A trap is a non-empty set
+//! of places Q such as each transition consuming tokens from Q produces tokens
+//! in Q: once marked, a trap stays marked. Traps are the siphons of the net
+//! with reversed arcs: see findMinimalSiphons().
+//--------------------------------------------------------------------------
+SiphonsResult findMinimalTraps(CompiledNet const& net,
+    size_t const max = MAX_SIPHONS, size_t const threads = 0u);
+
+//--------------------------------------------------------------------------
+//! \brief Return the maximal siphon (union of all siphons) included in the
+//! given set of place indices. The result is sorted and empty if the set
+//! holds no siphon. Complexity is O(P + T + A).
+//--------------------------------------------------------------------------
+std::vector<size_t> maximalSiphon(CompiledNet const& net, std::vector<size_t> const& places);
+
+//--------------------------------------------------------------------------
+//! \brief Return the maximal trap (union of all traps) included in the given
+//! set of place indices. The result is sorted and empty if the set holds no
+//! trap. Complexity is O(P + T + A).
+//--------------------------------------------------------------------------
+std::vector<size_t> maximalTrap(CompiledNet const& net, std::vector<size_t> const& places);
+
+//--------------------------------------------------------------------------
+//! \brief Return true if the net is ordinary (arc weights are 1) and extended
+//! free-choice: two places sharing a consumer transition have the same
+//! consumer transitions.
+//--------------------------------------------------------------------------
+bool isFreeChoice(CompiledNet const& net);
+
+//--------------------------------------------------------------------------
+//! \brief Returned by checkCommoner()
+//--------------------------------------------------------------------------
+struct CommonerResult
+{
+    //! \brief False if the enumeration of siphons has been aborted.
+    bool success = false;
+    //! \brief In case of failure, holds the reason of the failure.
+    std::string message;
+    //! \brief Does each minimal siphon contain a trap marked by the initial
+    //! marking ?
+    bool holds = false;
+    //! \brief Is the net extended free-choice (see isFreeChoice()) ?
+    bool free_choice = false;
+    //! \brief Minimal siphons not containing an initially marked trap: they
+    //! may be emptied, disabling their consumer transitions forever.
+    std::vector<std::vector<size_t>> siphons;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Check the Commoner's condition: each siphon contains a trap marked
+//! by the initial marking of the net. A marked trap stays marked, so such a
+//! siphon is never emptied. When the condition holds, an ordinary net is
+//! deadlock-free (no reachable marking disables all transitions); a
+//! free-choice net is live if and only if the condition holds. Checking the
+//! minimal siphons is enough since each siphon includes a minimal one.
+//!
+//! \note Net::Settings::maxTokens is not taken into account: the net is
+//! analyzed as a Petri net (GRAFCET saturating tokens may behave
+//! differently).
+//--------------------------------------------------------------------------
+CommonerResult checkCommoner(CompiledNet const& net, size_t const threads = 0u);
+
+} // namespace tpne
+
+#endif
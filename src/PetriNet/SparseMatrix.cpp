@@ -20,13 +20,62 @@
 
 #include "PetriNet/SparseMatrix.hpp"
 #include "PetriNet/TropicalAlgebra.hpp"
+#include "PetriNet/TropicalKernels.hpp"
 
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
 
 namespace tpne {
 
+static_assert(sizeof(MaxPlus) == sizeof(double) && std::is_standard_layout<MaxPlus>::value,
+              "MaxPlus shall have the memory layout of a double");
+static_assert(sizeof(MinPlus) == sizeof(double) && std::is_standard_layout<MinPlus>::value,
+              "MinPlus shall have the memory layout of a double");
+
+// === MATRIX-VECTOR KERNELS ===========================================
+
+//! \brief Generic CRS matrix-vector product.
+template<typename T>
+static void multiplyRows(size_t rows, const std::vector<size_t>& offsets,
+                         const std::vector<size_t>& cols, const std::vector<T>& vals,
+                         const T* vec, T* result)
+{
+    for (size_t i = 0; i < rows; ++i)
+    {
+        T sum = zero<T>();
+        for (size_t pos = offsets[i]; pos < offsets[i + 1]; ++pos)
+        {
+            sum = sum + vals[pos] * vec[cols[pos]];
+        }
+        result[i] = sum;
+    }
+}
+
+//! \brief (max,+) matrix-vector product using vectorized kernels.
+static void multiplyRows(size_t rows, const std::vector<size_t>& offsets,
+                         const std::vector<size_t>& cols, const std::vector<MaxPlus>& vals,
+                         const MaxPlus* vec, MaxPlus* result)
+{
+    tropical::maxPlusSpMV(rows, offsets.data(), cols.data(),
+                          reinterpret_cast<const double*>(vals.data()),
+                          reinterpret_cast<const double*>(vec),
+                          reinterpret_cast<double*>(result));
+}
+
+//! \brief (min,+) matrix-vector product using vectorized kernels.
+static void multiplyRows(size_t rows, const std::vector<size_t>& offsets,
+                         const std::vector<size_t>& cols, const std::vector<MinPlus>& vals,
+                         const MinPlus* vec, MinPlus* result)
+{
+    tropical::minPlusSpMV(rows, offsets.data(), cols.data(),
+                          reinterpret_cast<const double*>(vals.data()),
+                          reinterpret_cast<const double*>(vec),
+                          reinterpret_cast<double*>(result));
+}
+
 // === CONSTRUCTORS / DESTRUCTOR ===========================================
 
 template<typename T>
@@ -191,24 +240,16 @@ std::vector<T> SparseMatrix<T>::multiply(const std::vector<T>& vec) const
     }
 
     std::vector<T> result(m_rows_count, zero<T>());
-
-    for (size_t i = 0; i < m_rows_count; ++i)
-    {
-        T sum = zero<T>();
-        const size_t row_start = m_rows[i];
-        const size_t row_end = m_rows[i + 1];
-
-        for (size_t pos = row_start; pos < row_end; ++pos)
-        {
-            sum = sum + m_vals[pos] * vec[m_cols[pos]];
-        }
-
-        result[i] = sum;
-    }
-
+    multiplyRows(m_rows_count, m_rows, m_cols, m_vals, vec.data(), result.data());
     return result;
 }
 
+template<typename T>
+void SparseMatrix<T>::multiply(const T* vec, T* result) const
+{
+    multiplyRows(m_rows_count, m_rows, m_cols, m_vals, vec, result);
+}
+
 template<typename T>
 std::vector<T> SparseMatrix<T>::operator*(const std::vector<T>& vec) const
 {
@@ -226,22 +267,50 @@ SparseMatrix<T> SparseMatrix<T>::multiply(const SparseMatrix<T>& other) const
 
     SparseMatrix<T> result(m_rows_count, other.m_cols_count);
 
+    // Gustavson's algorithm: the row i of the result is the sum of the rows k
+    // of the right matrix scaled by the elements (i, k) of the left matrix.
+    // Rows are accumulated inside a dense vector, touched columns are
+    // remembered to be compressed at the end of each row.
+    std::vector<T> accumulator(other.m_cols_count, zero<T>());
+    std::vector<size_t> marker(other.m_cols_count, m_rows_count);
+    std::vector<size_t> touched;
+
     for (size_t i = 0; i < m_rows_count; ++i)
     {
-        for (size_t j = 0; j < other.m_cols_count; ++j)
+        touched.clear();
+        for (size_t pos = m_rows[i]; pos < m_rows[i + 1]; ++pos)
         {
-            T sum = zero<T>();
+            const T& a = m_vals[pos];
+            const size_t k = m_cols[pos];
 
-            for (size_t k = 0; k < m_cols_count; ++k)
+            for (size_t opos = other.m_rows[k]; opos < other.m_rows[k + 1]; ++opos)
             {
-                sum = sum + get(i, k) * other.get(k, j);
+                const size_t j = other.m_cols[opos];
+                const T product = a * other.m_vals[opos];
+
+                if (marker[j] != i)
+                {
+                    marker[j] = i;
+                    accumulator[j] = product;
+                    touched.push_back(j);
+                }
+                else
+                {
+                    accumulator[j] = accumulator[j] + product;
+                }
             }
+        }
 
-            if (!(sum == zero<T>()))
+        std::sort(touched.begin(), touched.end());
+        for (size_t j : touched)
+        {
+            if (!(accumulator[j] == zero<T>()))
             {
-                result.set(i, j, sum);
+                result.m_vals.push_back(accumulator[j]);
+                result.m_cols.push_back(j);
             }
         }
+        result.m_rows[i + 1] = result.m_vals.size();
     }
 
     return result;
@@ -262,21 +331,7 @@ SparseMatrix<T> SparseMatrix<T>::add(const SparseMatrix<T>& other) const
             "Cannot add: matrices dimensions don't match.");
     }
 
-    SparseMatrix<T> result(m_rows_count, m_cols_count);
-
-    for (size_t i = 0; i < m_rows_count; ++i)
-    {
-        for (size_t j = 0; j < m_cols_count; ++j)
-        {
-            T sum = get(i, j) + other.get(i, j);
-            if (!(sum == zero<T>()))
-            {
-                result.set(i, j, sum);
-            }
-        }
-    }
-
-    return result;
+    return merge(other, [](const T& a, const T& b) -> T { return a + b; });
 }
 
 template<typename T>
@@ -294,21 +349,7 @@ SparseMatrix<T> SparseMatrix<T>::subtract(const SparseMatrix<T>& other) const
             "Cannot subtract: matrices dimensions don't match.");
     }
 
-    SparseMatrix<T> result(m_rows_count, m_cols_count);
-
-    for (size_t i = 0; i < m_rows_count; ++i)
-    {
-        for (size_t j = 0; j < m_cols_count; ++j)
-        {
-            T diff = get(i, j) - other.get(i, j);
-            if (!(diff == zero<T>()))
-            {
-                result.set(i, j, diff);
-            }
-        }
-    }
-
-    return result;
+    return merge(other, [](const T& a, const T& b) -> T { return a - b; });
 }
 
 template<typename T>
@@ -328,6 +369,56 @@ void SparseMatrix<T>::validateCoordinates(size_t row, size_t col) const
     }
 }
 
+template<typename T>
+template<typename Operation>
+SparseMatrix<T> SparseMatrix<T>::merge(const SparseMatrix<T>& other, Operation op) const
+{
+    SparseMatrix<T> result(m_rows_count, m_cols_count);
+    result.m_vals.reserve(m_vals.size() + other.m_vals.size());
+    result.m_cols.reserve(m_cols.size() + other.m_cols.size());
+
+    // Columns of each row are sorted: merge both rows like a merge sort. An
+    // element missing in one of the matrices is zero<T>().
+    for (size_t i = 0; i < m_rows_count; ++i)
+    {
+        size_t pos = m_rows[i];
+        size_t opos = other.m_rows[i];
+        const size_t end = m_rows[i + 1];
+        const size_t oend = other.m_rows[i + 1];
+
+        while ((pos < end) || (opos < oend))
+        {
+            size_t col;
+            T val;
+
+            if ((opos == oend) || ((pos < end) && (m_cols[pos] < other.m_cols[opos])))
+            {
+                col = m_cols[pos];
+                val = op(m_vals[pos++], zero<T>());
+            }
+            else if ((pos == end) || (other.m_cols[opos] < m_cols[pos]))
+            {
+                col = other.m_cols[opos];
+                val = op(zero<T>(), other.m_vals[opos++]);
+            }
+            else
+            {
+                col = m_cols[pos];
+                val = op(m_vals[pos++], other.m_vals[opos++]);
+            }
+
+            if (!(val == zero<T>()))
+            {
+                result.m_vals.push_back(val);
+                result.m_cols.push_back(col);
+            }
+        }
+        result.m_rows[i + 1] = result.m_vals.size();
+    }
+
+    return result;
+}
+
 template<typename T>
 void SparseMatrix<T>::insert(size_t index, size_t row, size_t col, T val)
 {
@@ -490,11 +581,283 @@ std::ostream& printSparseMatrix(std::ostream& os, const SparseMatrix<T>& matrix,
     return os;
 }
 
+// === BUILDER =========================================================
+
+template<typename T>
+SparseMatrixBuilder<T>::SparseMatrixBuilder(size_t rows, size_t cols)
+    : m_rows_count(rows), m_cols_count(cols)
+{
+}
+
+template<typename T>
+SparseMatrixBuilder<T>& SparseMatrixBuilder<T>::add(size_t row, size_t col, T val)
+{
+    if (row >= m_rows_count || col >= m_cols_count)
+    {
+        throw std::out_of_range("Matrix coordinates out of range.");
+    }
+
+    if (!(val == zero<T>()))
+    {
+        m_triplets.push_back(Triplet{row, col, val});
+    }
+
+    return *this;
+}
+
+template<typename T>
+void SparseMatrixBuilder<T>::build(SparseMatrix<T>& matrix)
+{
+    const size_t nnz = m_triplets.size();
+
+    // Counting sort by column, then stable counting sort by row: triplets end
+    // sorted by row then by column.
+    std::vector<size_t> offsets(m_cols_count + 1, 0);
+    for (const Triplet& t : m_triplets)
+    {
+        ++offsets[t.col + 1];
+    }
+    for (size_t j = 0; j < m_cols_count; ++j)
+    {
+        offsets[j + 1] += offsets[j];
+    }
+    std::vector<size_t> by_col(nnz);
+    for (size_t k = 0; k < nnz; ++k)
+    {
+        by_col[offsets[m_triplets[k].col]++] = k;
+    }
+
+    offsets.assign(m_rows_count + 1, 0);
+    for (const Triplet& t : m_triplets)
+    {
+        ++offsets[t.row + 1];
+    }
+    for (size_t i = 0; i < m_rows_count; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<size_t> order(nnz);
+    for (size_t k : by_col)
+    {
+        order[offsets[m_triplets[k].row]++] = k;
+    }
+
+    // Compress to CRS: consecutive triplets with the same coordinates are
+    // combined.
+    matrix.reshape(m_rows_count, m_cols_count);
+    matrix.m_vals.reserve(nnz);
+    matrix.m_cols.reserve(nnz);
+
+    size_t k = 0;
+    while (k < nnz)
+    {
+        const Triplet& first = m_triplets[order[k]];
+        T sum = first.val;
+        for (++k; (k < nnz) && (m_triplets[order[k]].row == first.row) &&
+                 (m_triplets[order[k]].col == first.col); ++k)
+        {
+            sum = sum + m_triplets[order[k]].val;
+        }
+
+        if (!(sum == zero<T>()))
+        {
+            matrix.m_vals.push_back(sum);
+            matrix.m_cols.push_back(first.col);
+            ++matrix.m_rows[first.row + 1];
+        }
+    }
+    for (size_t i = 0; i < m_rows_count; ++i)
+    {
+        matrix.m_rows[i + 1] += matrix.m_rows[i];
+    }
+
+    m_triplets.clear();
+}
+
+template<typename T>
+SparseMatrix<T> SparseMatrixBuilder<T>::build()
+{
+    SparseMatrix<T> matrix;
+    build(matrix);
+    return matrix;
+}
+
+// === KLEENE STAR =====================================================
+
+//! \brief Kleene star of an acyclic graph given the topological order of its
+//! nodes: row i of A* is e_i ⨁ (A(i, j) ⨂ row j of A*) for all successors j.
+template<typename T>
+static SparseMatrix<T> acyclicStar(size_t n, const std::vector<size_t>& offsets,
+                                   const std::vector<size_t>& cols,
+                                   const std::vector<T>& vals,
+                                   const std::vector<size_t>& order)
+{
+    std::vector<std::vector<std::pair<size_t, T>>> rows(n);
+    std::vector<T> accumulator(n, zero<T>());
+    std::vector<size_t> marker(n, n);
+    std::vector<size_t> touched;
+
+    for (size_t r = n; r-- > 0;)
+    {
+        const size_t i = order[r];
+        touched.assign(1, i);
+        marker[i] = i;
+        accumulator[i] = one<T>();
+
+        for (size_t pos = offsets[i]; pos < offsets[i + 1]; ++pos)
+        {
+            const T& a = vals[pos];
+            for (const auto& element : rows[cols[pos]])
+            {
+                const size_t j = element.first;
+                const T product = a * element.second;
+                if (marker[j] != i)
+                {
+                    marker[j] = i;
+                    accumulator[j] = product;
+                    touched.push_back(j);
+                }
+                else
+                {
+                    accumulator[j] = accumulator[j] + product;
+                }
+            }
+        }
+
+        std::sort(touched.begin(), touched.end());
+        rows[i].reserve(touched.size());
+        for (size_t j : touched)
+        {
+            if (!(accumulator[j] == zero<T>()))
+            {
+                rows[i].emplace_back(j, accumulator[j]);
+            }
+        }
+    }
+
+    SparseMatrixBuilder<T> builder(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (const auto& element : rows[i])
+        {
+            builder.add(i, element.first, element.second);
+        }
+    }
+    return builder.build();
+}
+
+//! \brief Kleene star by the Floyd-Warshall algorithm.
+template<typename T>
+static SparseMatrix<T> floydWarshallStar(size_t n, const std::vector<size_t>& offsets,
+                                         const std::vector<size_t>& cols,
+                                         const std::vector<T>& vals)
+{
+    std::vector<T> dist(n * n, zero<T>());
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t pos = offsets[i]; pos < offsets[i + 1]; ++pos)
+        {
+            dist[i * n + cols[pos]] = vals[pos];
+        }
+    }
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        const T* row_k = &dist[k * n];
+        for (size_t i = 0; i < n; ++i)
+        {
+            const T d_ik = dist[i * n + k];
+            if (d_ik == zero<T>())
+                continue;
+
+            T* row_i = &dist[i * n];
+            for (size_t j = 0; j < n; ++j)
+            {
+                if (!(row_k[j] == zero<T>()))
+                {
+                    row_i[j] = row_i[j] + T(d_ik * row_k[j]);
+                }
+            }
+        }
+    }
+
+    // A circuit with a weight better than one<T>() makes the star diverge.
+    SparseMatrixBuilder<T> builder(n, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        T& d_ii = dist[i * n + i];
+        if (!(T(d_ii + one<T>()) == one<T>()))
+        {
+            throw std::invalid_argument(
+                "Cannot compute the star: the matrix has a circuit with a positive weight.");
+        }
+        d_ii = one<T>();
+        for (size_t j = 0; j < n; ++j)
+        {
+            builder.add(i, j, dist[i * n + j]);
+        }
+    }
+    return builder.build();
+}
+
+template<typename T>
+SparseMatrix<T> star(const SparseMatrix<T>& A)
+{
+    if (A.m_rows_count != A.m_cols_count)
+    {
+        throw std::invalid_argument(
+            "Cannot compute the star: matrix is not square.");
+    }
+
+    // Kahn's algorithm: topological order of the graph i -> j.
+    const size_t n = A.m_rows_count;
+    std::vector<size_t> in_degree(n, 0);
+    for (size_t col : A.m_cols)
+    {
+        ++in_degree[col];
+    }
+    std::vector<size_t> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (in_degree[i] == 0)
+        {
+            order.push_back(i);
+        }
+    }
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        const size_t i = order[k];
+        for (size_t pos = A.m_rows[i]; pos < A.m_rows[i + 1]; ++pos)
+        {
+            if (--in_degree[A.m_cols[pos]] == 0)
+            {
+                order.push_back(A.m_cols[pos]);
+            }
+        }
+    }
+
+    if (order.size() == n)
+    {
+        return acyclicStar(n, A.m_rows, A.m_cols, A.m_vals, order);
+    }
+    return floydWarshallStar(n, A.m_rows, A.m_cols, A.m_vals);
+}
+
 // === EXPLICIT TEMPLATE INSTANTIATIONS ================================
 
 template class SparseMatrix<double>;
 template class SparseMatrix<MaxPlus>;
 template class SparseMatrix<MinPlus>;
+template class SparseMatrix<int64_t>;
+
+template class SparseMatrixBuilder<double>;
+template class SparseMatrixBuilder<MaxPlus>;
+template class SparseMatrixBuilder<MinPlus>;
+template class SparseMatrixBuilder<int64_t>;
+
+template SparseMatrix<MaxPlus> star<MaxPlus>(const SparseMatrix<MaxPlus>&);
+template SparseMatrix<MinPlus> star<MinPlus>(const SparseMatrix<MinPlus>&);
 
 template bool operator==<double>(const SparseMatrix<double>&, const SparseMatrix<double>&);
 template bool operator!=<double>(const SparseMatrix<double>&, const SparseMatrix<double>&);
@@ -508,8 +871,13 @@ template bool operator==<MinPlus>(const SparseMatrix<MinPlus>&, const SparseMatr
 template bool operator!=<MinPlus>(const SparseMatrix<MinPlus>&, const SparseMatrix<MinPlus>&);
 template std::ostream& operator<<<MinPlus>(std::ostream&, const SparseMatrix<MinPlus>&);
 
+template bool operator==<int64_t>(const SparseMatrix<int64_t>&, const SparseMatrix<int64_t>&);
+template bool operator!=<int64_t>(const SparseMatrix<int64_t>&, const SparseMatrix<int64_t>&);
+template std::ostream& operator<<<int64_t>(std::ostream&, const SparseMatrix<int64_t>&);
+
 template std::ostream& printSparseMatrix<double>(std::ostream&, const SparseMatrix<double>&, IndexingStyle, DisplayFormat);
 template std::ostream& printSparseMatrix<MaxPlus>(std::ostream&, const SparseMatrix<MaxPlus>&, IndexingStyle, DisplayFormat);
 template std::ostream& printSparseMatrix<MinPlus>(std::ostream&, const SparseMatrix<MinPlus>&, IndexingStyle, DisplayFormat);
+template std::ostream& printSparseMatrix<int64_t>(std::ostream&, const SparseMatrix<int64_t>&, IndexingStyle, DisplayFormat);
 
 }  // namespace tpne
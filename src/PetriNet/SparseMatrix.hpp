@@ -79,6 +79,8 @@ inline std::string getTypePrefix<MinPlus>()
     return "mp";
 }
 
+template<typename T> class SparseMatrixBuilder;
+
 // *****************************************************************************
 //! \brief Sparse matrix implementation using Compressed Row Storage (CRS) format.
 //!
@@ -93,7 +95,7 @@ inline std::string getTypePrefix<MinPlus>()
 //! - m_cols: column indices of non-zero elements
 //! - m_rows: row pointers (m_rows[i] points to the start of row i in m_vals)
 //!
-//! \tparam T Element type (supports double, MaxPlus, MinPlus, etc.)
+//! \tparam T Element type (supports double, MaxPlus, MinPlus, int64_t)
 // *****************************************************************************
 template<typename T>
 class SparseMatrix
@@ -136,6 +138,17 @@ public:
     //! \return Number of columns in the matrix
     size_t nbColumns() const { return m_cols_count; }
 
+    //! \brief Get the number of stored (non-zero) elements
+    size_t nbNonZeros() const { return m_vals.size(); }
+
+    //! \brief Direct access to the CRS storage: stored elements of the row
+    //! \c i are column(k) and value(k) for k in [rowBegin(i), rowEnd(i)[,
+    //! sorted by increasing column.
+    size_t rowBegin(size_t i) const { return m_rows[i]; }
+    size_t rowEnd(size_t i) const { return m_rows[i + 1]; }
+    size_t column(size_t k) const { return m_cols[k]; }
+    const T& value(size_t k) const { return m_vals[k]; }
+
     //! \brief Resize the matrix (clears all elements)
     //! \param rows New number of rows
     //! \param cols New number of columns
@@ -161,15 +174,24 @@ public:
 
     // === OPERATIONS ======================================================
 
-    //! \brief Matrix-vector multiplication
+    //! \brief Matrix-vector multiplication. (max,+) and (min,+) products use
+    //! the vectorized kernels of TropicalKernels.hpp.
     //! \param vec Vector to multiply with
     //! \return Resulting vector
     std::vector<T> multiply(const std::vector<T>& vec) const;
 
+    //! \brief Matrix-vector multiplication without memory allocation.
+    //! \param vec Vector of nbColumns() elements to multiply with
+    //! \param result Resulting vector of nbRows() elements. Shall not overlap
+    //! \c vec.
+    void multiply(const T* vec, T* result) const;
+
     //! \brief Matrix-vector multiplication operator
     std::vector<T> operator*(const std::vector<T>& vec) const;
 
-    //! \brief Matrix-matrix multiplication
+    //! \brief Matrix-matrix multiplication (row-wise Gustavson algorithm).
+    //! Complexity is O(n + flops) where flops is the number of elementary
+    //! products between non-zero elements.
     //! \param other Matrix to multiply with
     //! \return Resulting matrix
     SparseMatrix<T> multiply(const SparseMatrix<T>& other) const;
@@ -177,7 +199,7 @@ public:
     //! \brief Matrix-matrix multiplication operator
     SparseMatrix<T> operator*(const SparseMatrix<T>& other) const;
 
-    //! \brief Matrix addition
+    //! \brief Matrix addition. Rows are merged: complexity is O(n + nnz).
     //! \param other Matrix to add
     //! \return Resulting matrix
     SparseMatrix<T> add(const SparseMatrix<T>& other) const;
@@ -185,7 +207,7 @@ public:
     //! \brief Matrix addition operator
     SparseMatrix<T> operator+(const SparseMatrix<T>& other) const;
 
-    //! \brief Matrix subtraction
+    //! \brief Matrix subtraction. Rows are merged: complexity is O(n + nnz).
     //! \param other Matrix to subtract
     //! \return Resulting matrix
     SparseMatrix<T> subtract(const SparseMatrix<T>& other) const;
@@ -228,6 +250,11 @@ public:
 
 private:
 
+    friend class SparseMatrixBuilder<T>;
+
+    template<typename X>
+    friend SparseMatrix<X> star(const SparseMatrix<X>& A);
+
     // === INTERNAL HELPERS ================================================
 
     //! \brief Validate that coordinates are within bounds
@@ -239,6 +266,12 @@ private:
     //! \brief Remove a non-zero element at the specified position
     void remove(size_t index, size_t row);
 
+    //! \brief Merge rows of this matrix with rows of another matrix of the
+    //! same dimensions, applying op(a, b) on elements stored by at least one
+    //! of the two matrices.
+    template<typename Operation>
+    SparseMatrix<T> merge(const SparseMatrix<T>& other, Operation op) const;
+
     // === MEMBER VARIABLES ================================================
 
     //! \brief Number of rows
@@ -253,6 +286,82 @@ private:
     std::vector<size_t> m_rows;
 };
 
+// *****************************************************************************
+//! \brief Kleene star A* = I ⨁ A ⨁ A² ⨁ ... of a square (max,+) or (min,+)
+//! matrix. (A*)(i, j) is the weight of the best path from i to j in the
+//! graph having an arc i -> j of weight A(i, j) for each stored element.
+//!
+//! If the graph is acyclic (for example the matrix D of toSysLin(), made of
+//! places without tokens), rows are computed in reverse topological order
+//! from the rows of their successors: the cost depends on the number of
+//! elements of the result. Else a Floyd-Warshall algorithm is used on a
+//! dense copy (O(n³)).
+//!
+//! \tparam T MaxPlus or MinPlus.
+//! \throw std::invalid_argument if the matrix is not square or if the graph
+//! has a circuit with a weight greater than one<T>() (positive circuit in
+//! (max,+), negative circuit in (min,+)): the star is then not finite.
+// *****************************************************************************
+template<typename T>
+SparseMatrix<T> star(const SparseMatrix<T>& A);
+
+// *****************************************************************************
+//! \brief Bulk construction of a SparseMatrix from (row, col, value) triplets.
+//!
+//! SparseMatrix::set() inserts in the middle of the CRS arrays: filling a
+//! matrix element by element costs O(nnz²). This builder only appends triplets
+//! and compresses them in O(rows + cols + nnz) when build() is called:
+//! triplets are sorted by a two-pass counting sort (by column then by row) and
+//! duplicated coordinates are combined with the addition of T (the maximum for
+//! MaxPlus, the minimum for MinPlus). Values equal to zero<T>() are not stored.
+//!
+//! \tparam T Element type (supports double, MaxPlus, MinPlus, int64_t)
+// *****************************************************************************
+template<typename T>
+class SparseMatrixBuilder
+{
+public:
+
+    //! \brief Prepare the construction of a rows x cols matrix.
+    SparseMatrixBuilder(size_t rows, size_t cols);
+
+    //! \brief Reserve memory for the given number of triplets.
+    void reserve(size_t nnz) { m_triplets.reserve(nnz); }
+
+    //! \brief Number of triplets added since the last build.
+    size_t size() const { return m_triplets.size(); }
+
+    //! \brief Add the value to the element (row, col) using 0-based indexing.
+    //! \throw std::out_of_range if coordinates are out of the matrix.
+    //! \return Reference to this builder for chaining
+    SparseMatrixBuilder<T>& add(size_t row, size_t col, T val);
+
+    //! \brief Replace the content and the dimensions of the given matrix by
+    //! the added triplets. The builder is then emptied and can be reused.
+    void build(SparseMatrix<T>& matrix);
+
+    //! \brief Return a new matrix made of the added triplets. The builder is
+    //! then emptied and can be reused.
+    SparseMatrix<T> build();
+
+private:
+
+    //! \brief Element of the matrix in coordinate format.
+    struct Triplet
+    {
+        size_t row;
+        size_t col;
+        T val;
+    };
+
+    //! \brief Number of rows
+    size_t m_rows_count;
+    //! \brief Number of columns
+    size_t m_cols_count;
+    //! \brief Elements added since the last build.
+    std::vector<Triplet> m_triplets;
+};
+
 }  // namespace tpne
 
 #endif // TPNE_SPARSE_MATRIX_H
@@ -0,0 +1,148 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/StronglyConnectedComponents.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace tpne {
+
+//------------------------------------------------------------------------------
+StronglyConnectedComponents findStronglyConnectedComponents(
+    size_t const nnodes, std::vector<int> const& IJ)
+{
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+    size_t const narcs = IJ.size() / 2u;
+
+    // Successors of each node in CSR format.
+    std::vector<size_t> offsets(nnodes + 1u, 0u);
+    for (size_t a = 0u; a < narcs; ++a)
+        ++offsets[size_t(IJ[2u * a]) + 1u];
+    for (size_t u = 0u; u < nnodes; ++u)
+        offsets[u + 1u] += offsets[u];
+    std::vector<size_t> successors(narcs);
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t a = 0u; a < narcs; ++a)
+        successors[next[size_t(IJ[2u * a])]++] = size_t(IJ[2u * a + 1u]);
+
+    StronglyConnectedComponents result;
+    result.component.assign(nnodes, NONE);
+
+    std::vector<size_t> index(nnodes, NONE);
+    std::vector<size_t> lowlink(nnodes);
+    std::vector<size_t> stack;
+    std::vector<size_t> calls; // Depth-first search: nodes being visited.
+    size_t counter = 0u;
+
+    for (size_t root = 0u; root < nnodes; ++root)
+    {
+        if (index[root] != NONE)
+            continue;
+
+        index[root] = lowlink[root] = counter++;
+        next[root] = offsets[root];
+        stack.push_back(root);
+        calls.push_back(root);
+
+        while (!calls.empty())
+        {
+            size_t const u = calls.back();
+            if (next[u] < offsets[u + 1u])
+            {
+                size_t const v = successors[next[u]++];
+                if (index[v] == NONE)
+                {
+                    // Visit the successor.
+                    index[v] = lowlink[v] = counter++;
+                    next[v] = offsets[v];
+                    stack.push_back(v);
+                    calls.push_back(v);
+                }
+                else if (result.component[v] == NONE)
+                {
+                    // The successor is on the stack.
+                    lowlink[u] = std::min(lowlink[u], index[v]);
+                }
+                continue;
+            }
+
+            // All successors visited: u is the root of a component ?
+            calls.pop_back();
+            if (lowlink[u] == index[u])
+            {
+                size_t v;
+                do
+                {
+                    v = stack.back();
+                    stack.pop_back();
+                    result.component[v] = result.count;
+                } while (v != u);
+                ++result.count;
+            }
+            if (!calls.empty())
+            {
+                size_t const parent = calls.back();
+                lowlink[parent] = std::min(lowlink[parent], lowlink[u]);
+            }
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+WeaklyConnectedComponents findWeaklyConnectedComponents(
+    size_t const nnodes, std::vector<int> const& IJ)
+{
+    // Union-find with path halving: the root of a set is its smallest node.
+    std::vector<size_t> parent(nnodes);
+    for (size_t u = 0u; u < nnodes; ++u)
+        parent[u] = u;
+
+    auto find = [&parent](size_t u)
+    {
+        while (parent[u] != u)
+            u = parent[u] = parent[parent[u]];
+        return u;
+    };
+
+    for (size_t a = 0u; a < IJ.size() / 2u; ++a)
+    {
+        size_t const u = find(size_t(IJ[2u * a]));
+        size_t const v = find(size_t(IJ[2u * a + 1u]));
+        if (u < v)
+            parent[v] = u;
+        else if (v < u)
+            parent[u] = v;
+    }
+
+    WeaklyConnectedComponents result;
+    result.component.resize(nnodes);
+    for (size_t u = 0u; u < nnodes; ++u)
+    {
+        size_t const root = find(u);
+        result.component[u] = (root == u) ? result.count++ : result.component[root];
+    }
+
+    return result;
+}
+
+} // namespace tpne
@@ -0,0 +1,79 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef STRONGLY_CONNECTED_COMPONENTS_HPP
+#  define STRONGLY_CONNECTED_COMPONENTS_HPP
+
+#  include <cstddef>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Strongly connected components of a directed graph.
+// *****************************************************************************
+struct StronglyConnectedComponents
+{
+    //! \brief Number of components.
+    size_t count = 0u;
+    //! \brief Component index of each node. Components are numbered in
+    //! reverse topological order: an arc u -> v between two different
+    //! components satisfies component[u] > component[v].
+    std::vector<size_t> component;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Compute the strongly connected components of a directed graph with
+//! the Tarjan algorithm (iterative version: no recursion limit on large
+//! graphs). Complexity is O(nodes + arcs).
+//! \param[in] nnodes number of nodes.
+//! \param[in] IJ arcs {(source node, destination node), ... } as given to
+//!   Semi_Howard().
+//--------------------------------------------------------------------------
+StronglyConnectedComponents findStronglyConnectedComponents(
+    size_t const nnodes, std::vector<int> const& IJ);
+
+// *****************************************************************************
+//! \brief Weakly connected components of a directed graph: components of the
+//! graph when the direction of arcs is ignored. No arc links two different
+//! components, so they can be analysed independently.
+// *****************************************************************************
+struct WeaklyConnectedComponents
+{
+    //! \brief Number of components.
+    size_t count = 0u;
+    //! \brief Component index of each node. Components are numbered by
+    //! increasing index of their first node.
+    std::vector<size_t> component;
+};
+
+//--------------------------------------------------------------------------
+//! \brief Compute the weakly connected components of a directed graph with
+//! a union-find. Complexity is almost O(nodes + arcs).
+//! \param[in] nnodes number of nodes.
+//! \param[in] IJ arcs {(source node, destination node), ... } as given to
+//!   Semi_Howard().
+//--------------------------------------------------------------------------
+WeaklyConnectedComponents findWeaklyConnectedComponents(
+    size_t const nnodes, std::vector<int> const& IJ);
+
+} // namespace tpne
+
+#endif
@@ -0,0 +1,216 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/SymbolicReachability.hpp"
+#include "PetriNet/PetriNet.hpp"
+
+#include <algorithm>
+
+namespace tpne {
+
+//! \brief Number of nodes of the manager triggering the garbage collector.
+static constexpr size_t COLLECT_NODES = 1u << 20;
+
+//------------------------------------------------------------------------------
+SymbolicReachability::SymbolicReachability(CompiledNet const& net)
+    : m_net(net), m_bdd(net.countPlaces())
+{}
+
+//------------------------------------------------------------------------------
+bool SymbolicReachability::explore()
+{
+    return explore(m_net.initialMarking());
+}
+
+//------------------------------------------------------------------------------
+bool SymbolicReachability::explore(Marking const& initial)
+{
+    m_bdd.reset(m_net.countPlaces());
+    m_relations.clear();
+    m_dead_transitions.clear();
+    m_reachable = BDDManager::ZERO;
+    m_deadlocks = BDDManager::ZERO;
+    m_states = 0.0;
+    m_deadlock_count = 0.0;
+    m_iterations = 0u;
+    m_error.clear();
+
+    for (size_t p = 0u; p < initial.size(); ++p)
+    {
+        if (initial[p] > 1u)
+        {
+            m_error = "The net is not 1-safe: the place P" +
+                      std::to_string(m_net.placeId(p)) +
+                      " has more than one token in the initial marking";
+            return false;
+        }
+    }
+
+    buildRelations();
+
+    // Fixed point of images.
+    size_t threshold = COLLECT_NODES;
+    m_reachable = m_bdd.minterm(valuesOf(initial));
+    BDDManager::Node previous;
+    do
+    {
+        previous = m_reachable;
+        for (auto const& r: m_relations)
+        {
+            BDDManager::Node const image = m_bdd.conjunction(
+                m_bdd.andExists(m_reachable, r.enabled, r.places), r.post);
+            m_reachable = m_bdd.disjunction(m_reachable, image);
+        }
+        ++m_iterations;
+
+        if (m_bdd.countNodes() > threshold)
+        {
+            collect({ m_reachable, previous });
+            threshold = std::max(threshold, 2u * m_bdd.countNodes());
+        }
+    } while (m_reachable != previous);
+
+    // Markings reached with saturated tokens are wrong when the net is not
+    // 1-safe, but the first unsafe firing is made from a correct marking.
+    if (Net::Settings::maxTokens != 1u)
+    {
+        for (size_t t = 0u; t < m_relations.size(); ++t)
+        {
+            Relation const& r = m_relations[t];
+            BDDManager::Node const enabled = m_bdd.conjunction(m_reachable, r.enabled);
+            if (m_bdd.conjunction(enabled, r.unsafe) != BDDManager::ZERO)
+            {
+                m_error = "The net is not 1-safe: firing the transition T" +
+                          std::to_string(m_net.transitionId(t)) +
+                          " puts a second token in a place";
+                m_reachable = BDDManager::ZERO;
+                return false;
+            }
+        }
+    }
+
+    // Deadlocks and dead transitions.
+    BDDManager::Node enabled = BDDManager::ZERO;
+    for (size_t t = 0u; t < m_relations.size(); ++t)
+    {
+        Relation const& r = m_relations[t];
+        if (m_bdd.conjunction(m_reachable, r.enabled) == BDDManager::ZERO)
+            m_dead_transitions.push_back(t);
+        enabled = m_bdd.disjunction(enabled, r.enabled);
+    }
+    m_deadlocks = m_bdd.conjunction(m_reachable, m_bdd.negation(enabled));
+
+    m_states = m_bdd.satCount(m_reachable);
+    m_deadlock_count = m_bdd.satCount(m_deadlocks);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void SymbolicReachability::buildRelations()
+{
+    size_t const P = m_net.countPlaces();
+    size_t const T = m_net.countTransitions();
+    std::vector<bool> is_input(P, false);
+    std::vector<bool> is_output(P, false);
+    std::vector<size_t> inputs, places;
+
+    m_relations.resize(T);
+    for (size_t t = 0u; t < T; ++t)
+    {
+        inputs.clear();
+        places.clear();
+        for (size_t k = m_net.preBegin(t); k < m_net.preEnd(t); ++k)
+        {
+            inputs.push_back(m_net.prePlace(k));
+            is_input[m_net.prePlace(k)] = true;
+        }
+        for (size_t k = m_net.postBegin(t); k < m_net.postEnd(t); ++k)
+        {
+            places.push_back(m_net.postPlace(k));
+            is_output[m_net.postPlace(k)] = true;
+        }
+
+        Relation& r = m_relations[t];
+        r.enabled = m_bdd.cube(inputs);
+        r.post = BDDManager::ONE;
+        r.unsafe = BDDManager::ZERO;
+        for (auto const p: places)
+        {
+            r.post = m_bdd.conjunction(r.post, m_bdd.variable(p));
+            if (!is_input[p])
+                r.unsafe = m_bdd.disjunction(r.unsafe, m_bdd.variable(p));
+        }
+        for (auto const p: inputs)
+        {
+            if (!is_output[p])
+                r.post = m_bdd.conjunction(r.post, m_bdd.negativeVariable(p));
+        }
+        places.insert(places.end(), inputs.begin(), inputs.end());
+        r.places = m_bdd.cube(places);
+
+        for (auto const p: places)
+            is_input[p] = is_output[p] = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void SymbolicReachability::collect(std::vector<BDDManager::Node> const& sets)
+{
+    std::vector<BDDManager::Node> roots(sets);
+    for (auto const& r: m_relations)
+    {
+        roots.push_back(r.enabled);
+        roots.push_back(r.places);
+        roots.push_back(r.post);
+        roots.push_back(r.unsafe);
+    }
+    m_bdd.collect(roots);
+}
+
+//------------------------------------------------------------------------------
+std::vector<bool> SymbolicReachability::valuesOf(Marking const& marking) const
+{
+    std::vector<bool> values(m_net.countPlaces(), false);
+    for (size_t p = 0u; p < values.size(); ++p)
+        values[p] = (marking[p] != 0u);
+    return values;
+}
+
+//------------------------------------------------------------------------------
+bool SymbolicReachability::contains(Marking const& marking) const
+{
+    for (auto const tokens: marking)
+    {
+        if (tokens > 1u)
+            return false;
+    }
+    return m_bdd.evaluate(m_reachable, valuesOf(marking));
+}
+
+//------------------------------------------------------------------------------
+bool SymbolicReachability::deadlock(Marking& marking) const
+{
+    std::vector<bool> values;
+    bool const found = m_bdd.pick(m_deadlocks, values);
+    marking.assign(values.begin(), values.end());
+    return found;
+}
+
+} // namespace tpne
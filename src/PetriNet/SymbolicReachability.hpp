@@ -0,0 +1,184 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef SYMBOLIC_REACHABILITY_HPP
+#  define SYMBOLIC_REACHABILITY_HPP
+
+#  include "PetriNet/BDD.hpp"
+#  include "PetriNet/CompiledNet.hpp"
+
+#  include <string>
+#  include <vector>
+
+namespace tpne {
+
+// *****************************************************************************
+//! \brief Symbolic state space of a 1-safe net (at most one token per place,
+//! for example a GRAFCET) computed with binary decision diagrams: sets of
+//! markings are boolean functions of one variable per place (the place index),
+//! therefore millions of markings are handled without enumerating them.
+//!
+//! The transition relation is partitioned by transition. Since the net is
+//! safe, firing the transition t only depends on its input and output places:
+//! t is enabled when all its input places are marked and the image of a set
+//! of markings S is: (exists places of t: S & enabled(t)) & output places
+//! marked & other input places unmarked. The reachable set is the fixed point
+//! of images of all transitions (chained: each image is added to the set
+//! before computing the next one).
+//!
+//! Like ReachabilityGraph, receptivities are not evaluated and tokens are
+//! saturated when Net::Settings::maxTokens is 1 (GRAFCET). Else the net shall
+//! be 1-safe: explore() fails when a reachable firing puts a second token in a
+//! place.
+// *****************************************************************************
+class SymbolicReachability
+{
+public:
+
+    using Marking = CompiledNet::Marking;
+
+    //--------------------------------------------------------------------------
+    //! \brief Constructor. Nothing is computed until explore() is called.
+    //! \param[in] net: the compiled net to explore. Shall outlive this
+    //! instance.
+    //--------------------------------------------------------------------------
+    explicit SymbolicReachability(CompiledNet const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute the markings reachable from the initial marking of the
+    //! compiled net, its deadlocks and its dead transitions.
+    //! \return false if the net is not 1-safe (see error()).
+    //--------------------------------------------------------------------------
+    bool explore();
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute the markings reachable from the given marking (indexed
+    //! by place index).
+    //! \return false if the net is not 1-safe (see error()).
+    //--------------------------------------------------------------------------
+    bool explore(Marking const& initial);
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the reason of the failure of explore().
+    //--------------------------------------------------------------------------
+    inline std::string const& error() const { return m_error; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of reachable markings.
+    //--------------------------------------------------------------------------
+    inline double countStates() const { return m_states; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of reachable markings where no transition is
+    //! enabled.
+    //--------------------------------------------------------------------------
+    inline double countDeadlocks() const { return m_deadlock_count; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the sorted transition indices which are enabled by no
+    //! reachable marking.
+    //--------------------------------------------------------------------------
+    inline std::vector<size_t> const& deadTransitions() const { return m_dead_transitions; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of fixed point iterations (rounds of images
+    //! of all transitions).
+    //--------------------------------------------------------------------------
+    inline size_t iterations() const { return m_iterations; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Return true if the marking (indexed by place index) is
+    //! reachable.
+    //--------------------------------------------------------------------------
+    bool contains(Marking const& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Get one of the deadlocks.
+    //! \return false if there is no deadlock.
+    //--------------------------------------------------------------------------
+    bool deadlock(Marking& marking) const;
+
+    //--------------------------------------------------------------------------
+    //! \brief Return the number of nodes of the diagram of reachable markings.
+    //--------------------------------------------------------------------------
+    inline size_t countNodes() const { return m_bdd.size(m_reachable); }
+
+private:
+
+    // *************************************************************************
+    //! \brief Partition of the transition relation for a transition.
+    // *************************************************************************
+    struct Relation
+    {
+        //! \brief Markings enabling the transition: its input places marked.
+        BDDManager::Node enabled;
+        //! \brief Cube of input and output places, quantified by the image.
+        BDDManager::Node places;
+        //! \brief Places after the firing: output places marked, other input
+        //! places unmarked.
+        BDDManager::Node post;
+        //! \brief Markings with tokens in output places which are not input
+        //! places: firing puts a second token.
+        BDDManager::Node unsafe;
+    };
+
+    //--------------------------------------------------------------------------
+    //! \brief Build the partitioned transition relation.
+    //--------------------------------------------------------------------------
+    void buildRelations();
+
+    //--------------------------------------------------------------------------
+    //! \brief Free the nodes of the manager not used by the relations and the
+    //! given sets.
+    //--------------------------------------------------------------------------
+    void collect(std::vector<BDDManager::Node> const& sets);
+
+    //--------------------------------------------------------------------------
+    //! \brief Convert a marking to values of variables.
+    //--------------------------------------------------------------------------
+    std::vector<bool> valuesOf(Marking const& marking) const;
+
+private:
+
+    //! \brief The net to explore.
+    CompiledNet const& m_net;
+    //! \brief Decision diagrams: one variable per place index.
+    BDDManager m_bdd;
+    //! \brief Transition relation for each transition index.
+    std::vector<Relation> m_relations;
+    //! \brief Reachable markings.
+    BDDManager::Node m_reachable = BDDManager::ZERO;
+    //! \brief Reachable markings without enabled transitions.
+    BDDManager::Node m_deadlocks = BDDManager::ZERO;
+    //! \brief Transitions enabled by no reachable marking.
+    std::vector<size_t> m_dead_transitions;
+    //! \brief Number of reachable markings.
+    double m_states = 0.0;
+    //! \brief Number of deadlocks.
+    double m_deadlock_count = 0.0;
+    //! \brief Number of fixed point iterations.
+    size_t m_iterations = 0u;
+    //! \brief Reason of the failure of explore().
+    std::string m_error;
+};
+
+} // namespace tpne
+
+#endif
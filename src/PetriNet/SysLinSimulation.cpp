@@ -0,0 +1,160 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/SysLinSimulation.hpp"
+#include "PetriNet/Algorithms.hpp"
+#include "PetriNet/TropicalKernels.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace tpne {
+
+//------------------------------------------------------------------------------
+SysLinSimulation::SysLinSimulation(SparseMatrix<MaxPlus> const& D,
+                                   SparseMatrix<MaxPlus> const& A,
+                                   SparseMatrix<MaxPlus> const& B,
+                                   SparseMatrix<MaxPlus> const& C)
+    : m_C(C)
+{
+    init(D, A, B);
+}
+
+//------------------------------------------------------------------------------
+SysLinSimulation::SysLinSimulation(Net const& net)
+{
+    SparseMatrix<MaxPlus> D, A, B;
+    if (!toSysLin(net, D, A, B, m_C))
+    {
+        throw std::invalid_argument("The Petri net is not an event graph");
+    }
+    init(D, A, B);
+}
+
+//------------------------------------------------------------------------------
+void SysLinSimulation::init(SparseMatrix<MaxPlus> const& D,
+                            SparseMatrix<MaxPlus> const& A,
+                            SparseMatrix<MaxPlus> const& B)
+{
+    size_t const n = D.nbRows();
+    if ((D.nbColumns() != n) || (A.nbRows() != n) || (A.nbColumns() != n) ||
+        (B.nbRows() != n) || (m_C.nbColumns() != n))
+    {
+        throw std::invalid_argument(
+            "Cannot simulate: matrices dimensions of the system don't match.");
+    }
+
+    SparseMatrix<MaxPlus> const Ds = star(D);
+    m_DsA = Ds * A;
+    m_DsB = Ds * B;
+
+    m_ax.resize(n);
+    m_bu.resize(n);
+    m_y.resize(m_C.nbRows());
+    reset();
+}
+
+//------------------------------------------------------------------------------
+void SysLinSimulation::reset()
+{
+    m_x.assign(states(), zero<MaxPlus>());
+    m_y.assign(outputs(), zero<MaxPlus>());
+    m_event = 0u;
+}
+
+//------------------------------------------------------------------------------
+void SysLinSimulation::reset(std::vector<MaxPlus> const& x0)
+{
+    if (x0.size() != states())
+    {
+        throw std::invalid_argument(
+            "Cannot simulate: initial state and number of states don't match.");
+    }
+    m_x = x0;
+    m_C.multiply(m_x.data(), m_y.data());
+    m_event = 0u;
+}
+
+//------------------------------------------------------------------------------
+void SysLinSimulation::step(MaxPlus const* u)
+{
+    // X(n) = D*A X(n-1) ⨁ D*B U(n)
+    m_DsA.multiply(m_x.data(), m_ax.data());
+    if ((u != nullptr) && (inputs() != 0u))
+    {
+        m_DsB.multiply(u, m_bu.data());
+        tropical::maxPlusAdd(states(), reinterpret_cast<double const*>(m_ax.data()),
+                             reinterpret_cast<double const*>(m_bu.data()),
+                             reinterpret_cast<double*>(m_x.data()));
+    }
+    else
+    {
+        m_x.swap(m_ax);
+    }
+
+    // Y(n) = C X(n)
+    m_C.multiply(m_x.data(), m_y.data());
+    ++m_event;
+}
+
+//------------------------------------------------------------------------------
+void SysLinSimulation::simulate(size_t const events, MaxPlus const* U,
+                                MaxPlus* X, MaxPlus* Y)
+{
+    size_t const n = states();
+    size_t const m = inputs();
+    size_t const p = outputs();
+
+    for (size_t k = 0u; k < events; ++k)
+    {
+        step((U != nullptr) ? U + k * m : nullptr);
+        if (X != nullptr)
+        {
+            std::copy(m_x.begin(), m_x.end(), X + k * n);
+        }
+        if (Y != nullptr)
+        {
+            std::copy(m_y.begin(), m_y.end(), Y + k * p);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void SysLinSimulation::simulate(size_t const events, MaxPlus const* U, std::ostream& os)
+{
+    size_t const m = inputs();
+
+    for (size_t k = 0u; k < events; ++k)
+    {
+        step((U != nullptr) ? U + k * m : nullptr);
+        os << m_event;
+        for (auto const& x: m_x)
+        {
+            os << ", " << x;
+        }
+        for (auto const& y: m_y)
+        {
+            os << ", " << y;
+        }
+        os << '\n';
+    }
+}
+
+} // namespace tpne
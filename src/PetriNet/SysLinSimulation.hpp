@@ -0,0 +1,151 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef SYSLIN_SIMULATION_HPP
+#  define SYSLIN_SIMULATION_HPP
+
+#  include "PetriNet/SparseMatrix.hpp"
+
+#  include <cstddef>
+#  include <ostream>
+#  include <vector>
+
+namespace tpne {
+
+class Net;
+
+// *****************************************************************************
+//! \brief Simulation of the dater trajectories of a timed event graph given as
+//! implicit (max,+) linear system (see toSysLin()):
+//!   X(n) = D X(n) ⨁ A X(n-1) ⨁ B U(n)
+//!   Y(n) = C X(n)
+//!
+//! The implicit part is removed once at construction with star(): D* = I ⨁ D
+//! ⨁ D² ⨁ ... is finite when the event graph has no circuit without tokens
+//! having a positive duration. The system becomes explicit:
+//!   X(n) = D*A X(n-1) ⨁ D*B U(n)
+//! Each event then costs two sparse (max,+) matrix-vector products, without
+//! memory allocation.
+// *****************************************************************************
+class SysLinSimulation
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //! \brief Prepare the simulation from the matrices of the system.
+    //! \throw std::invalid_argument if dimensions do not match or if D* is not
+    //! finite.
+    //--------------------------------------------------------------------------
+    SysLinSimulation(SparseMatrix<MaxPlus> const& D, SparseMatrix<MaxPlus> const& A,
+                     SparseMatrix<MaxPlus> const& B, SparseMatrix<MaxPlus> const& C);
+
+    //--------------------------------------------------------------------------
+    //! \brief Prepare the simulation of the timed event graph.
+    //! \throw std::invalid_argument if the net is not an event graph or if it
+    //! has a circuit without tokens and with a positive duration.
+    //--------------------------------------------------------------------------
+    explicit SysLinSimulation(Net const& net);
+
+    //--------------------------------------------------------------------------
+    //! \brief Dimensions of the system.
+    //--------------------------------------------------------------------------
+    inline size_t states() const { return m_DsA.nbRows(); }
+    inline size_t inputs() const { return m_DsB.nbColumns(); }
+    inline size_t outputs() const { return m_C.nbRows(); }
+
+    //--------------------------------------------------------------------------
+    //! \brief Explicit form D*A and D*B of the system.
+    //--------------------------------------------------------------------------
+    inline SparseMatrix<MaxPlus> const& DsA() const { return m_DsA; }
+    inline SparseMatrix<MaxPlus> const& DsB() const { return m_DsB; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Restart from the initial state X(0). By default all states are
+    //! epsilon (-inf).
+    //! \throw std::invalid_argument if x0 has not states() elements.
+    //--------------------------------------------------------------------------
+    void reset();
+    void reset(std::vector<MaxPlus> const& x0);
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute the next event X(n) and Y(n) from X(n-1) and U(n).
+    //! \param[in] u: inputs() dates. Can be nullptr when the system has no
+    //! input.
+    //--------------------------------------------------------------------------
+    void step(MaxPlus const* u);
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute the next events into preallocated buffers.
+    //! \param[in] events: number of events to compute.
+    //! \param[in] U: events x inputs() dates (row-major: inputs of the first
+    //! event first). Can be nullptr when the system has no input.
+    //! \param[out] X: events x states() dates or nullptr if not needed.
+    //! \param[out] Y: events x outputs() dates or nullptr if not needed.
+    //--------------------------------------------------------------------------
+    void simulate(size_t const events, MaxPlus const* U, MaxPlus* X, MaxPlus* Y);
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute the next events and stream them as CSV: one line per
+    //! event holding the event number, the states then the outputs.
+    //! \param[in] U: same as simulate(size_t, MaxPlus const*, MaxPlus*, MaxPlus*).
+    //--------------------------------------------------------------------------
+    void simulate(size_t const events, MaxPlus const* U, std::ostream& os);
+
+    //--------------------------------------------------------------------------
+    //! \brief Number of events computed since the last reset.
+    //--------------------------------------------------------------------------
+    inline size_t event() const { return m_event; }
+
+    //--------------------------------------------------------------------------
+    //! \brief Current states X(n) and outputs Y(n).
+    //--------------------------------------------------------------------------
+    inline std::vector<MaxPlus> const& X() const { return m_x; }
+    inline std::vector<MaxPlus> const& Y() const { return m_y; }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //! \brief Compute m_DsA and m_DsB.
+    //--------------------------------------------------------------------------
+    void init(SparseMatrix<MaxPlus> const& D, SparseMatrix<MaxPlus> const& A,
+              SparseMatrix<MaxPlus> const& B);
+
+private:
+
+    //! \brief D* A
+    SparseMatrix<MaxPlus> m_DsA;
+    //! \brief D* B
+    SparseMatrix<MaxPlus> m_DsB;
+    //! \brief Output matrix.
+    SparseMatrix<MaxPlus> m_C;
+    //! \brief States X(n).
+    std::vector<MaxPlus> m_x;
+    //! \brief Outputs Y(n).
+    std::vector<MaxPlus> m_y;
+    //! \brief Scratch buffers for D*A X(n-1) and D*B U(n).
+    std::vector<MaxPlus> m_ax;
+    std::vector<MaxPlus> m_bu;
+    //! \brief Number of events since the last reset.
+    size_t m_event = 0u;
+};
+
+} // namespace tpne
+
+#endif
@@ -0,0 +1,310 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "PetriNet/TropicalKernels.hpp"
+
+#include <atomic>
+#include <limits>
+
+#if !defined(TPNE_DISABLE_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#  define TPNE_TROPICAL_AVX2
+#  include <immintrin.h>
+#endif
+
+namespace tpne {
+namespace tropical {
+
+// *****************************************************************************
+//! \brief Operations of the (max,+) algebra.
+// *****************************************************************************
+struct Max
+{
+    static constexpr bool is_max = true;
+    static inline double epsilon() { return -std::numeric_limits<double>::infinity(); }
+    static inline double sum(double const a, double const b) { return (a < b) ? b : a; }
+};
+
+// *****************************************************************************
+//! \brief Operations of the (min,+) algebra.
+// *****************************************************************************
+struct Min
+{
+    static constexpr bool is_max = false;
+    static inline double epsilon() { return std::numeric_limits<double>::infinity(); }
+    static inline double sum(double const a, double const b) { return (b < a) ? b : a; }
+};
+
+//------------------------------------------------------------------------------
+//! \brief Tropical product: -inf + +inf gives NaN in IEEE 754 but shall give
+//! epsilon (absorbing element).
+//------------------------------------------------------------------------------
+template<class Op>
+static inline double product(double const a, double const b)
+{
+    double const p = a + b;
+    return (p != p) ? Op::epsilon() : p;
+}
+
+// =============================================================================
+// Scalar kernels
+// =============================================================================
+
+template<class Op>
+static void scalarSpMV(size_t const rows, size_t const* offsets, size_t const* cols,
+                       double const* vals, double const* x, double* y)
+{
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double sum = Op::epsilon();
+        for (size_t k = offsets[i]; k < offsets[i + 1u]; ++k)
+        {
+            sum = Op::sum(sum, product<Op>(vals[k], x[cols[k]]));
+        }
+        y[i] = sum;
+    }
+}
+
+template<class Op>
+static void scalarGemv(size_t const rows, size_t const cols, double const* M,
+                       double const* x, double* y)
+{
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double const* row = M + i * cols;
+        double sum = Op::epsilon();
+        for (size_t j = 0u; j < cols; ++j)
+        {
+            sum = Op::sum(sum, product<Op>(row[j], x[j]));
+        }
+        y[i] = sum;
+    }
+}
+
+template<class Op>
+static void scalarAdd(size_t const n, double const* a, double const* b, double* y)
+{
+    for (size_t i = 0u; i < n; ++i)
+    {
+        y[i] = Op::sum(a[i], b[i]);
+    }
+}
+
+// =============================================================================
+// AVX2 kernels
+// =============================================================================
+
+#if defined(TPNE_TROPICAL_AVX2)
+
+template<class Op>
+__attribute__((target("avx2")))
+static inline __m256d sum4(__m256d const a, __m256d const b)
+{
+    return Op::is_max ? _mm256_max_pd(a, b) : _mm256_min_pd(a, b);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Tropical product of 4 doubles, NaN being replaced by epsilon.
+//------------------------------------------------------------------------------
+template<class Op>
+__attribute__((target("avx2")))
+static inline __m256d product4(__m256d const a, __m256d const b, __m256d const eps)
+{
+    __m256d const p = _mm256_add_pd(a, b);
+    return _mm256_blendv_pd(p, eps, _mm256_cmp_pd(p, p, _CMP_UNORD_Q));
+}
+
+template<class Op>
+__attribute__((target("avx2")))
+static inline double reduce4(__m256d const v)
+{
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, v);
+    return Op::sum(Op::sum(lanes[0], lanes[1]), Op::sum(lanes[2], lanes[3]));
+}
+
+template<class Op>
+__attribute__((target("avx2")))
+static void avx2SpMV(size_t const rows, size_t const* offsets, size_t const* cols,
+                     double const* vals, double const* x, double* y)
+{
+    __m256d const eps = _mm256_set1_pd(Op::epsilon());
+
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        size_t k = offsets[i];
+        size_t const end = offsets[i + 1u];
+        double sum = Op::epsilon();
+
+        // Short rows do not amortize the horizontal reduction.
+        if (end - k >= 8u)
+        {
+            __m256d acc = eps;
+            for (; k + 4u <= end; k += 4u)
+            {
+                __m256d const xs = _mm256_set_pd(x[cols[k + 3u]], x[cols[k + 2u]],
+                                                 x[cols[k + 1u]], x[cols[k]]);
+                acc = sum4<Op>(acc, product4<Op>(_mm256_loadu_pd(vals + k), xs, eps));
+            }
+            sum = reduce4<Op>(acc);
+        }
+        for (; k < end; ++k)
+        {
+            sum = Op::sum(sum, product<Op>(vals[k], x[cols[k]]));
+        }
+        y[i] = sum;
+    }
+}
+
+template<class Op>
+__attribute__((target("avx2")))
+static void avx2Gemv(size_t const rows, size_t const cols, double const* M,
+                     double const* x, double* y)
+{
+    __m256d const eps = _mm256_set1_pd(Op::epsilon());
+
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double const* row = M + i * cols;
+        __m256d acc = eps;
+        size_t j = 0u;
+        for (; j + 4u <= cols; j += 4u)
+        {
+            acc = sum4<Op>(acc, product4<Op>(_mm256_loadu_pd(row + j), _mm256_loadu_pd(x + j), eps));
+        }
+        double sum = reduce4<Op>(acc);
+        for (; j < cols; ++j)
+        {
+            sum = Op::sum(sum, product<Op>(row[j], x[j]));
+        }
+        y[i] = sum;
+    }
+}
+
+template<class Op>
+__attribute__((target("avx2")))
+static void avx2Add(size_t const n, double const* a, double const* b, double* y)
+{
+    size_t i = 0u;
+    for (; i + 4u <= n; i += 4u)
+    {
+        _mm256_storeu_pd(y + i, sum4<Op>(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    for (; i < n; ++i)
+    {
+        y[i] = Op::sum(a[i], b[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+static bool cpuHasAVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+static bool cpuHasAVX2()
+{
+    return false;
+}
+
+#endif
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+
+//------------------------------------------------------------------------------
+//! \brief Are AVX2 kernels used ? Initialized from the CPU capabilities.
+//------------------------------------------------------------------------------
+static std::atomic<bool>& simd()
+{
+    static std::atomic<bool> enabled(cpuHasAVX2());
+    return enabled;
+}
+
+//------------------------------------------------------------------------------
+bool isSIMDEnabled()
+{
+    return simd().load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool enableSIMD(bool const enable)
+{
+    bool const enabled = enable && cpuHasAVX2();
+    simd().store(enabled, std::memory_order_relaxed);
+    return enabled;
+}
+
+#if defined(TPNE_TROPICAL_AVX2)
+#  define TPNE_DISPATCH(kernel, op, ...)         \
+    if (isSIMDEnabled())                         \
+        avx2##kernel<op>(__VA_ARGS__);           \
+    else                                         \
+        scalar##kernel<op>(__VA_ARGS__)
+#else
+#  define TPNE_DISPATCH(kernel, op, ...)         \
+    scalar##kernel<op>(__VA_ARGS__)
+#endif
+
+//------------------------------------------------------------------------------
+void maxPlusSpMV(size_t const rows, size_t const* offsets, size_t const* cols,
+                 double const* vals, double const* x, double* y)
+{
+    TPNE_DISPATCH(SpMV, Max, rows, offsets, cols, vals, x, y);
+}
+
+//------------------------------------------------------------------------------
+void minPlusSpMV(size_t const rows, size_t const* offsets, size_t const* cols,
+                 double const* vals, double const* x, double* y)
+{
+    TPNE_DISPATCH(SpMV, Min, rows, offsets, cols, vals, x, y);
+}
+
+//------------------------------------------------------------------------------
+void maxPlusGemv(size_t const rows, size_t const cols, double const* M,
+                 double const* x, double* y)
+{
+    TPNE_DISPATCH(Gemv, Max, rows, cols, M, x, y);
+}
+
+//------------------------------------------------------------------------------
+void minPlusGemv(size_t const rows, size_t const cols, double const* M,
+                 double const* x, double* y)
+{
+    TPNE_DISPATCH(Gemv, Min, rows, cols, M, x, y);
+}
+
+//------------------------------------------------------------------------------
+void maxPlusAdd(size_t const n, double const* a, double const* b, double* y)
+{
+    TPNE_DISPATCH(Add, Max, n, a, b, y);
+}
+
+//------------------------------------------------------------------------------
+void minPlusAdd(size_t const n, double const* a, double const* b, double* y)
+{
+    TPNE_DISPATCH(Add, Min, n, a, b, y);
+}
+
+} // namespace tropical
+} // namespace tpne
@@ -0,0 +1,93 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef TROPICAL_KERNELS_HPP
+#  define TROPICAL_KERNELS_HPP
+
+#  include <cstddef>
+
+// *****************************************************************************
+//! \brief Vectorized kernels for the (max,+) and (min,+) algebras working on
+//! raw arrays of double (MaxPlus and MinPlus have the memory layout of a
+//! double).
+//!
+//! On x86-64 with GCC or Clang, kernels are compiled twice: a portable scalar
+//! version and an AVX2 version (4 doubles per instruction). The version is
+//! chosen at runtime depending on the CPU. Define TPNE_DISABLE_SIMD at build
+//! time to only compile the scalar version.
+//!
+//! Epsilon (-inf for (max,+) and +inf for (min,+)) is absorbing for the
+//! product: epsilon (x) +-inf is epsilon and never NaN.
+// *****************************************************************************
+
+namespace tpne {
+namespace tropical {
+
+//------------------------------------------------------------------------------
+//! \brief Return true if the AVX2 kernels are used.
+//------------------------------------------------------------------------------
+bool isSIMDEnabled();
+
+//------------------------------------------------------------------------------
+//! \brief Enable or disable the AVX2 kernels (for benchmarks and tests). The
+//! AVX2 kernels are enabled by default when the CPU supports them.
+//! \return true if the AVX2 kernels are used after this call: always false if
+//! the CPU does not support them.
+//------------------------------------------------------------------------------
+bool enableSIMD(bool const enable);
+
+//------------------------------------------------------------------------------
+//! \brief Sparse matrix-vector product y = M (x) x in CRS format.
+//! \param[in] rows: number of rows of M (size of y).
+//! \param[in] offsets: row pointers (rows + 1 elements).
+//! \param[in] cols: column indices of the non-zero elements.
+//! \param[in] vals: values of the non-zero elements.
+//! \param[in] x: vector of size the number of columns of M.
+//! \param[out] y: result. Shall not overlap x.
+//------------------------------------------------------------------------------
+void maxPlusSpMV(size_t const rows, size_t const* offsets, size_t const* cols,
+                 double const* vals, double const* x, double* y);
+void minPlusSpMV(size_t const rows, size_t const* offsets, size_t const* cols,
+                 double const* vals, double const* x, double* y);
+
+//------------------------------------------------------------------------------
+//! \brief Dense matrix-vector product y = M (x) x.
+//! \param[in] rows: number of rows of M (size of y).
+//! \param[in] cols: number of columns of M (size of x).
+//! \param[in] M: row-major matrix of rows x cols elements.
+//! \param[in] x: input vector.
+//! \param[out] y: result. Shall not overlap x.
+//------------------------------------------------------------------------------
+void maxPlusGemv(size_t const rows, size_t const cols, double const* M,
+                 double const* x, double* y);
+void minPlusGemv(size_t const rows, size_t const cols, double const* M,
+                 double const* x, double* y);
+
+//------------------------------------------------------------------------------
+//! \brief Element-wise sum y = a (+) b of vectors of n elements. y can be a or
+//! b.
+//------------------------------------------------------------------------------
+void maxPlusAdd(size_t const n, double const* a, double const* b, double* y);
+void minPlusAdd(size_t const n, double const* a, double const* b, double* y);
+
+} // namespace tropical
+} // namespace tpne
+
+#endif
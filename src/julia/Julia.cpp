@@ -22,6 +22,7 @@
 
 #include "PetriNet/PetriNet.hpp"
 #include "PetriNet/Algorithms.hpp"
+#include "PetriNet/BatchSimulation.hpp"
 #include "PetriNet/SparseMatrix.hpp"
 #include "PetriNet/TropicalAlgebra.hpp"
 
@@ -205,6 +206,7 @@ bool petri_set_marks(int64_t const pn, int64_t const* tokens)
     {
         places[i].tokens = size_t(tokens[i]);
     }
+    g_petri_nets[size_t(pn)]->touchMarking();
     return true;
 }
 
@@ -353,9 +355,29 @@ bool petri_set_tokens(int64_t const pn, int64_t const id, int64_t const tokens)
         return -1;
 
     places[size_t(id)].tokens = size_t(tokens);
+    g_petri_nets[size_t(pn)]->touchMarking();
     return true;
 }
 
+//------------------------------------------------------------------------------
+int64_t petri_simulate(int64_t const pn, double const duration, int64_t const seed,
+                       int64_t* tokens)
+{
+    CHECK_VALID_PETRI_HANDLE(pn, -1);
+
+    tpne::CompiledNet const compiled(*g_petri_nets[size_t(pn)]);
+    tpne::BatchSimulation simulation(compiled, uint32_t(seed));
+    simulation.runUntil(duration);
+
+    tpne::BatchSimulation::Marking const& marking = simulation.marking();
+    size_t i = marking.size();
+    while (i--)
+    {
+        tokens[i] = int64_t(marking[i]);
+    }
+    return int64_t(simulation.firings());
+}
+
 //------------------------------------------------------------------------------
 bool petri_save(int64_t const pn, const char* filepath)
 {
@@ -458,7 +480,11 @@ bool petri_to_adjacency_matrices(int64_t const pn, CSparseMatrix_t* pN, CSparseM
     CHECK_VALID_PETRI_HANDLE(pn, false);
     CHECK_IS_EVENT_GRAPH(pn, false);
 
-    if (tpne::toAdjacencyMatrices(*g_petri_nets[size_t(pn)], N, T))
+    if (!tpne::toAdjacencyMatrices(*g_petri_nets[size_t(pn)], N, T))
+    {
+        std::cerr << "Parallel places cannot be folded into adjacency matrices" << std::endl;
+        return false;
+    }
     convert(N, pN);
     convert(T, pT);
     return true;
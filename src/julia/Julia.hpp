@@ -248,6 +248,23 @@ extern "C" int64_t petri_get_tokens(int64_t const pn, int64_t const id);
 extern "C" bool petri_set_tokens(int64_t const pn, int64_t const id,
                                  int64_t const tokens);
 
+// ****************************************************************************
+//! \brief Simulate the Petri net without the GUI (discrete-event simulation)
+//! from its current marking during the given duration. The marking of the net
+//! is not modified.
+//! \param[in] pn: the handle of the petri net created by create_petri_net().
+//! \param[in] duration: duration of the simulation (in unit of time of arcs).
+//! \param[in] seed: seed of the random generator for the order of firings.
+//! \param[out] tokens the list of tokens for each places (#P0, #P1 .. #Pn)
+//! at the end of the simulation. Tokens transiting along arcs are not counted.
+//! \note the size of list of tokens is not checked and shall be made by the
+//! caller function.
+//! \return -1 if the Petri net handle is invalid or return the number of
+//! firings.
+// ****************************************************************************
+extern "C" int64_t petri_simulate(int64_t const pn, double const duration,
+                                  int64_t const seed, int64_t* tokens);
+
 // ****************************************************************************
 //! \brief Save the petri net.
 //! \param[in] pn: the handle of the petri net created by create_petri_net().
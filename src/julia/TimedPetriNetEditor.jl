@@ -457,6 +457,31 @@ end
 
 # TODO retourner successeurs https://youtu.be/mN8XWiXyHyk
 
+"""
+    simulate
+
+Simulate the Petri net, without the GUI, during the given duration and return
+the number of firings and the marking at the end of the simulation. The marking
+of the Petri net is not modified. The seed makes the order of firings
+reproducible.
+Throw an exception if the Petri net handle is invalid.
+
+# Examples
+```julia-repl
+julia> pn = load_petri("examples/Howard2.json")
+PetriNet(0)
+
+julia> firings, marking = simulate(pn, 100.0)
+```
+"""
+function simulate(pn::PetriNet, duration::Float64; seed::Int=0)
+    list = Vector{Int}(undef, max(count_places(pn), 0))
+    firings = ccall((:petri_simulate, libtpne), Clonglong, (Clonglong, Cdouble, Clonglong, Ptr{Int}),
+                    pn.handle, duration, seed, list)
+    (firings < 0) && error("Invalid Petri net handle")
+    return (firings, list)
+end
+
 """
     tokens!
 
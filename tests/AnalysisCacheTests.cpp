@@ -0,0 +1,172 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/AnalysisCache.hpp"
+#include "PetriNet/PetriNet.hpp"
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Create a timed event graph made of a circuit of two transitions.
+//------------------------------------------------------------------------------
+static void createCircuit(Net& net)
+{
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(1.0f, 0.0f);
+    net.addArc(t0, t1, 1u, 3.0f);
+    net.addArc(t1, t0, 0u, 2.0f);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestAnalysisCache, TestRevisions)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    uint64_t structure = net.structureRevision();
+    uint64_t marking = net.markingRevision();
+    ASSERT_NE(structure, 0u);
+    ASSERT_NE(marking, 0u);
+
+    // Structural modifications.
+    Place& p = net.addPlace(0.0f, 0.0f, 1u);
+    ASSERT_NE(net.structureRevision(), structure);
+    ASSERT_EQ(net.markingRevision(), marking);
+    structure = net.structureRevision();
+    Transition& t = net.addTransition(1.0f, 0.0f);
+    ASSERT_NE(net.structureRevision(), structure);
+    structure = net.structureRevision();
+    ASSERT_STREQ(net.addArc(p, t).c_str(), "");
+    ASSERT_NE(net.structureRevision(), structure);
+    structure = net.structureRevision();
+
+    // Moving nodes is not a structural modification.
+    p.x = 42.0f;
+    t.y = 42.0f;
+    ASSERT_EQ(net.structureRevision(), structure);
+    ASSERT_EQ(net.markingRevision(), marking);
+
+    // Marking modifications.
+    ASSERT_EQ(net.tokens({ 3u }), true);
+    ASSERT_EQ(net.structureRevision(), structure);
+    ASSERT_NE(net.markingRevision(), marking);
+    marking = net.markingRevision();
+    p.increment();
+    net.touchMarking();
+    ASSERT_NE(net.markingRevision(), marking);
+
+    // Copies have their own revisions.
+    Net copy(net);
+    ASSERT_NE(copy.structureRevision(), net.structureRevision());
+    ASSERT_NE(copy.markingRevision(), net.markingRevision());
+    structure = copy.structureRevision();
+    copy = net;
+    ASSERT_NE(copy.structureRevision(), structure);
+    ASSERT_NE(copy.structureRevision(), net.structureRevision());
+
+    // Removals.
+    structure = net.structureRevision();
+    ASSERT_EQ(net.removeArc(p, t), true);
+    ASSERT_NE(net.structureRevision(), structure);
+    structure = net.structureRevision();
+    net.removeNode(net.transitions()[0]);
+    ASSERT_NE(net.structureRevision(), structure);
+    structure = net.structureRevision();
+    net.clear();
+    ASSERT_NE(net.structureRevision(), structure);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestAnalysisCache, TestMemoization)
+{
+    Net net(TypeOfNet::TimedEventGraph);
+    createCircuit(net);
+    AnalysisCache cache;
+
+    // Computed once.
+    ASSERT_EQ(cache.isEventGraph(net), true);
+    ASSERT_EQ(cache.isEventGraph(net), true);
+    ASSERT_EQ(cache.computations(), 1u);
+    CriticalCycleResult const& res = cache.criticalCycle(net);
+    ASSERT_EQ(res.success, true);
+    ASSERT_EQ(res.durations.size(), 2u);
+    ASSERT_DOUBLE_EQ(res.durations[0], 5.0);
+    ASSERT_EQ(&cache.criticalCycle(net), &res);
+    ASSERT_EQ(cache.computations(), 2u);
+
+    // Moving nodes does not invalidate results.
+    net.transitions()[0].x = 10.0f;
+    ASSERT_EQ(cache.isEventGraph(net), true);
+    ASSERT_EQ(cache.criticalCycle(net).success, true);
+    ASSERT_EQ(cache.computations(), 2u);
+
+    // Tokens invalidate results depending on the marking only.
+    std::vector<size_t> tokens = net.tokens();
+    tokens[0] = 2u;
+    ASSERT_EQ(net.tokens(tokens), true);
+    ASSERT_EQ(cache.isEventGraph(net), true);
+    ASSERT_EQ(cache.computations(), 2u);
+    ASSERT_DOUBLE_EQ(cache.criticalCycle(net).durations[0], 2.5);
+    ASSERT_EQ(cache.computations(), 3u);
+
+    // Options of equations are part of the key.
+    std::string dater = cache.daterEquation(net, false, false);
+    ASSERT_STRNE(dater.c_str(), "");
+    ASSERT_EQ(cache.daterEquation(net, false, false), dater);
+    ASSERT_EQ(cache.computations(), 4u);
+    ASSERT_NE(cache.daterEquation(net, false, true), dater);
+    ASSERT_EQ(cache.computations(), 5u);
+
+    // Structural modifications invalidate all results.
+    Transition& t = net.addTransition(2.0f, 0.0f);
+    ASSERT_EQ(cache.isEventGraph(net), true);
+    ASSERT_EQ(cache.computations(), 6u);
+    net.addPlace(3.0f, 0.0f, 0u);
+    ASSERT_EQ(net.addArc(t, net.places().back()).empty(), true);
+    ASSERT_EQ(cache.isEventGraph(net), false);
+    ASSERT_EQ(cache.computations(), 7u);
+
+    // Results of a net are not returned for another net.
+    Net copy(net);
+    ASSERT_EQ(cache.isEventGraph(copy), false);
+    ASSERT_EQ(cache.computations(), 8u);
+
+    cache.clear();
+    ASSERT_EQ(cache.isEventGraph(net), false);
+    ASSERT_EQ(cache.computations(), 9u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestAnalysisCache, TestMatrices)
+{
+    Net net(TypeOfNet::TimedEventGraph);
+    createCircuit(net);
+    AnalysisCache cache;
+
+    AnalysisCache::SysLin const& syslin = cache.sysLin(net);
+    ASSERT_EQ(syslin.success, true);
+    SparseMatrix<MaxPlus> D, A, B, C;
+    ASSERT_EQ(toSysLin(net, D, A, B, C), true);
+    ASSERT_EQ(syslin.D, D);
+    ASSERT_EQ(syslin.A, A);
+
+    AnalysisCache::AdjacencyMatrices const& adjacency = cache.adjacencyMatrices(net);
+    ASSERT_EQ(adjacency.success, true);
+    ASSERT_EQ(cache.computations(), 2u);
+}
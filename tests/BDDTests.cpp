@@ -0,0 +1,175 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/BDD.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Return the truth table of the function over all the variables.
+//------------------------------------------------------------------------------
+static std::vector<bool> truthTable(BDDManager const& bdd, BDDManager::Node const f)
+{
+    size_t const n = bdd.countVariables();
+    std::vector<bool> table, values(n);
+    for (size_t i = 0u; i < (size_t(1) << n); ++i)
+    {
+        for (size_t v = 0u; v < n; ++v)
+            values[v] = (i >> v) & 1u;
+        table.push_back(bdd.evaluate(f, values));
+    }
+    return table;
+}
+
+//------------------------------------------------------------------------------
+TEST(TestBDD, TestOperators)
+{
+    BDDManager bdd(4u);
+    BDDManager::Node const x0 = bdd.variable(0u);
+    BDDManager::Node const x1 = bdd.variable(1u);
+    BDDManager::Node const x2 = bdd.variable(2u);
+
+    ASSERT_EQ(bdd.variable(0u), x0);
+    ASSERT_EQ(bdd.negation(x0), bdd.negativeVariable(0u));
+    ASSERT_EQ(bdd.negation(bdd.negation(x0)), x0);
+    ASSERT_EQ(bdd.conjunction(x0, bdd.negation(x0)), BDDManager::ZERO);
+    ASSERT_EQ(bdd.disjunction(x0, bdd.negation(x0)), BDDManager::ONE);
+
+    // De Morgan and commutativity: equivalent functions share their node.
+    BDDManager::Node const a = bdd.negation(bdd.conjunction(x0, x1));
+    BDDManager::Node const b = bdd.disjunction(bdd.negation(x1), bdd.negation(x0));
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(bdd.ite(x0, x1, x2), bdd.disjunction(bdd.conjunction(x0, x1),
+              bdd.conjunction(bdd.negation(x0), x2)));
+
+    // Counting over the 4 variables.
+    ASSERT_EQ(bdd.satCount(BDDManager::ZERO), 0.0);
+    ASSERT_EQ(bdd.satCount(BDDManager::ONE), 16.0);
+    ASSERT_EQ(bdd.satCount(x0), 8.0);
+    ASSERT_EQ(bdd.satCount(bdd.conjunction(x0, x1)), 4.0);
+    ASSERT_EQ(bdd.satCount(bdd.disjunction(x0, x1)), 12.0);
+    ASSERT_EQ(bdd.size(bdd.conjunction(x0, x1)), 4u);
+
+    // Quantification.
+    BDDManager::Node const f = bdd.conjunction(bdd.conjunction(x0, x1), x2);
+    ASSERT_EQ(bdd.exists(f, bdd.cube({ 0u })), bdd.conjunction(x1, x2));
+    ASSERT_EQ(bdd.exists(f, bdd.cube({ 2u, 0u })), x1);
+    ASSERT_EQ(bdd.exists(f, bdd.cube({ 0u, 1u, 2u })), BDDManager::ONE);
+    ASSERT_EQ(bdd.exists(bdd.ite(x1, x0, x2), bdd.cube({ 1u })), bdd.disjunction(x0, x2));
+    ASSERT_EQ(bdd.andExists(bdd.disjunction(x0, x1), bdd.negation(x0), bdd.cube({ 0u })), x1);
+
+    // Assignments.
+    std::vector<bool> values;
+    ASSERT_EQ(bdd.pick(BDDManager::ZERO, values), false);
+    ASSERT_EQ(bdd.pick(bdd.conjunction(bdd.negation(x0), x2), values), true);
+    ASSERT_EQ(values, std::vector<bool>({ false, false, true, false }));
+    BDDManager::Node const m = bdd.minterm({ true, false, true, true });
+    ASSERT_EQ(bdd.satCount(m), 1.0);
+    ASSERT_EQ(bdd.pick(m, values), true);
+    ASSERT_EQ(values, std::vector<bool>({ true, false, true, true }));
+    ASSERT_EQ(bdd.evaluate(m, values), true);
+    values[3] = false;
+    ASSERT_EQ(bdd.evaluate(m, values), false);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestBDD, TestRandomFunctions)
+{
+    // Compare operators on random functions with their truth tables.
+    size_t const n = 8u;
+    BDDManager bdd(n);
+    std::mt19937 generator(42u);
+    std::vector<BDDManager::Node> functions;
+    std::vector<std::vector<bool>> tables;
+    for (size_t v = 0u; v < n; ++v)
+    {
+        functions.push_back(bdd.variable(v));
+        tables.push_back(truthTable(bdd, functions.back()));
+    }
+
+    std::uniform_int_distribution<size_t> op(0u, 4u);
+    for (size_t i = 0u; i < 300u; ++i)
+    {
+        std::uniform_int_distribution<size_t> pick(0u, functions.size() - 1u);
+        size_t const a = pick(generator), b = pick(generator), c = pick(generator);
+        std::vector<bool> table(tables[a].size());
+        BDDManager::Node f;
+        switch (op(generator))
+        {
+        case 0u:
+            f = bdd.negation(functions[a]);
+            for (size_t k = 0u; k < table.size(); ++k)
+                table[k] = !tables[a][k];
+            break;
+        case 1u:
+            f = bdd.conjunction(functions[a], functions[b]);
+            for (size_t k = 0u; k < table.size(); ++k)
+                table[k] = tables[a][k] && tables[b][k];
+            break;
+        case 2u:
+            f = bdd.disjunction(functions[a], functions[b]);
+            for (size_t k = 0u; k < table.size(); ++k)
+                table[k] = tables[a][k] || tables[b][k];
+            break;
+        case 3u:
+            f = bdd.ite(functions[a], functions[b], functions[c]);
+            for (size_t k = 0u; k < table.size(); ++k)
+                table[k] = tables[a][k] ? tables[b][k] : tables[c][k];
+            break;
+        default:
+        {
+            // Exists x_v: f(x_v = 0) | f(x_v = 1).
+            size_t const v = c % n;
+            f = bdd.andExists(functions[a], functions[b], bdd.cube({ v }));
+            for (size_t k = 0u; k < table.size(); ++k)
+            {
+                size_t const k0 = k & ~(size_t(1) << v);
+                size_t const k1 = k | (size_t(1) << v);
+                table[k] = (tables[a][k0] && tables[b][k0]) || (tables[a][k1] && tables[b][k1]);
+            }
+            break;
+        }
+        }
+
+        ASSERT_EQ(truthTable(bdd, f), table);
+        ASSERT_EQ(bdd.satCount(f), double(std::count(table.begin(), table.end(), true)));
+        functions.push_back(f);
+        tables.push_back(table);
+    }
+
+    // Free the nodes of half of the functions: the others are unchanged and
+    // stay canonical.
+    size_t const nodes = bdd.countNodes();
+    std::vector<BDDManager::Node> roots(functions.begin(), functions.begin() + 150);
+    bdd.collect(roots);
+    ASSERT_LE(bdd.countNodes(), nodes);
+    for (size_t i = 0u; i < roots.size(); ++i)
+        ASSERT_EQ(truthTable(bdd, roots[i]), tables[i]);
+    for (size_t i = 1u; i < roots.size(); ++i)
+    {
+        BDDManager::Node const f = bdd.conjunction(roots[i - 1u], roots[i]);
+        ASSERT_EQ(bdd.negation(bdd.disjunction(bdd.negation(roots[i - 1u]),
+                                               bdd.negation(roots[i]))), f);
+    }
+}
@@ -0,0 +1,152 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/BatchSimulation.hpp"
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+TEST(TestBatchSimulation, TestCircuit)
+{
+    // P0 (1 token) -> T0 -> 2s -> P1 -> T1 -> 3s -> P0: cycle time is 5s.
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1, 2.0f);
+    net.addArc(p1, t1);
+    net.addArc(t1, p0, 3.0f);
+
+    CompiledNet compiled(net);
+    BatchSimulation simulation(compiled);
+    ASSERT_EQ(simulation.time(), 0.0);
+    ASSERT_EQ(simulation.firings(), 0u);
+
+    // T0 fires at 0, 5, 10 ... 100 and T1 fires at 2, 7 ... 97.
+    ASSERT_EQ(simulation.runUntil(100.0), 41u);
+    ASSERT_EQ(simulation.time(), 100.0);
+    ASSERT_EQ(simulation.firingCounts(), std::vector<size_t>({ 21u, 20u }));
+    ASSERT_EQ(simulation.marking(), std::vector<size_t>({ 0u, 0u }));
+    ASSERT_EQ(simulation.transitingTokens(), 1u);
+    ASSERT_EQ(simulation.isDead(), false);
+
+    // Going back in time does nothing.
+    ASSERT_EQ(simulation.runUntil(50.0), 0u);
+    ASSERT_EQ(simulation.time(), 100.0);
+
+    // T0 token arrives at 102.
+    ASSERT_EQ(simulation.runFirings(1u), 1u);
+    ASSERT_EQ(simulation.time(), 102.0);
+    ASSERT_EQ(simulation.firingCounts(), std::vector<size_t>({ 21u, 21u }));
+
+    // The Net is not modified.
+    ASSERT_EQ(p0.tokens, 1u);
+    ASSERT_EQ(p1.tokens, 0u);
+
+    simulation.reset();
+    ASSERT_EQ(simulation.time(), 0.0);
+    ASSERT_EQ(simulation.firings(), 0u);
+    ASSERT_EQ(simulation.marking(), std::vector<size_t>({ 1u, 0u }));
+    ASSERT_EQ(simulation.transitingTokens(), 0u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestBatchSimulation, TestSourceAndSink)
+{
+    // T0 (source) -> 1.5s -> P0 -> T1 (sink)
+    Net net(TypeOfNet::TimedPetriNet);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 0u);
+    net.addArc(t0, p0, 1.5f);
+    net.addArc(p0, t1);
+
+    CompiledNet compiled(net);
+    BatchSimulation simulation(compiled);
+
+    // The source fires at 0, 1.5, 3 ... 9: it waits for its token.
+    ASSERT_EQ(simulation.runUntil(10.0), 13u);
+    ASSERT_EQ(simulation.firingCounts(), std::vector<size_t>({ 7u, 6u }));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestBatchSimulation, TestDeadlock)
+{
+    // P0 (3 tokens) -> T0 -> P1: T0 fires 3 times then the net is dead.
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 3u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1, 1.0f);
+
+    CompiledNet compiled(net);
+    BatchSimulation simulation(compiled);
+    ASSERT_EQ(simulation.runFirings(100u), 3u);
+    ASSERT_EQ(simulation.time(), 1.0);
+    ASSERT_EQ(simulation.marking(), std::vector<size_t>({ 0u, 3u }));
+    ASSERT_EQ(simulation.isDead(), true);
+
+    // Start from another marking.
+    simulation.reset({ 1u, 0u });
+    ASSERT_EQ(simulation.runUntil(0.5), 1u);
+    ASSERT_EQ(simulation.marking(), std::vector<size_t>({ 0u, 0u }));
+    ASSERT_EQ(simulation.isDead(), false);
+    ASSERT_EQ(simulation.runUntil(1.0), 0u);
+    ASSERT_EQ(simulation.marking(), std::vector<size_t>({ 0u, 1u }));
+    ASSERT_EQ(simulation.isDead(), true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestBatchSimulation, TestSeed)
+{
+    // P0 (100 tokens) shared by T0 and T1 (conflict).
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 100u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(p0, t1);
+    net.addArc(t0, p1, 1.0f);
+    net.addArc(t1, p1, 1.0f);
+
+    CompiledNet compiled(net);
+    BatchSimulation s1(compiled, 42u);
+    BatchSimulation s2(compiled, 42u);
+    ASSERT_EQ(s1.runUntil(1.0), 100u);
+    ASSERT_EQ(s2.runUntil(1.0), 100u);
+    ASSERT_EQ(s1.firingCounts(), s2.firingCounts());
+    ASSERT_GT(s1.firingCounts()[0], 0u);
+    ASSERT_GT(s1.firingCounts()[1], 0u);
+    ASSERT_EQ(s1.marking(), std::vector<size_t>({ 0u, 100u }));
+
+    // Consume all tokens at once.
+    Net::Settings::firing = Net::Settings::Fire::MaxPossible;
+    s1.reset();
+    ASSERT_EQ(s1.runFirings(60u), 60u);
+    ASSERT_EQ(s1.marking(), std::vector<size_t>({ 40u, 0u }));
+    ASSERT_EQ(s1.transitingTokens(), 60u);
+    Net::Settings::firing = Net::Settings::Fire::OneByOne;
+}
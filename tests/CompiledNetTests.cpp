@@ -0,0 +1,133 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/CompiledNet.hpp"
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+TEST(TestCompiledNet, TestIncidence)
+{
+    // P0 -> T0 -> P1, P2 -> T1 -> P0 and T2 is a source feeding P2.
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 2u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Place& p2 = net.addPlace(0.0f, 0.0f, 1u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    Transition& t2 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1, 3.0f);
+    net.addArc(p1, t1);
+    net.addArc(p2, t1);
+    net.addArc(t1, p0, 4.0f);
+    net.addArc(t2, p2, 5.0f);
+
+    CompiledNet compiled(net);
+    ASSERT_EQ(compiled.countPlaces(), 3u);
+    ASSERT_EQ(compiled.countTransitions(), 3u);
+    ASSERT_EQ(compiled.initialMarking(), std::vector<size_t>({ 2u, 0u, 1u }));
+
+    // Pre incidence
+    ASSERT_EQ(compiled.preEnd(0u) - compiled.preBegin(0u), 1u);
+    ASSERT_EQ(compiled.prePlace(compiled.preBegin(0u)), 0u);
+    ASSERT_EQ(compiled.preEnd(1u) - compiled.preBegin(1u), 2u);
+    ASSERT_EQ(compiled.prePlace(compiled.preBegin(1u)), 1u);
+    ASSERT_EQ(compiled.prePlace(compiled.preBegin(1u) + 1u), 2u);
+    ASSERT_EQ(compiled.preWeight(compiled.preBegin(1u)), 1u);
+    ASSERT_EQ(compiled.isSource(1u), false);
+    ASSERT_EQ(compiled.isSource(2u), true);
+
+    // Post incidence
+    ASSERT_EQ(compiled.postEnd(0u) - compiled.postBegin(0u), 1u);
+    ASSERT_EQ(compiled.postPlace(compiled.postBegin(0u)), 1u);
+    ASSERT_EQ(compiled.postDuration(compiled.postBegin(0u)), 3.0f);
+    ASSERT_EQ(compiled.postArc(compiled.postBegin(0u)), 1u);
+    ASSERT_EQ(compiled.postPlace(compiled.postBegin(2u)), 2u);
+    ASSERT_EQ(compiled.postDuration(compiled.postBegin(2u)), 5.0f);
+    ASSERT_EQ(compiled.postArc(compiled.postBegin(2u)), 5u);
+
+    // Consumers
+    ASSERT_EQ(compiled.consumersEnd(0u) - compiled.consumersBegin(0u), 1u);
+    ASSERT_EQ(compiled.consumer(compiled.consumersBegin(0u)), 0u);
+    ASSERT_EQ(compiled.consumer(compiled.consumersBegin(2u)), 1u);
+
+    // Producers
+    ASSERT_EQ(compiled.producersEnd(0u) - compiled.producersBegin(0u), 1u);
+    ASSERT_EQ(compiled.producer(compiled.producersBegin(0u)), 1u);
+    ASSERT_EQ(compiled.producer(compiled.producersBegin(1u)), 0u);
+    ASSERT_EQ(compiled.producer(compiled.producersBegin(2u)), 2u);
+
+    // Firing
+    CompiledNet::Marking marking = compiled.initialMarking();
+    ASSERT_EQ(compiled.isEnabled(0u, marking), true);
+    ASSERT_EQ(compiled.isEnabled(1u, marking), false);
+    ASSERT_EQ(compiled.isEnabled(2u, marking), true);
+    ASSERT_EQ(compiled.maxTokensToConsume(1u, marking), 0u);
+    ASSERT_EQ(compiled.maxTokensToConsume(2u, marking), 1u);
+    compiled.fire(0u, 1u, marking);
+    ASSERT_EQ(marking, std::vector<size_t>({ 1u, 1u, 1u }));
+    ASSERT_EQ(compiled.isEnabled(1u, marking), true);
+    compiled.fire(1u, 1u, marking);
+    ASSERT_EQ(marking, std::vector<size_t>({ 2u, 0u, 0u }));
+
+    // The net is not modified.
+    ASSERT_EQ(p0.tokens, 2u);
+    ASSERT_EQ(p2.tokens, 1u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestCompiledNet, TestSameBehaviorThanNet)
+{
+    bool springify;
+    Net net(TypeOfNet::TimedPetriNet);
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/Howard2.json", springify).c_str(), "");
+
+    CompiledNet compiled(net);
+    ASSERT_EQ(compiled.countPlaces(), net.places().size());
+    ASSERT_EQ(compiled.countTransitions(), net.transitions().size());
+
+    // Fire transitions on both representations and compare markings.
+    CompiledNet::Marking marking = compiled.initialMarking();
+    Net::Settings::firing = Net::Settings::Fire::MaxPossible;
+    for (size_t step = 0u; step < 20u; ++step)
+    {
+        for (size_t t = 0u; t < compiled.countTransitions(); ++t)
+        {
+            Transition& trans = net.transitions()[t];
+            trans.receptivity = true;
+            ASSERT_EQ(compiled.isEnabled(t, marking), trans.isEnabled());
+            size_t const count = compiled.maxTokensToConsume(t, marking);
+            ASSERT_EQ(count, trans.maxTokensToConsume());
+            if (count == 0u)
+                continue;
+
+            compiled.fire(t, count, marking);
+            for (auto* a: trans.arcsIn)
+                a->tokensIn() -= count;
+            for (auto* a: trans.arcsOut)
+                a->tokensOut() += count;
+            ASSERT_EQ(marking, net.tokens());
+        }
+    }
+    Net::Settings::firing = Net::Settings::Fire::OneByOne;
+}
@@ -65,6 +65,100 @@ TEST(TestEventGraph, TestHoward2)
     ASSERT_EQ(canonic.m_places[5].tokens, 1u);
 }
 
+//------------------------------------------------------------------------------
+//! \brief Check the canonical form computed without duplicating the net is
+//! the same than the duplicated net in canonical form.
+//------------------------------------------------------------------------------
+static void checkCanonicalForm(Net const& net)
+{
+    Net canonic(TypeOfNet::TimedPetriNet);
+    CanonicalForm form;
+
+    toCanonicalForm(net, canonic);
+    toCanonicalForm(net, form);
+
+    ASSERT_EQ(form.net_transitions, net.transitions().size());
+    ASSERT_EQ(form.roles.size(), canonic.transitions().size());
+    size_t inputs = 0u, states = 0u, outputs = 0u;
+    for (auto const& t: canonic.transitions())
+    {
+        if (t.isInput())
+        {
+            ASSERT_EQ(form.roles[t.id], CanonicalForm::Role::Input);
+            ASSERT_EQ(form.indices[t.id], inputs++);
+        }
+        else if (t.isState())
+        {
+            ASSERT_EQ(form.roles[t.id], CanonicalForm::Role::State);
+            ASSERT_EQ(form.indices[t.id], states++);
+        }
+        else if (t.isOutput())
+        {
+            ASSERT_EQ(form.roles[t.id], CanonicalForm::Role::Output);
+            ASSERT_EQ(form.indices[t.id], outputs++);
+        }
+    }
+    ASSERT_EQ(form.nb_inputs, inputs);
+    ASSERT_EQ(form.nb_states, states);
+    ASSERT_EQ(form.nb_outputs, outputs);
+
+    ASSERT_EQ(form.places.size(), canonic.places().size());
+    for (size_t i = 0u; i < form.places.size(); ++i)
+    {
+        Place const& p = canonic.places()[i];
+        ASSERT_EQ(form.places[i].id, p.id);
+        ASSERT_EQ(form.places[i].from, p.arcsIn[0]->from.id);
+        ASSERT_EQ(form.places[i].to, p.arcsOut[0]->to.id);
+        ASSERT_EQ(form.places[i].duration, p.arcsIn[0]->duration);
+        ASSERT_EQ(form.places[i].tokens, p.tokens);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestEventGraph, TestVirtualCanonicalForm)
+{
+    bool stringify;
+
+    for (auto const& file: { "Howard2.json", "JPQ.json", "EventGraph.json",
+                             "SemiNetherlands.teg" })
+    {
+        Net net(TypeOfNet::TimedPetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        net.generateArcsInArcsOut();
+        ASSERT_EQ(isEventGraph(net), true);
+        checkCanonicalForm(net);
+    }
+
+    // Inputs and outputs linked to places holding several tokens.
+    Net net(TypeOfNet::TimedEventGraph);
+    Transition& u = net.addTransition(0.0f, 0.0f);
+    Transition& x0 = net.addTransition(1.0f, 0.0f);
+    Transition& x1 = net.addTransition(2.0f, 0.0f);
+    Transition& y = net.addTransition(3.0f, 0.0f);
+    ASSERT_EQ(net.addArc(u, x0, 3u, 1.0f), true);
+    ASSERT_EQ(net.addArc(u, x1, 1u, 2.0f), true);
+    ASSERT_EQ(net.addArc(x0, x1, 0u, 3.0f), true);
+    ASSERT_EQ(net.addArc(x1, x0, 2u, 4.0f), true);
+    ASSERT_EQ(net.addArc(x1, y, 2u, 5.0f), true);
+    ASSERT_EQ(net.addArc(x0, y, 1u, 6.0f), true);
+    checkCanonicalForm(net);
+
+    CanonicalForm form;
+    toCanonicalForm(net, form);
+    ASSERT_EQ(form.nb_inputs, 1u);
+    ASSERT_EQ(form.nb_outputs, 1u);
+    for (auto const& p: form.places)
+    {
+        ASSERT_LE(p.tokens, 1u);
+        if (p.tokens == 1u)
+        {
+            ASSERT_EQ(form.roles[p.from], CanonicalForm::Role::State);
+            ASSERT_EQ(form.roles[p.to], CanonicalForm::Role::State);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 // https://www.rocq.inria.fr/metalau/cohen/SED/book-online.html
 // Chapter 5.2 A Comparison Between Counter and Dater Descriptions
@@ -174,6 +268,38 @@ TEST(TestEventGraph, TestToAdjacencyMatrices)
     ASSERT_EQ(durations.get(2u, 3u).val, 1.0);
 }
 
+//------------------------------------------------------------------------------
+TEST(TestEventGraph, TestToAdjacencyMatricesParallelPlaces)
+{
+    // Parallel places T0 -> T1 (duration 5, no token) and (duration 100,
+    // 1 token) closed by T1 -> T0 (duration 0, 1 token). Keeping any single
+    // pair for T0 -> T1 gives a wrong cycle time: (5, 0) gives 5 while the
+    // circuit through the second place gives 100 / 2 = 50.
+    Net net(TypeOfNet::TimedPetriNet);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(1.0f, 0.0f);
+    ASSERT_EQ(net.addArc(t0, t1, 0u, 5.0f), true);
+    ASSERT_EQ(net.addArc(t0, t1, 1u, 100.0f), true);
+    ASSERT_EQ(net.addArc(t1, t0, 1u, 0.0f), true);
+    ASSERT_EQ(isEventGraph(net), true);
+
+    // Parallel places are reported instead of being folded.
+    SparseMatrix<MaxPlus> tokens;
+    SparseMatrix<MaxPlus> durations;
+    ASSERT_EQ(toAdjacencyMatrices(net, tokens, durations), false);
+
+    CanonicalForm canonic;
+    toCanonicalForm(net, canonic);
+    ASSERT_EQ(toAdjacencyMatrices(canonic, tokens, durations), false);
+
+    // Algorithms working on places directly are not concerned.
+    CriticalCycleResult res = findCriticalCycle(net);
+    ASSERT_EQ(res.success, true);
+    ASSERT_EQ(res.durations.size(), 2u);
+    ASSERT_EQ(res.durations[0], 50.0);
+    ASSERT_EQ(res.durations[1], 50.0);
+}
+
 //------------------------------------------------------------------------------
 // https://www.rocq.inria.fr/metalau/cohen/SED/book-online.html
 // Chapter 1.1. Preliminary Remarks and Some Notation
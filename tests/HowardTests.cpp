@@ -27,6 +27,9 @@
 #undef protected
 #undef private
 
+#include <random>
+#include <thread>
+
 using namespace ::tpne;
 
 //------------------------------------------------------------------------------
@@ -357,4 +360,285 @@ TEST(TestHoward, TestSemiNetherlandsExample)
              << "  82\n"
              << "  71\n";
     ASSERT_STREQ(res.message.str().c_str(), expected.str().c_str());
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------
+TEST(TestHoward, TestCircuits)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    bool stringify;
+
+    // Single cycle T0 -> T2 -> T1 -> T0. T3 is not on the cycle.
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/Howard2.json", stringify).c_str(), "");
+    CriticalCycleResult res = findCriticalCycle(net);
+    ASSERT_EQ(res.success, true);
+    ASSERT_EQ(res.circuits.size(), 1u);
+    ASSERT_EQ(res.circuits[0].size(), 6u);
+    ASSERT_STREQ(res.circuits[0][0]->from.key.c_str(), "T0");
+    ASSERT_STREQ(res.circuits[0][1]->to.key.c_str(), "T2");
+    ASSERT_STREQ(res.circuits[0][2]->from.key.c_str(), "T2");
+    ASSERT_STREQ(res.circuits[0][3]->to.key.c_str(), "T1");
+    ASSERT_STREQ(res.circuits[0][4]->from.key.c_str(), "T1");
+    ASSERT_STREQ(res.circuits[0][5]->to.key.c_str(), "T0");
+
+    // Two independent cycles: T0 -> T1 -> T0 and T2 -> T2.
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/SemiHoward.teg", stringify).c_str(), "");
+    res = findCriticalCycle(net);
+    ASSERT_EQ(res.success, true);
+    ASSERT_EQ(res.circuits.size(), 2u);
+    ASSERT_EQ(res.circuits[0].size(), 4u);
+    ASSERT_STREQ(res.circuits[0][0]->from.key.c_str(), "T0");
+    ASSERT_STREQ(res.circuits[0][0]->to.key.c_str(), "P0");
+    ASSERT_STREQ(res.circuits[0][1]->to.key.c_str(), "T1");
+    ASSERT_STREQ(res.circuits[0][2]->from.key.c_str(), "T1");
+    ASSERT_STREQ(res.circuits[0][2]->to.key.c_str(), "P1");
+    ASSERT_STREQ(res.circuits[0][3]->to.key.c_str(), "T0");
+    ASSERT_EQ(res.circuits[1].size(), 2u);
+    ASSERT_STREQ(res.circuits[1][0]->from.key.c_str(), "T2");
+    ASSERT_STREQ(res.circuits[1][0]->to.key.c_str(), "P4");
+    ASSERT_STREQ(res.circuits[1][1]->to.key.c_str(), "T2");
+
+    // Karp does not compute policies.
+    res = findCriticalCycle(net, CriticalCycleSolver::Karp);
+    ASSERT_EQ(res.success, true);
+    ASSERT_EQ(res.circuits.size(), 0u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestHoward, TestIndependentComponents)
+{
+    // Many disconnected event graphs: large enough to be solved concurrently.
+    size_t const ncomponents = 200u;
+    size_t const size = 60u;
+    std::mt19937 generator(42u);
+    std::uniform_int_distribution<size_t> node(0u, size - 1u);
+    std::uniform_int_distribution<size_t> tokens(1u, 2u);
+    std::uniform_real_distribution<float> duration(0.0f, 10.0f);
+
+    Net net(TypeOfNet::TimedEventGraph);
+    for (size_t i = 0u; i < ncomponents * size; ++i)
+        net.addTransition(float(i), 0.0f);
+    for (size_t c = 0u; c < ncomponents; ++c)
+    {
+        size_t const first = c * size;
+        for (size_t i = 0u; i < size; ++i)
+        {
+            ASSERT_EQ(net.addArc(net.m_transitions[first + i],
+                                 net.m_transitions[first + (i + 1u) % size],
+                                 1u, duration(generator)), true);
+        }
+        for (size_t i = 0u; i < 2u * size / 3u; ++i)
+        {
+            net.addArc(net.m_transitions[first + node(generator)],
+                       net.m_transitions[first + node(generator)],
+                       tokens(generator), duration(generator));
+        }
+    }
+
+    CriticalCycleResult res = findCriticalCycle(net);
+    ASSERT_EQ(res.success, true);
+    ASSERT_EQ(res.circuits.size(), res.cycles);
+    ASSERT_GE(res.cycles, ncomponents);
+
+    // Same results than Howard on the whole graph.
+    std::vector<int> IJ;
+    std::vector<double> T, N;
+    for (auto const& p: net.places())
+    {
+        IJ.push_back(int(p.arcsIn[0]->from.id));
+        IJ.push_back(int(p.arcsOut[0]->to.id));
+        T.push_back(p.arcsIn[0]->duration);
+        N.push_back(double(p.tokens));
+    }
+    size_t const nnodes = net.transitions().size();
+    std::vector<double> chi(nnodes), v(nnodes);
+    std::vector<int> pi(nnodes);
+    int ncycles, niterations;
+    ASSERT_EQ(Semi_Howard(IJ.data(), T.data(), N.data(), int(nnodes),
+                          int(T.size()), chi.data(), v.data(), pi.data(),
+                          &niterations, &ncycles, 0), 0);
+    ASSERT_EQ(res.cycles, size_t(ncycles));
+    for (size_t i = 0u; i < nnodes; ++i)
+    {
+        ASSERT_NEAR(res.durations[i], chi[i], 1e-9);
+        ASSERT_NEAR(res.eigenvector[i], v[i], 1e-6);
+    }
+
+    // Each circuit is a cycle of the optimal policy.
+    for (auto const& circuit: res.circuits)
+    {
+        ASSERT_EQ(circuit.size() % 2u, 0u);
+        ASSERT_EQ(&circuit.front()->from, &circuit.back()->to);
+        for (size_t a = 0u; a < circuit.size(); a += 2u)
+        {
+            ASSERT_EQ(&circuit[a]->to, &circuit[a + 1u]->from);
+            ASSERT_EQ(pi[circuit[a]->from.id], int(circuit[a + 1u]->to.id));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestHoward, TestSemiWorkspaceReuse)
+{
+    // Netherlands example (8 nodes) then simple example (3 nodes) then
+    // Netherlands again with the same workspace.
+    std::vector<double> timings1 = {
+        61.0, 81.0, 58.0, 0.0, 86.0, 69.0, 69.0, 36.0, 35.0, 0.0, 58.0, 61.0
+    };
+    std::vector<double> delays1 = {
+        2.0, 1.0, 1.0, 0.0, 2.0, 2.0, 1.0, 1.0, 1.0, 0.0, 1.0, 1.0
+    };
+    std::vector<int> arcs1 = {
+        0, 1,   1, 3,   2, 0,
+        2, 5,   3, 2,   3, 4,
+        4, 3,   4, 6,   5, 4,
+        6, 1,   6, 7,   7, 5,
+    };
+    std::vector<double> timings2 = { 0.0, 1.0, 0.0, 1.0, 2.0 };
+    std::vector<double> delays2 = { 1.0, 0.0, 0.0, 0.0, 1.0 };
+    std::vector<int> arcs2 = { 0, 1,   1, 0,   2, 0,   2, 1,   2, 2 };
+
+    HowardWorkspace* workspace = Howard_New_Workspace();
+    ASSERT_NE(workspace, nullptr);
+
+    for (size_t i = 0u; i < 3u; ++i)
+    {
+        bool const first = (i != 1u);
+        std::vector<double>& timings = first ? timings1 : timings2;
+        std::vector<double>& delays = first ? delays1 : delays2;
+        std::vector<int>& arcs = first ? arcs1 : arcs2;
+        int const nnodes = first ? 8 : 3;
+        int const narcs = int(timings.size());
+
+        std::vector<double> v1(nnodes), v2(nnodes);
+        std::vector<double> chi1(nnodes), chi2(nnodes);
+        std::vector<int> pi1(nnodes), pi2(nnodes);
+        int ncomponents1, ncomponents2;
+        int niterations1, niterations2;
+
+        ASSERT_EQ(Semi_Howard(arcs.data(), timings.data(), delays.data(),
+                              nnodes, narcs, chi1.data(), v1.data(), pi1.data(),
+                              &niterations1, &ncomponents1, 0), 0);
+        ASSERT_EQ(Semi_Howard_With_Workspace(workspace, arcs.data(),
+                              timings.data(), delays.data(), nnodes, narcs,
+                              chi2.data(), v2.data(), pi2.data(),
+                              &niterations2, &ncomponents2, 0), 0);
+        ASSERT_EQ(chi1, chi2);
+        ASSERT_EQ(v1, v2);
+        ASSERT_EQ(pi1, pi2);
+        ASSERT_EQ(niterations1, niterations2);
+        ASSERT_EQ(ncomponents1, ncomponents2);
+    }
+
+    // Errors do not corrupt the workspace.
+    std::vector<double> v(8), chi(8);
+    std::vector<int> pi(8);
+    int ncomponents, niterations;
+    ASSERT_EQ(Semi_Howard_With_Workspace(workspace, arcs1.data(),
+                          timings1.data(), delays1.data(), 9, 12,
+                          chi.data(), v.data(), pi.data(),
+                          &niterations, &ncomponents, 0), 1);
+    ASSERT_EQ(Semi_Howard_With_Workspace(workspace, arcs1.data(),
+                          timings1.data(), delays1.data(), 8, 12,
+                          chi.data(), v.data(), pi.data(),
+                          &niterations, &ncomponents, 0), 0);
+    ASSERT_NEAR(chi[0], 47.6667, 0.001);
+
+    Howard_Free_Workspace(workspace);
+    Howard_Free_Workspace(nullptr);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestHoward, TestConcurrentCriticalCycle)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    bool stringify;
+
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/SemiNetherlands.teg", stringify).c_str(), "");
+    CriticalCycleResult expected = findCriticalCycle(net);
+    ASSERT_EQ(expected.success, true);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(8u, 0);
+    for (size_t i = 0u; i < failures.size(); ++i)
+    {
+        threads.emplace_back([&net, &expected, &failures, i]()
+        {
+            for (size_t j = 0u; j < 100u; ++j)
+            {
+                CriticalCycleResult res = findCriticalCycle(net);
+                if ((!res.success) || (res.eigenvector != expected.eigenvector) ||
+                    (res.durations != expected.durations) ||
+                    (res.arcs != expected.arcs))
+                {
+                    failures[i] += 1;
+                }
+            }
+        });
+    }
+    for (auto& thread: threads)
+        thread.join();
+
+    ASSERT_EQ(failures, std::vector<int>(8u, 0));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestHoward, TestSweepCriticalCycle)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    bool stringify;
+
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/SemiNetherlands.teg", stringify).c_str(), "");
+    size_t const P = net.places().size();
+
+    // Scenarios: the net itself, then durations and tokens varying.
+    std::vector<CriticalCycleScenario> scenarios(1u);
+    for (size_t i = 1u; i < 64u; ++i)
+    {
+        CriticalCycleScenario scenario;
+        for (size_t p = 0u; p < P; ++p)
+        {
+            scenario.durations.push_back(double((i * 7u + p * 13u) % 50u));
+            scenario.tokens.push_back(double(1u + (i + p) % 3u));
+        }
+        scenarios.push_back(scenario);
+    }
+
+    // A cycle without tokens has no optimal policy.
+    scenarios.push_back(CriticalCycleScenario{ {}, std::vector<double>(P, 0.0) });
+
+    CriticalCycleSweep sweep = sweepCriticalCycle(net, scenarios, 4u);
+    ASSERT_EQ(sweep.success, true);
+    ASSERT_EQ(sweep.eigenvalues.size(), scenarios.size());
+    ASSERT_NEAR(sweep.eigenvalues[0], 47.6667, 0.001);
+    ASSERT_EQ(std::isnan(sweep.eigenvalues.back()), true);
+
+    // Same results than findCriticalCycle on modified nets.
+    for (size_t s = 1u; s + 1u < scenarios.size(); ++s)
+    {
+        Net copy(net);
+        for (size_t p = 0u; p < P; ++p)
+        {
+            copy.places()[p].arcsIn[0]->duration = float(scenarios[s].durations[p]);
+            copy.places()[p].tokens = size_t(scenarios[s].tokens[p]);
+        }
+        CriticalCycleResult res = findCriticalCycle(copy);
+        ASSERT_EQ(res.success, true);
+        ASSERT_NEAR(sweep.eigenvalues[s],
+                    *std::max_element(res.durations.begin(), res.durations.end()),
+                    1e-9);
+    }
+
+    // Scenarios shall match the number of places.
+    scenarios.push_back(CriticalCycleScenario{ { 1.0 }, {} });
+    sweep = sweepCriticalCycle(net, scenarios);
+    ASSERT_EQ(sweep.success, false);
+    ASSERT_STREQ(sweep.message.c_str(),
+                 "Scenario 65 shall have one duration and one token count per place");
+
+    // Not an event graph.
+    Net empty(TypeOfNet::TimedPetriNet);
+    sweep = sweepCriticalCycle(empty, scenarios);
+    ASSERT_EQ(sweep.success, false);
+    ASSERT_EQ(sweep.eigenvalues.size(), 0u);
+}
@@ -0,0 +1,323 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "Nets.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Invariants.hpp"
+#include "PetriNet/Reachability.hpp"
+
+#include <random>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Check the semiflows of the matrix: y.C = 0, positive weights without
+//! common divisor, and no support included in another one.
+//------------------------------------------------------------------------------
+static void checkSemiflows(SparseMatrix<int64_t> const& C,
+                           std::vector<Semiflow> const& semiflows)
+{
+    for (auto const& s: semiflows)
+    {
+        ASSERT_EQ(s.indices.size(), s.weights.size());
+        ASSERT_EQ(s.indices.empty(), false);
+        ASSERT_EQ(std::is_sorted(s.indices.begin(), s.indices.end()), true);
+
+        int64_t g = 0;
+        std::vector<int64_t> product(C.nbColumns(), 0);
+        for (size_t i = 0u; i < s.indices.size(); ++i)
+        {
+            ASSERT_GT(s.weights[i], 0);
+            g = std::gcd(g, s.weights[i]);
+            for (size_t k = C.rowBegin(s.indices[i]); k < C.rowEnd(s.indices[i]); ++k)
+                product[C.column(k)] += s.weights[i] * C.value(k);
+        }
+        ASSERT_EQ(g, 1);
+        for (auto const v: product)
+            ASSERT_EQ(v, 0);
+    }
+
+    for (auto const& s: semiflows)
+    {
+        for (auto const& o: semiflows)
+        {
+            if (&s == &o)
+                continue;
+            ASSERT_EQ(std::includes(s.indices.begin(), s.indices.end(),
+                                    o.indices.begin(), o.indices.end()), false);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Check that the weighted sums of tokens of the P-semiflows are the
+//! same for all reachable markings and that the structural bounds are upper
+//! bounds of the places.
+//------------------------------------------------------------------------------
+static void checkConservation(CompiledNet const& net, ReachabilityGraph const& graph,
+                              std::vector<Semiflow> const& semiflows)
+{
+    auto weighted = [](Semiflow const& s, CompiledNet::Marking const& m)
+    {
+        int64_t sum = 0;
+        for (size_t i = 0u; i < s.indices.size(); ++i)
+            sum += s.weights[i] * int64_t(m[s.indices[i]]);
+        return sum;
+    };
+
+    CompiledNet::Marking marking;
+    for (size_t state = 0u; state < graph.countStates(); ++state)
+    {
+        graph.marking(state, marking);
+        for (auto const& s: semiflows)
+            ASSERT_EQ(weighted(s, marking), weighted(s, net.initialMarking()));
+    }
+
+    std::vector<size_t> const bounds = structuralBounds(net, semiflows);
+    for (size_t p = 0u; p < net.countPlaces(); ++p)
+        ASSERT_LE(graph.bounds()[p], bounds[p]);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestInvariants, TestIncidenceMatrix)
+{
+    Net net(TypeOfNet::PetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(1.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 1.0f);
+    Transition& t1 = net.addTransition(1.0f, 1.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1);
+    net.addArc(p1, t1);
+    net.addArc(t1, p1); // Self-loop: null in the incidence matrix
+
+    SparseMatrix<int64_t> const C = incidenceMatrix(CompiledNet(net));
+    ASSERT_EQ(C.nbRows(), 2u);
+    ASSERT_EQ(C.nbColumns(), 2u);
+    ASSERT_EQ(C.nbNonZeros(), 2u);
+    ASSERT_EQ(C.get(0u, 0u), -1);
+    ASSERT_EQ(C.get(1u, 0u), 1);
+    ASSERT_EQ(C.get(0u, 1u), 0);
+    ASSERT_EQ(C.get(1u, 1u), 0);
+
+    // The token moves from P0 to P1. The self-loop is a T-semiflow.
+    CompiledNet compiled(net);
+    SemiflowsResult const psemiflows = findPSemiflows(compiled);
+    ASSERT_EQ(psemiflows.success, true);
+    ASSERT_EQ(psemiflows.semiflows.size(), 1u);
+    ASSERT_EQ(psemiflows.semiflows[0].indices, std::vector<size_t>({ 0u, 1u }));
+    ASSERT_EQ(psemiflows.semiflows[0].weights, std::vector<int64_t>({ 1, 1 }));
+    SemiflowsResult const tsemiflows = findTSemiflows(compiled);
+    ASSERT_EQ(tsemiflows.success, true);
+    ASSERT_EQ(tsemiflows.semiflows.size(), 1u);
+    ASSERT_EQ(tsemiflows.semiflows[0].indices, std::vector<size_t>({ 1u }));
+    ASSERT_EQ(structuralBounds(compiled, psemiflows.semiflows),
+              std::vector<size_t>({ 1u, 1u }));
+
+    // A source transition breaks the conservation.
+    Transition& t2 = net.addTransition(2.0f, 1.0f);
+    net.addArc(t2, p1);
+    compiled.compile(net);
+    ASSERT_EQ(findPSemiflows(compiled).semiflows.size(), 0u);
+    ASSERT_EQ(structuralBounds(compiled, {}),
+              std::vector<size_t>({ size_t(-1), size_t(-1) }));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestInvariants, TestCircuits)
+{
+    Net net(TypeOfNet::PetriNet);
+    createCircuits(net, 3u, 4u);
+    CompiledNet compiled(net);
+
+    // Each circuit conserves its token and can fire back to its marking.
+    SemiflowsResult const psemiflows = findPSemiflows(compiled);
+    ASSERT_EQ(psemiflows.success, true);
+    ASSERT_EQ(psemiflows.semiflows.size(), 3u);
+    for (size_t c = 0u; c < 3u; ++c)
+    {
+        Semiflow const& s = psemiflows.semiflows[c];
+        ASSERT_EQ(s.indices, std::vector<size_t>({ 4u * c, 4u * c + 1u, 4u * c + 2u, 4u * c + 3u }));
+        ASSERT_EQ(s.weights, std::vector<int64_t>({ 1, 1, 1, 1 }));
+    }
+    ASSERT_EQ(structuralBounds(compiled, psemiflows.semiflows),
+              std::vector<size_t>(12u, 1u));
+
+    SemiflowsResult const tsemiflows = findTSemiflows(compiled);
+    ASSERT_EQ(tsemiflows.success, true);
+    ASSERT_EQ(tsemiflows.semiflows.size(), 3u);
+    checkSemiflows(incidenceMatrix(compiled), psemiflows.semiflows);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestInvariants, TestPhilosophers)
+{
+    for (size_t const n: { 2u, 5u, 8u })
+    {
+        Net net(TypeOfNet::PetriNet);
+        createPhilosophers(net, n);
+        CompiledNet compiled(net);
+        SparseMatrix<int64_t> const C = incidenceMatrix(compiled);
+
+        // A philosopher thinks, holds its left fork or eats. A fork is free,
+        // held as left fork or used by one of the two eating neighbors.
+        SemiflowsResult const psemiflows = findPSemiflows(compiled);
+        ASSERT_EQ(psemiflows.success, true);
+        ASSERT_EQ(psemiflows.semiflows.size(), 2u * n);
+        checkSemiflows(C, psemiflows.semiflows);
+        ASSERT_EQ(structuralBounds(compiled, psemiflows.semiflows),
+                  std::vector<size_t>(4u * n, 1u));
+
+        // Each philosopher can take both forks and release them.
+        SemiflowsResult const tsemiflows = findTSemiflows(compiled);
+        ASSERT_EQ(tsemiflows.success, true);
+        ASSERT_EQ(tsemiflows.semiflows.size(), n);
+        for (size_t i = 0u; i < n; ++i)
+        {
+            ASSERT_EQ(tsemiflows.semiflows[i].indices,
+                      std::vector<size_t>({ 3u * i, 3u * i + 1u, 3u * i + 2u }));
+        }
+
+        ReachabilityGraph graph(compiled);
+        ASSERT_EQ(graph.explore(ReachabilityGraph::Options()), true);
+        checkConservation(compiled, graph, psemiflows.semiflows);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestInvariants, TestRandomMatrices)
+{
+    // Compare with the brute force enumeration of the solutions with small
+    // weights: each solution contains the support of a minimal semiflow.
+    std::mt19937 generator(42u);
+    std::uniform_int_distribution<int> value(-2, 2);
+    for (size_t iteration = 0u; iteration < 50u; ++iteration)
+    {
+        size_t const n = 6u, m = 1u + iteration % 4u;
+        SparseMatrixBuilder<int64_t> builder(n, m);
+        for (size_t i = 0u; i < n; ++i)
+        {
+            for (size_t j = 0u; j < m; ++j)
+                builder.add(i, j, (value(generator) % 2 == 0) ? 0 : value(generator));
+        }
+        SparseMatrix<int64_t> const C = builder.build();
+        SemiflowsResult const result = findSemiflows(C);
+        ASSERT_EQ(result.success, true);
+        checkSemiflows(C, result.semiflows);
+
+        std::vector<int64_t> y(n, 0);
+        size_t found = 0u;
+        while (true)
+        {
+            size_t i = 0u;
+            for (; (i < n) && (y[i] == 3); ++i)
+                y[i] = 0;
+            if (i == n)
+                break;
+            ++y[i];
+
+            std::vector<int64_t> product(m, 0);
+            for (size_t r = 0u; r < n; ++r)
+            {
+                for (size_t k = C.rowBegin(r); k < C.rowEnd(r); ++k)
+                    product[C.column(k)] += y[r] * C.value(k);
+            }
+            if (std::any_of(product.begin(), product.end(), [](int64_t v) { return v != 0; }))
+                continue;
+
+            ++found;
+            bool covered = false;
+            for (auto const& s: result.semiflows)
+            {
+                covered |= std::all_of(s.indices.begin(), s.indices.end(),
+                                       [&](size_t k) { return y[k] != 0; });
+            }
+            ASSERT_EQ(covered, true);
+        }
+        ASSERT_EQ(found == 0u, result.semiflows.empty());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestInvariants, TestMaxRows)
+{
+    // Each pair (p_i, q_j) of places of the complete bipartite net is a
+    // minimal semiflow.
+    Net net(TypeOfNet::PetriNet);
+    Transition& t = net.addTransition(0.0f, 0.0f);
+    for (size_t i = 0u; i < 10u; ++i)
+    {
+        net.addArc(net.addPlace(float(i), 0.0f, 1u), t);
+        net.addArc(t, net.addPlace(float(i), 1.0f, 0u));
+    }
+    CompiledNet compiled(net);
+
+    SemiflowsResult result = findPSemiflows(compiled);
+    ASSERT_EQ(result.success, true);
+    ASSERT_EQ(result.semiflows.size(), 100u);
+    checkSemiflows(incidenceMatrix(compiled), result.semiflows);
+
+    result = findPSemiflows(compiled, 50u);
+    ASSERT_EQ(result.success, false);
+    ASSERT_STRNE(result.message.c_str(), "");
+    ASSERT_EQ(result.semiflows.empty(), true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestInvariants, TestExamples)
+{
+    for (auto const& file: { "Philosophers.json", "EmergencyCalls.json",
+                             "SmarthomeSafety.json", "LandingGear.json",
+                             "ProducerConsumer.json", "FourRoadJunctions.json",
+                             "TrafficLights.json", "EventGraph.json" })
+    {
+        bool stringify;
+        Net net(TypeOfNet::PetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        CompiledNet compiled(net);
+        SparseMatrix<int64_t> const C = incidenceMatrix(compiled);
+
+        SemiflowsResult const psemiflows = findPSemiflows(compiled);
+        ASSERT_EQ(psemiflows.success, true);
+        checkSemiflows(C, psemiflows.semiflows);
+
+        SemiflowsResult const tsemiflows = findTSemiflows(compiled);
+        ASSERT_EQ(tsemiflows.success, true);
+        for (auto const& s: tsemiflows.semiflows)
+        {
+            std::vector<int64_t> x(compiled.countTransitions(), 0);
+            for (size_t i = 0u; i < s.indices.size(); ++i)
+                x[s.indices[i]] = s.weights[i];
+            for (auto const v: C.multiply(x))
+                ASSERT_EQ(v, 0);
+        }
+
+        // Places covered by P-semiflows are bounded.
+        std::vector<size_t> const bounds = structuralBounds(compiled, psemiflows.semiflows);
+        if (std::count(bounds.begin(), bounds.end(), size_t(-1)) == 0)
+        {
+            ReachabilityGraph graph(compiled);
+            ASSERT_EQ(graph.explore(ReachabilityGraph::Options()), true);
+            checkConservation(compiled, graph, psemiflows.semiflows);
+        }
+    }
+}
@@ -0,0 +1,203 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Algorithms.hpp"
+#include "PetriNet/Howard.h"
+#include "PetriNet/Karp.hpp"
+#include "PetriNet/StronglyConnectedComponents.hpp"
+
+#include <random>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+TEST(TestKarp, TestStronglyConnectedComponents)
+{
+    // {0, 1, 2} -> {3, 4} -> {5}, {6} isolated.
+    std::vector<int> arcs = {
+        0, 1,   1, 2,   2, 0,   2, 3,
+        3, 4,   4, 3,   4, 5,   1, 5,
+    };
+    StronglyConnectedComponents scc = findStronglyConnectedComponents(7u, arcs);
+    ASSERT_EQ(scc.count, 4u);
+    ASSERT_EQ(scc.component[0], scc.component[1]);
+    ASSERT_EQ(scc.component[1], scc.component[2]);
+    ASSERT_EQ(scc.component[3], scc.component[4]);
+    ASSERT_NE(scc.component[0], scc.component[3]);
+    ASSERT_NE(scc.component[3], scc.component[5]);
+    ASSERT_NE(scc.component[6], scc.component[0]);
+
+    // Reverse topological order.
+    for (size_t a = 0u; a < arcs.size(); a += 2u)
+        ASSERT_GE(scc.component[size_t(arcs[a])], scc.component[size_t(arcs[a + 1u])]);
+
+    // Long chain: no recursion limit.
+    size_t const n = 1000000u;
+    std::vector<int> chain;
+    for (size_t i = 0u; i < n; ++i)
+    {
+        chain.push_back(int(i));
+        chain.push_back(int((i + 1u) % n));
+    }
+    ASSERT_EQ(findStronglyConnectedComponents(n, chain).count, 1u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestKarp, TestWeaklyConnectedComponents)
+{
+    // {0, 1, 2, 3} linked whatever the direction of arcs, {4, 5}, {6} isolated.
+    std::vector<int> arcs = {
+        1, 0,   2, 3,   3, 1,   5, 4,   5, 5,
+    };
+    WeaklyConnectedComponents wcc = findWeaklyConnectedComponents(7u, arcs);
+    ASSERT_EQ(wcc.count, 3u);
+    ASSERT_EQ(wcc.component.size(), 7u);
+    ASSERT_EQ(wcc.component[0], 0u);
+    ASSERT_EQ(wcc.component[1], 0u);
+    ASSERT_EQ(wcc.component[2], 0u);
+    ASSERT_EQ(wcc.component[3], 0u);
+    ASSERT_EQ(wcc.component[4], 1u);
+    ASSERT_EQ(wcc.component[5], 1u);
+    ASSERT_EQ(wcc.component[6], 2u);
+
+    ASSERT_EQ(findWeaklyConnectedComponents(0u, {}).count, 0u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestKarp, TestSemiSimple)
+{
+    std::vector<double> timings = { 0.0, 1.0, 0.0, 1.0, 2.0 };
+    std::vector<double> delays = { 1.0, 0.0, 0.0, 0.0, 1.0 };
+    std::vector<int> arcs = { 0, 1,   1, 0,   2, 0,   2, 1,   2, 2 };
+
+    std::vector<double> chi;
+    size_t ncomponents;
+    ASSERT_EQ(Karp(arcs, timings, delays, 3u, chi, ncomponents), 0);
+    ASSERT_EQ(ncomponents, 2u);
+    ASSERT_EQ(chi.size(), 3u);
+    ASSERT_DOUBLE_EQ(chi[0], 1.0);
+    ASSERT_DOUBLE_EQ(chi[1], 1.0);
+    ASSERT_DOUBLE_EQ(chi[2], 2.0);
+
+    // Several tokens on an arc.
+    delays = { 3.0, 0.0, 0.0, 0.0, 1.0 };
+    timings = { 0.0, 6.0, 0.0, 1.0, 2.0 };
+    ASSERT_EQ(Karp(arcs, timings, delays, 3u, chi, ncomponents), 0);
+    ASSERT_DOUBLE_EQ(chi[0], 2.0);
+    ASSERT_DOUBLE_EQ(chi[2], 2.0);
+    ASSERT_EQ(ncomponents, 2u);
+
+    // Degenerate inputs.
+    delays = { 0.0, 0.0, 0.0, 0.0, 1.0 };
+    ASSERT_EQ(Karp(arcs, timings, delays, 3u, chi, ncomponents), 1);
+    delays = { 1.5, 0.0, 0.0, 0.0, 1.0 };
+    ASSERT_EQ(Karp(arcs, timings, delays, 3u, chi, ncomponents), 3);
+    std::vector<int> path = { 0, 1 };
+    ASSERT_EQ(Karp(path, { 1.0 }, { 1.0 }, 2u, chi, ncomponents), 2);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestKarp, TestExamples)
+{
+    char const* files[] = {
+        "../data/examples/Howard2.json",
+        "../data/examples/SemiHoward.teg",
+        "../data/examples/SemiNetherlands.teg",
+    };
+
+    for (auto const& file: files)
+    {
+        Net net(TypeOfNet::TimedPetriNet);
+        bool stringify;
+        ASSERT_STREQ(loadFromFile(net, file, stringify).c_str(), "");
+
+        CriticalCycleResult howard = findCriticalCycle(net);
+        CriticalCycleResult karp = findCriticalCycle(net, CriticalCycleSolver::Karp);
+        ASSERT_EQ(howard.success, true);
+        ASSERT_EQ(karp.success, true);
+        ASSERT_EQ(karp.solver, CriticalCycleSolver::Karp);
+        ASSERT_EQ(karp.cycles, howard.cycles);
+        ASSERT_EQ(karp.eigenvector.size(), 0u);
+        ASSERT_EQ(karp.arcs.size(), 0u);
+        ASSERT_EQ(karp.durations.size(), howard.durations.size());
+        for (size_t i = 0u; i < karp.durations.size(); ++i)
+            ASSERT_NEAR(karp.durations[i], howard.durations[i], 1e-9);
+    }
+
+    // Not an event graph.
+    Net net(TypeOfNet::TimedPetriNet);
+    bool stringify;
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/EmergencyCalls.json", stringify).c_str(), "");
+    CriticalCycleResult karp = findCriticalCycle(net, CriticalCycleSolver::Karp);
+    ASSERT_EQ(karp.success, false);
+    ASSERT_STREQ(karp.message.str().c_str(), "The Petri net is not an event graph. Because:\n  P0 has more than one output arc: T0 T4 T8\n");
+
+    std::stringstream expected;
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/SemiHoward.teg", stringify).c_str(), "");
+    karp = findCriticalCycle(net, CriticalCycleSolver::Karp);
+    expected << "Found 2 strongly connected components holding a critical cycle:\n"
+             << "Cycle durations [unit of time]:\n"
+             << "  T0: 1\n"
+             << "  T1: 1\n"
+             << "  T2: 2\n";
+    ASSERT_STREQ(karp.message.str().c_str(), expected.str().c_str());
+}
+
+//------------------------------------------------------------------------------
+TEST(TestKarp, TestRandomGraphs)
+{
+    std::mt19937 generator(42u);
+    std::uniform_int_distribution<int> timing(0, 20);
+    std::uniform_int_distribution<int> tokens(0, 3);
+
+    for (size_t test = 0u; test < 50u; ++test)
+    {
+        // Circuit with tokens on each node (Howard and Karp need each node to
+        // reach a cycle) plus random chords.
+        int const nnodes = 2 + int(test % 30u);
+        std::uniform_int_distribution<int> node(0, nnodes - 1);
+        std::vector<int> arcs;
+        std::vector<double> T, N;
+        for (int i = 0; i < nnodes; ++i)
+        {
+            arcs.push_back(i); arcs.push_back((i + 1) % nnodes);
+            T.push_back(timing(generator)); N.push_back(1.0 + tokens(generator));
+        }
+        for (int i = 0; i < 2 * nnodes; ++i)
+        {
+            arcs.push_back(node(generator)); arcs.push_back(node(generator));
+            T.push_back(timing(generator)); N.push_back(1.0 + tokens(generator));
+        }
+
+        size_t const n = size_t(nnodes);
+        std::vector<double> v(n), chi(n), karp;
+        std::vector<int> pi(n);
+        int ncomponents, niterations;
+        size_t kcomponents;
+        ASSERT_EQ(Semi_Howard(arcs.data(), T.data(), N.data(), nnodes, int(T.size()),
+                              chi.data(), v.data(), pi.data(),
+                              &niterations, &ncomponents, 0), 0);
+        ASSERT_EQ(Karp(arcs, T, N, n, karp, kcomponents), 0);
+        for (size_t i = 0u; i < n; ++i)
+            ASSERT_NEAR(karp[i], chi[i], 1e-9);
+    }
+}
@@ -0,0 +1,153 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/MonteCarlo.hpp"
+
+#include <stdexcept>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+TEST(TestMonteCarlo, TestDeterministicNet)
+{
+    // P0 (1 token) -> T0 -> 2s -> P1 -> T1 -> 3s -> P0: no conflict, all
+    // replications are identical.
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1, 2.0f);
+    net.addArc(p1, t1);
+    net.addArc(t1, p0, 3.0f);
+
+    CompiledNet compiled(net);
+    MonteCarlo montecarlo(compiled);
+    MonteCarlo::Options options;
+    options.replications = 100u;
+    options.duration = 100.0;
+    options.threads = 4u;
+    MonteCarlo::Result result = montecarlo.run(options);
+
+    ASSERT_EQ(result.replications, 100u);
+    ASSERT_EQ(result.duration, 100.0);
+    ASSERT_EQ(result.deadlocks, 0u);
+    ASSERT_EQ(result.throughputs.size(), 2u);
+    ASSERT_DOUBLE_EQ(result.throughputs[0].mean, 0.21);
+    ASSERT_DOUBLE_EQ(result.throughputs[0].min, 0.21);
+    ASSERT_DOUBLE_EQ(result.throughputs[0].max, 0.21);
+    ASSERT_DOUBLE_EQ(result.throughputs[0].stddev, 0.0);
+    ASSERT_DOUBLE_EQ(result.throughputs[1].mean, 0.20);
+    ASSERT_EQ(result.markings.size(), 2u);
+    ASSERT_DOUBLE_EQ(result.markings[0].mean, 0.0);
+    ASSERT_DOUBLE_EQ(result.markings[1].mean, 0.0);
+    ASSERT_DOUBLE_EQ(result.firings.mean, 41.0);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestMonteCarlo, TestConflict)
+{
+    // P0 (1 token) -> T0 or T1 -> 1s -> P0: a single transition fires at each
+    // date, chosen randomly.
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p0, 1.0f);
+    net.addArc(p0, t1);
+    net.addArc(t1, p0, 1.0f);
+
+    CompiledNet compiled(net);
+    MonteCarlo montecarlo(compiled);
+    MonteCarlo::Options options;
+    options.replications = 200u;
+    options.duration = 99.0;
+    options.seed = 42u;
+    options.threads = 1u;
+    MonteCarlo::Result single = montecarlo.run(options);
+    options.threads = 8u;
+    MonteCarlo::Result multi = montecarlo.run(options);
+
+    // 100 firings per replication shared between T0 and T1.
+    ASSERT_EQ(single.replications, 200u);
+    ASSERT_DOUBLE_EQ(single.firings.mean, 100.0);
+    ASSERT_DOUBLE_EQ(single.firings.stddev, 0.0);
+    ASSERT_DOUBLE_EQ(single.throughputs[0].mean + single.throughputs[1].mean, 100.0 / 99.0);
+    ASSERT_GT(single.throughputs[0].stddev, 0.0);
+    ASSERT_LT(single.throughputs[0].min, single.throughputs[0].max);
+    ASSERT_NEAR(single.throughputs[0].mean, 50.0 / 99.0, 0.05);
+
+    // Results do not depend on the number of threads.
+    for (size_t t = 0u; t < 2u; ++t)
+    {
+        ASSERT_EQ(single.throughputs[t].mean, multi.throughputs[t].mean);
+        ASSERT_EQ(single.throughputs[t].stddev, multi.throughputs[t].stddev);
+        ASSERT_EQ(single.throughputs[t].min, multi.throughputs[t].min);
+        ASSERT_EQ(single.throughputs[t].max, multi.throughputs[t].max);
+    }
+
+    // Other seeds give other results.
+    options.seed = 43u;
+    MonteCarlo::Result other = montecarlo.run(options);
+    ASSERT_NE(single.throughputs[0].mean, other.throughputs[0].mean);
+    ASSERT_NE(MonteCarlo::seedOf(42u, 0u), MonteCarlo::seedOf(42u, 1u));
+    ASSERT_NE(MonteCarlo::seedOf(42u, 0u), MonteCarlo::seedOf(43u, 0u));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestMonteCarlo, TestInitializer)
+{
+    // P0 -> T0 -> 1s -> P0: dead when P0 has no token.
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p0, 1.0f);
+
+    CompiledNet compiled(net);
+    MonteCarlo montecarlo(compiled);
+    MonteCarlo::Options options;
+    options.replications = 10u;
+    options.duration = 9.5;
+    options.threads = 3u;
+    MonteCarlo::Result result = montecarlo.run(options,
+        [](size_t const replication, MonteCarlo::Marking& marking)
+        {
+            marking[0] = replication % 2u;
+        });
+
+    ASSERT_EQ(result.deadlocks, 5u);
+    ASSERT_DOUBLE_EQ(result.firings.mean, 5.0);
+    ASSERT_DOUBLE_EQ(result.firings.min, 0.0);
+    ASSERT_DOUBLE_EQ(result.firings.max, 10.0);
+    ASSERT_DOUBLE_EQ(result.markings[0].mean, 0.0);
+
+    // Errors are given back to the caller.
+    ASSERT_THROW(montecarlo.run(options,
+        [](size_t const replication, MonteCarlo::Marking&)
+        {
+            if (replication == 5u)
+                throw std::runtime_error("error");
+        }), std::runtime_error);
+}
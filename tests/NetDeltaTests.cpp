@@ -0,0 +1,358 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#define protected public
+#define private public
+#  include "PetriNet/NetDelta.hpp"
+#undef protected
+#undef private
+#include "NetIndex.hpp"
+
+#include <random>
+#include <sstream>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Return the whole content of the net, including slots of nodes and
+//! arcs and orders of incoming and outgoing arcs.
+//------------------------------------------------------------------------------
+static std::string dump(Net const& net)
+{
+    std::stringstream ss;
+    auto dumpArcs = [&ss](Node const& node)
+    {
+        ss << " in:";
+        for (auto a: node.arcsIn)
+            ss << " " << a->index;
+        ss << " out:";
+        for (auto a: node.arcsOut)
+            ss << " " << a->index;
+        ss << std::endl;
+    };
+
+    ss << net.name << " " << net.m_next_place_id << " "
+       << net.m_next_transition_id << std::endl;
+    for (auto const& p: net.places())
+    {
+        ss << p << " " << p.actions.size();
+        dumpArcs(p);
+    }
+    for (auto const& t: net.transitions())
+    {
+        ss << t;
+        dumpArcs(t);
+    }
+    for (auto const& a: net.arcs())
+    {
+        ss << a.index << ": " << a << " " << a.duration << std::endl;
+    }
+    return ss.str();
+}
+
+//------------------------------------------------------------------------------
+//! \brief Pick a random node of the given type.
+//------------------------------------------------------------------------------
+static Node& randomNode(Net& net, bool const place, std::mt19937& generator)
+{
+    if (place)
+        return net.places()[generator() % net.places().size()];
+    return net.transitions()[generator() % net.transitions().size()];
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetDelta, TestRandomEdits)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    std::mt19937 generator(42u);
+    std::vector<NetDelta> deltas;
+    std::vector<std::string> dumps;
+
+    for (size_t i = 0u; i < 10u; ++i)
+    {
+        net.addPlace(float(i), 0.0f, i % 3u);
+        net.addTransition(float(i), 1.0f);
+    }
+    dumps.push_back(dump(net));
+
+    for (size_t i = 0u; i < 300u; ++i)
+    {
+        deltas.emplace_back();
+        NetDelta& delta = deltas.back();
+        net.journal(&delta);
+
+        bool const place = ((generator() % 2u) == 0u);
+        switch (generator() % 9u)
+        {
+        case 0u:
+            net.addPlace(float(i), 2.0f, i % 4u).caption = "added";
+            break;
+        case 1u:
+            net.addTransition(float(i), 3.0f);
+            break;
+        case 2u:
+        case 3u:
+            if (!net.places().empty() && !net.transitions().empty())
+            {
+                Node& from = randomNode(net, place, generator);
+                Node& to = randomNode(net, (generator() % 4u) == 0u ? place : !place, generator);
+                net.addArc(from, to, float(i));
+            }
+            break;
+        case 4u:
+            if (place ? !net.places().empty() : !net.transitions().empty())
+            {
+                net.removeNode(randomNode(net, place, generator));
+            }
+            break;
+        case 5u:
+            if (!net.arcs().empty())
+            {
+                net.removeArc(net.arcs()[generator() % net.arcs().size()]);
+            }
+            break;
+        case 6u:
+            if (!net.arcs().empty())
+            {
+                Arc& a = net.arcs()[generator() % net.arcs().size()];
+                float const duration = a.duration;
+                a.duration += 1.5f;
+                delta.duration(a, duration);
+            }
+            break;
+        case 7u:
+            if (place ? !net.places().empty() : !net.transitions().empty())
+            {
+                Node& n = randomNode(net, place, generator);
+                std::string const caption = n.caption;
+                n.caption = "caption" + std::to_string(i);
+                delta.caption(n, caption);
+            }
+            break;
+        default:
+            if (!net.places().empty())
+            {
+                Place& p = net.places()[generator() % net.places().size()];
+                float const x = p.x, y = p.y;
+                size_t const tokens = p.tokens;
+                p.x += 10.0f; p.y -= 5.0f;
+                delta.moveNode(p, x, y);
+                p.tokens += 1u;
+                delta.tokens(p, tokens);
+            }
+            break;
+        }
+
+        net.journal(nullptr);
+        checkIndex(net);
+        dumps.push_back(dump(net));
+    }
+
+    // Undo everything.
+    for (size_t i = deltas.size(); i--; )
+    {
+        ASSERT_TRUE(deltas[i].undo(net));
+        checkIndex(net);
+        ASSERT_EQ(dump(net), dumps[i]);
+    }
+
+    // Redo everything.
+    for (size_t i = 0u; i < deltas.size(); ++i)
+    {
+        ASSERT_TRUE(deltas[i].redo(net));
+        checkIndex(net);
+        ASSERT_EQ(dump(net), dumps[i + 1u]);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetDelta, TestRemoveEventGraphTransition)
+{
+    Net net(TypeOfNet::TimedEventGraph);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(1.0f, 0.0f);
+    Transition& t2 = net.addTransition(2.0f, 0.0f);
+    net.addArc(t0, t1, 1u, 2.0f);
+    net.addArc(t1, t2, 0u, 3.0f);
+    net.addArc(t2, t0, 1u, 4.0f);
+    std::string const before = dump(net);
+
+    NetDelta delta;
+    net.journal(&delta);
+    net.removeNode(net.transitions()[1]);
+    net.journal(nullptr);
+    ASSERT_EQ(net.transitions().size(), 2u);
+    ASSERT_EQ(net.places().size(), 1u);
+    std::string const after = dump(net);
+
+    ASSERT_TRUE(delta.undo(net));
+    checkIndex(net);
+    ASSERT_EQ(dump(net), before);
+    ASSERT_TRUE(delta.redo(net));
+    checkIndex(net);
+    ASSERT_EQ(dump(net), after);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetDelta, TestMergeMoves)
+{
+    Net net(TypeOfNet::PetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(10.0f, 0.0f, 2u);
+
+    // Dragging two nodes together: a single move per node.
+    NetDelta delta;
+    for (size_t i = 1u; i <= 20u; ++i)
+    {
+        float x = p0.x, y = p0.y;
+        p0.x += 1.0f;
+        delta.moveNode(p0, x, y);
+        x = p1.x; y = p1.y;
+        p1.y += 1.0f;
+        delta.moveNode(p1, x, y);
+    }
+    delta.tokens(p0, p0.tokens);
+    ASSERT_EQ(delta.size(), 2u);
+    size_t const tokens = p0.tokens;
+    p0.tokens = 5u;
+    delta.tokens(p0, tokens);
+    p0.tokens = 6u;
+    delta.tokens(p0, 5u);
+    ASSERT_EQ(delta.size(), 3u);
+
+    ASSERT_TRUE(delta.undo(net));
+    ASSERT_EQ(p0.x, 0.0f); ASSERT_EQ(p0.y, 0.0f); ASSERT_EQ(p0.tokens, 1u);
+    ASSERT_EQ(p1.x, 10.0f); ASSERT_EQ(p1.y, 0.0f);
+    ASSERT_TRUE(delta.redo(net));
+    ASSERT_EQ(p0.x, 20.0f); ASSERT_EQ(p0.y, 0.0f); ASSERT_EQ(p0.tokens, 6u);
+    ASSERT_EQ(p1.x, 10.0f); ASSERT_EQ(p1.y, 20.0f);
+
+    // A structural modification stops merging.
+    net.journal(&delta);
+    net.addTransition(5.0f, 5.0f);
+    net.journal(nullptr);
+    float const x = p0.x, y = p0.y;
+    p0.x = -1.0f;
+    delta.moveNode(p0, x, y);
+    ASSERT_EQ(delta.size(), 5u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetDelta, TestDurationsAndCaptions)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(0.0f, 1.0f, 0u);
+    Transition& t = net.addTransition(1.0f, 0.0f);
+    net.addArc(p0, t);
+    net.addArc(t, p0, 1.0f);
+    net.addArc(t, p1, 2.0f);
+    std::string const before = dump(net);
+    uint64_t revision = net.structureRevision();
+
+    // Successive changes of the same arc or node are merged.
+    NetDelta delta;
+    Arc& a = *net.findArc(t, p0);
+    for (size_t i = 0u; i < 10u; ++i)
+    {
+        float const duration = a.duration;
+        a.duration += 0.5f;
+        delta.duration(a, duration);
+    }
+    Arc& b = *net.findArc(t, p1);
+    b.duration = 3.0f;
+    delta.duration(b, 2.0f);
+    delta.duration(b, 3.0f);
+    ASSERT_EQ(delta.size(), 2u);
+    for (char const* caption: { "f", "fo", "foo" })
+    {
+        std::string const previous = t.caption;
+        t.caption = caption;
+        delta.caption(t, previous);
+    }
+    delta.caption(p0, p0.caption);
+    ASSERT_EQ(delta.size(), 3u);
+    std::string const after = dump(net);
+
+    // Durations and captions are part of the structure (see AnalysisCache).
+    ASSERT_TRUE(delta.undo(net));
+    ASSERT_EQ(dump(net), before);
+    ASSERT_EQ(a.duration, 1.0f);
+    ASSERT_EQ(b.duration, 2.0f);
+    ASSERT_EQ(t.caption, t.key);
+    ASSERT_NE(net.structureRevision(), revision);
+    revision = net.structureRevision();
+    ASSERT_TRUE(delta.redo(net));
+    ASSERT_EQ(dump(net), after);
+    ASSERT_EQ(a.duration, 6.0f);
+    ASSERT_EQ(b.duration, 3.0f);
+    ASSERT_EQ(t.caption, "foo");
+    ASSERT_NE(net.structureRevision(), revision);
+
+    // The arc shall exist.
+    ASSERT_TRUE(net.removeArc(t, p1));
+    ASSERT_FALSE(delta.undo(net));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetDelta, TestReset)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p = net.addPlace(0.0f, 0.0f, 1u);
+    Transition& t = net.addTransition(1.0f, 0.0f);
+    net.addArc(p, t);
+    std::string const before = dump(net);
+
+    NetDelta delta;
+    net.journal(&delta);
+    net.reset(TypeOfNet::GRAFCET);
+    net.addPlace(3.0f, 3.0f, 1u);
+    net.journal(nullptr);
+    ASSERT_EQ(net.type(), TypeOfNet::GRAFCET);
+    std::string const after = dump(net);
+
+    ASSERT_TRUE(delta.undo(net));
+    ASSERT_EQ(net.type(), TypeOfNet::TimedPetriNet);
+    ASSERT_EQ(dump(net), before);
+    checkIndex(net);
+    ASSERT_TRUE(delta.redo(net));
+    ASSERT_EQ(net.type(), TypeOfNet::GRAFCET);
+    ASSERT_EQ(dump(net), after);
+    checkIndex(net);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetDelta, TestMismatch)
+{
+    Net net(TypeOfNet::PetriNet);
+    NetDelta delta;
+    net.journal(&delta);
+    net.addPlace(0.0f, 0.0f);
+    net.journal(nullptr);
+    ASSERT_EQ(net.journal(), nullptr);
+
+    // Records do not match the other net.
+    Net other(TypeOfNet::PetriNet);
+    ASSERT_FALSE(delta.undo(other));
+    ASSERT_TRUE(delta.undo(net));
+    ASSERT_TRUE(net.places().empty());
+    ASSERT_FALSE(delta.undo(net));
+}
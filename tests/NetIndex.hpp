@@ -0,0 +1,74 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef TESTS_NET_INDEX_HPP
+#  define TESTS_NET_INDEX_HPP
+
+#  include <algorithm>
+
+//------------------------------------------------------------------------------
+//! \brief Check the internal indices of the net match the content of its
+//! containers.
+//! \note Shall be included after PetriNet/PetriNet.hpp has been included with
+//! private members made public.
+//------------------------------------------------------------------------------
+inline void checkIndex(tpne::Net& net)
+{
+    ASSERT_EQ(net.m_place_slots.size(), net.m_places.size());
+    for (auto& p: net.m_places)
+    {
+        ASSERT_EQ(net.findPlace(p.id), &p);
+        ASSERT_EQ(net.findNode(p.key), &p);
+    }
+
+    ASSERT_EQ(net.m_transition_slots.size(), net.m_transitions.size());
+    for (auto& t: net.m_transitions)
+    {
+        ASSERT_EQ(net.findTransition(t.id), &t);
+        ASSERT_EQ(net.findNode(t.key), &t);
+    }
+
+    ASSERT_EQ(net.m_arc_slots.size(), net.m_arcs.size());
+    size_t count_in = 0u, count_out = 0u;
+    size_t index = 0u;
+    for (auto& a: net.m_arcs)
+    {
+        ASSERT_EQ(a.index, index++);
+        ASSERT_EQ(net.findArc(a.from, a.to), &a);
+        ASSERT_EQ(std::count(a.from.arcsOut.begin(), a.from.arcsOut.end(), &a), 1);
+        ASSERT_EQ(std::count(a.to.arcsIn.begin(), a.to.arcsIn.end(), &a), 1);
+    }
+
+    // Incoming and outgoing arcs are incrementally updated: no extra arcs.
+    for (auto& p: net.m_places)
+    {
+        count_in += p.arcsIn.size();
+        count_out += p.arcsOut.size();
+    }
+    for (auto& t: net.m_transitions)
+    {
+        count_in += t.arcsIn.size();
+        count_out += t.arcsOut.size();
+    }
+    ASSERT_EQ(count_in, net.m_arcs.size());
+    ASSERT_EQ(count_out, net.m_arcs.size());
+}
+
+#endif // TESTS_NET_INDEX_HPP
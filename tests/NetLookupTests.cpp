@@ -0,0 +1,248 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#define protected public
+#define private public
+#  include "PetriNet/PetriNet.hpp"
+#undef protected
+#undef private
+#include "NetIndex.hpp"
+
+#include <algorithm>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+TEST(TestNetLookup, TestFindNode)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    net.addPlace(1.0f, 1.0f, 1u);
+    net.addTransition(2.0f, 2.0f);
+    net.addPlace(42u, "", 3.0f, 3.0f, 0u);
+
+    ASSERT_EQ(net.findNode("P0"), &net.m_places[0]);
+    ASSERT_EQ(net.findNode("T0"), &net.m_transitions[0]);
+    ASSERT_EQ(net.findNode("P42"), &net.m_places[1]);
+    ASSERT_EQ(net.findNode("P1"), nullptr);
+    ASSERT_EQ(net.findNode("T1"), nullptr);
+    ASSERT_EQ(net.findNode("P042"), nullptr);
+    ASSERT_EQ(net.findNode("P4x"), nullptr);
+    ASSERT_EQ(net.findNode("X0"), nullptr);
+    ASSERT_EQ(net.findNode("P"), nullptr);
+    ASSERT_EQ(net.findNode(""), nullptr);
+    ASSERT_EQ(net.findPlace(42u), &net.m_places[1]);
+    ASSERT_EQ(net.findTransition(42u), nullptr);
+
+    net.clear();
+    ASSERT_EQ(net.findNode("P0"), nullptr);
+    ASSERT_EQ(net.findNode("T0"), nullptr);
+    checkIndex(net);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetLookup, TestFindArc)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(1.0f, 1.0f, 1u);
+    Transition& t0 = net.addTransition(2.0f, 2.0f);
+    Transition& t1 = net.addTransition(3.0f, 3.0f);
+
+    ASSERT_STREQ(net.addArc(p0, t0).c_str(), "");
+    ASSERT_STREQ(net.addArc(t0, p0, 2.0f).c_str(), "");
+    ASSERT_STRNE(net.addArc(p0, t0).c_str(), "");
+    ASSERT_NE(net.findArc(p0, t0), nullptr);
+    ASSERT_NE(net.findArc(t0, p0), nullptr);
+    ASSERT_EQ(net.findArc(p0, t1), nullptr);
+    ASSERT_EQ(net.findArc(t1, p0), nullptr);
+    checkIndex(net);
+
+    // Transition -> Transition creates an intermediate place.
+    ASSERT_STREQ(net.addArc(t0, t1).c_str(), "");
+    ASSERT_EQ(net.m_places.size(), 2u);
+    ASSERT_NE(net.findArc(t0, net.m_places[1]), nullptr);
+    ASSERT_NE(net.findArc(net.m_places[1], t1), nullptr);
+    checkIndex(net);
+
+    ASSERT_EQ(net.removeArc(p0, t0), true);
+    ASSERT_EQ(net.removeArc(p0, t0), false);
+    ASSERT_EQ(net.findArc(p0, t0), nullptr);
+    checkIndex(net);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetLookup, TestRemoveNodes)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    for (size_t i = 0u; i < 8u; ++i)
+    {
+        net.addPlace(float(i), 0.0f, i);
+        net.addTransition(float(i), 1.0f);
+    }
+    for (size_t i = 0u; i < 8u; ++i)
+    {
+        net.addArc(net.m_places[i], net.m_transitions[i]);
+        net.addArc(net.m_transitions[i], net.m_places[(i + 1u) % 8u]);
+    }
+    ASSERT_EQ(net.m_arcs.size(), 16u);
+    checkIndex(net);
+
+    // Swap-and-pop: the latest place takes the slot and the identifier of P2.
+    net.removeNode(net.m_places[2]);
+    ASSERT_EQ(net.m_places.size(), 7u);
+    ASSERT_EQ(net.m_arcs.size(), 14u);
+    ASSERT_EQ(net.findNode("P7"), nullptr);
+    ASSERT_EQ(net.findPlace(2u)->tokens, 7u);
+    ASSERT_NE(net.findArc(*net.findPlace(2u), *net.findTransition(7u)), nullptr);
+    ASSERT_NE(net.findArc(*net.findTransition(6u), *net.findPlace(2u)), nullptr);
+    checkIndex(net);
+
+    // Remove the latest transition.
+    net.removeNode(net.m_transitions[7]);
+    ASSERT_EQ(net.m_transitions.size(), 7u);
+    ASSERT_EQ(net.findNode("T7"), nullptr);
+    checkIndex(net);
+
+    // Remove the first transition.
+    net.removeNode(net.m_transitions[0]);
+    ASSERT_EQ(net.m_transitions.size(), 6u);
+    ASSERT_EQ(net.findNode("T6"), nullptr);
+    checkIndex(net);
+
+    // Copies have their own index.
+    Net copy(net);
+    checkIndex(copy);
+    ASSERT_EQ(copy.findNode("P0"), &copy.m_places[0]);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetLookup, TestRemoveEventGraphNodes)
+{
+    Net net(TypeOfNet::TimedEventGraph);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(1.0f, 0.0f);
+    Transition& t2 = net.addTransition(2.0f, 0.0f);
+    ASSERT_EQ(net.addArc(t0, t1, 1u, 1.0f), true);
+    ASSERT_EQ(net.addArc(t1, t2, 0u, 2.0f), true);
+    ASSERT_EQ(net.addArc(t2, t0, 0u, 3.0f), true);
+    ASSERT_EQ(net.addArc(t1, t1, 1u, 4.0f), true);
+    ASSERT_EQ(net.m_places.size(), 4u);
+    ASSERT_EQ(net.m_arcs.size(), 8u);
+    ASSERT_EQ(t1.arcsIn.size(), 2u);
+    ASSERT_EQ(t1.arcsOut.size(), 2u);
+    checkIndex(net);
+
+    // Removing a transition also removes its adjacent places.
+    net.removeNode(net.m_transitions[1]);
+    ASSERT_EQ(net.m_transitions.size(), 2u);
+    ASSERT_EQ(net.m_places.size(), 1u);
+    ASSERT_EQ(net.m_arcs.size(), 2u);
+    ASSERT_EQ(net.m_transitions[1].arcsOut.size(), 1u);
+    ASSERT_EQ(net.m_transitions[0].arcsIn.size(), 1u);
+    checkIndex(net);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetLookup, TestRemoveKeepsMovedNode)
+{
+    Net net(TypeOfNet::GRAFCET);
+    net.addPlace(0.0f, 0.0f, 1u);
+    net.addPlace(1.0f, 0.0f, 0u);
+    Place& p2 = net.addPlace(2u, "Step", 2.0f, 0.0f, 1u);
+    p2.actions.push_back(tpne::Action());
+    p2.actions.back().name = "Action1";
+    net.addTransition(0.0f, 1.0f);
+    Transition& t1 = net.addTransition(1u, "X1", 1.0f, 1.0f);
+    t1.delay = 2.0f;
+    net.addArc(net.m_places[2], net.m_transitions[1]);
+    checkIndex(net);
+
+    // P2 is moved to the slot of P0: it is renamed but keeps its content.
+    net.removeNode(net.m_places[0]);
+    ASSERT_EQ(net.m_places.size(), 2u);
+    Place const& p = net.m_places[0];
+    ASSERT_EQ(p.id, 0u);
+    ASSERT_STREQ(p.key.c_str(), "P0");
+    ASSERT_STREQ(p.caption.c_str(), "Step");
+    ASSERT_EQ(p.tokens, 1u);
+    ASSERT_EQ(p.actions.size(), 1u);
+    ASSERT_STREQ(p.actions[0].name.c_str(), "Action1");
+    ASSERT_EQ(p.arcsOut.size(), 1u);
+    ASSERT_EQ(&p.arcsOut[0]->from, &p);
+    checkIndex(net);
+
+    // Default captions follow the new key.
+    net.removeNode(net.m_places[0]);
+    ASSERT_STREQ(net.m_places[0].key.c_str(), "P0");
+    ASSERT_STREQ(net.m_places[0].caption.c_str(), "P0");
+
+    // Same for transitions.
+    net.removeNode(net.m_transitions[0]);
+    Transition const& t = net.m_transitions[0];
+    ASSERT_STREQ(t.key.c_str(), "T0");
+    ASSERT_STREQ(t.caption.c_str(), "X1");
+    ASSERT_EQ(t.delay, 2.0f);
+    checkIndex(net);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestNetLookup, TestMoveNet)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(1.0f, 1.0f, 1u);
+    Transition& t0 = net.addTransition(2.0f, 2.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p0);
+    Arc const* arc = net.findArc(p0, t0);
+    uint64_t const structure = net.structureRevision();
+    uint64_t const marking = net.markingRevision();
+
+    // Nodes and arcs keep their addresses and the net keeps its revisions.
+    Net moved(std::move(net));
+    ASSERT_EQ(&moved.m_places[0], &p0);
+    ASSERT_EQ(&moved.m_transitions[0], &t0);
+    ASSERT_EQ(moved.findArc(p0, t0), arc);
+    ASSERT_EQ(moved.structureRevision(), structure);
+    ASSERT_EQ(moved.markingRevision(), marking);
+    checkIndex(moved);
+
+    // The moved net is empty, usable and does not share revisions.
+    ASSERT_EQ(net.isEmpty(), true);
+    ASSERT_NE(net.structureRevision(), structure);
+    ASSERT_NE(net.markingRevision(), marking);
+    net.addPlace(0.0f, 0.0f, 0u);
+    ASSERT_NE(net.findNode("P0"), nullptr);
+    checkIndex(net);
+
+    // Move assignment.
+    net = std::move(moved);
+    ASSERT_EQ(&net.m_places[0], &p0);
+    ASSERT_EQ(net.findArc(p0, t0), arc);
+    ASSERT_EQ(net.structureRevision(), structure);
+    ASSERT_EQ(moved.isEmpty(), true);
+    checkIndex(net);
+    checkIndex(moved);
+
+    // Copy assignment gives new nodes.
+    moved = net;
+    ASSERT_NE(&moved.m_places[0], &p0);
+    ASSERT_NE(moved.structureRevision(), structure);
+    checkIndex(moved);
+}
@@ -0,0 +1,92 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#ifndef TESTS_NETS_HPP
+#  define TESTS_NETS_HPP
+
+#  include "PetriNet/PetriNet.hpp"
+
+//------------------------------------------------------------------------------
+//! \brief Create k independent circuits of L places holding a single token:
+//! the net has L^k reachable markings.
+//------------------------------------------------------------------------------
+inline void createCircuits(tpne::Net& net, size_t const k, size_t const L)
+{
+    for (size_t c = 0u; c < k; ++c)
+    {
+        size_t const first = net.places().size();
+        for (size_t i = 0u; i < L; ++i)
+        {
+            net.addPlace(float(i), float(c), (i == 0u) ? 1u : 0u);
+            net.addTransition(float(i), float(c));
+        }
+        for (size_t i = 0u; i < L; ++i)
+        {
+            net.addArc(net.places()[first + i], net.transitions()[first + i]);
+            net.addArc(net.transitions()[first + i],
+                       net.places()[first + (i + 1u) % L]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Create the n dining philosophers: a philosopher takes its left fork
+//! then its right fork, eats and releases both forks. The only deadlock is
+//! when all philosophers hold their left fork. This 1-safe net has 2n
+//! P-semiflows and n T-semiflows.
+//! Places of the philosopher i are 4 * i + {thinking, left fork, eating, fork}.
+//! Transitions are 3 * i + {take left fork, take right fork, release forks}.
+//------------------------------------------------------------------------------
+inline void createPhilosophers(tpne::Net& net, size_t const n)
+{
+    for (size_t i = 0u; i < n; ++i)
+    {
+        net.addPlace(float(i), 0.0f, 1u);
+        net.addPlace(float(i), 1.0f, 0u);
+        net.addPlace(float(i), 2.0f, 0u);
+        net.addPlace(float(i), 3.0f, 1u);
+        net.addTransition(float(i), 0.5f);
+        net.addTransition(float(i), 1.5f);
+        net.addTransition(float(i), 2.5f);
+    }
+    for (size_t i = 0u; i < n; ++i)
+    {
+        tpne::Place& thinking = net.places()[4u * i];
+        tpne::Place& left = net.places()[4u * i + 1u];
+        tpne::Place& eating = net.places()[4u * i + 2u];
+        tpne::Place& fork = net.places()[4u * i + 3u];
+        tpne::Place& next = net.places()[4u * ((i + 1u) % n) + 3u];
+        tpne::Transition& take_left = net.transitions()[3u * i];
+        tpne::Transition& take_right = net.transitions()[3u * i + 1u];
+        tpne::Transition& release = net.transitions()[3u * i + 2u];
+        net.addArc(thinking, take_left);
+        net.addArc(fork, take_left);
+        net.addArc(take_left, left);
+        net.addArc(left, take_right);
+        net.addArc(next, take_right);
+        net.addArc(take_right, eating);
+        net.addArc(eating, release);
+        net.addArc(release, thinking);
+        net.addArc(release, fork);
+        net.addArc(release, next);
+    }
+}
+
+#endif // TESTS_NETS_HPP
@@ -0,0 +1,566 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "Nets.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Reachability.hpp"
+#include "PetriNet/SymbolicReachability.hpp"
+
+#include <map>
+#include <queue>
+#include <set>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Return the markings of the deadlocks.
+//------------------------------------------------------------------------------
+static std::set<CompiledNet::Marking> deadlocksOf(ReachabilityGraph const& graph)
+{
+    std::set<CompiledNet::Marking> markings;
+    CompiledNet::Marking marking;
+    for (auto const s: graph.deadlocks())
+    {
+        graph.marking(s, marking);
+        markings.insert(marking);
+    }
+    return markings;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Naive breadth-first search used as reference.
+//------------------------------------------------------------------------------
+static size_t countReachable(CompiledNet const& net, size_t& deadlocks)
+{
+    std::map<CompiledNet::Marking, size_t> visited;
+    std::queue<CompiledNet::Marking> queue;
+    visited[net.initialMarking()] = 0u;
+    queue.push(net.initialMarking());
+    deadlocks = 0u;
+    while (!queue.empty())
+    {
+        CompiledNet::Marking marking = queue.front();
+        queue.pop();
+        bool dead = true;
+        for (size_t t = 0u; t < net.countTransitions(); ++t)
+        {
+            if (!net.isEnabled(t, marking))
+                continue;
+            dead = false;
+            CompiledNet::Marking next = marking;
+            net.fire(t, 1u, next);
+            if (visited.emplace(next, visited.size()).second)
+                queue.push(next);
+        }
+        deadlocks += dead;
+    }
+    return visited.size();
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestCircuit)
+{
+    Net net(TypeOfNet::PetriNet);
+    createCircuits(net, 1u, 3u);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ReachabilityGraph::Options options;
+    options.edges = true;
+    ASSERT_EQ(graph.explore(options), true);
+    ASSERT_EQ(graph.isComplete(), true);
+    ASSERT_EQ(graph.isBounded(), true);
+    ASSERT_EQ(graph.countStates(), 3u);
+    ASSERT_EQ(graph.countEdges(), 3u);
+    ASSERT_EQ(graph.deadlocks().empty(), true);
+    ASSERT_EQ(graph.bounds(), std::vector<size_t>({ 1u, 1u, 1u }));
+
+    CompiledNet::Marking marking;
+    graph.marking(0u, marking);
+    ASSERT_EQ(marking, std::vector<size_t>({ 1u, 0u, 0u }));
+    graph.marking(2u, marking);
+    ASSERT_EQ(marking, std::vector<size_t>({ 0u, 0u, 1u }));
+    ASSERT_EQ(graph.trace(2u), std::vector<size_t>({ 0u, 1u }));
+
+    // The last state goes back to the initial state.
+    ASSERT_EQ(graph.edgesEnd(2u) - graph.edgesBegin(2u), 1u);
+    ASSERT_EQ(graph.edge(graph.edgesBegin(2u)).transition, 2u);
+    ASSERT_EQ(graph.edge(graph.edgesBegin(2u)).state, 0u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestDeadlock)
+{
+    // P0 (2 tokens) -> T0 -> P1
+    Net net(TypeOfNet::PetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 2u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ASSERT_EQ(graph.explore(ReachabilityGraph::Options()), true);
+    ASSERT_EQ(graph.countStates(), 3u);
+    ASSERT_EQ(graph.countEdges(), 0u);
+    ASSERT_EQ(graph.deadlocks(), std::vector<size_t>({ 2u }));
+    ASSERT_EQ(graph.trace(2u), std::vector<size_t>({ 0u, 0u }));
+    ASSERT_EQ(graph.bounds(), std::vector<size_t>({ 2u, 2u }));
+
+    CompiledNet::Marking marking;
+    graph.marking(2u, marking);
+    ASSERT_EQ(marking, std::vector<size_t>({ 0u, 2u }));
+
+    // From another marking.
+    ASSERT_EQ(graph.explore(ReachabilityGraph::Options(), { 0u, 5u }), true);
+    ASSERT_EQ(graph.countStates(), 1u);
+    ASSERT_EQ(graph.deadlocks(), std::vector<size_t>({ 0u }));
+    ASSERT_EQ(graph.trace(0u).empty(), true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestUnbounded)
+{
+    // T0 (source) -> P0
+    Net net(TypeOfNet::PetriNet);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 0u);
+    net.addArc(t0, p0);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ReachabilityGraph::Options options;
+    options.max_states = 100u;
+    ASSERT_EQ(graph.explore(options), false);
+    ASSERT_EQ(graph.isComplete(), false);
+    ASSERT_EQ(graph.isBounded(), false);
+    ASSERT_EQ(graph.countStates(), 100u);
+
+    // Coverability graph: [0] -> [w] -> [w].
+    options.coverability = true;
+    options.edges = true;
+    ASSERT_EQ(graph.explore(options), true);
+    ASSERT_EQ(graph.isBounded(), false);
+    ASSERT_EQ(graph.countStates(), 2u);
+    ASSERT_EQ(graph.countEdges(), 2u);
+    ASSERT_EQ(graph.bounds(), std::vector<size_t>({ ReachabilityGraph::OMEGA }));
+    ASSERT_EQ(graph.edge(graph.edgesBegin(1u)).state, 1u);
+
+    CompiledNet::Marking marking;
+    graph.marking(1u, marking);
+    ASSERT_EQ(marking, std::vector<size_t>({ ReachabilityGraph::OMEGA }));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestCoverability)
+{
+    // T0 consumes the token of P0 and gives it back with a token in P1.
+    Net net(TypeOfNet::PetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p0);
+    net.addArc(t0, p1);
+    // T1 consumes P1 tokens.
+    net.addArc(p1, t1);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ReachabilityGraph::Options options;
+    options.coverability = true;
+    ASSERT_EQ(graph.explore(options), true);
+    ASSERT_EQ(graph.countStates(), 2u);
+    ASSERT_EQ(graph.deadlocks().empty(), true);
+    ASSERT_EQ(graph.bounds(), std::vector<size_t>({ 1u, ReachabilityGraph::OMEGA }));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestThreads)
+{
+    Net net(TypeOfNet::PetriNet);
+    createCircuits(net, 4u, 6u);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ReachabilityGraph::Options options;
+    options.edges = true;
+
+    for (size_t threads: { 1u, 4u })
+    {
+        options.threads = threads;
+        ASSERT_EQ(graph.explore(options), true);
+        ASSERT_EQ(graph.countStates(), 6u * 6u * 6u * 6u);
+        ASSERT_EQ(graph.countEdges(), 4u * graph.countStates());
+        ASSERT_EQ(graph.deadlocks().empty(), true);
+        ASSERT_GT(graph.memory(), 0u);
+
+        // Each arc fires a transition from the marking of its source.
+        CompiledNet::Marking source, target;
+        for (size_t s = 0u; s < graph.countStates(); ++s)
+        {
+            graph.marking(s, source);
+            for (size_t k = graph.edgesBegin(s); k < graph.edgesEnd(s); ++k)
+            {
+                graph.marking(graph.edge(k).state, target);
+                compiled.fire(graph.edge(k).transition, 1u, source);
+                ASSERT_EQ(source, target);
+                graph.marking(s, source);
+            }
+        }
+    }
+
+    // Limited number of states.
+    options.max_states = 1000u;
+    options.threads = 1u;
+    ASSERT_EQ(graph.explore(options), false);
+    ASSERT_EQ(graph.countStates(), 1000u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestTruncatedEdges)
+{
+    Net net(TypeOfNet::PetriNet);
+    createCircuits(net, 4u, 6u);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ReachabilityGraph::Options options;
+    options.edges = true;
+    options.max_states = 100u;
+
+    // States dropped by max_states are still reached by other states: their
+    // arcs shall not be stored.
+    for (size_t threads: { 1u, 4u })
+    {
+        options.threads = threads;
+        ASSERT_EQ(graph.explore(options), false);
+        ASSERT_EQ(graph.countStates(), 100u);
+        ASSERT_GT(graph.countEdges(), 0u);
+        for (size_t k = 0u; k < graph.countEdges(); ++k)
+        {
+            ASSERT_LT(graph.edge(k).state, graph.countStates());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestGrafcet)
+{
+    // Tokens are saturated to 1 in GRAFCET.
+    Net net(TypeOfNet::GRAFCET);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 0u);
+    net.addArc(t0, p0);
+
+    CompiledNet compiled(net);
+    ReachabilityGraph graph(compiled);
+    ReachabilityGraph::Options options;
+    options.coverability = true;
+    ASSERT_EQ(graph.explore(options), true);
+    ASSERT_EQ(graph.countStates(), 2u);
+    ASSERT_EQ(graph.isBounded(), true);
+    ASSERT_EQ(graph.bounds(), std::vector<size_t>({ 1u }));
+    net.reset(TypeOfNet::PetriNet);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestExamples)
+{
+    // Bounded nets.
+    for (auto const& file: { "Philosophers.json", "EmergencyCalls.json",
+                             "SmarthomeSafety.json", "LandingGear.json" })
+    {
+        bool stringify;
+        Net net(TypeOfNet::PetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        CompiledNet compiled(net);
+
+        size_t deadlocks;
+        size_t const states = countReachable(compiled, deadlocks);
+
+        ReachabilityGraph graph(compiled);
+        ASSERT_EQ(graph.explore(ReachabilityGraph::Options()), true);
+        ASSERT_EQ(graph.countStates(), states);
+        ASSERT_EQ(graph.deadlocks().size(), deadlocks);
+        for (auto const s: graph.deadlocks())
+        {
+            CompiledNet::Marking marking = compiled.initialMarking();
+            for (auto const t: graph.trace(s))
+            {
+                ASSERT_EQ(compiled.isEnabled(t, marking), true);
+                compiled.fire(t, 1u, marking);
+            }
+            CompiledNet::Marking expected;
+            graph.marking(s, expected);
+            ASSERT_EQ(marking, expected);
+        }
+    }
+
+    // Nets with source transitions.
+    for (auto const& file: { "ProducerConsumer.json", "Infinite.json" })
+    {
+        bool stringify;
+        Net net(TypeOfNet::PetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        CompiledNet compiled(net);
+        ReachabilityGraph graph(compiled);
+        ReachabilityGraph::Options options;
+        options.max_states = 1000u;
+        ASSERT_EQ(graph.explore(options), false);
+        options.coverability = true;
+        ASSERT_EQ(graph.explore(options), true);
+        ASSERT_EQ(graph.isBounded(), false);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestReductionChains)
+{
+    // 4 independent chains of 10 transitions: 11^4 states but a single path
+    // is enough for reaching the deadlock.
+    Net net(TypeOfNet::PetriNet);
+    for (size_t c = 0u; c < 4u; ++c)
+    {
+        Place* from = &net.addPlace(0.0f, float(c), 1u);
+        for (size_t i = 0u; i < 10u; ++i)
+        {
+            Transition& t = net.addTransition(float(i), float(c));
+            Place& to = net.addPlace(float(i + 1u), float(c), 0u);
+            net.addArc(*from, t);
+            net.addArc(t, to);
+            from = &to;
+        }
+    }
+
+    CompiledNet compiled(net);
+    ReachabilityGraph full(compiled);
+    ASSERT_EQ(full.explore(ReachabilityGraph::Options()), true);
+    ASSERT_EQ(full.countStates(), 11u * 11u * 11u * 11u);
+    ASSERT_EQ(full.deadlocks().size(), 1u);
+
+    ReachabilityGraph reduced(compiled);
+    ReachabilityGraph::Options options;
+    options.reduction = true;
+    ASSERT_EQ(reduced.explore(options), true);
+    ASSERT_EQ(reduced.countStates(), 41u);
+    ASSERT_EQ(reduced.isBounded(), false);
+    ASSERT_EQ(deadlocksOf(reduced), deadlocksOf(full));
+    ASSERT_EQ(reduced.trace(reduced.deadlocks()[0]).size(), 40u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestReductionPhilosophers)
+{
+    Net net(TypeOfNet::PetriNet);
+    createPhilosophers(net, 8u);
+    CompiledNet compiled(net);
+
+    ReachabilityGraph full(compiled);
+    ASSERT_EQ(full.explore(ReachabilityGraph::Options()), true);
+    ASSERT_EQ(full.deadlocks().size(), 1u);
+
+    ReachabilityGraph::Options options;
+    options.reduction = true;
+    for (size_t threads: { 1u, 4u })
+    {
+        options.threads = threads;
+        ReachabilityGraph reduced(compiled);
+        ASSERT_EQ(reduced.explore(options), true);
+        ASSERT_LT(10u * reduced.countStates(), full.countStates());
+        ASSERT_EQ(deadlocksOf(reduced), deadlocksOf(full));
+
+        // The trace leads to the deadlock.
+        CompiledNet::Marking marking = compiled.initialMarking();
+        for (auto const t: reduced.trace(reduced.deadlocks()[0]))
+            compiled.fire(t, 1u, marking);
+        ASSERT_EQ(marking, *deadlocksOf(full).begin());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestReachability, TestReductionExamples)
+{
+    for (auto const& file: { "Philosophers.json", "EmergencyCalls.json",
+                             "SmarthomeSafety.json", "LandingGear.json" })
+    {
+        bool stringify;
+        Net net(TypeOfNet::PetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        CompiledNet compiled(net);
+
+        ReachabilityGraph full(compiled);
+        ASSERT_EQ(full.explore(ReachabilityGraph::Options()), true);
+
+        ReachabilityGraph reduced(compiled);
+        ReachabilityGraph::Options options;
+        options.reduction = true;
+        ASSERT_EQ(reduced.explore(options), true);
+        ASSERT_LE(reduced.countStates(), full.countStates());
+        ASSERT_EQ(deadlocksOf(reduced), deadlocksOf(full));
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSymbolicReachability, TestPhilosophers)
+{
+    Net net(TypeOfNet::PetriNet);
+    createPhilosophers(net, 6u);
+    CompiledNet compiled(net);
+
+    ReachabilityGraph graph(compiled);
+    ASSERT_EQ(graph.explore(ReachabilityGraph::Options()), true);
+    SymbolicReachability symbolic(compiled);
+    ASSERT_EQ(symbolic.explore(), true);
+    ASSERT_STREQ(symbolic.error().c_str(), "");
+    ASSERT_EQ(symbolic.countStates(), double(graph.countStates()));
+    ASSERT_EQ(symbolic.countDeadlocks(), 1.0);
+    ASSERT_EQ(symbolic.deadTransitions().empty(), true);
+    ASSERT_GT(symbolic.iterations(), 1u);
+    ASSERT_GT(symbolic.countNodes(), 2u);
+
+    CompiledNet::Marking marking;
+    for (size_t s = 0u; s < graph.countStates(); ++s)
+    {
+        graph.marking(s, marking);
+        ASSERT_EQ(symbolic.contains(marking), true);
+    }
+    ASSERT_EQ(symbolic.deadlock(marking), true);
+    ASSERT_EQ(std::set<CompiledNet::Marking>({ marking }), deadlocksOf(graph));
+
+    // Too large for the explicit search: all philosophers holding their left
+    // fork is still the only deadlock.
+    Net large(TypeOfNet::PetriNet);
+    createPhilosophers(large, 60u);
+    CompiledNet compiled_large(large);
+    SymbolicReachability symbolic_large(compiled_large);
+    ASSERT_EQ(symbolic_large.explore(), true);
+    ASSERT_GT(symbolic_large.countStates(), 1e20);
+    ASSERT_EQ(symbolic_large.countDeadlocks(), 1.0);
+    ASSERT_EQ(symbolic_large.deadlock(marking), true);
+    for (size_t i = 0u; i < 60u; ++i)
+    {
+        ASSERT_EQ(marking[4u * i + 1u], 1u);
+        ASSERT_EQ(marking[4u * i + 3u], 0u);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSymbolicReachability, TestDeadTransitions)
+{
+    // P0 (1 token) -> T0 -> P1 and T1 waits for the empty place P2.
+    Net net(TypeOfNet::PetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(0.0f, 0.0f, 0u);
+    Place& p2 = net.addPlace(0.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Transition& t1 = net.addTransition(0.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1);
+    net.addArc(p2, t1);
+    net.addArc(t1, p0);
+
+    CompiledNet compiled(net);
+    SymbolicReachability symbolic(compiled);
+    ASSERT_EQ(symbolic.explore(), true);
+    ASSERT_EQ(symbolic.countStates(), 2.0);
+    ASSERT_EQ(symbolic.countDeadlocks(), 1.0);
+    ASSERT_EQ(symbolic.deadTransitions(), std::vector<size_t>({ 1u }));
+    ASSERT_EQ(symbolic.contains({ 0u, 1u, 0u }), true);
+    ASSERT_EQ(symbolic.contains({ 1u, 1u, 0u }), false);
+
+    CompiledNet::Marking marking;
+    ASSERT_EQ(symbolic.deadlock(marking), true);
+    ASSERT_EQ(marking, std::vector<size_t>({ 0u, 1u, 0u }));
+
+    // From another marking.
+    ASSERT_EQ(symbolic.explore({ 0u, 0u, 1u }), true);
+    ASSERT_EQ(symbolic.countStates(), 3.0);
+    ASSERT_EQ(symbolic.deadTransitions().empty(), true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSymbolicReachability, TestUnsafe)
+{
+    // T0 (source) -> P0: the second firing puts two tokens in P0.
+    Net net(TypeOfNet::PetriNet);
+    Transition& t0 = net.addTransition(0.0f, 0.0f);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 0u);
+    net.addArc(t0, p0);
+
+    CompiledNet compiled(net);
+    SymbolicReachability symbolic(compiled);
+    ASSERT_EQ(symbolic.explore(), false);
+    ASSERT_STREQ(symbolic.error().c_str(),
+                 "The net is not 1-safe: firing the transition T0 puts a second token in a place");
+    ASSERT_EQ(symbolic.explore({ 2u }), false);
+    ASSERT_STREQ(symbolic.error().c_str(),
+                 "The net is not 1-safe: the place P0 has more than one token in the initial marking");
+
+    // Tokens are saturated in GRAFCET.
+    Net grafcet(TypeOfNet::GRAFCET);
+    Transition& t1 = grafcet.addTransition(0.0f, 0.0f);
+    Place& p1 = grafcet.addPlace(0.0f, 0.0f, 0u);
+    grafcet.addArc(t1, p1);
+    CompiledNet compiled_grafcet(grafcet);
+    SymbolicReachability symbolic_grafcet(compiled_grafcet);
+    ASSERT_EQ(symbolic_grafcet.explore(), true);
+    ASSERT_EQ(symbolic_grafcet.countStates(), 2.0);
+    ASSERT_EQ(symbolic_grafcet.countDeadlocks(), 0.0);
+    grafcet.reset(TypeOfNet::PetriNet);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSymbolicReachability, TestExamples)
+{
+    for (auto const& file: { "GRAFCET.json", "GRAFCET2.json", "Gemma.json",
+                             "GermanTrafficLights.json", "GrafcetActions.json",
+                             "Philosophers.json", "TrafficLights.json" })
+    {
+        bool stringify;
+        Net net(TypeOfNet::PetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        CompiledNet compiled(net);
+
+        ReachabilityGraph graph(compiled);
+        ASSERT_EQ(graph.explore(ReachabilityGraph::Options()), true);
+        SymbolicReachability symbolic(compiled);
+        ASSERT_EQ(symbolic.explore(), true) << file << ": " << symbolic.error();
+        ASSERT_EQ(symbolic.countStates(), double(graph.countStates())) << file;
+        ASSERT_EQ(symbolic.countDeadlocks(), double(graph.deadlocks().size())) << file;
+
+        CompiledNet::Marking marking;
+        for (size_t s = 0u; s < graph.countStates(); ++s)
+        {
+            graph.marking(s, marking);
+            ASSERT_EQ(symbolic.contains(marking), true) << file;
+        }
+    }
+
+    // Restore the settings of Petri nets (GRAFCET saturates tokens).
+    Net net(TypeOfNet::PetriNet);
+}
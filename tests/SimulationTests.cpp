@@ -0,0 +1,107 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Simulation.hpp"
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+TEST(TestSimulation, TestCircuit)
+{
+    // P0 (1 token) -> T0 -> 2s -> P1 -> T1 -> 3s -> P0
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 1u);
+    Place& p1 = net.addPlace(100.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(50.0f, 0.0f);
+    Transition& t1 = net.addTransition(50.0f, 100.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1, 2.0f);
+    net.addArc(p1, t1);
+    net.addArc(t1, p0, 3.0f);
+
+    Simulation simulation(net);
+    simulation.start();
+    simulation.step(0.0f);
+    ASSERT_EQ(simulation.isRunning(), true);
+
+    // T0 fires.
+    simulation.step(0.5f);
+    ASSERT_EQ(p0.tokens, 0u);
+    ASSERT_EQ(p1.tokens, 0u);
+    ASSERT_EQ(simulation.animatedTokens().size(), 1u);
+
+    // Nothing can fire while the token is transiting.
+    simulation.step(0.5f);
+    simulation.step(0.5f);
+    ASSERT_EQ(p1.tokens, 0u);
+    ASSERT_EQ(simulation.animatedTokens().size(), 1u);
+
+    // The token arrives in P1 then T1 fires at the next step.
+    simulation.step(0.5f);
+    ASSERT_EQ(p1.tokens, 1u);
+    ASSERT_EQ(simulation.animatedTokens().size(), 0u);
+    simulation.step(0.0f);
+    ASSERT_EQ(p1.tokens, 0u);
+    ASSERT_EQ(simulation.animatedTokens().size(), 1u);
+
+    // Tokens added from outside the simulation are seen once notified.
+    p1.tokens = 1u;
+    simulation.invalidate();
+    simulation.step(0.0f);
+    ASSERT_EQ(p1.tokens, 0u);
+    ASSERT_EQ(simulation.animatedTokens().size(), 2u);
+
+    // The initial marking is restored when the simulation ends.
+    simulation.stop();
+    simulation.step(0.0f);
+    simulation.step(0.0f);
+    ASSERT_EQ(simulation.isRunning(), false);
+    ASSERT_EQ(p0.tokens, 1u);
+    ASSERT_EQ(p1.tokens, 0u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSimulation, TestFireAllTokens)
+{
+    // P0 (3 tokens) -> T0 -> P1: tokens are consumed one by one at the same
+    // step.
+    auto const firing = Net::Settings::firing;
+    Net::Settings::firing = Net::Settings::Fire::OneByOne;
+    Net net(TypeOfNet::TimedPetriNet);
+    Place& p0 = net.addPlace(0.0f, 0.0f, 3u);
+    Place& p1 = net.addPlace(100.0f, 0.0f, 0u);
+    Transition& t0 = net.addTransition(50.0f, 0.0f);
+    net.addArc(p0, t0);
+    net.addArc(t0, p1, 1.0f);
+
+    Simulation simulation(net);
+    simulation.start();
+    simulation.step(0.0f);
+    simulation.step(0.5f);
+    ASSERT_EQ(p0.tokens, 0u);
+    ASSERT_EQ(simulation.animatedTokens().size(), 1u);
+    ASSERT_EQ(simulation.animatedTokens()[0].tokens, 3u);
+
+    simulation.step(0.5f);
+    ASSERT_EQ(p1.tokens, 3u);
+    Net::Settings::firing = firing;
+}
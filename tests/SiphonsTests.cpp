@@ -0,0 +1,212 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "Nets.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/Reachability.hpp"
+#include "PetriNet/Siphons.hpp"
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Is the set of places (bit p of the mask) a siphon (or a trap when
+//! reversed) by definition ?
+//------------------------------------------------------------------------------
+static bool isSiphon(CompiledNet const& net, uint32_t const mask, bool const reversed)
+{
+    for (size_t t = 0u; t < net.countTransitions(); ++t)
+    {
+        bool produces = false, consumes = false;
+        for (size_t k = net.postBegin(t); k < net.postEnd(t); ++k)
+            (reversed ? consumes : produces) |= ((mask >> net.postPlace(k)) & 1u);
+        for (size_t k = net.preBegin(t); k < net.preEnd(t); ++k)
+            (reversed ? produces : consumes) |= ((mask >> net.prePlace(k)) & 1u);
+        if (produces && !consumes)
+            return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Enumerate the minimal siphons (or traps) from all subsets of places.
+//------------------------------------------------------------------------------
+static std::vector<std::vector<size_t>> bruteForce(CompiledNet const& net, bool const reversed)
+{
+    size_t const P = net.countPlaces();
+    std::vector<uint32_t> minimal;
+    // Subsets are visited by increasing size: a siphon is minimal if it does
+    // not include a minimal siphon found before.
+    std::vector<uint32_t> masks;
+    for (uint32_t mask = 1u; mask < (1u << P); ++mask)
+        masks.push_back(mask);
+    std::stable_sort(masks.begin(), masks.end(), [](uint32_t a, uint32_t b)
+    {
+        return __builtin_popcount(a) < __builtin_popcount(b);
+    });
+    for (auto const mask: masks)
+    {
+        if (!isSiphon(net, mask, reversed))
+            continue;
+        if (std::none_of(minimal.begin(), minimal.end(),
+                         [mask](uint32_t m) { return (m & mask) == m; }))
+            minimal.push_back(mask);
+    }
+
+    std::vector<std::vector<size_t>> sets;
+    for (auto const mask: minimal)
+    {
+        std::vector<size_t> set;
+        for (size_t p = 0u; p < P; ++p)
+        {
+            if ((mask >> p) & 1u)
+                set.push_back(p);
+        }
+        sets.push_back(set);
+    }
+    std::sort(sets.begin(), sets.end());
+    return sets;
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSiphons, TestDefinitions)
+{
+    // P0 -> T0 -> P1 -> T1 -> P0 and the source T2 -> P2 -> T3.
+    Net net(TypeOfNet::PetriNet);
+    net.addPlace(0.0f, 0.0f, 1u);
+    net.addPlace(1.0f, 0.0f, 0u);
+    net.addPlace(2.0f, 0.0f, 0u);
+    for (size_t i = 0u; i < 4u; ++i)
+        net.addTransition(float(i), 1.0f);
+    net.addArc(net.places()[0], net.transitions()[0]);
+    net.addArc(net.transitions()[0], net.places()[1]);
+    net.addArc(net.places()[1], net.transitions()[1]);
+    net.addArc(net.transitions()[1], net.places()[0]);
+    net.addArc(net.transitions()[2], net.places()[2]);
+    net.addArc(net.places()[2], net.transitions()[3]);
+    CompiledNet compiled(net);
+
+    // P2 is fed by a source transition: not a siphon. P2 is emptied by a
+    // sink transition: not a trap.
+    SiphonsResult siphons = findMinimalSiphons(compiled);
+    ASSERT_EQ(siphons.success, true);
+    ASSERT_EQ(siphons.sets, std::vector<std::vector<size_t>>({ { 0u, 1u } }));
+    SiphonsResult traps = findMinimalTraps(compiled);
+    ASSERT_EQ(traps.success, true);
+    ASSERT_EQ(traps.sets, std::vector<std::vector<size_t>>({ { 0u, 1u } }));
+
+    ASSERT_EQ(maximalSiphon(compiled, { 0u, 1u, 2u }), std::vector<size_t>({ 0u, 1u }));
+    ASSERT_EQ(maximalSiphon(compiled, { 1u, 2u }), std::vector<size_t>());
+    ASSERT_EQ(maximalTrap(compiled, { 0u, 1u, 2u }), std::vector<size_t>({ 0u, 1u }));
+    ASSERT_EQ(maximalTrap(compiled, { 0u }), std::vector<size_t>());
+
+    CommonerResult commoner = checkCommoner(compiled);
+    ASSERT_EQ(commoner.success, true);
+    ASSERT_EQ(commoner.holds, true);
+    ASSERT_EQ(commoner.free_choice, true);
+    ASSERT_EQ(commoner.siphons.size(), 0u);
+
+    // Without tokens the circuit is dead.
+    net.places()[0].tokens = 0u;
+    compiled.compile(net);
+    commoner = checkCommoner(compiled);
+    ASSERT_EQ(commoner.success, true);
+    ASSERT_EQ(commoner.holds, false);
+    ASSERT_EQ(commoner.siphons, std::vector<std::vector<size_t>>({ { 0u, 1u } }));
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSiphons, TestPhilosophers)
+{
+    for (size_t const n: { 2u, 3u })
+    {
+        Net net(TypeOfNet::PetriNet);
+        createPhilosophers(net, n);
+        CompiledNet compiled(net);
+
+        for (size_t const threads: { 1u, 4u })
+        {
+            SiphonsResult const siphons = findMinimalSiphons(compiled, MAX_SIPHONS, threads);
+            ASSERT_EQ(siphons.success, true);
+            ASSERT_EQ(siphons.sets, bruteForce(compiled, false));
+            SiphonsResult const traps = findMinimalTraps(compiled, MAX_SIPHONS, threads);
+            ASSERT_EQ(traps.success, true);
+            ASSERT_EQ(traps.sets, bruteForce(compiled, true));
+        }
+
+        // All philosophers can hold their left fork: the forks and the
+        // eating places form a siphon emptied by this deadlock.
+        CommonerResult const commoner = checkCommoner(compiled);
+        ASSERT_EQ(commoner.success, true);
+        ASSERT_EQ(commoner.holds, false);
+        ASSERT_EQ(commoner.free_choice, false);
+        ASSERT_EQ(commoner.siphons.empty(), false);
+    }
+
+    // Larger nets: the number of minimal siphons grows with n.
+    Net net(TypeOfNet::PetriNet);
+    createPhilosophers(net, 10u);
+    CompiledNet compiled(net);
+    SiphonsResult const siphons = findMinimalSiphons(compiled, MAX_SIPHONS, 4u);
+    ASSERT_EQ(siphons.success, true);
+    ASSERT_EQ(siphons.sets, findMinimalSiphons(compiled, MAX_SIPHONS, 1u).sets);
+    for (auto const& siphon: siphons.sets)
+        ASSERT_EQ(maximalSiphon(compiled, siphon), siphon);
+
+    SiphonsResult const limited = findMinimalSiphons(compiled, 3u);
+    ASSERT_EQ(limited.success, false);
+    ASSERT_STRNE(limited.message.c_str(), "");
+    ASSERT_EQ(limited.sets.empty(), true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSiphons, TestExamples)
+{
+    for (auto const& file: { "Philosophers.json", "EmergencyCalls.json",
+                             "SmarthomeSafety.json", "LandingGear.json",
+                             "ProducerConsumer.json", "TrafficLights.json",
+                             "EventGraph.json", "Howard1.json", "Simple.json",
+                             "ChainSaw.json" })
+    {
+        bool stringify;
+        Net net(TypeOfNet::PetriNet);
+        ASSERT_STREQ(loadFromFile(net, std::string("../data/examples/") + file,
+                                  stringify).c_str(), "");
+        CompiledNet compiled(net);
+        if (compiled.countPlaces() > 16u)
+            continue;
+
+        ASSERT_EQ(findMinimalSiphons(compiled).sets, bruteForce(compiled, false));
+        ASSERT_EQ(findMinimalTraps(compiled).sets, bruteForce(compiled, true));
+
+        // A deadlock empties a siphon without marked trap (ordinary nets).
+        CommonerResult const commoner = checkCommoner(compiled);
+        ASSERT_EQ(commoner.success, true);
+        if (commoner.holds)
+        {
+            ReachabilityGraph graph(compiled);
+            ReachabilityGraph::Options options;
+            options.coverability = true;
+            options.max_states = 100000u;
+            ASSERT_EQ(graph.explore(options), true);
+            ASSERT_EQ(graph.deadlocks().size(), 0u);
+        }
+    }
+}
@@ -220,3 +220,286 @@ TEST(TestSparseMatrix, TestDisplayOptions)
     ASSERT_TRUE(julia_str.find("[1, 2]") != std::string::npos);
     ASSERT_TRUE(julia_str.find(", 2, 2") != std::string::npos);
 }
+
+//------------------------------------------------------------------------------
+//! \brief Reference dense product used to check the sparse product.
+//------------------------------------------------------------------------------
+template<typename T>
+static T denseProduct(SparseMatrix<T> const& A, SparseMatrix<T> const& B,
+                      size_t i, size_t j)
+{
+    T sum = zero<T>();
+    for (size_t k = 0u; k < A.nbColumns(); ++k)
+    {
+        sum = sum + T(A.get(i, k) * B.get(k, j));
+    }
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSparseMatrix, TestSparseProduct)
+{
+    // Rectangular matrices with empty rows and columns.
+    SparseMatrix<MaxPlus> A(4u, 3u);
+    SparseMatrix<MaxPlus> B(3u, 5u);
+    A.set(0u, 0u, MaxPlus(1.0));
+    A.set(0u, 2u, MaxPlus(2.0));
+    A.set(2u, 1u, MaxPlus(3.0));
+    A.set(3u, 0u, MaxPlus(4.0));
+    A.set(3u, 1u, MaxPlus(0.0));
+    B.set(0u, 4u, MaxPlus(5.0));
+    B.set(0u, 1u, MaxPlus(1.0));
+    B.set(1u, 1u, MaxPlus(6.0));
+    B.set(2u, 0u, MaxPlus(7.0));
+    B.set(2u, 4u, MaxPlus(1.0));
+
+    SparseMatrix<MaxPlus> C = A * B;
+    ASSERT_EQ(C.nbRows(), 4u);
+    ASSERT_EQ(C.nbColumns(), 5u);
+    for (size_t i = 0u; i < 4u; ++i)
+    {
+        for (size_t j = 0u; j < 5u; ++j)
+        {
+            ASSERT_EQ(C.get(i, j).val, denseProduct(A, B, i, j).val);
+        }
+    }
+
+    // Columns are sorted and no zero is stored.
+    ASSERT_EQ(C.m_vals.size(), 6u);
+    ASSERT_EQ(C.m_rows[1] - C.m_rows[0], 3u);
+    ASSERT_EQ(C.m_cols[0], 0u);
+    ASSERT_EQ(C.m_cols[1], 1u);
+    ASSERT_EQ(C.m_cols[2], 4u);
+    ASSERT_EQ(C.m_rows[2], C.m_rows[1]);
+
+    // (min,+) version.
+    SparseMatrix<MinPlus> E(2u, 2u);
+    E.set(0u, 1u, MinPlus(1.0));
+    E.set(1u, 0u, MinPlus(2.0));
+    E.set(1u, 1u, MinPlus(4.0));
+    SparseMatrix<MinPlus> E2 = E * E;
+    ASSERT_EQ(E2.get(0u, 0u).val, 3.0);
+    ASSERT_EQ(E2.get(0u, 1u).val, 5.0);
+    ASSERT_EQ(E2.get(1u, 0u).val, 6.0);
+    ASSERT_EQ(E2.get(1u, 1u).val, 3.0);
+
+    // Classic algebra: cancellations are not stored.
+    SparseMatrix<double> F(2u, 2u);
+    F.set(0u, 0u, 1.0);
+    F.set(0u, 1u, 1.0);
+    F.set(1u, 0u, 1.0);
+    F.set(1u, 1u, -1.0);
+    SparseMatrix<double> F2 = F * F;
+    ASSERT_EQ(F2.m_vals.size(), 2u);
+    ASSERT_EQ(F2.get(0u, 0u), 2.0);
+    ASSERT_EQ(F2.get(1u, 1u), 2.0);
+    ASSERT_EQ(F2.get(0u, 1u), 0.0);
+
+    ASSERT_THROW(A * A, std::invalid_argument);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSparseMatrix, TestLargeSparseProduct)
+{
+    // Cyclic permutation with weights: the n-th power is the diagonal.
+    const size_t n = 2000u;
+    SparseMatrix<MaxPlus> A(n);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        A.set(i, (i + 1u) % n, MaxPlus(1.0));
+    }
+
+    SparseMatrix<MaxPlus> P = A;
+    for (size_t k = 1u; k < 8u; ++k)
+    {
+        P = P * A;
+    }
+    ASSERT_EQ(P.m_vals.size(), n);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        ASSERT_EQ(P.get(i, (i + 8u) % n).val, 8.0);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSparseMatrix, TestAddSubtract)
+{
+    SparseMatrix<double> A(3u, 4u);
+    SparseMatrix<double> B(3u, 4u);
+    A.set(0u, 0u, 1.0);
+    A.set(0u, 3u, 2.0);
+    A.set(2u, 1u, 3.0);
+    B.set(0u, 1u, 4.0);
+    B.set(0u, 3u, 5.0);
+    B.set(1u, 2u, 6.0);
+    B.set(2u, 1u, 3.0);
+
+    SparseMatrix<double> C = A + B;
+    ASSERT_EQ(C.m_vals.size(), 5u);
+    ASSERT_EQ(C.get(0u, 0u), 1.0);
+    ASSERT_EQ(C.get(0u, 1u), 4.0);
+    ASSERT_EQ(C.get(0u, 3u), 7.0);
+    ASSERT_EQ(C.get(1u, 2u), 6.0);
+    ASSERT_EQ(C.get(2u, 1u), 6.0);
+
+    // Cancellations are not stored.
+    SparseMatrix<double> D = A - B;
+    ASSERT_EQ(D.m_vals.size(), 4u);
+    ASSERT_EQ(D.get(0u, 0u), 1.0);
+    ASSERT_EQ(D.get(0u, 1u), -4.0);
+    ASSERT_EQ(D.get(0u, 3u), -3.0);
+    ASSERT_EQ(D.get(1u, 2u), -6.0);
+    ASSERT_EQ(D.get(2u, 1u), 0.0);
+
+    // Same result than building the matrix element by element.
+    SparseMatrix<double> E(3u, 4u);
+    E.set(0u, 0u, 1.0).set(0u, 1u, -4.0).set(0u, 3u, -3.0).set(1u, 2u, -6.0);
+    ASSERT_EQ(D, E);
+
+    // (max,+) sum keeps the maximum and the elements of both matrices.
+    SparseMatrix<MaxPlus> M(2u, 2u);
+    SparseMatrix<MaxPlus> N(2u, 2u);
+    M.set(0u, 0u, MaxPlus(1.0));
+    N.set(0u, 0u, MaxPlus(3.0));
+    N.set(1u, 0u, MaxPlus(2.0));
+    SparseMatrix<MaxPlus> S = M + N;
+    ASSERT_EQ(S.m_vals.size(), 2u);
+    ASSERT_EQ(S.get(0u, 0u).val, 3.0);
+    ASSERT_EQ(S.get(1u, 0u).val, 2.0);
+
+    ASSERT_THROW(A + SparseMatrix<double>(4u, 3u), std::invalid_argument);
+    ASSERT_THROW(A - SparseMatrix<double>(3u, 3u), std::invalid_argument);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSparseMatrix, TestBuilder)
+{
+    // Unsorted triplets with duplicates and zeros.
+    SparseMatrixBuilder<MaxPlus> builder(3u, 4u);
+    builder.add(2u, 3u, MaxPlus(1.0))
+           .add(0u, 2u, MaxPlus(5.0))
+           .add(2u, 0u, MaxPlus(2.0))
+           .add(0u, 2u, MaxPlus(7.0))
+           .add(0u, 1u, zero<MaxPlus>())
+           .add(0u, 0u, MaxPlus(3.0))
+           .add(0u, 2u, MaxPlus(6.0));
+    ASSERT_EQ(builder.size(), 6u);
+    ASSERT_THROW(builder.add(3u, 0u, MaxPlus(1.0)), std::out_of_range);
+    ASSERT_THROW(builder.add(0u, 4u, MaxPlus(1.0)), std::out_of_range);
+
+    SparseMatrix<MaxPlus> M = builder.build();
+    ASSERT_EQ(builder.size(), 0u);
+    ASSERT_EQ(M.nbRows(), 3u);
+    ASSERT_EQ(M.nbColumns(), 4u);
+
+    // Same content than calling set() with the (max,+) sum of duplicates.
+    SparseMatrix<MaxPlus> E(3u, 4u);
+    E.set(0u, 0u, MaxPlus(3.0)).set(0u, 2u, MaxPlus(7.0))
+     .set(2u, 0u, MaxPlus(2.0)).set(2u, 3u, MaxPlus(1.0));
+    ASSERT_EQ(M, E);
+
+    // Reuse the builder: the matrix content is replaced.
+    builder.add(1u, 1u, MaxPlus(4.0));
+    builder.build(M);
+    ASSERT_EQ(M.m_vals.size(), 1u);
+    ASSERT_EQ(M.get(1u, 1u).val, 4.0);
+    ASSERT_EQ(M.m_rows[0], 0u);
+    ASSERT_EQ(M.m_rows[1], 0u);
+    ASSERT_EQ(M.m_rows[2], 1u);
+    ASSERT_EQ(M.m_rows[3], 1u);
+
+    // Classic algebra: duplicates are summed and cancellations are dropped.
+    SparseMatrixBuilder<double> dbuilder(2u, 2u);
+    dbuilder.add(1u, 0u, 1.0).add(1u, 0u, 2.0).add(0u, 1u, 4.0).add(0u, 1u, -4.0);
+    SparseMatrix<double> D = dbuilder.build();
+    ASSERT_EQ(D.m_vals.size(), 1u);
+    ASSERT_EQ(D.get(1u, 0u), 3.0);
+
+    // Empty matrix.
+    SparseMatrix<MinPlus> N = SparseMatrixBuilder<MinPlus>(0u, 0u).build();
+    ASSERT_EQ(N.nbRows(), 0u);
+    ASSERT_EQ(N.m_rows.size(), 1u);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Reference star: I ⨁ A ⨁ ... ⨁ A^n (enough when no circuit has a
+//! positive weight).
+//------------------------------------------------------------------------------
+template<typename T>
+static SparseMatrix<T> powersStar(SparseMatrix<T> const& A)
+{
+    size_t const n = A.nbRows();
+    SparseMatrix<T> S(n);
+    for (size_t i = 0u; i < n; ++i)
+        S.set(i, i, one<T>());
+    SparseMatrix<T> P(S);
+    for (size_t k = 0u; k < n; ++k)
+    {
+        P = P * A;
+        S = S + P;
+    }
+    return S;
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSparseMatrix, TestStar)
+{
+    // Acyclic graph (like the matrix D of the dater equation).
+    SparseMatrix<MaxPlus> D(5u);
+    D.set(0u, 1u, MaxPlus(5.0));
+    D.set(0u, 3u, MaxPlus(1.0));
+    D.set(1u, 2u, MaxPlus(3.0));
+    D.set(3u, 2u, MaxPlus(1.0));
+    D.set(4u, 0u, MaxPlus(2.0));
+    SparseMatrix<MaxPlus> Ds = star(D);
+    ASSERT_EQ(Ds, powersStar(D));
+    ASSERT_EQ(Ds.get(4u, 2u).val, 10.0);
+    ASSERT_EQ(Ds.get(3u, 3u).val, 0.0);
+    ASSERT_EQ(Ds.get(2u, 0u), zero<MaxPlus>());
+
+    // Circuits of null or negative weights.
+    SparseMatrix<MaxPlus> A(4u);
+    A.set(0u, 1u, MaxPlus(2.0));
+    A.set(1u, 0u, MaxPlus(-2.0));
+    A.set(1u, 2u, MaxPlus(1.0));
+    A.set(2u, 2u, MaxPlus(-1.0));
+    A.set(2u, 3u, MaxPlus(4.0));
+    A.set(3u, 1u, MaxPlus(-6.0));
+    ASSERT_EQ(star(A), powersStar(A));
+    ASSERT_EQ(star(A).get(0u, 3u).val, 7.0);
+
+    // (min,+): shortest paths.
+    SparseMatrix<MinPlus> M(3u);
+    M.set(0u, 1u, MinPlus(4.0));
+    M.set(1u, 2u, MinPlus(1.0));
+    M.set(2u, 0u, MinPlus(2.0));
+    M.set(0u, 2u, MinPlus(7.0));
+    SparseMatrix<MinPlus> Ms = star(M);
+    ASSERT_EQ(Ms, powersStar(M));
+    ASSERT_EQ(Ms.get(0u, 2u).val, 5.0);
+    ASSERT_EQ(Ms.get(2u, 1u).val, 6.0);
+
+    // Diverging stars.
+    A.set(3u, 1u, MaxPlus(-4.0));
+    ASSERT_THROW(star(A), std::invalid_argument);
+    M.set(2u, 0u, MinPlus(-6.0));
+    ASSERT_THROW(star(M), std::invalid_argument);
+    ASSERT_THROW(star(SparseMatrix<MaxPlus>(2u, 3u)), std::invalid_argument);
+
+    // Empty matrix.
+    ASSERT_EQ(star(SparseMatrix<MaxPlus>(0u)).nbRows(), 0u);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSparseMatrix, TestLargeAcyclicStar)
+{
+    // Chain 0 -> 1 -> ... -> n-1: the star is upper triangular.
+    size_t const n = 2000u;
+    SparseMatrixBuilder<MaxPlus> builder(n, n);
+    for (size_t i = 0u; i + 1u < n; ++i)
+        builder.add(i, i + 1u, MaxPlus(1.0));
+    SparseMatrix<MaxPlus> S = star(builder.build());
+    ASSERT_EQ(S.nbNonZeros(), n * (n + 1u) / 2u);
+    ASSERT_EQ(S.get(0u, n - 1u).val, double(n - 1u));
+    ASSERT_EQ(S.get(n - 1u, 0u), zero<MaxPlus>());
+}
@@ -0,0 +1,149 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/PetriNet.hpp"
+#include "PetriNet/SysLinSimulation.hpp"
+#include "PetriNet/Algorithms.hpp"
+
+#include <sstream>
+
+using namespace ::tpne;
+
+//------------------------------------------------------------------------------
+//! \brief Reference: solve X(n) = D X(n) ⨁ A X(n-1) ⨁ B U(n) by fixed point.
+//------------------------------------------------------------------------------
+static std::vector<MaxPlus> implicitStep(SparseMatrix<MaxPlus> const& D,
+    SparseMatrix<MaxPlus> const& A, SparseMatrix<MaxPlus> const& B,
+    std::vector<MaxPlus> const& x, std::vector<MaxPlus> const& u)
+{
+    std::vector<MaxPlus> ax = A * x;
+    std::vector<MaxPlus> bu = (B.nbColumns() == 0u)
+        ? std::vector<MaxPlus>(x.size(), zero<MaxPlus>()) : B * u;
+    std::vector<MaxPlus> next(x.size(), zero<MaxPlus>());
+    for (size_t k = 0u; k <= x.size(); ++k)
+    {
+        std::vector<MaxPlus> dx = D * next;
+        for (size_t i = 0u; i < x.size(); ++i)
+            next[i] = MaxPlus(dx[i] + ax[i]) + bu[i];
+    }
+    return next;
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSysLinSimulation, TestAutonomous)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    bool stringify;
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/Howard2.json", stringify).c_str(), "");
+
+    SparseMatrix<MaxPlus> D, A, B, C;
+    ASSERT_EQ(toSysLin(net, D, A, B, C), true);
+
+    SysLinSimulation simulation(net);
+    ASSERT_EQ(simulation.states(), 5u);
+    ASSERT_EQ(simulation.inputs(), 0u);
+    ASSERT_EQ(simulation.outputs(), 0u);
+
+    std::vector<MaxPlus> x(5u, one<MaxPlus>());
+    simulation.reset(x);
+    for (size_t n = 1u; n <= 20u; ++n)
+    {
+        x = implicitStep(D, A, B, x, {});
+        simulation.step(nullptr);
+        ASSERT_EQ(simulation.event(), n);
+        for (size_t i = 0u; i < 5u; ++i)
+            ASSERT_EQ(simulation.X()[i].val, x[i].val);
+    }
+
+    // Default initial state: epsilon remains epsilon.
+    simulation.reset();
+    simulation.step(nullptr);
+    for (auto const& xi: simulation.X())
+        ASSERT_EQ(xi, zero<MaxPlus>());
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSysLinSimulation, TestInputOutput)
+{
+    Net net(TypeOfNet::TimedPetriNet);
+    bool stringify;
+    ASSERT_STREQ(loadFromFile(net, "../data/examples/JPQ.json", stringify).c_str(), "");
+
+    SparseMatrix<MaxPlus> D, A, B, C;
+    ASSERT_EQ(toSysLin(net, D, A, B, C), true);
+    SysLinSimulation simulation(D, A, B, C);
+    ASSERT_EQ(simulation.states(), 2u);
+    ASSERT_EQ(simulation.inputs(), 1u);
+    ASSERT_EQ(simulation.outputs(), 1u);
+
+    // Inputs arrive every 2 units of time.
+    size_t const events = 10u;
+    std::vector<MaxPlus> U(events);
+    for (size_t n = 0u; n < events; ++n)
+        U[n] = MaxPlus(2.0 * double(n));
+
+    // Preallocated buffers.
+    std::vector<MaxPlus> X(events * 2u), Y(events);
+    simulation.simulate(events, U.data(), X.data(), Y.data());
+    ASSERT_EQ(simulation.event(), events);
+
+    std::vector<MaxPlus> x(2u, zero<MaxPlus>());
+    for (size_t n = 0u; n < events; ++n)
+    {
+        x = implicitStep(D, A, B, x, { U[n] });
+        ASSERT_EQ(X[2u * n].val, x[0].val);
+        ASSERT_EQ(X[2u * n + 1u].val, x[1].val);
+        ASSERT_EQ(Y[n].val, (C * x)[0].val);
+    }
+
+    // Streamed to CSV: same trajectory.
+    std::stringstream ss;
+    simulation.reset();
+    simulation.simulate(2u, U.data(), ss);
+    std::stringstream expected;
+    for (size_t n = 0u; n < 2u; ++n)
+        expected << (n + 1u) << ", " << X[2u * n] << ", " << X[2u * n + 1u]
+                 << ", " << Y[n] << '\n';
+    ASSERT_STREQ(ss.str().c_str(), expected.str().c_str());
+}
+
+//------------------------------------------------------------------------------
+TEST(TestSysLinSimulation, TestErrors)
+{
+    SparseMatrix<MaxPlus> D(2u), A(2u), B(2u, 0u), C(0u, 2u);
+
+    // Circuit without tokens and with positive durations: D* is not finite.
+    D.set(0u, 1u, MaxPlus(1.0));
+    D.set(1u, 0u, MaxPlus(1.0));
+    ASSERT_THROW(SysLinSimulation(D, A, B, C), std::invalid_argument);
+
+    // Bad dimensions.
+    ASSERT_THROW(SysLinSimulation(SparseMatrix<MaxPlus>(2u), SparseMatrix<MaxPlus>(3u), B, C),
+                 std::invalid_argument);
+
+    SysLinSimulation simulation(SparseMatrix<MaxPlus>(2u), A, B, C);
+    ASSERT_THROW(simulation.reset(std::vector<MaxPlus>(3u)), std::invalid_argument);
+
+    // Not an event graph.
+    Net net(TypeOfNet::TimedPetriNet);
+    net.addPlace(0.0f, 0.0f, 0u);
+    ASSERT_THROW(SysLinSimulation{net}, std::invalid_argument);
+}
@@ -0,0 +1,169 @@
+//=============================================================================
+// TimedPetriNetEditor: A timed Petri net editor.
+// Copyright 2021 -- 2026 Quentin Quadrat <lecrapouille@gmail.com>
+//
+// This file is part of TimedPetriNetEditor.
+//
+// TimedPetriNetEditor is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GNU Emacs.  If not, see <http://www.gnu.org/licenses/>.
+//=============================================================================
+
+#include "main.hpp"
+#include "PetriNet/TropicalKernels.hpp"
+#include "PetriNet/SparseMatrix.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace ::tpne;
+
+static double const inf = std::numeric_limits<double>::infinity();
+
+//------------------------------------------------------------------------------
+//! \brief Random vector with some -inf and +inf elements.
+//------------------------------------------------------------------------------
+static std::vector<double> randomVector(std::mt19937& generator, size_t const n)
+{
+    std::uniform_real_distribution<double> values(-10.0, 10.0);
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::vector<double> v(n);
+    for (auto& x: v)
+    {
+        int const k = kind(generator);
+        x = (k == 0) ? -inf : ((k == 1) ? inf : values(generator));
+    }
+    return v;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Reference tropical product: epsilon is absorbing.
+//------------------------------------------------------------------------------
+static double product(double const a, double const b, double const eps)
+{
+    return ((a == eps) || (b == eps)) ? eps : a + b;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Run the kernels with and without SIMD and compare them to a
+//! reference implementation. Sizes are not multiple of the SIMD width.
+//------------------------------------------------------------------------------
+static void checkKernels(bool const simd)
+{
+    bool const previous = tropical::isSIMDEnabled();
+    tropical::enableSIMD(simd);
+
+    std::mt19937 generator(42u);
+    size_t const rows = 37u, cols = 29u;
+    std::vector<double> const M = randomVector(generator, rows * cols);
+    std::vector<double> const x = randomVector(generator, cols);
+    std::vector<double> const a = randomVector(generator, rows);
+
+    // Dense matrix-vector products.
+    std::vector<double> y(rows);
+    tropical::maxPlusGemv(rows, cols, M.data(), x.data(), y.data());
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double expected = -inf;
+        for (size_t j = 0u; j < cols; ++j)
+            expected = std::max(expected, product(M[i * cols + j], x[j], -inf));
+        ASSERT_EQ(y[i], expected);
+    }
+    tropical::minPlusGemv(rows, cols, M.data(), x.data(), y.data());
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double expected = inf;
+        for (size_t j = 0u; j < cols; ++j)
+            expected = std::min(expected, product(M[i * cols + j], x[j], inf));
+        ASSERT_EQ(y[i], expected);
+    }
+
+    // Sparse matrix-vector products: row i has i % 11 elements.
+    std::vector<size_t> offsets(1u, 0u), indices;
+    std::vector<double> vals;
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        for (size_t k = 0u; k < i % 11u; ++k)
+        {
+            indices.push_back((i * 7u + k * 3u) % cols);
+            vals.push_back(M[indices.size()]);
+        }
+        offsets.push_back(indices.size());
+    }
+    tropical::maxPlusSpMV(rows, offsets.data(), indices.data(), vals.data(), x.data(), y.data());
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double expected = -inf;
+        for (size_t k = offsets[i]; k < offsets[i + 1u]; ++k)
+            expected = std::max(expected, product(vals[k], x[indices[k]], -inf));
+        ASSERT_EQ(y[i], expected);
+    }
+    tropical::minPlusSpMV(rows, offsets.data(), indices.data(), vals.data(), x.data(), y.data());
+    for (size_t i = 0u; i < rows; ++i)
+    {
+        double expected = inf;
+        for (size_t k = offsets[i]; k < offsets[i + 1u]; ++k)
+            expected = std::min(expected, product(vals[k], x[indices[k]], inf));
+        ASSERT_EQ(y[i], expected);
+    }
+
+    // Vector sums, in place.
+    std::vector<double> b = randomVector(generator, rows);
+    std::vector<double> s(b);
+    tropical::maxPlusAdd(rows, a.data(), s.data(), s.data());
+    for (size_t i = 0u; i < rows; ++i)
+        ASSERT_EQ(s[i], std::max(a[i], b[i]));
+    tropical::minPlusAdd(rows, a.data(), b.data(), s.data());
+    for (size_t i = 0u; i < rows; ++i)
+        ASSERT_EQ(s[i], std::min(a[i], b[i]));
+
+    tropical::enableSIMD(previous);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestTropicalKernels, TestScalar)
+{
+    checkKernels(false);
+    ASSERT_EQ(tropical::enableSIMD(false), false);
+    ASSERT_EQ(tropical::isSIMDEnabled(), false);
+    tropical::enableSIMD(true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestTropicalKernels, TestSIMD)
+{
+    // Falls back on scalar kernels when the CPU has no AVX2.
+    checkKernels(true);
+}
+
+//------------------------------------------------------------------------------
+TEST(TestTropicalKernels, TestSparseMatrixEpsilon)
+{
+    // -inf (x) +inf is epsilon and not NaN.
+    SparseMatrix<MaxPlus> M(2u, 5u);
+    for (size_t j = 0u; j < 5u; ++j)
+        M.set(0u, j, MaxPlus(double(j)));
+    M.set(1u, 4u, MaxPlus(inf));
+
+    std::vector<MaxPlus> x = { MaxPlus(1.0), zero<MaxPlus>(), MaxPlus(0.0),
+                               MaxPlus(-2.0), zero<MaxPlus>() };
+    std::vector<MaxPlus> y = M * x;
+    ASSERT_EQ(y[0].val, 2.0);
+    ASSERT_EQ(y[1].val, -inf);
+
+    SparseMatrix<MinPlus> N(1u, 5u);
+    for (size_t j = 0u; j < 5u; ++j)
+        N.set(0u, j, MinPlus(-inf));
+    std::vector<MinPlus> z(5u, zero<MinPlus>());
+    ASSERT_EQ((N * z)[0].val, inf);
+}